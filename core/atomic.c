@@ -26,8 +26,9 @@
 #include "cpu.h"
 #include "atomic.h"
 
-/* Set ARCH_HAS_ATOMIC_COMPARE_AND_SWAP within cpu.h to override this function */
-#if (ARCH_HAS_ATOMIC_COMPARE_AND_SWAP == 0)
+/* Set ARCH_HAS_ATOMIC_COMPARE_AND_SWAP within cpu.h to override this function.
+ * Not needed at all if the compiler provides lock-free atomics, see atomic.h */
+#if (ARCH_HAS_ATOMIC_COMPARE_AND_SWAP == 0) && !ATOMIC_LOCK_FREE
 
 int atomic_cas(atomic_int_t *var, int old, int now)
 {
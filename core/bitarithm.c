@@ -19,45 +19,39 @@
  * @}
  */
 
-#include <stdio.h>
+#include "bitarithm.h"
 
-unsigned bitarithm_msb(unsigned v)
+unsigned bitarithm_msb_soft(unsigned v)
 {
     register unsigned r; // result of log2(v) will go here
-
-#if ARCH_32_BIT
     register unsigned shift;
 
+#if ARCH_32_BIT
     r =     (v > 0xFFFF) << 4; v >>= r;
     shift = (v > 0xFF  ) << 3; v >>= shift; r |= shift;
+#else
+    r =     (v > 0xFF  ) << 3; v >>= r;
+#endif
     shift = (v > 0xF   ) << 2; v >>= shift; r |= shift;
     shift = (v > 0x3   ) << 1; v >>= shift; r |= shift;
                                             r |= (v >> 1);
-#else
-    r = 0;
-    while (v >>= 1) { // unroll for more speed...
-        r++;
-    }
-
-#endif
 
     return r;
 }
 /*---------------------------------------------------------------------------*/
-unsigned bitarithm_lsb(register unsigned v)
+unsigned bitarithm_lsb_soft(unsigned v)
 {
-    register unsigned r = 0;
-
-    while ((v & 0x01) == 0) {
-        v >>= 1;
-        r++;
-    };
-
-    return r;
+    /* the lowest set bit is the highest one once all others are cleared */
+    return bitarithm_msb_soft(v & -v);
 }
 /*---------------------------------------------------------------------------*/
-unsigned bitarithm_bits_set(unsigned v)
+unsigned bitarithm_bits_set_soft(unsigned v)
 {
+#if ARCH_32_BIT
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+#else
     unsigned c; // c accumulates the total bits set in v
 
     for (c = 0; v; c++) {
@@ -65,4 +59,5 @@ unsigned bitarithm_bits_set(unsigned v)
     }
 
     return c;
+#endif
 }
@@ -42,6 +42,26 @@ typedef struct {
  */
 #define ATOMIC_INIT(val) {(val)}
 
+/**
+ * @brief   Set to 1 if the compiler can implement atomic operations on int
+ *          with native lock-free instructions (e.g. LDREX/STREX on Cortex-M3
+ *          and up, `lock cmpxchg` on x86)
+ *
+ * In this case all functions in this file are inline wrappers around the
+ * GCC `__atomic` builtins. Otherwise, atomic_cas() is implemented by
+ * disabling interrupts (or by the CPU, see ARCH_HAS_ATOMIC_COMPARE_AND_SWAP)
+ * and the other functions are built upon it.
+ *
+ * Define ATOMIC_USE_IRQ_LOCK to force the interrupt based implementation.
+ */
+#if defined(__GCC_ATOMIC_INT_LOCK_FREE) && (__GCC_ATOMIC_INT_LOCK_FREE == 2) \
+    && !defined(ATOMIC_USE_IRQ_LOCK)
+#define ATOMIC_LOCK_FREE    (1)
+#else
+#define ATOMIC_LOCK_FREE    (0)
+#endif
+
+#if ATOMIC_LOCK_FREE || defined(DOXYGEN)
 /**
  * @brief Atomic Compare and Swap
  *
@@ -54,7 +74,11 @@ typedef struct {
  * @return 1 if the write completed successfully
  * @return 0 if the write failed.
  */
-int atomic_cas(atomic_int_t *var, int old, int now);
+static inline int atomic_cas(atomic_int_t *var, int old, int now)
+{
+    return __atomic_compare_exchange_n(&var->value, &old, now, 0,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
 
 /**
  * @brief Increment a counter variable by one atomically and return the old value.
@@ -65,13 +89,7 @@ int atomic_cas(atomic_int_t *var, int old, int now);
  */
 static inline int atomic_inc(atomic_int_t *var)
 {
-    int old;
-
-    do {
-        old = var->value;
-    } while (!atomic_cas(var, old, old + 1));
-
-    return old;
+    return __atomic_fetch_add(&var->value, 1, __ATOMIC_SEQ_CST);
 }
 
 /**
@@ -83,13 +101,7 @@ static inline int atomic_inc(atomic_int_t *var)
  */
 static inline int atomic_dec(atomic_int_t *var)
 {
-    int old;
-
-    do {
-        old = var->value;
-    } while (!atomic_cas(var, old, old - 1));
-
-    return old;
+    return __atomic_fetch_sub(&var->value, 1, __ATOMIC_SEQ_CST);
 }
 
 /**
@@ -102,13 +114,7 @@ static inline int atomic_dec(atomic_int_t *var)
  */
 static inline int atomic_set_to_one(atomic_int_t *var)
 {
-    do {
-        if (var->value != 0) {
-            return 0;
-        }
-    } while (!atomic_cas(var, 0, 1));
-
-    return 1;
+    return atomic_cas(var, 0, 1);
 }
 
 /**
@@ -119,6 +125,46 @@ static inline int atomic_set_to_one(atomic_int_t *var)
  * @return 1 if the old value was not 0 and the variable was successfully updated
  * @return 0 if the variable was already cleared
  */
+static inline int atomic_set_to_zero(atomic_int_t *var)
+{
+    return (__atomic_exchange_n(&var->value, 0, __ATOMIC_SEQ_CST) != 0);
+}
+#else
+int atomic_cas(atomic_int_t *var, int old, int now);
+
+static inline int atomic_inc(atomic_int_t *var)
+{
+    int old;
+
+    do {
+        old = var->value;
+    } while (!atomic_cas(var, old, old + 1));
+
+    return old;
+}
+
+static inline int atomic_dec(atomic_int_t *var)
+{
+    int old;
+
+    do {
+        old = var->value;
+    } while (!atomic_cas(var, old, old - 1));
+
+    return old;
+}
+
+static inline int atomic_set_to_one(atomic_int_t *var)
+{
+    do {
+        if (var->value != 0) {
+            return 0;
+        }
+    } while (!atomic_cas(var, 0, 1));
+
+    return 1;
+}
+
 static inline int atomic_set_to_zero(atomic_int_t *var)
 {
     int old;
@@ -133,6 +179,7 @@ static inline int atomic_set_to_zero(atomic_int_t *var)
 
     return 1;
 }
+#endif /* ATOMIC_LOCK_FREE */
 
 /**
  * @brief Get the value of an atomic int
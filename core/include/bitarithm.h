@@ -91,32 +91,91 @@
 #define ARCH_32_BIT   (__INT_MAX__ == 2147483647) /**< 1 for 32 bit architectures, 0 otherwise */
 
 /**
- * @brief   Returns the number of the highest '1' bit in a value
- * @param[in]   v   Input value
- * @return          Bit Number
+ * @brief   1 if the CPU can count leading and trailing zeros in hardware
+ *
+ * With hardware support, bitarithm_msb() and bitarithm_lsb() compile to a
+ * few instructions (CLZ, RBIT on ARMv7-M, BSR/BSF on x86) instead of
+ * calling the software implementations.
+ */
+#ifndef BITARITHM_HAS_CLZ
+#if defined(__ARM_FEATURE_CLZ) || defined(__i386__) || defined(__x86_64__)
+#define BITARITHM_HAS_CLZ   (1)
+#else
+#define BITARITHM_HAS_CLZ   (0)
+#endif
+#endif
+
+/**
+ * @brief   1 if the CPU counts set bits in hardware
+ */
+#ifndef BITARITHM_HAS_POPCNT
+#if defined(__POPCNT__)
+#define BITARITHM_HAS_POPCNT    (1)
+#else
+#define BITARITHM_HAS_POPCNT    (0)
+#endif
+#endif
+
+/**
+ * @brief   Software implementation of bitarithm_msb()
  *
  * Source: http://graphics.stanford.edu/~seander/bithacks.html#IntegerLogObvious
  */
-unsigned bitarithm_msb(unsigned v);
+unsigned bitarithm_msb_soft(unsigned v);
+
+/**
+ * @brief   Software implementation of bitarithm_lsb()
+ */
+unsigned bitarithm_lsb_soft(unsigned v);
+
+/**
+ * @brief   Software implementation of bitarithm_bits_set()
+ *
+ * Source: http://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetParallel
+ */
+unsigned bitarithm_bits_set_soft(unsigned v);
+
+/**
+ * @brief   Returns the number of the highest '1' bit in a value
+ * @param[in]   v   Input value - must be unequal to '0'
+ * @return          Bit Number
+ */
+static inline unsigned bitarithm_msb(unsigned v)
+{
+#if BITARITHM_HAS_CLZ
+    return (8 * sizeof(v) - 1) - __builtin_clz(v);
+#else
+    return bitarithm_msb_soft(v);
+#endif
+}
 
 /**
  * @brief   Returns the number of the lowest '1' bit in a value
- * @param[in]   v   Input value - must be unequal to '0', otherwise the
- *                  function will produce an infinite loop
+ * @param[in]   v   Input value - must be unequal to '0'
  * @return          Bit Number
- *
- * Source: http://graphics.stanford.edu/~seander/bithacks.html#IntegerLogObvious
  */
-unsigned bitarithm_lsb(register unsigned v);
+static inline unsigned bitarithm_lsb(unsigned v)
+{
+#if BITARITHM_HAS_CLZ
+    return __builtin_ctz(v);
+#else
+    return bitarithm_lsb_soft(v);
+#endif
+}
 
 /**
  * @brief   Returns the number of bits set in a value
  * @param[in]   v   Input value
  * @return          Number of set bits
- *
- * Source: http://graphics.stanford.edu/~seander/bithacks.html#IntegerLogObvious
  */
-unsigned bitarithm_bits_set(unsigned v);
+static inline unsigned bitarithm_bits_set(unsigned v)
+{
+#if BITARITHM_HAS_POPCNT
+    return __builtin_popcount(v);
+#else
+    return bitarithm_bits_set_soft(v);
+#endif
+}
 
 #ifdef __cplusplus
 }
@@ -17,6 +17,7 @@
  * This file contains a circularly linked list implementation.
  *
  * clist_insert(), clist_remove_head() and clist_advance() take constant time.
+ * clist_remove() takes linear time.
  *
  * Each list is represented as a "clist_node_t". It's only member, the "next"
  * pointer, points to the last entry in the list, whose "next" pointer points to
@@ -91,6 +92,39 @@ static inline clist_node_t *clist_remove_head(clist_node_t *list)
     }
 }
 
+/**
+ * @brief Removes *node* from *list*
+ *
+ * @param[in,out]   list        Pointer to the *list* to remove *node* from.
+ * @param[in]       node        Node to remove. Must not be NULL.
+ *
+ * @return          *node* if it was found in and removed from *list*
+ * @return          NULL if *node* was not part of *list*
+ */
+static inline clist_node_t *clist_remove(clist_node_t *list, clist_node_t *node)
+{
+    if (list->next) {
+        clist_node_t *pos = list->next;
+        do {
+            if (pos->next == node) {
+                if (pos == node) {
+                    /* node was the only element */
+                    list->next = NULL;
+                }
+                else {
+                    pos->next = node->next;
+                    if (list->next == node) {
+                        list->next = pos;
+                    }
+                }
+                return node;
+            }
+            pos = pos->next;
+        } while (pos != list->next);
+    }
+    return NULL;
+}
+
 /**
  * @brief Advances the circle list.
  *
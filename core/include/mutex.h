@@ -11,6 +11,24 @@
  * @defgroup    core_sync Synchronization
  * @brief       Mutex for thread synchronization
  * @ingroup     core
+ *
+ * Mutexes queue their waiters by thread priority. When the
+ * `core_mutex_priority_inheritance` module is used, a thread that blocks on a
+ * mutex additionally lends its priority to the current owner of the mutex if
+ * the owner has a lower priority. Whenever a boosted owner unlocks a mutex,
+ * its priority is recomputed from the priority it was created with and the
+ * threads still blocked on mutexes it owns, so mutexes can be unlocked in any
+ * order. This bounds the time a high priority thread can be blocked by lower
+ * priority threads holding a shared resource (priority inversion).
+ *
+ * Only blocked threads keep a reference to a mutex, so mutexes used as
+ * signals (locked by one context, unlocked by another or never unlocked
+ * before going out of scope) are safe to use. A mutex locked from interrupt
+ * context has no owner and does not take part in priority inheritance.
+ *
+ * @note    Priority inheritance is not transitive: if the owner itself is
+ *          blocked on another mutex, the owner of that mutex is not boosted.
+ *
  * @{
  *
  * @file
@@ -26,6 +44,7 @@
 
 #include "list.h"
 #include "atomic.h"
+#include "kernel_types.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -34,20 +53,31 @@
 /**
  * @brief Mutex structure. Must never be modified by the user.
  */
-typedef struct {
+typedef struct mutex {
     /**
      * @brief   The process waiting queue of the mutex. **Must never be changed
      *          by the user.**
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PRIORITY_INHERITANCE) || defined(DOXYGEN)
+    /**
+     * @brief   The current owner of the mutex or @ref KERNEL_PID_UNDEF
+     * @internal
+     */
+    kernel_pid_t owner;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Initializes a mutex object.
@@ -58,6 +88,9 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    mutex->owner = KERNEL_PID_UNDEF;
+#endif
 }
 
 /**
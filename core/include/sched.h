@@ -39,6 +39,23 @@
  * happens, threads with the same priority will only switch due to
  * voluntary or implicit context switches.
  *
+ * The optional `sched_round_robin` module adds time slicing among
+ * threads of the same priority: while more than one thread is runnable
+ * at the priority of the active thread, an xtimer moves the active
+ * thread to the end of its run queue every @ref SCHED_RR_QUANTUM
+ * microseconds. No timer is used while a thread is alone on its
+ * priority level. The timer is only re-armed when the thread owning the
+ * quantum changes; a quantum keeps running while its thread is preempted
+ * by a higher priority thread that does not need time slicing itself.
+ *
+ * The optional `sched_stack_watermark` module records the lowest stack
+ * pointer of each thread as saved when the scheduler switches it out, and
+ * `ps` reports stack usage from it. This is only a sample: stack used
+ * between two context switches (deep calls that return before the thread
+ * yields, blocks or is preempted, or an ISR running on the thread's stack
+ * without causing a switch) is not seen. The value is a lower bound, use
+ * the stack fill pattern for the exact maximum.
+ *
  * ## Interrupts:
  *
  * When an interrupt occurs, e.g. because a timer fired or a network
@@ -99,6 +116,10 @@ typedef struct _thread thread_t;
 /**
  * @def SCHED_PRIO_LEVELS
  * @brief The number of thread priority levels
+ *
+ * Up to 256 levels are supported. Beyond the number of bits in an `unsigned`,
+ * the scheduler uses a two-level bitmap to find the highest runnable
+ * priority.
  */
 #ifndef SCHED_PRIO_LEVELS
 #define SCHED_PRIO_LEVELS 16
@@ -119,6 +140,25 @@ int sched_run(void);
  */
 void sched_set_status(thread_t *process, unsigned int status);
 
+/**
+ * @brief   Change the priority of the given thread
+ *
+ * @details If the thread is on a run queue, it is moved to the tail of the run
+ *          queue of its new priority. This function does not trigger a
+ *          context switch, the caller is responsible for calling
+ *          sched_switch() or thread_yield_higher() if appropriate.
+ *
+ * @note    This is used by the mutex implementation to implement priority
+ *          inheritance (`core_mutex_priority_inheritance`). Other code should
+ *          usually not alter thread priorities at runtime.
+ *
+ * @param[in,out]   thread      Thread to change the priority of,
+ *                              must not be NULL
+ * @param[in]       priority    New priority of the thread,
+ *                              must be smaller than @ref SCHED_PRIO_LEVELS
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief       Yield if approriate.
  *
@@ -174,6 +214,25 @@ extern clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
  */
 NORETURN void sched_task_exit(void);
 
+#if defined(MODULE_SCHED_ROUND_ROBIN) || defined(DOXYGEN)
+/**
+ * @def SCHED_RR_QUANTUM
+ * @brief   Time slice in microseconds given to a thread before the next
+ *          thread of the same priority is scheduled
+ *
+ * Only used with the `sched_round_robin` module. The timer is only set while
+ * more than one thread is runnable at the priority of the active thread.
+ */
+#ifndef SCHED_RR_QUANTUM
+#define SCHED_RR_QUANTUM (10000U)
+#endif
+
+/**
+ *  Number of time slices that expired per thread
+ */
+extern unsigned int sched_rr_slices[KERNEL_PID_LAST + 1];
+#endif /* MODULE_SCHED_ROUND_ROBIN */
+
 #ifdef MODULE_SCHEDSTATISTICS
 /**
  *  Scheduler statistics
@@ -78,6 +78,11 @@ struct _thread {
 
     kernel_pid_t pid;               /**< thread's process id            */
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    uint8_t base_priority;          /**< priority without inheritance   */
+    struct mutex *mutex_blocked;    /**< mutex the thread waits for     */
+#endif
+
 #ifdef MODULE_CORE_THREAD_FLAGS
     thread_flags_t flags;           /**< currently set flags            */
 #endif
@@ -93,9 +98,15 @@ struct _thread {
     msg_t *msg_array;               /**< memory holding messages        */
 #endif
 
-#if defined DEVELHELP || defined(SCHED_TEST_STACK)
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || \
+    defined(MODULE_MPU_STACK_GUARD)
     char *stack_start;              /**< thread's stack start address   */
 #endif
+#ifdef MODULE_SCHED_STACK_WATERMARK
+    char *stack_lowest;             /**< lowest stack pointer seen on
+                                         context switches, only sampled
+                                         when switched out              */
+#endif
 #ifdef DEVELHELP
     const char *name;               /**< thread's name                  */
     int stack_size;                 /**< thread's stack size            */
@@ -45,6 +45,12 @@
  * Note that some flags (currently the three most significant bits) are used by
  * core functions and should not be set by the user. They can be waited for.
  *
+ * Below those, modules that block on a flag of their own take one bit each,
+ * counting down: bit 12 for sockets (`SOCKET_THREAD_FLAG`), bit 11 for the
+ * SAUL sampler (`SAUL_SAMPLER_THREAD_FLAG`) and bit 10 for asynchronous bus
+ * transactions (`BUS_ASYNC_THREAD_FLAG`). New modules should pick the next
+ * free bit.
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  */
 #ifndef THREAD_FLAG_H
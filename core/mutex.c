@@ -37,6 +37,101 @@
 
 #define MUTEX_LOCKED ((void*)-1)
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+/* the priority @p thread is entitled to: its base priority or that of the
+ * highest priority thread blocked on any mutex it owns. Only blocked threads
+ * reference mutexes, so a mutex that is left locked and goes out of scope
+ * (e.g. one used as a signal) leaves nothing behind. */
+static uint8_t _inherited_priority(thread_t *thread)
+{
+    uint8_t priority = thread->base_priority;
+
+    if (thread->priority == priority) {
+        /* not boosted, nothing to give back */
+        return priority;
+    }
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        thread_t *waiter = (thread_t *)thread_get(pid);
+        if (waiter && waiter->mutex_blocked &&
+            (waiter->mutex_blocked->owner == thread->pid) &&
+            (waiter->priority < priority)) {
+            priority = waiter->priority;
+        }
+    }
+
+    return priority;
+}
+
+static inline void _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    /* an ISR cannot own a mutex, don't attribute it to the thread it
+     * interrupted */
+    if (!irq_is_in()) {
+        mutex->owner = thread->pid;
+    }
+}
+
+static inline void _boost_owner(mutex_t *mutex, thread_t *waiter)
+{
+    thread_t *owner = (thread_t *)thread_get(mutex->owner);
+
+    waiter->mutex_blocked = mutex;
+    if (owner && (owner->priority > waiter->priority)) {
+        DEBUG("PID[%" PRIkernel_pid "]: boosting owner %" PRIkernel_pid
+              " to prio %" PRIu32 "\n", waiter->pid, owner->pid,
+              (uint32_t)waiter->priority);
+        sched_change_priority(owner, waiter->priority);
+    }
+}
+
+static inline void _pass_owner(mutex_t *mutex, thread_t *process)
+{
+    thread_t *owner = (thread_t *)thread_get(mutex->owner);
+
+    mutex->owner = KERNEL_PID_UNDEF;
+    if (process) {
+        process->mutex_blocked = NULL;
+        mutex->owner = process->pid;
+        /* the woken waiter inherits from those still waiting behind it */
+        if (mutex->queue.next) {
+            thread_t *waiter = container_of((clist_node_t*)mutex->queue.next,
+                                            thread_t, rq_entry);
+            if (waiter->priority < process->priority) {
+                sched_change_priority(process, waiter->priority);
+            }
+        }
+    }
+
+    if (owner) {
+        uint8_t priority = _inherited_priority(owner);
+        if (owner->priority != priority) {
+            DEBUG("PID[%" PRIkernel_pid "]: restoring prio %" PRIu32 "\n",
+                  owner->pid, (uint32_t)priority);
+            sched_change_priority(owner, priority);
+        }
+    }
+}
+#else
+static inline void _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    (void)mutex;
+    (void)thread;
+}
+
+static inline void _boost_owner(mutex_t *mutex, thread_t *waiter)
+{
+    (void)mutex;
+    (void)waiter;
+}
+
+static inline void _pass_owner(mutex_t *mutex, thread_t *process)
+{
+    (void)mutex;
+    (void)process;
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -46,6 +141,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _set_owner(mutex, (thread_t*)sched_active_thread);
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -63,6 +159,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+        _boost_owner(mutex, me);
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -89,6 +186,7 @@ void mutex_unlock(mutex_t *mutex)
     }
 
     if (mutex->queue.next == MUTEX_LOCKED) {
+        _pass_owner(mutex, NULL);
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
@@ -98,6 +196,7 @@ void mutex_unlock(mutex_t *mutex)
     list_node_t *next = list_remove_head(&mutex->queue);
 
     thread_t *process = container_of((clist_node_t*)next, thread_t, rq_entry);
+    _pass_owner(mutex, process);
 
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
@@ -120,12 +219,14 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
 
     if (mutex->queue.next) {
         if (mutex->queue.next == MUTEX_LOCKED) {
+            _pass_owner(mutex, NULL);
             mutex->queue.next = NULL;
         }
         else {
             list_node_t *next = list_remove_head(&mutex->queue);
             thread_t *process = container_of((clist_node_t*)next, thread_t,
                                              rq_entry);
+            _pass_owner(mutex, process);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
             sched_set_status(process, STATUS_PENDING);
             if (!mutex->queue.next) {
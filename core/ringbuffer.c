@@ -54,14 +54,26 @@ static char get_head(ringbuffer_t *restrict rb)
 
 unsigned ringbuffer_add(ringbuffer_t *restrict rb, const char *buf, unsigned n)
 {
-    unsigned i;
-    for (i = 0; i < n; i++) {
-        if (ringbuffer_full(rb)) {
-            break;
+    unsigned free = rb->size - rb->avail;
+    if (n > free) {
+        n = free;
+    }
+    if (n > 0) {
+        unsigned pos = rb->start + rb->avail;
+        if (pos >= rb->size) {
+            pos -= rb->size;
+        }
+        unsigned bytes_till_end = rb->size - pos;
+        if (bytes_till_end >= n) {
+            memcpy(rb->buf + pos, buf, n);
         }
-        add_tail(rb, buf[i]);
+        else {
+            memcpy(rb->buf + pos, buf, bytes_till_end);
+            memcpy(rb->buf, buf + bytes_till_end, n - bytes_till_end);
+        }
+        rb->avail += n;
     }
-    return i;
+    return n;
 }
 
 int ringbuffer_add_one(ringbuffer_t *restrict rb, char c)
@@ -117,12 +129,12 @@ unsigned ringbuffer_remove(ringbuffer_t *restrict rb, unsigned n)
         rb->start = rb->avail = 0;
     }
     else {
-        rb->start -= n;
+        rb->start += n;
         rb->avail -= n;
 
-        /* compensate underflow */
-        if (rb->start > rb->size) {
-            rb->start += rb->size;
+        /* compensate overflow */
+        if (rb->start >= rb->size) {
+            rb->start -= rb->size;
         }
     }
 
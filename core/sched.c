@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 
+#include "assert.h"
 #include "sched.h"
 #include "clist.h"
 #include "bitarithm.h"
@@ -29,7 +30,7 @@
 #include "irq.h"
 #include "log.h"
 
-#ifdef MODULE_SCHEDSTATISTICS
+#if defined(MODULE_SCHEDSTATISTICS) || defined(MODULE_SCHED_ROUND_ROBIN)
 #include "xtimer.h"
 #endif
 
@@ -51,13 +52,149 @@ volatile thread_t *sched_active_thread;
 volatile kernel_pid_t sched_active_pid = KERNEL_PID_UNDEF;
 
 clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
-static uint32_t runqueue_bitcache = 0;
+
+/**
+ * @brief   Priorities per word of the run queue bitmap
+ */
+#define RQ_WORD_BITS    (ARCH_32_BIT ? 32 : 16)
+
+/**
+ * @brief   Words in the run queue bitmap
+ */
+#define RQ_WORDS        ((SCHED_PRIO_LEVELS + RQ_WORD_BITS - 1) / RQ_WORD_BITS)
+
+#if RQ_WORDS == 1
+static unsigned runqueue_bitcache = 0;
+
+static inline void _runqueue_set(uint8_t priority)
+{
+    runqueue_bitcache |= 1u << priority;
+}
+
+static inline void _runqueue_clear(uint8_t priority)
+{
+    runqueue_bitcache &= ~(1u << priority);
+}
+
+static inline unsigned _runqueue_first(void)
+{
+    return bitarithm_lsb(runqueue_bitcache);
+}
+#else
+/* more priorities than bits in a word: a second level marks the words of the
+ * bitmap that are not empty, so finding the first runnable priority still
+ * takes two bit scans */
+#if RQ_WORDS > RQ_WORD_BITS
+#error "SCHED_PRIO_LEVELS exceeds the capacity of the run queue bitmap"
+#endif
+static unsigned runqueue_bitcache[RQ_WORDS];
+static unsigned runqueue_words = 0;
+
+static inline void _runqueue_set(uint8_t priority)
+{
+    unsigned word = priority / RQ_WORD_BITS;
+
+    runqueue_bitcache[word] |= 1u << (priority % RQ_WORD_BITS);
+    runqueue_words |= 1u << word;
+}
+
+static inline void _runqueue_clear(uint8_t priority)
+{
+    unsigned word = priority / RQ_WORD_BITS;
+
+    runqueue_bitcache[word] &= ~(1u << (priority % RQ_WORD_BITS));
+    if (!runqueue_bitcache[word]) {
+        runqueue_words &= ~(1u << word);
+    }
+}
+
+static inline unsigned _runqueue_first(void)
+{
+    unsigned word = bitarithm_lsb(runqueue_words);
+
+    return word * RQ_WORD_BITS + bitarithm_lsb(runqueue_bitcache[word]);
+}
+#endif
+
+#ifdef MODULE_MPU_STACK_GUARD
+#include "mpu.h"
+#endif
+
+/**
+ * @brief   Stack pointer of a thread that is not running
+ *
+ * CPUs that keep the stack pointer somewhere else than in thread_t::sp
+ * override this in their cpu_conf.h.
+ */
+#ifndef THREAD_SAVED_SP
+#define THREAD_SAVED_SP(thread)     ((thread)->sp)
+#endif
 
 #ifdef MODULE_SCHEDSTATISTICS
 static void (*sched_cb) (uint32_t timestamp, uint32_t value) = NULL;
 schedstat sched_pidlist[KERNEL_PID_LAST + 1];
 #endif
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+unsigned int sched_rr_slices[KERNEL_PID_LAST + 1];
+static xtimer_t _rr_timer;
+/* thread whose quantum the timer is armed for, KERNEL_PID_UNDEF if unarmed */
+static volatile kernel_pid_t _rr_owner = KERNEL_PID_UNDEF;
+
+static inline int _rr_shared(uint8_t priority)
+{
+    clist_node_t *rq = &sched_runqueues[priority];
+    return (rq->next && (rq->next != rq->next->next));
+}
+
+static void _rr_cb(void *arg)
+{
+    (void)arg;
+    thread_t *owner = (thread_t *)sched_threads[_rr_owner];
+
+    _rr_owner = KERNEL_PID_UNDEF;
+
+    if (owner && (owner->status >= STATUS_ON_RUNQUEUE) &&
+        (sched_runqueues[owner->priority].next->next == &owner->rq_entry) &&
+        _rr_shared(owner->priority)) {
+        /* the owner is the head of its run queue, move it to the tail and
+         * let the next thread of the same priority run */
+        sched_rr_slices[owner->pid]++;
+        clist_advance(&sched_runqueues[owner->priority]);
+        sched_context_switch_request = 1;
+    }
+}
+
+static void _rr_start(thread_t *thread)
+{
+    if (thread->pid == _rr_owner) {
+        /* the quantum of this thread is still running */
+        return;
+    }
+
+    int shared = _rr_shared(thread->priority);
+
+    if (_rr_owner != KERNEL_PID_UNDEF) {
+        thread_t *owner = (thread_t *)sched_threads[_rr_owner];
+        if (!shared && owner && (owner->status >= STATUS_ON_RUNQUEUE)) {
+            /* a higher priority thread that needs no time slicing preempted
+             * the owner, whose quantum just keeps running */
+            return;
+        }
+        xtimer_remove(&_rr_timer);
+        _rr_owner = KERNEL_PID_UNDEF;
+    }
+
+    /* only spend a timer if other threads of the same priority are waiting
+     * for the CPU */
+    if (shared) {
+        _rr_timer.callback = _rr_cb;
+        _rr_owner = thread->pid;
+        xtimer_set(&_rr_timer, SCHED_RR_QUANTUM);
+    }
+}
+#endif
+
 int sched_run(void)
 {
     sched_context_switch_request = 0;
@@ -67,7 +204,7 @@ int sched_run(void)
     /* The bitmask in runqueue_bitcache is never empty,
      * since the threading should not be started before at least the idle thread was started.
      */
-    int nextrq = bitarithm_lsb(runqueue_bitcache);
+    int nextrq = _runqueue_first();
     thread_t *next_thread = container_of(sched_runqueues[nextrq].next->next, thread_t, rq_entry);
 
     DEBUG("sched_run: active thread: %" PRIkernel_pid ", next thread: %" PRIkernel_pid "\n",
@@ -94,6 +231,13 @@ int sched_run(void)
         }
 #endif
 
+#ifdef MODULE_SCHED_STACK_WATERMARK
+        char *sp = (char *)THREAD_SAVED_SP(active_thread);
+        if (sp < active_thread->stack_lowest) {
+            active_thread->stack_lowest = sp;
+        }
+#endif
+
 #ifdef MODULE_SCHEDSTATISTICS
         schedstat *active_stat = &sched_pidlist[active_thread->pid];
         if (active_stat->laststart) {
@@ -111,10 +255,20 @@ int sched_run(void)
     }
 #endif
 
+#ifdef MODULE_MPU_STACK_GUARD
+    /* make the lowest 32 byte aligned block of the stack read only */
+    mpu_configure(1, (uintptr_t)next_thread->stack_start + 31,
+                  MPU_ATTR(1, AP_RO_RO, 0, 1, 0, 1, MPU_SIZE_32B));
+#endif
+
     next_thread->status = STATUS_RUNNING;
     sched_active_pid = next_thread->pid;
     sched_active_thread = (volatile thread_t *) next_thread;
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+    _rr_start(next_thread);
+#endif
+
     DEBUG("sched_run: done, changed sched_active_thread.\n");
 
     return 1;
@@ -134,7 +288,16 @@ void sched_set_status(thread_t *process, unsigned int status)
             DEBUG("sched_set_status: adding thread %" PRIkernel_pid " to runqueue %" PRIu16 ".\n",
                   process->pid, process->priority);
             clist_insert(&sched_runqueues[process->priority], &(process->rq_entry));
-            runqueue_bitcache |= 1 << process->priority;
+            _runqueue_set(process->priority);
+
+#ifdef MODULE_SCHED_ROUND_ROBIN
+            /* a thread joined the run queue of the active thread */
+            if (sched_active_thread && (_rr_owner != sched_active_pid) &&
+                (sched_active_thread->priority == process->priority) &&
+                (sched_active_thread != process)) {
+                _rr_start((thread_t *)sched_active_thread);
+            }
+#endif
         }
     }
     else {
@@ -144,7 +307,7 @@ void sched_set_status(thread_t *process, unsigned int status)
             clist_remove_head(&sched_runqueues[process->priority]);
 
             if (!sched_runqueues[process->priority].next) {
-                runqueue_bitcache &= ~(1 << process->priority);
+                _runqueue_clear(process->priority);
             }
         }
     }
@@ -152,6 +315,42 @@ void sched_set_status(thread_t *process, unsigned int status)
     process->status = status;
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert(priority < SCHED_PRIO_LEVELS);
+
+    unsigned irqstate = irq_disable();
+
+    if (thread->priority == priority) {
+        irq_restore(irqstate);
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid " %" PRIu16 " -> %" PRIu16 "\n",
+          thread->pid, (uint16_t)thread->priority, (uint16_t)priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_remove(&sched_runqueues[thread->priority], &(thread->rq_entry));
+
+        if (!sched_runqueues[thread->priority].next) {
+            _runqueue_clear(thread->priority);
+        }
+
+        clist_node_t *tail = sched_runqueues[priority].next;
+        clist_insert(&sched_runqueues[priority], &(thread->rq_entry));
+        if (tail && (thread == (thread_t *)sched_active_thread)) {
+            /* keep the active thread at the head of its new run queue, as
+             * sched_set_status() removes the head when the thread blocks */
+            sched_runqueues[priority].next = tail;
+        }
+        _runqueue_set(priority);
+    }
+
+    thread->priority = priority;
+
+    irq_restore(irqstate);
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
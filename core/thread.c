@@ -211,10 +211,15 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cb->pid = pid;
     cb->sp = thread_stack_init(function, arg, stack, stacksize);
 
-#if defined(DEVELHELP) || defined(SCHED_TEST_STACK)
+#if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || \
+    defined(MODULE_MPU_STACK_GUARD)
     cb->stack_start = stack;
 #endif
 
+#ifdef MODULE_SCHED_STACK_WATERMARK
+    cb->stack_lowest = (char *)cb;
+#endif
+
 #ifdef DEVELHELP
     cb->stack_size = total_stacksize;
     cb->name = name;
@@ -223,6 +228,11 @@ kernel_pid_t thread_create(char *stack, int stacksize, char priority, int flags,
     cb->priority = priority;
     cb->status = 0;
 
+#ifdef MODULE_CORE_MUTEX_PRIORITY_INHERITANCE
+    cb->base_priority = priority;
+    cb->mutex_blocked = NULL;
+#endif
+
     cb->rq_entry.next = NULL;
 
 #ifdef MODULE_CORE_MSG
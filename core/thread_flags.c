@@ -19,6 +19,7 @@
  */
 
 
+#include "atomic.h"
 #include "thread_flags.h"
 #include "irq.h"
 #include "thread.h"
@@ -29,11 +30,16 @@
 #ifdef MODULE_CORE_THREAD_FLAGS
 static thread_flags_t _thread_flags_clear_atomic(thread_t *thread, thread_flags_t mask)
 {
+#if ATOMIC_LOCK_FREE && (__GCC_ATOMIC_SHORT_LOCK_FREE == 2)
+    return __atomic_fetch_and(&thread->flags, (thread_flags_t)~mask,
+                              __ATOMIC_SEQ_CST) & mask;
+#else
     unsigned state = irq_disable();
     mask &= thread->flags;
     thread->flags &= ~mask;
     irq_restore(state);
     return mask;
+#endif
 }
 
 static void _thread_flags_wait(thread_flags_t mask, thread_t *thread, unsigned threadstate, unsigned irqstate)
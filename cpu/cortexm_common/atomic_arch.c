@@ -25,7 +25,8 @@
 #include "irq.h"
 #include "cpu.h"
 
-#if ARCH_HAS_ATOMIC_COMPARE_AND_SWAP
+/* with lock-free compiler builtins, atomic_cas() is inlined from atomic.h */
+#if ARCH_HAS_ATOMIC_COMPARE_AND_SWAP && !ATOMIC_LOCK_FREE
 int atomic_cas(atomic_int_t *var, int old, int now)
 {
     int tmp;
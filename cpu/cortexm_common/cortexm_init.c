@@ -20,6 +20,10 @@
 
 #include "cpu.h"
 
+#ifdef MODULE_MPU_STACK_GUARD
+#include "mpu.h"
+#endif
+
 /**
  * @name   Pattern to write into the co-processor Access Control Register to
  *         allow full FPU access
@@ -60,4 +64,9 @@ void cortexm_init(void)
 #ifdef SCB_CCR_STKALIGN_Msk
     SCB->CCR |= SCB_CCR_STKALIGN_Msk;
 #endif
+
+#ifdef MODULE_MPU_STACK_GUARD
+    /* the guard region itself is set on every context switch */
+    mpu_enable();
+#endif
 }
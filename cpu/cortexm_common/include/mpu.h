@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cortexm_common
+ * @{
+ *
+ * @file
+ * @brief       Minimal interface to the Cortex-M memory protection unit
+ *
+ * Used by the `mpu_stack_guard` module to place a read-only guard region at
+ * the bottom of the stack of the active thread.
+ */
+
+#ifndef MPU_H_
+#define MPU_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Access permissions (privileged_unprivileged)
+ */
+enum {
+    AP_NO_NO = 0,   /**< no access */
+    AP_RW_NO = 1,   /**< privileged read/write, no unprivileged access */
+    AP_RW_RO = 2,   /**< privileged read/write, unprivileged read only */
+    AP_RW_RW = 3,   /**< read/write for everyone */
+    AP_RO_NO = 5,   /**< privileged read only, no unprivileged access */
+    AP_RO_RO = 6,   /**< read only for everyone */
+};
+
+/**
+ * @brief   Region sizes, a region of size n covers 2^(n + 1) bytes
+ */
+enum {
+    MPU_SIZE_32B  = 4,  /**< 32 bytes */
+    MPU_SIZE_64B  = 5,  /**< 64 bytes */
+    MPU_SIZE_128B = 6,  /**< 128 bytes */
+    MPU_SIZE_256B = 7,  /**< 256 bytes */
+    MPU_SIZE_512B = 8,  /**< 512 bytes */
+    MPU_SIZE_1K   = 9,  /**< 1 kilobyte */
+};
+
+/**
+ * @brief   Assemble the attribute and size register value of a region
+ *
+ * @param[in] xn    execute never
+ * @param[in] ap    access permissions
+ * @param[in] tex   type extension
+ * @param[in] c     cacheable
+ * @param[in] b     bufferable
+ * @param[in] s     shareable
+ * @param[in] size  region size
+ */
+#define MPU_ATTR(xn, ap, tex, c, b, s, size) \
+    (((uint32_t)(xn) << 28) | ((uint32_t)(ap) << 24) | \
+     ((uint32_t)(tex) << 19) | ((uint32_t)(s) << 18) | \
+     ((uint32_t)(c) << 17) | ((uint32_t)(b) << 16) | ((uint32_t)(size) << 1))
+
+/**
+ * @brief   Enable the MPU, keeping the default memory map as background
+ *          region for privileged accesses
+ *
+ * @return  0 on success
+ * @return  -1 if the CPU has no MPU
+ */
+int mpu_enable(void);
+
+/**
+ * @brief   Disable the MPU
+ *
+ * @return  0 on success
+ * @return  -1 if the CPU has no MPU
+ */
+int mpu_disable(void);
+
+/**
+ * @brief   Configure and enable a region
+ *
+ * @param[in] region    number of the region
+ * @param[in] base      base address, rounded down to the region size
+ * @param[in] attr      attributes and size, see @ref MPU_ATTR
+ *
+ * @return  0 on success
+ * @return  -1 if the CPU has no MPU
+ */
+int mpu_configure(uint_fast8_t region, uintptr_t base, uint_fast32_t attr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPU_H_ */
+/** @} */
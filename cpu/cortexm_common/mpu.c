@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cortexm_common
+ * @{
+ *
+ * @file
+ * @brief       Cortex-M memory protection unit configuration
+ *
+ * @}
+ */
+
+#include "cpu.h"
+#include "mpu.h"
+
+int mpu_enable(void)
+{
+#if __MPU_PRESENT
+    MPU->CTRL = MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk;
+#ifdef SCB_SHCSR_MEMFAULTENA_Msk
+    /* report violations as MemManage fault instead of HardFault */
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk;
+#endif
+    __DSB();
+    __ISB();
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+int mpu_disable(void)
+{
+#if __MPU_PRESENT
+    MPU->CTRL &= ~MPU_CTRL_ENABLE_Msk;
+    __DSB();
+    __ISB();
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+int mpu_configure(uint_fast8_t region, uintptr_t base, uint_fast32_t attr)
+{
+#if __MPU_PRESENT
+    MPU->RNR = region;
+    MPU->RBAR = base & MPU_RBAR_ADDR_Msk;
+    MPU->RASR = attr | MPU_RASR_ENABLE_Msk;
+    return 0;
+#else
+    (void)region;
+    (void)base;
+    (void)attr;
+    return -1;
+#endif
+}
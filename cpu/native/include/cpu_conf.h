@@ -50,6 +50,21 @@ extern "C" {
 #endif /* OS */
 /** @} */
 
+/**
+ * @brief   On native, thread_t::sp points to the ucontext of a thread, the
+ *          stack pointer of a thread that is not running is saved in there
+ */
+#define THREAD_SAVED_SP(thread)     native_thread_saved_sp((thread)->sp)
+
+/**
+ * @brief   Get the stack pointer saved in a thread's ucontext
+ *
+ * @param[in] ctx   thread_t::sp of the thread
+ *
+ * @return  the saved stack pointer
+ */
+char *native_thread_saved_sp(char *ctx);
+
 /**
  * @brief   Native internal Ethernet protocol number
  */
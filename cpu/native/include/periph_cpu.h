@@ -32,6 +32,11 @@ extern "C" {
 #define CPUID_LEN           (4U)
 #endif
 
+/**
+ * @brief   The UART reads all pending bytes at once from the host
+ */
+#define PERIPH_UART_HAS_INIT_BUF
+
 #ifdef __cplusplus
 }
 #endif
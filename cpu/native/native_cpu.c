@@ -21,6 +21,11 @@
  * @author  Kaspar Schleiser <kaspar@schleiser.de>
  */
 
+/* for gregs[REG_ESP] access under Linux, must precede all system headers */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <unistd.h>
 
@@ -108,6 +113,21 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_sta
     return (char *) p;
 }
 
+char *native_thread_saved_sp(char *ctx)
+{
+    ucontext_t *uc = (ucontext_t *)ctx;
+
+#ifdef __MACH__
+    return (char *)uc->uc_mcontext->__ss.__esp;
+#elif defined(__FreeBSD__)
+    return (char *)uc->uc_mcontext.mc_esp;
+#elif defined(__arm__)
+    return (char *)uc->uc_mcontext.arm_sp;
+#else
+    return (char *)uc->uc_mcontext.gregs[REG_ESP];
+#endif
+}
+
 void isr_cpu_switch_context_exit(void)
 {
     ucontext_t *ctx;
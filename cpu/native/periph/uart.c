@@ -21,7 +21,7 @@
 #include <limits.h>
 #include <string.h>
 #include <termios.h>
-#include <fcntl.h>
+#include <sys/select.h>
 
 #include "thread.h"
 #include "periph/uart.h"
@@ -31,11 +31,28 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+/**
+ * @brief   Size of the chunks read from the host
+ */
+#ifndef NATIVE_UART_RX_BUFSIZE
+#define NATIVE_UART_RX_BUFSIZE  (512U)
+#endif
+
 /**
  * @brief callback function and its argument
  */
 static uart_isr_ctx_t uart_config[UART_NUMOF];
 
+/**
+ * @brief bulk callback functions, used instead of uart_isr_ctx_t::rx_cb if set
+ */
+static uart_rx_buf_cb_t uart_rx_buf_cb[UART_NUMOF];
+
+/**
+ * @brief receive buffer, only used from interrupt context
+ */
+static uint8_t rx_buf[NATIVE_UART_RX_BUFSIZE];
+
 /**
  * @brief filenames of /dev/tty
  */
@@ -61,40 +78,43 @@ static void io_signal_handler(int fd)
         }
     }
 
-    int is_first = 1;
-
     while (1) {
-        char c;
-        int status = real_read(fd, &c, 1);
+        int status = real_read(fd, rx_buf, sizeof(rx_buf));
 
-        if (status == 1) {
-            if (is_first) {
-                is_first = 0;
-                DEBUG("read char from serial port");
+        if (status > 0) {
+#if ENABLE_DEBUG
+            DEBUG("read from serial port:");
+            for (int i = 0; i < status; i++) {
+                DEBUG(" %02x", rx_buf[i]);
             }
-
-            DEBUG(" %02x", (unsigned char) c);
-
-            uart_config[uart].rx_cb(uart_config[uart].arg, c);
-        } else {
+            DEBUG("\n");
+#endif
+            if (uart_rx_buf_cb[uart]) {
+                uart_rx_buf_cb[uart](uart_config[uart].arg, rx_buf, status);
+            }
+            else {
+                for (int i = 0; i < status; i++) {
+                    uart_config[uart].rx_cb(uart_config[uart].arg, rx_buf[i]);
+                }
+            }
+        }
+        else {
             if (status == -1 && errno != EAGAIN) {
                 DEBUG("error: cannot read from serial port\n");
 
                 uart_config[uart].rx_cb = NULL;
+                uart_rx_buf_cb[uart] = NULL;
             }
 
             break;
         }
     }
 
-    if (!is_first) {
-        DEBUG("\n");
-    }
-
     native_async_read_continue(fd);
 }
 
-int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
+static int _init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb,
+                 uart_rx_buf_cb_t rx_buf_cb, void *arg)
 {
     if (uart >= UART_NUMOF) {
         return -1;
@@ -149,6 +169,7 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
 
     uart_config[uart].rx_cb = rx_cb;
     uart_config[uart].arg = arg;
+    uart_rx_buf_cb[uart] = rx_buf_cb;
 
     native_async_read_setup();
     native_async_read_add_handler(tty_fds[uart], io_signal_handler);
@@ -156,6 +177,17 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
     return 0;
 }
 
+int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
+{
+    return _init(uart, baudrate, rx_cb, NULL, arg);
+}
+
+int uart_init_buf(uart_t uart, uint32_t baudrate, uart_rx_buf_cb_t rx_cb,
+                  void *arg)
+{
+    return _init(uart, baudrate, NULL, rx_cb, arg);
+}
+
 void uart_write(uart_t uart, const uint8_t *data, size_t len)
 {
     DEBUG("writing to serial port ");
@@ -171,14 +203,35 @@ void uart_write(uart_t uart, const uint8_t *data, size_t len)
 
     DEBUG("\n");
 
-    _native_write(tty_fds[uart], data, len);
+    /* the tty is non-blocking, wait until the host takes the rest */
+    while (len) {
+        ssize_t res = _native_write(tty_fds[uart], data, len);
+
+        if (res > 0) {
+            data += res;
+            len -= res;
+        }
+        else if (res == -1 && errno == EAGAIN) {
+            fd_set wfds;
+
+            FD_ZERO(&wfds);
+            FD_SET(tty_fds[uart], &wfds);
+            _native_syscall_enter();
+            real_select(tty_fds[uart] + 1, NULL, &wfds, NULL, NULL);
+            _native_syscall_leave();
+        }
+        else {
+            DEBUG("error: cannot write to serial port\n");
+            break;
+        }
+    }
 }
 
 void uart_cleanup(void) {
     native_async_read_cleanup();
 
     for (uart_t uart = 0; uart < UART_NUMOF; uart++) {
-        if (uart_config[uart].rx_cb != NULL) {
+        if ((uart_config[uart].rx_cb != NULL) || (uart_rx_buf_cb[uart] != NULL)) {
             real_close(tty_fds[uart]);
         }
     }
@@ -31,6 +31,8 @@
 #include <stdint.h>
 #include "atomic.h"
 
+/* with lock-free compiler builtins, atomic_cas() is inlined from atomic.h */
+#if !ATOMIC_LOCK_FREE
 int atomic_cas(atomic_int_t *dest, int known_value, int new_value)
 {
     uint8_t successful;
@@ -41,3 +43,4 @@ int atomic_cas(atomic_int_t *dest, int known_value, int new_value)
                   : "flags");
     return successful;
 }
+#endif
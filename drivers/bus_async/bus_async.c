@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_bus_async
+ * @{
+ *
+ * @file
+ * @brief       Transaction queue shared by all backends
+ *
+ * @}
+ */
+
+#include "irq.h"
+#include "sched.h"
+#include "bus_async.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static void _notify(bus_async_xfer_t *xfer, int result)
+{
+    xfer->result = result;
+    if (xfer->cb) {
+        xfer->cb(xfer, xfer->arg);
+    }
+    else if (xfer->thread) {
+        thread_flags_set(xfer->thread, xfer->flags);
+    }
+}
+
+void bus_async_init(bus_async_t *bus, const bus_async_driver_t *driver)
+{
+    bus->driver = driver;
+    bus->head = NULL;
+    bus->tail = NULL;
+}
+
+void bus_async_submit(bus_async_t *bus, bus_async_xfer_t *xfer)
+{
+    xfer->next = NULL;
+    xfer->result = -EINPROGRESS;
+
+    unsigned state = irq_disable();
+    int idle = (bus->head == NULL);
+    if (idle) {
+        bus->head = xfer;
+    }
+    else {
+        bus->tail->next = xfer;
+    }
+    bus->tail = xfer;
+    irq_restore(state);
+
+    if (idle) {
+        bus->driver->start(bus, xfer);
+    }
+}
+
+int bus_async_transfer(bus_async_t *bus, bus_async_xfer_t *xfer)
+{
+    xfer->cb = NULL;
+    xfer->thread = (thread_t *)sched_active_thread;
+    xfer->flags = BUS_ASYNC_THREAD_FLAG;
+
+    bus_async_submit(bus, xfer);
+    while (xfer->result == -EINPROGRESS) {
+        thread_flags_wait_any(BUS_ASYNC_THREAD_FLAG);
+    }
+
+    return xfer->result;
+}
+
+void bus_async_done(bus_async_t *bus, int result)
+{
+    unsigned state = irq_disable();
+    bus_async_xfer_t *xfer = bus->head;
+    bus_async_xfer_t *next = xfer->next;
+    bus_async_xfer_t *chain = xfer->chain;
+
+    if (chain && (result == 0)) {
+        /* the chained transaction goes first, the rest queues behind it */
+        chain->result = -EINPROGRESS;
+        chain->next = next;
+        if (bus->tail == xfer) {
+            bus->tail = chain;
+        }
+        next = chain;
+        chain = NULL;
+    }
+    bus->head = next;
+    if (next == NULL) {
+        bus->tail = NULL;
+    }
+    irq_restore(state);
+
+    /* keep the bus busy before anyone gets to see the result */
+    if (next) {
+        bus->driver->start(bus, next);
+    }
+
+    DEBUG("bus_async: %p done: %d\n", (void *)xfer, result);
+    _notify(xfer, result);
+
+    /* cancel the chain of a failed transaction */
+    while (chain) {
+        bus_async_xfer_t *cancelled = chain;
+        chain = chain->chain;
+        _notify(cancelled, -ECANCELED);
+    }
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_bus_async_periph
+ * @{
+ *
+ * @file
+ * @brief       Peripheral bus backend implementation
+ *
+ * @}
+ */
+
+#include "periph_conf.h"
+#include "periph/gpio.h"
+#include "thread.h"
+#include "bus_async/periph.h"
+
+#if SPI_NUMOF
+#include "periph/spi.h"
+#endif
+#if I2C_NUMOF
+#include "periph/i2c.h"
+#endif
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if SPI_NUMOF
+static int _run_spi(unsigned dev, const bus_async_xfer_t *xfer)
+{
+    int res = 0;
+
+    spi_acquire(dev);
+    if (xfer->cs != GPIO_UNDEF) {
+        gpio_clear(xfer->cs);
+    }
+
+    for (unsigned i = 0; i < xfer->ops_numof; i++) {
+        const bus_async_op_t *op = &xfer->ops[i];
+
+        if (spi_transfer_bytes(dev, (char *)op->out, (char *)op->in,
+                               op->len) < (int)op->len) {
+            res = -EIO;
+            break;
+        }
+    }
+
+    if (xfer->cs != GPIO_UNDEF) {
+        gpio_set(xfer->cs);
+    }
+    spi_release(dev);
+
+    return res;
+}
+#endif
+
+#if I2C_NUMOF
+static int _run_i2c(unsigned dev, const bus_async_xfer_t *xfer)
+{
+    const bus_async_op_t *ops = xfer->ops;
+    unsigned numof = xfer->ops_numof;
+    int res = 0;
+
+    i2c_acquire(dev);
+
+    for (unsigned i = 0; i < numof;) {
+        const bus_async_op_t *op = &ops[i];
+        const bus_async_op_t *data = (i + 1 < numof) ? &ops[i + 1] : NULL;
+        int expected;
+        int n;
+
+        if (op->out && (op->len == 1) && data && data->in && !data->out) {
+            expected = data->len;
+            n = i2c_read_regs(dev, xfer->addr, op->out[0], (char *)data->in,
+                              data->len);
+            i += 2;
+        }
+        else if (op->out && (op->len == 1) && data && data->out && !data->in) {
+            expected = data->len;
+            n = i2c_write_regs(dev, xfer->addr, op->out[0], (char *)data->out,
+                               data->len);
+            i += 2;
+        }
+        else if (op->out) {
+            expected = op->len;
+            n = i2c_write_bytes(dev, xfer->addr, (char *)op->out, op->len);
+            i++;
+        }
+        else {
+            expected = op->len;
+            n = i2c_read_bytes(dev, xfer->addr, (char *)op->in, op->len);
+            i++;
+        }
+
+        if (n != expected) {
+            res = ((n == 0) && expected) ? -ENXIO : -EIO;
+            break;
+        }
+    }
+
+    i2c_release(dev);
+
+    return res;
+}
+#endif
+
+static void *_worker(void *arg)
+{
+    bus_async_periph_t *bus = arg;
+
+    while (1) {
+        thread_flags_wait_any(BUS_ASYNC_THREAD_FLAG);
+
+        bus_async_xfer_t *xfer = bus->bus.head;
+        int res = -ENODEV;
+
+        if (xfer == NULL) {
+            continue;
+        }
+#if I2C_NUMOF
+        if (bus->i2c) {
+            res = _run_i2c(bus->dev, xfer);
+        }
+#endif
+#if SPI_NUMOF
+        if (!bus->i2c) {
+            res = _run_spi(bus->dev, xfer);
+        }
+#endif
+        DEBUG("bus_async_periph: transaction on %s %u: %d\n",
+              bus->i2c ? "I2C" : "SPI", bus->dev, res);
+        bus_async_done(&bus->bus, res);
+    }
+
+    return NULL;
+}
+
+static void _start(bus_async_t *bus, bus_async_xfer_t *xfer)
+{
+    (void)xfer;
+    thread_flags_set((thread_t *)thread_get(((bus_async_periph_t *)bus)->pid),
+                     BUS_ASYNC_THREAD_FLAG);
+}
+
+static const bus_async_driver_t _driver = {
+    .start = _start,
+};
+
+static kernel_pid_t _init(bus_async_periph_t *bus, unsigned dev, uint8_t i2c,
+                          char *stack, int stacksize, char priority)
+{
+    bus_async_init(&bus->bus, &_driver);
+    bus->dev = dev;
+    bus->i2c = i2c;
+    bus->pid = thread_create(stack, stacksize, priority,
+                             THREAD_CREATE_STACKTEST, _worker, bus,
+                             i2c ? "bus_async_i2c" : "bus_async_spi");
+    return bus->pid;
+}
+
+kernel_pid_t bus_async_periph_init_spi(bus_async_periph_t *bus, unsigned dev,
+                                       char *stack, int stacksize,
+                                       char priority)
+{
+    return _init(bus, dev, 0, stack, stacksize, priority);
+}
+
+kernel_pid_t bus_async_periph_init_i2c(bus_async_periph_t *bus, unsigned dev,
+                                       char *stack, int stacksize,
+                                       char priority)
+{
+    return _init(bus, dev, 1, stack, stacksize, priority);
+}
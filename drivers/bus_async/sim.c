@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_bus_async_sim
+ * @{
+ *
+ * @file
+ * @brief       Simulated bus implementation
+ *
+ * @}
+ */
+
+#include "irq.h"
+#include "bus_async/sim.h"
+
+static const bus_async_driver_t _driver;
+
+static bus_async_sim_dev_t *_find(bus_async_sim_t *sim, uint16_t addr)
+{
+    bus_async_sim_dev_t *dev = sim->devs;
+    while (dev && (dev->addr != addr)) {
+        dev = dev->next;
+    }
+    return dev;
+}
+
+static int _execute(bus_async_sim_t *sim, bus_async_xfer_t *xfer)
+{
+    bus_async_sim_dev_t *dev = _find(sim, xfer->addr);
+    int set_ptr = 1;
+
+    if (!dev && sim->i2c) {
+        return -ENXIO;
+    }
+
+    for (unsigned i = 0; i < xfer->ops_numof; i++) {
+        const bus_async_op_t *op = &xfer->ops[i];
+
+        for (unsigned j = 0; j < op->len; j++) {
+            uint8_t in = 0xff;
+
+            if (!dev) {
+                /* nobody drives MISO */
+            }
+            else if (op->out && set_ptr) {
+                dev->ptr = op->out[j];
+            }
+            else {
+                if (dev->ptr < dev->regs_len) {
+                    in = dev->regs[dev->ptr];
+                    if (op->out) {
+                        dev->regs[dev->ptr] = op->out[j];
+                    }
+                }
+                dev->ptr++;
+            }
+            set_ptr = 0;
+
+            if (op->in) {
+                op->in[j] = in;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static void _complete(void *arg)
+{
+    bus_async_sim_t *sim = arg;
+
+    /* the data moves at the end, as with DMA buffers are not valid before */
+    int res = _execute(sim, sim->bus.head);
+
+    sim->xfers++;
+    bus_async_done(&sim->bus, res);
+}
+
+static void _start(bus_async_t *bus, bus_async_xfer_t *xfer)
+{
+    bus_async_sim_t *sim = (bus_async_sim_t *)bus;
+    uint32_t duration = bus_async_sim_duration(sim, xfer);
+
+    sim->busy_us += duration;
+    xtimer_set(&sim->timer, duration);
+}
+
+static void _init(bus_async_sim_t *sim, uint32_t clock, uint8_t i2c)
+{
+    bus_async_init(&sim->bus, &_driver);
+    sim->devs = NULL;
+    sim->clock = clock;
+    sim->i2c = i2c;
+    sim->timer.callback = _complete;
+    sim->timer.arg = sim;
+    sim->xfers = 0;
+    sim->busy_us = 0;
+}
+
+void bus_async_sim_init_spi(bus_async_sim_t *sim, uint32_t clock)
+{
+    _init(sim, clock, 0);
+}
+
+void bus_async_sim_init_i2c(bus_async_sim_t *sim, uint32_t clock)
+{
+    _init(sim, clock, 1);
+}
+
+void bus_async_sim_add_dev(bus_async_sim_t *sim, bus_async_sim_dev_t *dev,
+                           uint16_t addr, uint8_t *regs, size_t regs_len)
+{
+    dev->addr = addr;
+    dev->ptr = 0;
+    dev->regs = regs;
+    dev->regs_len = regs_len;
+
+    unsigned state = irq_disable();
+    dev->next = sim->devs;
+    sim->devs = dev;
+    irq_restore(state);
+}
+
+uint32_t bus_async_sim_duration(const bus_async_sim_t *sim,
+                                const bus_async_xfer_t *xfer)
+{
+    uint64_t cycles = bus_async_xfer_len(xfer) * (sim->i2c ? 9 : 8);
+
+    if (sim->i2c) {
+        /* (repeated) start plus address byte per operation, one stop */
+        cycles += xfer->ops_numof * (1 + 9) + 1;
+    }
+
+    return (uint32_t)((cycles * 1000000 + sim->clock - 1) / sim->clock);
+}
+
+static const bus_async_driver_t _driver = {
+    .start = _start,
+};
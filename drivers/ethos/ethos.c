@@ -24,6 +24,7 @@
 
 #include "random.h"
 #include "ethos.h"
+#include "framing.h"
 #include "periph/uart.h"
 #include "tsrb.h"
 #include "irq.h"
@@ -41,12 +42,9 @@
 #include "debug.h"
 
 static void _get_mac_addr(netdev2_t *dev, uint8_t* buf);
-static void ethos_isr(void *arg, uint8_t c);
+static void ethos_isr(void *arg, const uint8_t *data, size_t len);
 static const netdev2_driver_t netdev2_driver_ethos;
 
-static const uint8_t _esc_esc[] = {ETHOS_ESC_CHAR, (ETHOS_ESC_CHAR ^ 0x20)};
-static const uint8_t _esc_delim[] = {ETHOS_ESC_CHAR, (ETHOS_FRAME_DELIMITER ^ 0x20)};
-
 
 void ethos_setup(ethos_t *dev, const ethos_params_t *params)
 {
@@ -59,6 +57,7 @@ void ethos_setup(ethos_t *dev, const ethos_params_t *params)
 
     tsrb_init(&dev->inbuf, (char*)params->buf, params->bufsize);
     mutex_init(&dev->out_mutex);
+    uart_txbuf_init(&dev->out, params->uart, dev->out_buf, sizeof(dev->out_buf));
 
     uint32_t a = random_uint32();
     memcpy(dev->mac_addr, (char*)&a, 4);
@@ -68,7 +67,7 @@ void ethos_setup(ethos_t *dev, const ethos_params_t *params)
     dev->mac_addr[0] &= (0x2);      /* unset globally unique bit */
     dev->mac_addr[0] &= ~(0x1);     /* set unicast bit*/
 
-    uart_init(params->uart, params->baudrate, ethos_isr, (void*)dev);
+    uart_init_buf(params->uart, params->baudrate, ethos_isr, (void*)dev);
 
     uint8_t frame_delim = ETHOS_FRAME_DELIMITER;
     uart_write(dev->uart, &frame_delim, 1);
@@ -82,14 +81,14 @@ static void _reset_state(ethos_t *dev)
     dev->framesize = 0;
 }
 
-static void _handle_char(ethos_t *dev, char c)
+static void _handle_chars(ethos_t *dev, const uint8_t *data, size_t len)
 {
     switch (dev->frametype) {
         case ETHOS_FRAME_TYPE_DATA:
         case ETHOS_FRAME_TYPE_HELLO:
         case ETHOS_FRAME_TYPE_HELLO_REPLY:
-             if (tsrb_add_one(&dev->inbuf, c) == 0) {
-                dev->framesize++;
+            if (tsrb_add(&dev->inbuf, (const char *)data, len) == (int)len) {
+                dev->framesize += len;
             } else {
                 //puts("lost frame");
                 dev->inbuf.reads = 0;
@@ -99,8 +98,10 @@ static void _handle_char(ethos_t *dev, char c)
             break;
 #ifdef USE_ETHOS_FOR_STDIO
         case ETHOS_FRAME_TYPE_TEXT:
-            dev->framesize++;
-            uart_stdio_rx_cb(NULL, c);
+            dev->framesize += len;
+            while (len--) {
+                uart_stdio_rx_cb(NULL, *data++);
+            }
 #endif
     }
 }
@@ -127,10 +128,8 @@ static void _end_of_frame(ethos_t *dev)
     _reset_state(dev);
 }
 
-static void ethos_isr(void *arg, uint8_t c)
+static void _handle_byte(ethos_t *dev, uint8_t c)
 {
-    ethos_t *dev = (ethos_t *) arg;
-
     switch (dev->state) {
         case WAIT_FRAMESTART:
             if (c == ETHOS_FRAME_DELIMITER) {
@@ -148,16 +147,18 @@ static void ethos_isr(void *arg, uint8_t c)
                 }
             }
             else {
-                _handle_char(dev, c);
+                _handle_chars(dev, &c, 1);
             }
             break;
         case IN_ESCAPE:
             switch (c) {
                 case (ETHOS_FRAME_DELIMITER ^ 0x20):
-                    _handle_char(dev, ETHOS_FRAME_DELIMITER);
+                    c = ETHOS_FRAME_DELIMITER;
+                    _handle_chars(dev, &c, 1);
                     break;
                 case (ETHOS_ESC_CHAR ^ 0x20):
-                    _handle_char(dev, ETHOS_ESC_CHAR);
+                    c = ETHOS_ESC_CHAR;
+                    _handle_chars(dev, &c, 1);
                     break;
                 case (ETHOS_FRAME_TYPE_TEXT ^ 0x20):
                     dev->frametype = ETHOS_FRAME_TYPE_TEXT;
@@ -174,6 +175,26 @@ static void ethos_isr(void *arg, uint8_t c)
     }
 }
 
+static void ethos_isr(void *arg, const uint8_t *data, size_t len)
+{
+    ethos_t *dev = (ethos_t *) arg;
+
+    while (len) {
+        /* pass bytes that need no unescaping on in one piece */
+        if (dev->state == IN_FRAME) {
+            size_t n = framing_plain_len(&framing_hdlc, data, len);
+            if (n) {
+                _handle_chars(dev, data, n);
+                data += n;
+                len -= n;
+                continue;
+            }
+        }
+        _handle_byte(dev, *data++);
+        len--;
+    }
+}
+
 static void _isr(netdev2_t *netdev)
 {
     ethos_t *dev = (ethos_t *) netdev;
@@ -197,57 +218,44 @@ static size_t iovec_count_total(const struct iovec *vector, int count)
     return result;
 }
 
-static void _write_escaped(uart_t uart, uint8_t c)
+static void _write(void *arg, const uint8_t *data, size_t len)
 {
-    uint8_t *out;
-    int n;
-
-    switch(c) {
-        case ETHOS_FRAME_DELIMITER:
-            out = (uint8_t*)_esc_delim;
-            n = 2;
-            break;
-        case ETHOS_ESC_CHAR:
-            out = (uint8_t*)_esc_esc;
-            n = 2;
-            break;
-        default:
-            out = &c;
-            n = 1;
-    }
-
-    uart_write(uart, out, n);
+    uart_txbuf_write((uart_txbuf_t *)arg, data, len);
 }
 
 void ethos_send_frame(ethos_t *dev, const uint8_t *data, size_t len, unsigned frame_type)
 {
-    uint8_t frame_delim = ETHOS_FRAME_DELIMITER;
+    uart_txbuf_t *out = &dev->out;
+    uart_txbuf_t isr_out;
+    uint8_t isr_buf[16];
 
     if (!irq_is_in()) {
         mutex_lock(&dev->out_mutex);
     }
     else {
         /* Send frame delimiter. This cancels the current frame,
-         * but enables in-ISR writes.  */
-        uart_write(dev->uart, &frame_delim, 1);
+         * but enables in-ISR writes. The bytes a thread may have
+         * pending in dev->out are left alone. */
+        uart_txbuf_init(&isr_out, dev->uart, isr_buf, sizeof(isr_buf));
+        out = &isr_out;
+        uart_txbuf_putc(out, ETHOS_FRAME_DELIMITER);
     }
 
     /* send frame delimiter */
-    uart_write(dev->uart, &frame_delim, 1);
+    uart_txbuf_putc(out, ETHOS_FRAME_DELIMITER);
 
     /* set frame type */
     if (frame_type) {
-        uint8_t out[2] = { ETHOS_ESC_CHAR, (frame_type ^ 0x20) };
-        uart_write(dev->uart, out, 2);
+        uart_txbuf_putc(out, ETHOS_ESC_CHAR);
+        uart_txbuf_putc(out, frame_type ^ 0x20);
     }
 
     /* send frame content */
-    while(len--) {
-        _write_escaped(dev->uart, *(uint8_t*)data++);
-    }
+    framing_encode(&framing_hdlc, data, len, _write, out);
 
     /* end of frame */
-    uart_write(dev->uart, &frame_delim, 1);
+    uart_txbuf_putc(out, ETHOS_FRAME_DELIMITER);
+    uart_txbuf_flush(out);
 
     if (!irq_is_in()) {
         mutex_unlock(&dev->out_mutex);
@@ -257,7 +265,6 @@ void ethos_send_frame(ethos_t *dev, const uint8_t *data, size_t len, unsigned fr
 static int _send(netdev2_t *netdev, const struct iovec *vector, int count)
 {
     ethos_t * dev = (ethos_t *) netdev;
-    (void)dev;
 
     /* count total packet length */
     size_t pktlen = iovec_count_total(vector, count);
@@ -266,20 +273,17 @@ static int _send(netdev2_t *netdev, const struct iovec *vector, int count)
     mutex_lock(&dev->out_mutex);
 
     /* send start-frame-delimiter */
-    uint8_t frame_delim = ETHOS_FRAME_DELIMITER;
-    uart_write(dev->uart, &frame_delim, 1);
+    uart_txbuf_putc(&dev->out, ETHOS_FRAME_DELIMITER);
 
     /* send iovec */
     while(count--) {
-        size_t n = vector->iov_len;
-        uint8_t *ptr = vector->iov_base;
-        while(n--) {
-            _write_escaped(dev->uart, *ptr++);
-        }
+        framing_encode(&framing_hdlc, vector->iov_base, vector->iov_len,
+                       _write, &dev->out);
         vector++;
     }
 
-    uart_write(dev->uart, &frame_delim, 1);
+    uart_txbuf_putc(&dev->out, ETHOS_FRAME_DELIMITER);
+    uart_txbuf_flush(&dev->out);
 
     mutex_unlock(&dev->out_mutex);
 
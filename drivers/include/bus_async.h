@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_bus_async Asynchronous bus transactions
+ * @ingroup     drivers
+ * @brief       Queued SPI and I2C transactions with completion notification
+ *
+ * A transaction (@ref bus_async_xfer_t) is a list of operations executed
+ * back to back on one device, e.g. writing a register address and reading a
+ * burst of data from it. Transactions are queued per bus with
+ * bus_async_submit(), which returns immediately. When a transaction is
+ * finished, its callback is executed or, if it has none, thread flags are
+ * set on a waiting thread. Transactions linked through
+ * bus_async_xfer_t::chain are started directly after their predecessor,
+ * ahead of anything else in the queue and without involving any thread.
+ *
+ * @code
+ * static const uint8_t reg = 0x28;
+ * static uint8_t data[6];
+ * static const bus_async_op_t ops[] = {
+ *     { .out = &reg, .len = 1 },
+ *     { .in = data, .len = sizeof(data) },
+ * };
+ * static bus_async_xfer_t xfer = {
+ *     .addr = 0x19, .cs = GPIO_UNDEF, .ops = ops, .ops_numof = 2,
+ * };
+ *
+ * if (bus_async_transfer(bus, &xfer) == 0) {
+ *     ...
+ * }
+ * @endcode
+ *
+ * The bus itself is driven by a backend:
+ * - `bus_async_periph` runs the transactions with the blocking periph SPI and
+ *   I2C functions in a worker thread of its own, see bus_async/periph.h
+ * - `bus_async_sim` simulates a bus with register file devices and realistic
+ *   transfer times on any platform, including native, see bus_async/sim.h
+ *
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous bus transaction interface
+ */
+
+#ifndef BUS_ASYNC_H
+#define BUS_ASYNC_H
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "periph/gpio.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Thread flag used by bus_async_transfer()
+ */
+#ifndef BUS_ASYNC_THREAD_FLAG
+#define BUS_ASYNC_THREAD_FLAG   (0x1 << 10)
+#endif
+
+/**
+ * @brief   One operation of a transaction
+ *
+ * On SPI, @p out and @p in are transferred simultaneously, a missing @p out
+ * sends zeros. On I2C, an operation either writes @p out or reads into
+ * @p in; consecutive operations are joined by a repeated start.
+ */
+typedef struct {
+    const uint8_t *out;     /**< bytes to send, may be NULL */
+    uint8_t *in;            /**< buffer for received bytes, may be NULL */
+    uint16_t len;           /**< number of bytes */
+} bus_async_op_t;
+
+/**
+ * @brief   Forward declaration of a transaction
+ */
+typedef struct bus_async_xfer bus_async_xfer_t;
+
+/**
+ * @brief   Completion callback, may be called in interrupt context
+ *
+ * The transaction may be submitted again from within the callback.
+ */
+typedef void (*bus_async_cb_t)(bus_async_xfer_t *xfer, void *arg);
+
+/**
+ * @brief   A transaction
+ */
+struct bus_async_xfer {
+    bus_async_xfer_t *next;     /**< queue link, managed by the bus */
+    bus_async_xfer_t *chain;    /**< transaction started right after this one,
+                                 *   or NULL */
+    uint16_t addr;              /**< I2C slave address, also identifies the
+                                 *   device on simulated SPI buses */
+    gpio_t cs;                  /**< SPI chip select pin, GPIO_UNDEF if none */
+    const bus_async_op_t *ops;  /**< operations */
+    uint8_t ops_numof;          /**< number of entries in bus_async_xfer_t::ops */
+    bus_async_cb_t cb;          /**< completion callback, may be NULL */
+    void *arg;                  /**< argument for bus_async_xfer_t::cb */
+    thread_t *thread;           /**< thread to notify if there is no callback */
+    thread_flags_t flags;       /**< flags to set on bus_async_xfer_t::thread */
+    volatile int result;        /**< -EINPROGRESS while queued, then 0 or a
+                                 *   negative errno value */
+};
+
+/**
+ * @brief   Forward declaration of a bus
+ */
+typedef struct bus_async bus_async_t;
+
+/**
+ * @brief   Backend interface
+ */
+typedef struct {
+    /**
+     * @brief   Start executing @p xfer
+     *
+     * Must not complete the transaction before returning. The backend calls
+     * bus_async_done() once it is finished.
+     */
+    void (*start)(bus_async_t *bus, bus_async_xfer_t *xfer);
+} bus_async_driver_t;
+
+/**
+ * @brief   A bus, embedded into the state of its backend
+ */
+struct bus_async {
+    const bus_async_driver_t *driver;   /**< backend */
+    bus_async_xfer_t *head;             /**< transaction in progress */
+    bus_async_xfer_t *tail;             /**< last queued transaction */
+};
+
+/**
+ * @brief   Initialize @p bus for use by @p driver, called by backends
+ */
+void bus_async_init(bus_async_t *bus, const bus_async_driver_t *driver);
+
+/**
+ * @brief   Queue @p xfer on @p bus
+ *
+ * Can be called from interrupt context. @p xfer and its operations must
+ * stay valid until it is completed.
+ *
+ * Transactions on bus_async_xfer_t::chain are not submitted by this, they
+ * are started as their predecessors complete. If a transaction fails, its
+ * chain is cancelled and completes with -ECANCELED.
+ */
+void bus_async_submit(bus_async_t *bus, bus_async_xfer_t *xfer);
+
+/**
+ * @brief   Submit @p xfer and wait for its completion
+ *
+ * Overwrites the completion settings of @p xfer.
+ *
+ * @return  0 on success
+ * @return  -ENXIO if the device did not respond
+ * @return  -EIO on other bus errors
+ */
+int bus_async_transfer(bus_async_t *bus, bus_async_xfer_t *xfer);
+
+/**
+ * @brief   Complete the transaction in progress with @p result, called by
+ *          backends
+ */
+void bus_async_done(bus_async_t *bus, int result);
+
+/**
+ * @brief   Total number of bytes of @p xfer's operations
+ */
+static inline size_t bus_async_xfer_len(const bus_async_xfer_t *xfer)
+{
+    size_t len = 0;
+    for (unsigned i = 0; i < xfer->ops_numof; i++) {
+        len += xfer->ops[i].len;
+    }
+    return len;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUS_ASYNC_H */
+/** @} */
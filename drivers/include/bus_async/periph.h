@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_bus_async_periph Peripheral bus backend
+ * @ingroup     drivers_bus_async
+ * @brief       Runs transactions on a periph SPI or I2C device in a worker
+ *              thread
+ *
+ * Works on every platform with the blocking periph drivers. Only the worker
+ * thread waits for the transfers, the threads submitting transactions do
+ * not. For SPI, the worker drives bus_async_xfer_t::cs around every
+ * transaction, the pin must have been initialized as output.
+ *
+ * On I2C, a single byte write operation followed by a read or write
+ * operation is executed as register access (i2c_read_regs() /
+ * i2c_write_regs()), everything else as plain reads and writes.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Peripheral bus backend interface
+ */
+
+#ifndef BUS_ASYNC_PERIPH_H
+#define BUS_ASYNC_PERIPH_H
+
+#include "bus_async.h"
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A bus driven by a worker thread
+ * @extends bus_async_t
+ */
+typedef struct {
+    bus_async_t bus;        /**< the bus */
+    unsigned dev;           /**< spi_t or i2c_t of the device */
+    uint8_t i2c;            /**< 1 for I2C, 0 for SPI */
+    kernel_pid_t pid;       /**< worker thread */
+} bus_async_periph_t;
+
+/**
+ * @brief   Drive the already initialized SPI device @p dev
+ *
+ * @param[out] bus          bus to initialize
+ * @param[in] dev           SPI device, initialized with spi_init_master()
+ * @param[in] stack         stack of the worker thread
+ * @param[in] stacksize     size of @p stack
+ * @param[in] priority      priority of the worker thread
+ *
+ * @return  PID of the worker thread
+ * @return  negative value if the thread could not be created
+ */
+kernel_pid_t bus_async_periph_init_spi(bus_async_periph_t *bus, unsigned dev,
+                                       char *stack, int stacksize,
+                                       char priority);
+
+/**
+ * @brief   Drive the already initialized I2C device @p dev
+ *
+ * @param[out] bus          bus to initialize
+ * @param[in] dev           I2C device, initialized with i2c_init_master()
+ * @param[in] stack         stack of the worker thread
+ * @param[in] stacksize     size of @p stack
+ * @param[in] priority      priority of the worker thread
+ *
+ * @return  PID of the worker thread
+ * @return  negative value if the thread could not be created
+ */
+kernel_pid_t bus_async_periph_init_i2c(bus_async_periph_t *bus, unsigned dev,
+                                       char *stack, int stacksize,
+                                       char priority);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUS_ASYNC_PERIPH_H */
+/** @} */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_bus_async_sim Simulated bus
+ * @ingroup     drivers_bus_async
+ * @brief       Bus backend simulating devices and transfer times
+ *
+ * Transactions take as long as they would on a real bus with the given
+ * clock, but the CPU is free meanwhile, like with a DMA driven bus. They
+ * complete from an xtimer callback. Very short transfers below the xtimer
+ * backoff are busy waited by xtimer.
+ *
+ * Devices are register files with an auto-incrementing register pointer,
+ * like most sensors: the first byte written in a transaction sets the
+ * pointer, further bytes written are stored and bytes read are taken from
+ * the pointer's position. On SPI, the byte received while sending the
+ * register address is 0xff. Transactions to an address without device fail
+ * with -ENXIO on I2C and read 0xff on SPI.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Simulated bus interface
+ */
+
+#ifndef BUS_ASYNC_SIM_H
+#define BUS_ASYNC_SIM_H
+
+#include "bus_async.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A simulated device
+ */
+typedef struct bus_async_sim_dev {
+    struct bus_async_sim_dev *next; /**< next device on the bus */
+    uint16_t addr;                  /**< address matched against
+                                     *   bus_async_xfer_t::addr */
+    uint8_t ptr;                    /**< register pointer */
+    uint8_t *regs;                  /**< register file */
+    size_t regs_len;                /**< size of bus_async_sim_dev_t::regs */
+} bus_async_sim_dev_t;
+
+/**
+ * @brief   A simulated bus
+ * @extends bus_async_t
+ */
+typedef struct {
+    bus_async_t bus;                /**< the bus */
+    bus_async_sim_dev_t *devs;      /**< devices on the bus */
+    uint32_t clock;                 /**< bus clock in Hz */
+    uint8_t i2c;                    /**< 1 for I2C, 0 for SPI */
+    xtimer_t timer;                 /**< completes the current transaction */
+    uint32_t xfers;                 /**< number of completed transactions */
+    uint32_t busy_us;               /**< total simulated transfer time */
+} bus_async_sim_t;
+
+/**
+ * @brief   Initialize a simulated SPI bus
+ *
+ * Every byte takes 8 clock cycles.
+ *
+ * @param[out] sim      bus to initialize
+ * @param[in] clock     bus clock in Hz
+ */
+void bus_async_sim_init_spi(bus_async_sim_t *sim, uint32_t clock);
+
+/**
+ * @brief   Initialize a simulated I2C bus
+ *
+ * Every byte takes 9 clock cycles, every operation an additional address
+ * byte and a start condition.
+ *
+ * @param[out] sim      bus to initialize
+ * @param[in] clock     bus clock in Hz
+ */
+void bus_async_sim_init_i2c(bus_async_sim_t *sim, uint32_t clock);
+
+/**
+ * @brief   Attach the device @p dev with the register file @p regs to @p sim
+ */
+void bus_async_sim_add_dev(bus_async_sim_t *sim, bus_async_sim_dev_t *dev,
+                           uint16_t addr, uint8_t *regs, size_t regs_len);
+
+/**
+ * @brief   Get the time @p xfer occupies @p sim in microseconds
+ */
+uint32_t bus_async_sim_duration(const bus_async_sim_t *sim,
+                                const bus_async_xfer_t *xfer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUS_ASYNC_SIM_H */
+/** @} */
@@ -42,6 +42,15 @@ extern "C" {
 #endif
 #endif
 
+/**
+ * @brief   Size of the buffer collecting outgoing bytes
+ *
+ * Frames are passed to the UART in chunks of this size.
+ */
+#ifndef ETHOS_TX_BUFSIZE
+#define ETHOS_TX_BUFSIZE                (64U)
+#endif
+
 /**
  * @name Escape char definitions
  * @{
@@ -78,6 +87,8 @@ typedef struct {
     unsigned frametype;     /**< type of currently incoming frame */
     size_t last_framesize;  /**< size of last completed frame */
     mutex_t out_mutex;      /**< mutex used for locking concurrent sends */
+    uart_txbuf_t out;       /**< write combining buffer for sends */
+    uint8_t out_buf[ETHOS_TX_BUFSIZE]; /**< memory of ethos_t::out */
 } ethos_t;
 
 /**
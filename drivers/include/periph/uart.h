@@ -47,6 +47,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <limits.h>
+#include <string.h>
 
 #include "periph_cpu.h"
 #include "periph_conf.h"
@@ -101,6 +102,15 @@ typedef unsigned int uart_t;
  */
 typedef void(*uart_rx_cb_t)(void *arg, uint8_t data);
 
+/**
+ * @brief   Signature for bulk receive callback
+ *
+ * @param[in] arg           context to the callback (optional)
+ * @param[in] data          the bytes that were received
+ * @param[in] len           number of bytes in @p data, at least 1
+ */
+typedef void(*uart_rx_buf_cb_t)(void *arg, const uint8_t *data, size_t len);
+
 /**
  * @brief   Interrupt context for a UART device
  * @{
@@ -135,6 +145,26 @@ typedef struct {
  */
 int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg);
 
+/**
+ * @brief   Initialize a given UART device with a bulk receive callback
+ *
+ * Same as uart_init(), but received bytes are handed to @p rx_cb in chunks.
+ * Platforms that receive more than one byte per interrupt (DMA, FIFOs, the
+ * host on native) define PERIPH_UART_HAS_INIT_BUF in their periph_cpu.h and
+ * implement this function, on all others the fallback in periph_common calls
+ * @p rx_cb for every single byte.
+ *
+ * @param[in] uart          UART device to initialize
+ * @param[in] baudrate      desired baudrate in baud/s
+ * @param[in] rx_cb         receive callback, executed in interrupt context
+ *                          with all bytes received since its last invocation
+ * @param[in] arg           optional context passed to the callback functions
+ *
+ * @return                  same as uart_init()
+ */
+int uart_init_buf(uart_t uart, uint32_t baudrate, uart_rx_buf_cb_t rx_cb,
+                  void *arg);
+
 /**
  * @brief   Write data from the given buffer to the specified UART device
  *
@@ -149,6 +179,73 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg);
  */
 void uart_write(uart_t uart, const uint8_t *data, size_t len);
 
+/**
+ * @brief   Write combining transmit buffer
+ *
+ * Collects small writes, e.g. single escaped bytes of a frame, and passes
+ * them to uart_write() in as few calls as possible. The buffer must be
+ * flushed with uart_txbuf_flush() at the end of a frame.
+ */
+typedef struct {
+    uart_t uart;            /**< UART device to write to */
+    uint8_t *buf;           /**< buffer memory */
+    size_t size;            /**< size of uart_txbuf_t::buf */
+    size_t len;             /**< number of pending bytes */
+} uart_txbuf_t;
+
+/**
+ * @brief   Initialize a transmit buffer for @p uart using @p buf
+ */
+static inline void uart_txbuf_init(uart_txbuf_t *tx, uart_t uart,
+                                   uint8_t *buf, size_t size)
+{
+    tx->uart = uart;
+    tx->buf = buf;
+    tx->size = size;
+    tx->len = 0;
+}
+
+/**
+ * @brief   Write all pending bytes of @p tx to its UART
+ */
+static inline void uart_txbuf_flush(uart_txbuf_t *tx)
+{
+    if (tx->len) {
+        uart_write(tx->uart, tx->buf, tx->len);
+        tx->len = 0;
+    }
+}
+
+/**
+ * @brief   Append one byte to @p tx, writing out the buffer if it is full
+ */
+static inline void uart_txbuf_putc(uart_txbuf_t *tx, uint8_t c)
+{
+    if (tx->len == tx->size) {
+        uart_txbuf_flush(tx);
+    }
+    tx->buf[tx->len++] = c;
+}
+
+/**
+ * @brief   Append @p len bytes to @p tx
+ *
+ * Chunks that do not fit into the buffer are written out directly.
+ */
+static inline void uart_txbuf_write(uart_txbuf_t *tx, const uint8_t *data,
+                                    size_t len)
+{
+    if (len > tx->size - tx->len) {
+        uart_txbuf_flush(tx);
+        if (len >= tx->size) {
+            uart_write(tx->uart, data, len);
+            return;
+        }
+    }
+    memcpy(tx->buf + tx->len, data, len);
+    tx->len += len;
+}
+
 /**
  * @brief   Power on the given UART device
  *
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup drivers
+ * @{
+ *
+ * @file
+ * @brief       common UART function fallback implementations
+ *
+ * @}
+ */
+#include <stdint.h>
+
+#include "board.h"
+#include "cpu.h"
+#include "periph_cpu.h"
+#include "periph_conf.h"
+
+#ifndef PERIPH_UART_HAS_INIT_BUF
+
+#include "periph/uart.h"
+
+static uart_rx_buf_cb_t _rx_buf_cb[UART_NUMOF];
+static void *_rx_buf_arg[UART_NUMOF];
+
+static void _rx_byte(void *arg, uint8_t data)
+{
+    uart_t uart = (uart_t)(uintptr_t)arg;
+
+    _rx_buf_cb[uart](_rx_buf_arg[uart], &data, 1);
+}
+
+int uart_init_buf(uart_t uart, uint32_t baudrate, uart_rx_buf_cb_t rx_cb,
+                  void *arg)
+{
+    if (uart >= UART_NUMOF) {
+        return -1;
+    }
+
+    _rx_buf_cb[uart] = rx_cb;
+    _rx_buf_arg[uart] = arg;
+
+    return uart_init(uart, baudrate, _rx_byte, (void *)(uintptr_t)uart);
+}
+
+#endif /* PERIPH_UART_HAS_INIT_BUF */
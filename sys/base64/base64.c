@@ -18,152 +18,317 @@
  *
  */
 
+#include <stdint.h>
+#include <string.h>
+
 #include "base64.h"
 
-#define BASE64_CAPITAL_UPPER_BOUND     (25)     /**< base64 'Z'           */
-#define BASE64_SMALL_UPPER_BOUND       (51)     /**< base64 'z'           */
-#define BASE64_NUMBER_UPPER_BOUND      (61)     /**< base64 '9'           */
-#define BASE64_PLUS                    (62)     /**< base64 '+'           */
-#define BASE64_SLASH                   (63)     /**< base64 '/'           */
-#define BASE64_EQUALS                  (0xFE)   /**< no base64 symbol '=' */
-#define BASE64_NOT_DEFINED             (0xFF)   /**< no base64 symbol     */
+#if (defined(__i386__) || defined(__x86_64__)) && defined(__GNUC__)
+#define BASE64_SSSE3    (1)
+#include <tmmintrin.h>
+#endif
+
+#define BASE64_INVALID  (0xff)  /**< marks bytes that are no base64 symbol */
+
+static const unsigned char _symbols[64] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/* code of each base64 symbol, BASE64_INVALID for all other bytes
+ * including '=' */
+static const uint8_t _codes[256] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+static inline void _encode_block(const unsigned char *in, unsigned char *out)
+{
+    uint32_t x = ((uint32_t)in[0] << 16) | (in[1] << 8) | in[2];
 
+    out[0] = _symbols[x >> 18];
+    out[1] = _symbols[(x >> 12) & 0x3f];
+    out[2] = _symbols[(x >> 6) & 0x3f];
+    out[3] = _symbols[x & 0x3f];
+}
+
+#ifdef BASE64_SSSE3
 /*
- * returns the corresponding ascii symbol value for the given base64 code
+ * The SSSE3 loops follow the approach of Wojciech Muła and Daniel Lemire
+ * ("Faster Base64 Encoding and Decoding using AVX2 Instructions"): the bit
+ * fields are moved into place with shuffles and multiplications, and
+ * symbols are translated with nibble indexed pshufb lookups.
  */
-static char getsymbol(unsigned char code)
+__attribute__((target("ssse3")))
+static size_t _encode_ssse3(const unsigned char *in, size_t len,
+                            unsigned char *out)
 {
-    if (code == BASE64_SLASH) {
-        return '/';
-    }
-
-    if (code == BASE64_PLUS) {
-        return '+';
+    const __m128i shuf = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7,
+                                      4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i offsets = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4,
+                                          -4, -4, -4, -4, -19, -16, 0, 0);
+    size_t done = 0;
+
+    /* loads 16 bytes, of which 12 are encoded */
+    for (; len - done >= 16; done += 12, out += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + done));
+        v = _mm_shuffle_epi8(v, shuf);
+
+        __m128i t0 = _mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00));
+        __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        __m128i t2 = _mm_and_si128(v, _mm_set1_epi32(0x003f03f0));
+        __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        __m128i codes = _mm_or_si128(t1, t3);
+
+        __m128i idx = _mm_subs_epu8(codes, _mm_set1_epi8(51));
+        idx = _mm_sub_epi8(idx, _mm_cmpgt_epi8(codes, _mm_set1_epi8(25)));
+        v = _mm_add_epi8(codes, _mm_shuffle_epi8(offsets, idx));
+        _mm_storeu_si128((__m128i *)out, v);
     }
+    return done;
+}
 
-    if (code <= BASE64_CAPITAL_UPPER_BOUND) {
-        return (code + 'A');
-    }
+__attribute__((target("ssse3")))
+static size_t _decode_ssse3(const unsigned char *in, size_t len,
+                            unsigned char *out)
+{
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                         0x11, 0x11, 0x11, 0x11, 0x13, 0x1a,
+                                         0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08,
+                                         0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+                                         0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                           0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_2f = _mm_set1_epi8(0x2f);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                       -1, -1, -1, -1);
+    size_t done = 0;
+
+    /* stores 16 bytes, of which 12 are decoded, so keep enough input left
+     * for the output to cover the surplus */
+    for (; len - done >= 24; done += 16, out += 12) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + done));
+        __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(v, 4), mask_2f);
+        __m128i lo_nibbles = _mm_and_si128(v, mask_2f);
+        __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+        __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+
+        /* leave anything but symbols to the scalar code */
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi),
+                                             _mm_setzero_si128()))) {
+            break;
+        }
 
-    if (code <= BASE64_SMALL_UPPER_BOUND) {
-        return (code + ('z' - BASE64_SMALL_UPPER_BOUND));
-    }
+        __m128i eq_2f = _mm_cmpeq_epi8(v, mask_2f);
+        __m128i roll = _mm_shuffle_epi8(lut_roll,
+                                        _mm_add_epi8(eq_2f, hi_nibbles));
+        v = _mm_add_epi8(v, roll);
 
-    if (code <= BASE64_NUMBER_UPPER_BOUND) {
-        return (code + ('9' - BASE64_NUMBER_UPPER_BOUND));
+        v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+        v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+        v = _mm_shuffle_epi8(v, pack);
+        _mm_storeu_si128((__m128i *)out, v);
     }
+    return done;
+}
+#endif
 
-    return (char)BASE64_NOT_DEFINED;
+void base64_encode_init(base64_encode_ctx_t *ctx)
+{
+    ctx->len = 0;
 }
 
-int base64_encode(unsigned char *data_in, size_t data_in_size, \
-                  unsigned char *base64_out, size_t *base64_out_size)
+size_t base64_encode_update(base64_encode_ctx_t *ctx, const unsigned char *data,
+                            size_t len, unsigned char *out)
 {
-    size_t padding_bytes = ((data_in_size % 3) ? (3 - (data_in_size % 3)) : 0);
-    size_t required_size = (4 * (data_in_size + 2 - ((data_in_size + 2) % 3)) / 3) + padding_bytes;
+    unsigned char *start = out;
 
-    if (data_in == NULL) {
-        return BASE64_ERROR_DATA_IN;
+    /* complete a block started by the previous call */
+    if (ctx->len) {
+        while (ctx->len < 3 && len) {
+            ctx->buf[ctx->len++] = *data++;
+            len--;
+        }
+        if (ctx->len < 3) {
+            return 0;
+        }
+        _encode_block(ctx->buf, out);
+        out += 4;
+        ctx->len = 0;
     }
 
-    if (data_in_size < 1) {
-        return BASE64_ERROR_DATA_IN_SIZE;
+#ifdef BASE64_SSSE3
+    if (__builtin_cpu_supports("ssse3")) {
+        size_t done = _encode_ssse3(data, len, out);
+        data += done;
+        len -= done;
+        out += done / 3 * 4;
     }
+#endif
 
-    if (*base64_out_size < required_size) {
-        *base64_out_size = required_size;
-        return BASE64_ERROR_BUFFER_OUT_SIZE;
+    for (; len >= 3; len -= 3, data += 3, out += 4) {
+        _encode_block(data, out);
     }
 
-    if (base64_out == NULL) {
-        return BASE64_ERROR_BUFFER_OUT;
+    memcpy(ctx->buf, data, len);
+    ctx->len = len;
+
+    return out - start;
+}
+
+size_t base64_encode_finish(base64_encode_ctx_t *ctx, unsigned char *out)
+{
+    if (!ctx->len) {
+        return 0;
+    }
+
+    uint32_t x = (uint32_t)ctx->buf[0] << 16;
+    if (ctx->len == 2) {
+        x |= ctx->buf[1] << 8;
     }
 
-    int iterate_base64_buffer = 0;
-    unsigned char nNum = 0;
-    int nLst = 0;
-    int njump = 0;
-    unsigned char tmpval;
+    out[0] = _symbols[x >> 18];
+    out[1] = _symbols[(x >> 12) & 0x3f];
+    out[2] = (ctx->len == 2) ? _symbols[(x >> 6) & 0x3f] : '=';
+    out[3] = '=';
+    ctx->len = 0;
 
-    for (int i = 0; i < (int)(data_in_size); ++i) {
-        njump++;
-        tmpval = *(data_in + i);
+    return 4;
+}
 
-        nNum = (tmpval >> (2 * njump));
+void base64_decode_init(base64_decode_ctx_t *ctx)
+{
+    ctx->bits = 0;
+    ctx->n = 0;
+}
 
-        if (njump == 4) {
-            nNum = nLst << (8 - 2 * njump);
-            njump = 0;
-            nLst = 0;
-            --i;
+size_t base64_decode_update(base64_decode_ctx_t *ctx, const unsigned char *in,
+                            size_t len, unsigned char *out)
+{
+    unsigned char *start = out;
+    uint32_t bits = ctx->bits;
+    unsigned n = ctx->n;
+
+    while (len) {
+#ifdef BASE64_SSSE3
+        if (!n && __builtin_cpu_supports("ssse3")) {
+            size_t done = _decode_ssse3(in, len, out);
+            in += done;
+            len -= done;
+            out += done / 4 * 3;
         }
-        else {
-            nNum += nLst << (8 - 2 * njump);
-            nLst =  tmpval & ((1 << njump * 2) - 1);
+#endif
+        /* four symbols at a time, as long as there is nothing to skip */
+        if (!n) {
+            for (; len >= 4; len -= 4, in += 4, out += 3) {
+                uint32_t a = _codes[in[0]];
+                uint32_t b = _codes[in[1]];
+                uint32_t c = _codes[in[2]];
+                uint32_t d = _codes[in[3]];
+                if ((a | b | c | d) > 0x3f) {
+                    break;
+                }
+                uint32_t x = (a << 18) | (b << 12) | (c << 6) | d;
+                out[0] = x >> 16;
+                out[1] = x >> 8;
+                out[2] = x;
+            }
         }
 
-        base64_out[iterate_base64_buffer++] = getsymbol(nNum);
+        /* one symbol at a time, until aligned to a block again */
+        while (len) {
+            uint8_t code = _codes[*in++];
+            len--;
+            if (code == BASE64_INVALID) {
+                continue;
+            }
+            bits = (bits << 6) | code;
+            if (++n == 4) {
+                out[0] = bits >> 16;
+                out[1] = bits >> 8;
+                out[2] = bits;
+                out += 3;
+                bits = 0;
+                n = 0;
+                break;
+            }
+        }
     }
 
-    /* The last character is not finished yet */
-    njump++;
+    ctx->bits = bits;
+    ctx->n = n;
 
-    nNum = nLst << (8 - 2 * njump);
-    base64_out[iterate_base64_buffer++] = getsymbol(nNum);
+    return out - start;
+}
 
-    /* if required we append '=' for the required dividability */
-    while (iterate_base64_buffer % 4) {
-        base64_out[iterate_base64_buffer++] = '=';
-    }
+size_t base64_decode_finish(base64_decode_ctx_t *ctx, unsigned char *out)
+{
+    size_t len = 0;
 
-    *base64_out_size = iterate_base64_buffer;
+    /* two symbols carry one byte, three symbols two bytes */
+    if (ctx->n == 2) {
+        out[0] = ctx->bits >> 4;
+        len = 1;
+    }
+    else if (ctx->n == 3) {
+        out[0] = ctx->bits >> 10;
+        out[1] = ctx->bits >> 2;
+        len = 2;
+    }
+    base64_decode_init(ctx);
 
-    return BASE64_SUCCESS;
+    return len;
 }
 
-/*
- *  returns the corresponding base64 code for the given ascii symbol
- */
-static int getcode(char symbol)
+int base64_encode(unsigned char *data_in, size_t data_in_size, \
+                  unsigned char *base64_out, size_t *base64_out_size)
 {
-    if (symbol == '/') {
-        return BASE64_SLASH;
-    }
+    size_t required_size = BASE64_ENCODE_SIZE(data_in_size);
 
-    if (symbol == '+') {
-        return BASE64_PLUS;
+    if (data_in == NULL) {
+        return BASE64_ERROR_DATA_IN;
     }
 
-    if (symbol == '=') {
-        /* indicates a padded base64 end */
-        return BASE64_EQUALS;
+    if (data_in_size < 1) {
+        return BASE64_ERROR_DATA_IN_SIZE;
     }
 
-    if (symbol < '0') {
-        /* indicates that the given symbol is not base64 and should be ignored */
-        return BASE64_NOT_DEFINED;
+    if (*base64_out_size < required_size) {
+        *base64_out_size = required_size;
+        return BASE64_ERROR_BUFFER_OUT_SIZE;
     }
 
-    if (symbol <= '9' && symbol >= '0') {
-        return (symbol + (BASE64_NUMBER_UPPER_BOUND - '9'));
+    if (base64_out == NULL) {
+        return BASE64_ERROR_BUFFER_OUT;
     }
 
-    if (symbol <= 'Z' && symbol >= 'A') {
-        return (symbol - 'A');
-    }
+    base64_encode_ctx_t ctx;
+    base64_encode_init(&ctx);
+    size_t len = base64_encode_update(&ctx, data_in, data_in_size, base64_out);
+    len += base64_encode_finish(&ctx, base64_out + len);
 
-    if (symbol <= 'z' && symbol >= 'a') {
-        return (symbol + (BASE64_SMALL_UPPER_BOUND - 'z'));
-    }
+    *base64_out_size = len;
 
-    /* indicates that the given symbol is not base64 and should be ignored */
-    return BASE64_NOT_DEFINED;
+    return BASE64_SUCCESS;
 }
 
 int base64_decode(unsigned char *base64_in, size_t base64_in_size, \
                   unsigned char *data_out, size_t *data_out_size)
 {
-    size_t required_size = ((base64_in_size / 4) * 3);
+    size_t required_size = BASE64_DECODE_SIZE(base64_in_size);
 
     if (base64_in == NULL) {
         return BASE64_ERROR_DATA_IN;
@@ -182,34 +347,11 @@ int base64_decode(unsigned char *base64_in, size_t base64_in_size, \
         return BASE64_ERROR_BUFFER_OUT;
     }
 
-    int iterate_data_buffer = 0;
-    unsigned char nNum = 0;
-    int nLst = getcode(base64_in[0]) << 2;
-    int code = 0;
-
-    int mask = 2;
-
-    for (int i = 1; i < (int)(base64_in_size); i++) {
-        code = getcode(base64_in[i]);
-
-        if (code == BASE64_NOT_DEFINED || code == BASE64_EQUALS) {
-            continue;
-        }
-
-        int nm = (0xFF << (2 * mask));
-
-        nNum = nLst + ((code & (0xFF & nm)) >> (2 * mask));
-        nLst = (code & (0xFF & ~nm)) << (8 - (2 * mask));
-
-        (mask != 3) ? data_out[iterate_data_buffer++] = nNum : nNum;
-        (mask == 0) ? mask = 3 : mask--;
-    }
-
-    if (code == BASE64_EQUALS) {
-        /* add the last character to the data_out buffer */
-        data_out[iterate_data_buffer] = nNum;
-    }
+    base64_decode_ctx_t ctx;
+    base64_decode_init(&ctx);
+    size_t len = base64_decode_update(&ctx, base64_in, base64_in_size, data_out);
+    len += base64_decode_finish(&ctx, data_out + len);
 
-    *data_out_size = iterate_data_buffer;
+    *data_out_size = len;
     return BASE64_SUCCESS;
 }
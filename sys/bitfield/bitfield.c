@@ -19,6 +19,7 @@
  */
 
 #include <stdint.h>
+#include "bitarithm.h"
 #include "bitfield.h"
 #include "irq.h"
 
@@ -26,19 +27,17 @@ int bf_get_unset(uint8_t field[], int size)
 {
     int result = -1;
     int nbytes = (size + 7) / 8;
-    int i = 0;
 
     unsigned state = irq_disable();
 
-    /* skip full bytes */
-    for (int j = 0; (j < nbytes) && (field[j] == 255); j++) {
-        i += 8;
-    }
-
-    for (; i < size; i++) {
-        if (!bf_isset(field, i)) {
-            bf_set(field, i);
-            result = i;
+    /* skip full bytes, then take the lowest unset bit of the first other */
+    for (int j = 0; j < nbytes; j++) {
+        if (field[j] != 0xff) {
+            int i = (j * 8) + bitarithm_lsb(~field[j] & 0xff);
+            if (i < size) {
+                bf_set(field, i);
+                result = i;
+            }
             break;
         }
     }
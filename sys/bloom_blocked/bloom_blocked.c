@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bloom_blocked
+ * @{
+ *
+ * @file
+ * @brief       Blocked Bloom filter implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "bloom_blocked.h"
+
+/**
+ * @brief   Bits in a block of a plain filter
+ */
+#define BLOCK_BITS      (BLOOM_BLOCKED_BLOCK_SIZE * 8)
+
+/**
+ * @brief   Counters in a block of a counting filter
+ */
+#define BLOCK_COUNTERS  (BLOOM_BLOCKED_BLOCK_SIZE * 2)
+
+/**
+ * @brief   Largest value of a counter, sticky
+ */
+#define COUNTER_MAX     (0xf)
+
+static inline uint32_t _rotl(uint32_t x, unsigned r)
+{
+    return (x << r) | (x >> (32 - r));
+}
+
+static inline uint32_t _fmix(uint32_t h)
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+/* two lanes of MurmurHash3 (x86_32) sharing the scrambled input words */
+uint64_t bloom_blocked_hash(const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    uint32_t h1 = 0x9747b28c;
+    uint32_t h2 = 0x3c6ef372;
+    uint32_t k;
+
+    for (size_t n = len / 4; n; n--) {
+        memcpy(&k, p, sizeof(k));
+        p += 4;
+        k *= 0xcc9e2d51;
+        k = _rotl(k, 15);
+        k *= 0x1b873593;
+        h1 ^= k;
+        h1 = _rotl(h1, 13) * 5 + 0xe6546b64;
+        h2 ^= k;
+        h2 = _rotl(h2, 17) * 9 + 0x38495ab5;
+    }
+
+    k = 0;
+    switch (len & 3) {
+        case 3:
+            k ^= p[2] << 16;
+            /* fall through */
+        case 2:
+            k ^= p[1] << 8;
+            /* fall through */
+        case 1:
+            k ^= p[0];
+            k *= 0xcc9e2d51;
+            k = _rotl(k, 15);
+            k *= 0x1b873593;
+            h1 ^= k;
+            h2 ^= _rotl(k, 7);
+    }
+
+    h1 = _fmix(h1 ^ (uint32_t)len);
+    h2 = _fmix(h2 ^ h1);
+
+    return ((uint64_t)h1 << 32) | h2;
+}
+
+/* index of the block, without a division */
+static inline size_t _block(size_t blocks, uint64_t hash)
+{
+    return (size_t)(((hash >> 32) * blocks) >> 32);
+}
+
+/* positions within a block of mask + 1 entries by triple hashing
+ * (Dillinger and Manolios), an extension of double hashing that draws on
+ * 24 bits of the hash instead of 16 and so produces far fewer key pairs
+ * sharing all their positions */
+#define FOREACH_POS(pos, k, hash, mask)                                     \
+    for (uint32_t i_ = 0, pos = (uint32_t)(hash) & (mask),                  \
+         b_ = ((uint32_t)(hash) >> 8), c_ = ((uint32_t)(hash) >> 16);       \
+         i_ < (k);                                                          \
+         i_++, pos = (pos + b_) & (mask), b_ += c_)
+
+static void _init(uint8_t **a, size_t *blocks, unsigned *k, uint8_t *buf,
+                  size_t size, unsigned numof)
+{
+    assert((size > 0) && ((size % BLOOM_BLOCKED_BLOCK_SIZE) == 0));
+    assert((numof > 0) && (numof <= 16));
+
+    *a = buf;
+    *blocks = size / BLOOM_BLOCKED_BLOCK_SIZE;
+    *k = numof;
+    memset(buf, 0, size);
+}
+
+void bloom_blocked_init(bloom_blocked_t *bloom, uint8_t *buf, size_t size,
+                        unsigned k)
+{
+    _init(&bloom->a, &bloom->blocks, &bloom->k, buf, size, k);
+}
+
+void bloom_blocked_clear(bloom_blocked_t *bloom)
+{
+    memset(bloom->a, 0, bloom->blocks * BLOOM_BLOCKED_BLOCK_SIZE);
+}
+
+void bloom_blocked_add_hash(bloom_blocked_t *bloom, uint64_t hash)
+{
+    uint8_t *block = bloom->a +
+                     _block(bloom->blocks, hash) * BLOOM_BLOCKED_BLOCK_SIZE;
+
+    FOREACH_POS(pos, bloom->k, hash, BLOCK_BITS - 1) {
+        block[pos / 8] |= 1 << (pos % 8);
+    }
+}
+
+bool bloom_blocked_check_hash(const bloom_blocked_t *bloom, uint64_t hash)
+{
+    const uint8_t *block = bloom->a +
+                           _block(bloom->blocks, hash) * BLOOM_BLOCKED_BLOCK_SIZE;
+
+    FOREACH_POS(pos, bloom->k, hash, BLOCK_BITS - 1) {
+        if (!(block[pos / 8] & (1 << (pos % 8)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void bloom_counting_init(bloom_counting_t *bloom, uint8_t *buf, size_t size,
+                         unsigned k)
+{
+    _init(&bloom->a, &bloom->blocks, &bloom->k, buf, size, k);
+}
+
+void bloom_counting_clear(bloom_counting_t *bloom)
+{
+    memset(bloom->a, 0, bloom->blocks * BLOOM_BLOCKED_BLOCK_SIZE);
+}
+
+static inline unsigned _get(const uint8_t *block, unsigned pos)
+{
+    return (block[pos / 2] >> ((pos % 2) * 4)) & COUNTER_MAX;
+}
+
+static inline void _put(uint8_t *block, unsigned pos, unsigned val)
+{
+    unsigned shift = (pos % 2) * 4;
+
+    block[pos / 2] = (block[pos / 2] & ~(COUNTER_MAX << shift)) |
+                     (val << shift);
+}
+
+void bloom_counting_add_hash(bloom_counting_t *bloom, uint64_t hash)
+{
+    uint8_t *block = bloom->a +
+                     _block(bloom->blocks, hash) * BLOOM_BLOCKED_BLOCK_SIZE;
+
+    FOREACH_POS(pos, bloom->k, hash, BLOCK_COUNTERS - 1) {
+        unsigned val = _get(block, pos);
+        if (val < COUNTER_MAX) {
+            _put(block, pos, val + 1);
+        }
+    }
+}
+
+void bloom_counting_remove_hash(bloom_counting_t *bloom, uint64_t hash)
+{
+    uint8_t *block = bloom->a +
+                     _block(bloom->blocks, hash) * BLOOM_BLOCKED_BLOCK_SIZE;
+
+    FOREACH_POS(pos, bloom->k, hash, BLOCK_COUNTERS - 1) {
+        unsigned val = _get(block, pos);
+        /* saturated counters lost track of their keys */
+        if ((val > 0) && (val < COUNTER_MAX)) {
+            _put(block, pos, val - 1);
+        }
+    }
+}
+
+bool bloom_counting_check_hash(const bloom_counting_t *bloom, uint64_t hash)
+{
+    const uint8_t *block = bloom->a +
+                           _block(bloom->blocks, hash) * BLOOM_BLOCKED_BLOCK_SIZE;
+
+    FOREACH_POS(pos, bloom->k, hash, BLOCK_COUNTERS - 1) {
+        if (!_get(block, pos)) {
+            return false;
+        }
+    }
+    return true;
+}
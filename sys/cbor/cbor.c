@@ -17,7 +17,9 @@
 
 #include "byteorder.h"
 
+#include <errno.h>
 #include <inttypes.h>
+#include <limits.h>
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -785,6 +787,796 @@ bool cbor_at_end(const cbor_stream_t *s, size_t offset)
     return s ? offset >= s->pos - 1 : true;
 }
 
+/* BEGIN: Cursor */
+
+/**
+ * Decode a head whose argument follows in extra bytes, see cursor_head()
+ */
+static size_t cursor_head_long(const uint8_t *p, const uint8_t *end, uint64_t *val,
+                               bool *indefinite)
+{
+    unsigned char additional_info = p[0] & CBOR_INFO_MASK;
+
+    if (additional_info == CBOR_VAR_FOLLOWS) {
+        *indefinite = true;
+        *val = 0;
+        return 1;
+    }
+
+    unsigned char bytes_follow = uint_bytes_follow(additional_info);
+
+    if (!bytes_follow || (size_t)(end - p) <= bytes_follow) {
+        return 0;
+    }
+
+    uint64_t v = 0;
+
+    for (unsigned i = 1; i <= bytes_follow; ++i) {
+        v = (v << 8) | p[i];
+    }
+
+    *val = v;
+    return bytes_follow + 1;
+}
+
+/**
+ * Decode the head of the item at @p p: the argument in @p val and whether the
+ * item has indefinite length in @p indefinite
+ *
+ * For major type 7 the argument is the float or simple value payload.
+ *
+ * @return Length of the head, or 0 if it is malformed or truncated
+ */
+static inline size_t cursor_head(const uint8_t *p, const uint8_t *end, uint64_t *val,
+                                 bool *indefinite)
+{
+    unsigned char additional_info = p[0] & CBOR_INFO_MASK;
+
+    *indefinite = false;
+
+    /* small arguments are by far the most common case */
+    if (additional_info < CBOR_UINT8_FOLLOWS) {
+        *val = additional_info;
+        return 1;
+    }
+
+    return cursor_head_long(p, end, val, indefinite);
+}
+
+static const uint8_t *cursor_skip_until_break(const uint8_t *p, const uint8_t *end,
+                                              unsigned depth);
+
+/**
+ * Skip the complete item at @p p
+ *
+ * Definite length containers just add their number of items to the number of
+ * items still to skip, only indefinite length items recurse (up to @p depth
+ * levels).
+ *
+ * @return Pointer behind the item, or NULL if it is malformed
+ */
+static const uint8_t *cursor_skip_item(const uint8_t *p, const uint8_t *end,
+                                       unsigned depth)
+{
+    uint64_t pending = 1;
+
+    while (pending) {
+        if (p >= end) {
+            return NULL;
+        }
+
+        unsigned char major_type = *p & CBOR_TYPE_MASK;
+
+        /* fast path for small integers and simple values, which consist of
+         * the initial byte only */
+        if ((*p & CBOR_INFO_MASK) < CBOR_UINT8_FOLLOWS
+            && (major_type == CBOR_UINT || major_type == CBOR_NEGINT
+                || major_type == CBOR_7)) {
+            ++p;
+            --pending;
+            continue;
+        }
+
+        uint64_t val;
+        bool indefinite;
+        size_t head = cursor_head(p, end, &val, &indefinite);
+
+        if (!head) {
+            return NULL;
+        }
+
+        p += head;
+        --pending;
+
+        switch (major_type) {
+            case CBOR_BYTES:
+            case CBOR_TEXT:
+                if (indefinite) {
+                    break;
+                }
+
+                if (val > (uint64_t)(end - p)) {
+                    return NULL;
+                }
+
+                p += val;
+                continue;
+
+            case CBOR_ARRAY:
+            case CBOR_MAP:
+                if (indefinite) {
+                    break;
+                }
+
+                if (major_type == CBOR_MAP) {
+                    if (val > UINT64_MAX / 2) {
+                        return NULL;
+                    }
+
+                    val *= 2;
+                }
+
+                /* every item takes at least one byte, which also keeps
+                 * pending from overflowing */
+                if (pending > (uint64_t)(end - p)
+                    || val > (uint64_t)(end - p) - pending) {
+                    return NULL;
+                }
+
+                pending += val;
+                continue;
+
+            case CBOR_TAG:
+                if (indefinite) {
+                    return NULL;
+                }
+
+                ++pending;
+                continue;
+
+            default:
+                /* integers, floats and simple values are done with their
+                 * head, a break is unexpected here */
+                if (indefinite) {
+                    return NULL;
+                }
+
+                continue;
+        }
+
+        /* only indefinite length strings and containers end up here */
+        if (!depth) {
+            return NULL;
+        }
+
+        p = cursor_skip_until_break(p, end, depth - 1);
+
+        if (!p) {
+            return NULL;
+        }
+    }
+
+    return p;
+}
+
+static const uint8_t *cursor_skip_until_break(const uint8_t *p, const uint8_t *end,
+                                              unsigned depth)
+{
+    while (p && p < end) {
+        if (*p == CBOR_BREAK) {
+            return p + 1;
+        }
+
+        p = cursor_skip_item(p, end, depth);
+    }
+
+    return NULL;
+}
+
+/**
+ * Account for one consumed item and move @p cursor to @p next
+ */
+static inline void cursor_advance(cbor_cursor_t *cursor, const uint8_t *next)
+{
+    cursor->pos = next;
+
+    if (cursor->remaining != SIZE_MAX) {
+        --cursor->remaining;
+    }
+}
+
+/**
+ * Check whether there is an item of major type @p major_type at the cursor
+ * and decode its head
+ *
+ * @return Length of the head, or negative errno
+ */
+static inline int cursor_expect(const cbor_cursor_t *cursor, unsigned char major_type,
+                                uint64_t *val, bool *indefinite)
+{
+    /* major_type is never CBOR_7, so this also rejects a break */
+    if (!cursor->remaining || cursor->pos >= cursor->end
+        || (*cursor->pos & CBOR_TYPE_MASK) != major_type) {
+        return -EINVAL;
+    }
+
+    size_t head = cursor_head(cursor->pos, cursor->end, val, indefinite);
+    return head ? (int)head : -EBADMSG;
+}
+
+void cbor_cursor_init(cbor_cursor_t *cursor, const uint8_t *buf, size_t len)
+{
+    cursor->pos = buf;
+    cursor->end = buf + len;
+    cursor->remaining = SIZE_MAX;
+    cursor->indefinite = false;
+}
+
+void cbor_cursor_init_stream(cbor_cursor_t *cursor, const cbor_stream_t *stream,
+                             size_t offset)
+{
+    cbor_cursor_init(cursor, stream->data + offset,
+                     offset < stream->pos ? stream->pos - offset : 0);
+}
+
+cbor_item_type_t cbor_cursor_peek(const cbor_cursor_t *cursor)
+{
+    static const uint8_t major_types[] = {
+        CBOR_ITEM_UINT, CBOR_ITEM_NEGINT, CBOR_ITEM_BYTES, CBOR_ITEM_TEXT,
+        CBOR_ITEM_ARRAY, CBOR_ITEM_MAP, CBOR_ITEM_TAG, CBOR_ITEM_SIMPLE
+    };
+
+    if (!cursor->remaining) {
+        return CBOR_ITEM_END;
+    }
+
+    if (cursor->pos >= cursor->end) {
+        /* only the top level may end with the buffer */
+        return (cursor->remaining == SIZE_MAX && !cursor->indefinite)
+               ? CBOR_ITEM_END : CBOR_ITEM_INVALID;
+    }
+
+    switch (*cursor->pos) {
+        case CBOR_BREAK:
+            return cursor->indefinite ? CBOR_ITEM_END : CBOR_ITEM_INVALID;
+        case CBOR_FALSE:
+        case CBOR_TRUE:
+            return CBOR_ITEM_BOOL;
+        case CBOR_NULL:
+            return CBOR_ITEM_NULL;
+        case CBOR_UNDEFINED:
+            return CBOR_ITEM_UNDEFINED;
+        case CBOR_FLOAT16:
+        case CBOR_FLOAT32:
+        case CBOR_FLOAT64:
+            return CBOR_ITEM_FLOAT;
+        default:
+            return major_types[*cursor->pos >> 5];
+    }
+}
+
+int cbor_cursor_skip(cbor_cursor_t *cursor)
+{
+    switch (cbor_cursor_peek(cursor)) {
+        case CBOR_ITEM_END:
+            return -ENOENT;
+        case CBOR_ITEM_INVALID:
+            return -EBADMSG;
+        default:
+            break;
+    }
+
+    const uint8_t *next = cursor_skip_item(cursor->pos, cursor->end,
+                                           CBOR_CURSOR_MAX_NESTING);
+
+    if (!next) {
+        return -EBADMSG;
+    }
+
+    cursor_advance(cursor, next);
+    return 0;
+}
+
+int cbor_cursor_enter(const cbor_cursor_t *cursor, cbor_cursor_t *inner)
+{
+    unsigned char major_type = (cursor->pos < cursor->end)
+                               ? (*cursor->pos & CBOR_TYPE_MASK) : 0;
+
+    if (major_type != CBOR_ARRAY && major_type != CBOR_MAP) {
+        return -EINVAL;
+    }
+
+    uint64_t len;
+    bool indefinite;
+    int head = cursor_expect(cursor, major_type, &len, &indefinite);
+
+    if (head < 0) {
+        return head;
+    }
+
+    inner->pos = cursor->pos + head;
+    inner->end = cursor->end;
+    inner->indefinite = indefinite;
+
+    if (indefinite) {
+        inner->remaining = SIZE_MAX;
+    }
+    else {
+        /* every item takes at least one byte */
+        if (len > (uint64_t)(cursor->end - inner->pos)) {
+            return -EBADMSG;
+        }
+
+        inner->remaining = (major_type == CBOR_MAP) ? 2 * (size_t)len : (size_t)len;
+    }
+
+    return 0;
+}
+
+int cbor_cursor_leave(cbor_cursor_t *cursor, const cbor_cursor_t *inner)
+{
+    const uint8_t *p = inner->pos;
+
+    if (inner->indefinite) {
+        p = cursor_skip_until_break(p, inner->end, CBOR_CURSOR_MAX_NESTING);
+    }
+    else {
+        for (size_t i = 0; p && i < inner->remaining; ++i) {
+            p = cursor_skip_item(p, inner->end, CBOR_CURSOR_MAX_NESTING);
+        }
+    }
+
+    if (!p) {
+        return -EBADMSG;
+    }
+
+    cursor_advance(cursor, p);
+    return 0;
+}
+
+int cbor_get_uint(cbor_cursor_t *cursor, uint64_t *val)
+{
+    bool indefinite;
+    int head = cursor_expect(cursor, CBOR_UINT, val, &indefinite);
+
+    if (head < 0) {
+        return head;
+    }
+
+    cursor_advance(cursor, cursor->pos + head);
+    return 0;
+}
+
+/**
+ * Decode a signed or unsigned integer, limited to @p max (and -1 - @p max)
+ */
+static inline int cursor_get_int(cbor_cursor_t *cursor, int64_t *val, uint64_t max)
+{
+    if (!cursor->remaining || cursor->pos >= cursor->end) {
+        return -EINVAL;
+    }
+
+    unsigned char major_type = *cursor->pos & CBOR_TYPE_MASK;
+
+    if (major_type != CBOR_UINT && major_type != CBOR_NEGINT) {
+        return -EINVAL;
+    }
+
+    uint64_t buf;
+    bool indefinite;
+    size_t head = cursor_head(cursor->pos, cursor->end, &buf, &indefinite);
+
+    if (!head || indefinite) {
+        return -EBADMSG;
+    }
+
+    if (buf > max) {
+        return -ERANGE;
+    }
+
+    *val = (major_type == CBOR_UINT) ? (int64_t)buf : -1 - (int64_t)buf;
+    cursor_advance(cursor, cursor->pos + head);
+    return 0;
+}
+
+int cbor_get_int64(cbor_cursor_t *cursor, int64_t *val)
+{
+    return cursor_get_int(cursor, val, INT64_MAX);
+}
+
+int cbor_get_int(cbor_cursor_t *cursor, int *val)
+{
+    int64_t buf;
+    int res = cursor_get_int(cursor, &buf, INT_MAX);
+
+    if (res == 0) {
+        *val = (int)buf;
+    }
+
+    return res;
+}
+
+int cbor_get_bool(cbor_cursor_t *cursor, bool *val)
+{
+    if (cbor_cursor_peek(cursor) != CBOR_ITEM_BOOL) {
+        return -EINVAL;
+    }
+
+    *val = (*cursor->pos == CBOR_TRUE);
+    cursor_advance(cursor, cursor->pos + 1);
+    return 0;
+}
+
+int cbor_get_null(cbor_cursor_t *cursor)
+{
+    if (cbor_cursor_peek(cursor) != CBOR_ITEM_NULL) {
+        return -EINVAL;
+    }
+
+    cursor_advance(cursor, cursor->pos + 1);
+    return 0;
+}
+
+#ifndef CBOR_NO_FLOAT
+int cbor_get_double(cbor_cursor_t *cursor, double *val)
+{
+    if (cbor_cursor_peek(cursor) != CBOR_ITEM_FLOAT) {
+        return -EINVAL;
+    }
+
+    uint64_t bits;
+    bool indefinite;
+    size_t head = cursor_head(cursor->pos, cursor->end, &bits, &indefinite);
+
+    if (!head) {
+        return -EBADMSG;
+    }
+
+    switch (*cursor->pos) {
+        case CBOR_FLOAT16: {
+            unsigned char half[2] = { bits >> 8, bits & 0xff };
+            *val = decode_float_half(half);
+            break;
+        }
+
+        case CBOR_FLOAT32: {
+            union {
+                float f;
+                uint32_t i;
+            } u = { .i = (uint32_t)bits };
+            *val = u.f;
+            break;
+        }
+
+        default: {
+            union {
+                double d;
+                uint64_t i;
+            } u = { .i = bits };
+            *val = u.d;
+            break;
+        }
+    }
+
+    cursor_advance(cursor, cursor->pos + head);
+    return 0;
+}
+
+int cbor_get_float(cbor_cursor_t *cursor, float *val)
+{
+    double buf;
+    int res = cbor_get_double(cursor, &buf);
+
+    if (res == 0) {
+        *val = (float)buf;
+    }
+
+    return res;
+}
+#endif /* CBOR_NO_FLOAT */
+
+/**
+ * Get a view of the definite length string of major type @p major_type
+ */
+static int cursor_get_string(cbor_cursor_t *cursor, unsigned char major_type,
+                             const uint8_t **data, size_t *len)
+{
+    uint64_t length;
+    bool indefinite;
+    int head = cursor_expect(cursor, major_type, &length, &indefinite);
+
+    if (head < 0) {
+        return head;
+    }
+
+    if (indefinite) {
+        return -ENOTSUP;
+    }
+
+    if (length > (uint64_t)(cursor->end - cursor->pos - head)) {
+        return -EBADMSG;
+    }
+
+    *data = cursor->pos + head;
+    *len = (size_t)length;
+    cursor_advance(cursor, *data + *len);
+    return 0;
+}
+
+int cbor_get_bytes(cbor_cursor_t *cursor, const uint8_t **data, size_t *len)
+{
+    return cursor_get_string(cursor, CBOR_BYTES, data, len);
+}
+
+int cbor_get_text(cbor_cursor_t *cursor, const char **str, size_t *len)
+{
+    const uint8_t *data;
+    int res = cursor_get_string(cursor, CBOR_TEXT, &data, len);
+
+    if (res == 0) {
+        *str = (const char *)data;
+    }
+
+    return res;
+}
+
+int cbor_get_tag(cbor_cursor_t *cursor, uint64_t *tag)
+{
+    bool indefinite;
+    int head = cursor_expect(cursor, CBOR_TAG, tag, &indefinite);
+
+    if (head < 0) {
+        return head;
+    }
+
+    if (indefinite) {
+        return -EBADMSG;
+    }
+
+    /* tag and tagged item count as one item, so don't touch remaining */
+    cursor->pos += head;
+    return 0;
+}
+
+/* END: Cursor */
+
+/* BEGIN: Writer */
+
+void cbor_writer_init(cbor_writer_t *writer, cbor_writer_cb_t cb, void *arg)
+{
+    writer->cb = cb;
+    writer->arg = arg;
+    writer->len = 0;
+    writer->error = 0;
+    writer->fill = 0;
+}
+
+static int writer_stream_cb(void *arg, const uint8_t *data, size_t len)
+{
+    cbor_stream_t *stream = arg;
+
+    if (len > stream->size - stream->pos) {
+        return -ENOBUFS;
+    }
+
+    memcpy(&stream->data[stream->pos], data, len);
+    stream->pos += len;
+    return 0;
+}
+
+void cbor_writer_init_stream(cbor_writer_t *writer, cbor_stream_t *stream)
+{
+    cbor_writer_init(writer, writer_stream_cb, stream);
+}
+
+#ifdef MODULE_GNRC_PKTBUF
+static int writer_pktbuf_cb(void *arg, const uint8_t *data, size_t len)
+{
+    gnrc_pktsnip_t **pkt = arg;
+    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, (void *)data, len,
+                                           GNRC_NETTYPE_UNDEF);
+
+    if (!snip) {
+        return -ENOMEM;
+    }
+
+    while (*pkt) {
+        pkt = &(*pkt)->next;
+    }
+
+    *pkt = snip;
+    return 0;
+}
+
+void cbor_writer_init_pktbuf(cbor_writer_t *writer, gnrc_pktsnip_t **pkt)
+{
+    cbor_writer_init(writer, writer_pktbuf_cb, pkt);
+}
+#endif /* MODULE_GNRC_PKTBUF */
+
+int cbor_writer_flush(cbor_writer_t *writer)
+{
+    if (!writer->error && writer->fill) {
+        writer->error = writer->cb(writer->arg, writer->buf, writer->fill);
+        writer->fill = 0;
+    }
+
+    return writer->error;
+}
+
+int cbor_writer_finish(cbor_writer_t *writer)
+{
+    return cbor_writer_flush(writer);
+}
+
+/**
+ * Stage @p len bytes of @p data, passing them to the sink right away if they
+ * do not fit into the staging buffer anyway
+ */
+static int writer_put(cbor_writer_t *writer, const uint8_t *data, size_t len)
+{
+    if (writer->error) {
+        return writer->error;
+    }
+
+    if (len > sizeof(writer->buf) - writer->fill) {
+        if (cbor_writer_flush(writer)) {
+            return writer->error;
+        }
+
+        if (len >= sizeof(writer->buf)) {
+            writer->error = writer->cb(writer->arg, data, len);
+            writer->len += writer->error ? 0 : len;
+            return writer->error;
+        }
+    }
+
+    memcpy(&writer->buf[writer->fill], data, len);
+    writer->fill += len;
+    writer->len += len;
+    return 0;
+}
+
+/**
+ * Encode the head of an item with major type @p major_type and argument
+ * @p val
+ */
+static int writer_put_head(cbor_writer_t *writer, unsigned char major_type, uint64_t val)
+{
+    if (writer->error) {
+        return writer->error;
+    }
+
+    /* make sure the longest head fits, so it can be built in place */
+    if (writer->fill > sizeof(writer->buf) - 9 && cbor_writer_flush(writer)) {
+        return writer->error;
+    }
+
+    uint8_t *head = &writer->buf[writer->fill];
+
+    if (val < CBOR_UINT8_FOLLOWS) {
+        head[0] = major_type | val;
+        writer->fill++;
+        writer->len++;
+        return 0;
+    }
+
+    unsigned char additional_info = uint_additional_info(val);
+    unsigned char bytes_follow = uint_bytes_follow(additional_info);
+
+    head[0] = major_type | additional_info;
+
+    for (int i = bytes_follow; i > 0; --i) {
+        head[i] = val & 0xff;
+        val >>= 8;
+    }
+
+    writer->fill += bytes_follow + 1;
+    writer->len += bytes_follow + 1;
+    return 0;
+}
+
+int cbor_put_uint(cbor_writer_t *writer, uint64_t val)
+{
+    return writer_put_head(writer, CBOR_UINT, val);
+}
+
+int cbor_put_int(cbor_writer_t *writer, int64_t val)
+{
+    if (val >= 0) {
+        return writer_put_head(writer, CBOR_UINT, (uint64_t)val);
+    }
+
+    return writer_put_head(writer, CBOR_NEGINT, (uint64_t)(-1 - val));
+}
+
+int cbor_put_bool(cbor_writer_t *writer, bool val)
+{
+    const uint8_t b = val ? CBOR_TRUE : CBOR_FALSE;
+    return writer_put(writer, &b, 1);
+}
+
+int cbor_put_null(cbor_writer_t *writer)
+{
+    const uint8_t b = CBOR_NULL;
+    return writer_put(writer, &b, 1);
+}
+
+#ifndef CBOR_NO_FLOAT
+int cbor_put_float(cbor_writer_t *writer, float val)
+{
+    union {
+        float f;
+        uint32_t i;
+    } u = { .f = val };
+    uint8_t buf[5] = { CBOR_FLOAT32, u.i >> 24, u.i >> 16, u.i >> 8, u.i };
+    return writer_put(writer, buf, sizeof(buf));
+}
+
+int cbor_put_double(cbor_writer_t *writer, double val)
+{
+    union {
+        double d;
+        uint64_t i;
+    } u = { .d = val };
+    uint8_t buf[9] = { CBOR_FLOAT64 };
+
+    for (int i = 8; i > 0; --i) {
+        buf[i] = u.i & 0xff;
+        u.i >>= 8;
+    }
+
+    return writer_put(writer, buf, sizeof(buf));
+}
+#endif /* CBOR_NO_FLOAT */
+
+int cbor_put_bytes(cbor_writer_t *writer, const void *data, size_t len)
+{
+    int res = writer_put_head(writer, CBOR_BYTES, len);
+    return res ? res : writer_put(writer, data, len);
+}
+
+int cbor_put_text(cbor_writer_t *writer, const char *str, size_t len)
+{
+    int res = writer_put_head(writer, CBOR_TEXT, len);
+    return res ? res : writer_put(writer, (const uint8_t *)str, len);
+}
+
+int cbor_put_array(cbor_writer_t *writer, size_t len)
+{
+    return writer_put_head(writer, CBOR_ARRAY, len);
+}
+
+int cbor_put_map(cbor_writer_t *writer, size_t len)
+{
+    return writer_put_head(writer, CBOR_MAP, len);
+}
+
+int cbor_put_array_indefinite(cbor_writer_t *writer)
+{
+    const uint8_t b = CBOR_ARRAY | CBOR_VAR_FOLLOWS;
+    return writer_put(writer, &b, 1);
+}
+
+int cbor_put_map_indefinite(cbor_writer_t *writer)
+{
+    const uint8_t b = CBOR_MAP | CBOR_VAR_FOLLOWS;
+    return writer_put(writer, &b, 1);
+}
+
+int cbor_put_break(cbor_writer_t *writer)
+{
+    const uint8_t b = CBOR_BREAK;
+    return writer_put(writer, &b, 1);
+}
+
+int cbor_put_tag(cbor_writer_t *writer, uint64_t tag)
+{
+    return writer_put_head(writer, CBOR_TAG, tag);
+}
+
+/* END: Writer */
+
 #ifndef CBOR_NO_PRINT
 /* BEGIN: Printers */
 void cbor_stream_print(const cbor_stream_t *stream)
@@ -20,21 +20,34 @@
 
 #include "checksum/fletcher16.h"
 
+/* Largest number of bytes to sum up before sum2 may overflow 32 bits,
+ * with both sums reduced to [1..255] before */
+#define FLETCHER16_BLOCK    (5802U)
+
+/* reduce modulo 255, mapping 0 to 255 as in one's complement arithmetic */
+static inline uint32_t _reduce(uint32_t sum)
+{
+    return (sum - 1) % 255 + 1;
+}
+
 uint16_t fletcher16(const uint8_t *data, size_t bytes)
 {
-    uint16_t sum1 = 0xff, sum2 = 0xff;
+    uint32_t sum1 = 0xff, sum2 = 0xff;
 
     while (bytes) {
-        size_t tlen = bytes > 20 ? 20 : bytes;
+        size_t tlen = bytes > FLETCHER16_BLOCK ? FLETCHER16_BLOCK : bytes;
         bytes -= tlen;
-        do {
+        for (; tlen >= 4; tlen -= 4) {
+            sum2 += sum1 += *data++;
+            sum2 += sum1 += *data++;
+            sum2 += sum1 += *data++;
+            sum2 += sum1 += *data++;
+        }
+        while (tlen--) {
             sum2 += sum1 += *data++;
-        } while (--tlen);
-        sum1 = (sum1 & 0xff) + (sum1 >> 8);
-        sum2 = (sum2 & 0xff) + (sum2 >> 8);
+        }
+        sum1 = _reduce(sum1);
+        sum2 = _reduce(sum2);
     }
-    /* Second reduction step to reduce sums to 8 bits */
-    sum1 = (sum1 & 0xff) + (sum1 >> 8);
-    sum2 = (sum2 & 0xff) + (sum2 >> 8);
     return (sum2 << 8) | sum1;
 }
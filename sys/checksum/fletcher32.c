@@ -20,21 +20,35 @@
 
 #include "checksum/fletcher32.h"
 
+/* Largest number of words to sum up before sum2 may overflow 32 bits,
+ * with both sums reduced to [1..65535] before */
+#define FLETCHER32_BLOCK    (360U)
+
+/* reduce modulo 65535, mapping 0 to 65535 as in one's complement arithmetic */
+static inline uint32_t _reduce(uint32_t sum)
+{
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (sum & 0xffff) + (sum >> 16);
+}
+
 uint32_t fletcher32(const uint16_t *data, size_t words)
 {
     uint32_t sum1 = 0xffff, sum2 = 0xffff;
 
     while (words) {
-        unsigned tlen = words > 359 ? 359 : words;
+        unsigned tlen = words > FLETCHER32_BLOCK ? FLETCHER32_BLOCK : words;
         words -= tlen;
-        do {
+        for (; tlen >= 4; tlen -= 4) {
+            sum2 += sum1 += *data++;
+            sum2 += sum1 += *data++;
+            sum2 += sum1 += *data++;
+            sum2 += sum1 += *data++;
+        }
+        while (tlen--) {
             sum2 += sum1 += *data++;
-        } while (--tlen);
-        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
-        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+        }
+        sum1 = _reduce(sum1);
+        sum2 = _reduce(sum2);
     }
-    /* Second reduction step to reduce sums to 16 bits */
-    sum1 = (sum1 & 0xffff) + (sum1 >> 16);
-    sum2 = (sum2 & 0xffff) + (sum2 >> 16);
     return (sum2 << 16) | sum1;
 }
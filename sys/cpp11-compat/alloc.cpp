@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Size class pools and bump arenas for C++ allocations
+ *
+ * @}
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "irq.h"
+#include "sched.h"
+
+#include "riot/alloc.hpp"
+
+namespace riot {
+
+namespace {
+
+alloc_stats arena_totals;
+arena* current_arena[KERNEL_PID_LAST + 1];
+
+inline void account_alloc(alloc_stats& s, size_t size) {
+  ++s.allocs;
+  s.bytes += size;
+  if (s.bytes > s.high_water) {
+    s.high_water = s.bytes;
+  }
+}
+
+#ifdef MODULE_CPP_POOL_NEW
+/* header in front of blocks from malloc(), keeps the payload aligned */
+union heap_header {
+  size_t size;
+  long double align;
+};
+
+struct pool {
+  char* begin;
+  char* end;
+  size_t block;
+  char* untouched;    /* blocks from here on were never handed out */
+  void* free_list;
+  alloc_stats stats;
+};
+
+#define POOL_STORAGE(size)                                                     \
+  union {                                                                      \
+    char buf[(size) * CPP_POOL_BLOCKS_##size];                                 \
+    long double align;                                                         \
+  } pool_##size
+
+POOL_STORAGE(16);
+POOL_STORAGE(32);
+POOL_STORAGE(64);
+POOL_STORAGE(128);
+
+#define POOL_INIT(size)                                                        \
+  { pool_##size.buf, pool_##size.buf + sizeof(pool_##size.buf), size,          \
+    pool_##size.buf, nullptr, {0, 0, 0, 0} }
+
+pool pools[pool_numof] = {
+  POOL_INIT(16), POOL_INIT(32), POOL_INIT(64), POOL_INIT(128)
+};
+
+alloc_stats heap_totals;
+
+void* pool_take(pool& p) {
+  void* ptr = p.free_list;
+  if (ptr) {
+    p.free_list = *static_cast<void**>(ptr);
+  }
+  else if (p.untouched < p.end) {
+    ptr = p.untouched;
+    p.untouched += p.block;
+  }
+  else {
+    ++p.stats.failed;
+    return nullptr;
+  }
+  account_alloc(p.stats, p.block);
+  return ptr;
+}
+#endif
+
+} // namespace
+
+#ifdef MODULE_CPP_POOL_NEW
+size_t pool_block_size(unsigned cls) noexcept { return pools[cls].block; }
+
+alloc_stats pool_stats(unsigned cls) noexcept {
+  unsigned state = irq_disable();
+  alloc_stats result = pools[cls].stats;
+  irq_restore(state);
+  return result;
+}
+
+alloc_stats heap_stats() noexcept {
+  unsigned state = irq_disable();
+  alloc_stats result = heap_totals;
+  irq_restore(state);
+  return result;
+}
+
+void* pool_alloc(size_t size) noexcept {
+  for (auto& p : pools) {
+    if (size <= p.block) {
+      unsigned state = irq_disable();
+      void* ptr = pool_take(p);
+      irq_restore(state);
+      if (ptr) {
+        return ptr;
+      }
+    }
+  }
+
+  /* too large or all fitting pools are exhausted */
+  auto hdr = static_cast<heap_header*>(std::malloc(sizeof(heap_header) + size));
+  unsigned state = irq_disable();
+  if (hdr) {
+    hdr->size = size;
+    account_alloc(heap_totals, size);
+  }
+  else {
+    ++heap_totals.failed;
+  }
+  irq_restore(state);
+  return hdr ? hdr + 1 : nullptr;
+}
+
+void pool_free(void* ptr) noexcept {
+  if (!ptr) {
+    return;
+  }
+  for (auto& p : pools) {
+    if (ptr >= p.begin && ptr < p.end) {
+      unsigned state = irq_disable();
+      *static_cast<void**>(ptr) = p.free_list;
+      p.free_list = ptr;
+      p.stats.bytes -= p.block;
+      irq_restore(state);
+      return;
+    }
+  }
+
+  auto hdr = static_cast<heap_header*>(ptr) - 1;
+  unsigned state = irq_disable();
+  heap_totals.bytes -= hdr->size;
+  irq_restore(state);
+  std::free(hdr);
+}
+#endif
+
+arena::~arena() { rewind(0); }
+
+void arena::reset() noexcept { rewind(0); }
+
+void arena::rewind(size_t mark) noexcept {
+  unsigned state = irq_disable();
+  arena_totals.allocs += m_allocs;
+  arena_totals.failed += m_failed;
+  if (m_high_water > arena_totals.high_water) {
+    arena_totals.high_water = m_high_water;
+  }
+  irq_restore(state);
+  m_allocs = 0;
+  m_failed = 0;
+  m_used = mark;
+}
+
+arena* arena::current() noexcept { return current_arena[sched_active_pid]; }
+
+arena::scope::scope(arena& a) noexcept
+    : m_arena(a), m_prev{current_arena[sched_active_pid]}, m_mark{a.m_used} {
+  current_arena[sched_active_pid] = &a;
+}
+
+arena::scope::~scope() {
+  current_arena[sched_active_pid] = m_prev;
+  m_arena.rewind(m_mark);
+}
+
+alloc_stats arena_stats() noexcept {
+  unsigned state = irq_disable();
+  alloc_stats result = arena_totals;
+  irq_restore(state);
+  return result;
+}
+
+} // namespace riot
+
+using namespace riot;
+
+extern "C" void cpp_alloc_print_stats(void) {
+#ifdef MODULE_CPP_POOL_NEW
+  for (unsigned i = 0; i < pool_numof; ++i) {
+    alloc_stats s = pool_stats(i);
+    printf("C++ pool %3u bytes: %u allocs, %u exhausted, %u bytes in use, "
+           "high water %u bytes\n", static_cast<unsigned>(pool_block_size(i)),
+           s.allocs, s.failed, static_cast<unsigned>(s.bytes),
+           static_cast<unsigned>(s.high_water));
+  }
+  alloc_stats h = heap_stats();
+  printf("C++ heap: %u allocs, %u failed, %u bytes in use, "
+         "high water %u bytes\n", h.allocs, h.failed,
+         static_cast<unsigned>(h.bytes), static_cast<unsigned>(h.high_water));
+#endif
+  alloc_stats a = arena_stats();
+  printf("C++ arenas: %u allocs, %u failed, high water %u bytes\n", a.allocs,
+         a.failed, static_cast<unsigned>(a.high_water));
+}
@@ -22,6 +22,8 @@
 #include <cstddef>
 #include <cstdlib>
 
+#include "riot/alloc.hpp"
+
 extern "C" {
 #include "panic.h"
 }
@@ -106,20 +108,29 @@ void __verbose_terminate_handler()
      Elegant Invention
  */
 
+#ifdef MODULE_CPP_POOL_NEW
+/* small objects come from the size class pools, see riot/alloc.hpp */
+#define CPP_ALLOC(size) riot::pool_alloc(size)
+#define CPP_FREE(ptr)   riot::pool_free(ptr)
+#else
+#define CPP_ALLOC(size) std::malloc(size)
+#define CPP_FREE(ptr)   std::free(ptr)
+#endif
+
 void* operator new(std::size_t size) {
-    return std::malloc(size);
+    return CPP_ALLOC(size);
 }
 
 void* operator new[](std::size_t size) {
-    return std::malloc(size);
+    return CPP_ALLOC(size);
 }
 
 void operator delete(void* ptr) noexcept {
-    std::free(ptr);
+    CPP_FREE(ptr);
 }
 
 void operator delete[](void* ptr) noexcept {
-    std::free(ptr);
+    CPP_FREE(ptr);
 }
 
 /* Optionally you can override the 'nothrow' versions as well.
@@ -129,19 +140,19 @@ void operator delete[](void* ptr) noexcept {
  */
 
 void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
-    return std::malloc(size);
+    return CPP_ALLOC(size);
 }
 
 void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
-    return std::malloc(size);
+    return CPP_ALLOC(size);
 }
 
 void operator delete(void* ptr, const std::nothrow_t&) noexcept {
-    std::free(ptr);
+    CPP_FREE(ptr);
 }
 
 void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
-    std::free(ptr);
+    CPP_FREE(ptr);
 }
 
 /** @} */
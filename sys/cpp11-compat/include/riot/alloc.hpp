@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Size class pools and bump arenas for C++ allocations
+ *
+ * With the `cpp_pool_new` pseudomodule, the global `operator new` takes
+ * small objects from fixed size class pools (see CPP_POOL_BLOCKS_16 and
+ * following) and only falls back to `malloc()` if the object is larger or
+ * its pool is exhausted. Freed blocks go back to their pool, so long running
+ * applications do not fragment the heap with small objects.
+ *
+ * riot::arena is a bump allocator over a caller supplied buffer for objects
+ * that die together, e.g. everything allocated while handling a request:
+ *
+ * @code
+ * static char buf[512];
+ * riot::arena a{buf, sizeof(buf)};
+ * {
+ *   riot::arena::scope s{a};
+ *   std::vector<int, riot::arena_allocator<int>> v{riot::arena_allocator<int>{a}};
+ *   ...
+ * } // everything allocated from a within the scope is released here
+ * @endcode
+ *
+ * Statistics of all of them are printed by the `heap` shell command.
+ *
+ * @}
+ */
+
+#ifndef RIOT_ALLOC_HPP
+#define RIOT_ALLOC_HPP
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @name Number of blocks in the pools used by `operator new`
+ * @{
+ */
+#ifndef CPP_POOL_BLOCKS_16
+#define CPP_POOL_BLOCKS_16  (8)
+#endif
+#ifndef CPP_POOL_BLOCKS_32
+#define CPP_POOL_BLOCKS_32  (8)
+#endif
+#ifndef CPP_POOL_BLOCKS_64
+#define CPP_POOL_BLOCKS_64  (4)
+#endif
+#ifndef CPP_POOL_BLOCKS_128
+#define CPP_POOL_BLOCKS_128 (4)
+#endif
+/** @} */
+
+namespace riot {
+
+/**
+ * @brief Allocation statistics of a pool, the heap or all arenas
+ */
+struct alloc_stats {
+  unsigned allocs;    /**< number of allocations */
+  unsigned failed;    /**< allocations that could not be served */
+  size_t bytes;       /**< bytes currently allocated */
+  size_t high_water;  /**< maximum of @ref bytes */
+};
+
+#if defined(MODULE_CPP_POOL_NEW) || defined(DOXYGEN)
+/**
+ * @brief Number of size classes
+ */
+constexpr unsigned pool_numof = 4;
+
+/**
+ * @brief Block size of size class @p cls
+ */
+size_t pool_block_size(unsigned cls) noexcept;
+
+/**
+ * @brief Statistics of size class @p cls
+ *
+ * @ref alloc_stats::failed counts requests that had to go to a larger
+ * class or the heap because the pool was exhausted.
+ */
+alloc_stats pool_stats(unsigned cls) noexcept;
+
+/**
+ * @brief Statistics of the allocations `operator new` passed to `malloc()`
+ */
+alloc_stats heap_stats() noexcept;
+
+/**
+ * @brief Allocate @p size bytes from the pools, or the heap if no pool fits
+ * @returns nullptr if out of memory
+ */
+void* pool_alloc(size_t size) noexcept;
+
+/**
+ * @brief Release memory returned by pool_alloc()
+ */
+void pool_free(void* ptr) noexcept;
+#endif
+
+/**
+ * @brief Bump allocator over a fixed buffer
+ *
+ * Memory is only given back all at once, by reset() or when a
+ * arena::scope ends. An arena must only be used by one thread at a time.
+ */
+class arena {
+ public:
+  /**
+   * @brief Makes @p a the current arena of the calling thread and rewinds
+   *        it to its current position at the end of the scope
+   */
+  class scope {
+   public:
+    explicit scope(arena& a) noexcept;
+    ~scope();
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+   private:
+    arena& m_arena;
+    arena* m_prev;
+    size_t m_mark;
+  };
+
+  inline arena(void* buf, size_t size) noexcept
+      : m_buf{static_cast<char*>(buf)}, m_size{size}, m_used{0},
+        m_high_water{0}, m_allocs{0}, m_failed{0} {}
+  ~arena();
+
+  arena(const arena&) = delete;
+  arena& operator=(const arena&) = delete;
+
+  /**
+   * @brief Allocate @p size bytes aligned to @p align, a power of two
+   * @returns nullptr if the arena is full
+   */
+  inline void* allocate(size_t size,
+                        size_t align = alignof(long double)) noexcept {
+    uintptr_t base = reinterpret_cast<uintptr_t>(m_buf);
+    size_t start = ((base + m_used + align - 1) & ~(align - 1)) - base;
+    if (start + size > m_size || start + size < start) {
+      ++m_failed;
+      return nullptr;
+    }
+    m_used = start + size;
+    if (m_used > m_high_water) {
+      m_high_water = m_used;
+    }
+    ++m_allocs;
+    return m_buf + start;
+  }
+
+  /**
+   * @brief Release everything allocated from the arena
+   */
+  void reset() noexcept;
+
+  inline size_t used() const noexcept { return m_used; }
+  inline size_t capacity() const noexcept { return m_size; }
+  inline size_t high_water() const noexcept { return m_high_water; }
+
+  /**
+   * @brief The arena of the innermost arena::scope of the calling thread
+   * @returns nullptr outside of any scope
+   */
+  static arena* current() noexcept;
+
+ private:
+  void rewind(size_t mark) noexcept;
+
+  char* m_buf;
+  size_t m_size;
+  size_t m_used;
+  size_t m_high_water;
+  unsigned m_allocs;
+  unsigned m_failed;
+};
+
+/**
+ * @brief Statistics of all arenas
+ *
+ * Arenas report when they are reset, rewound or destroyed.
+ * @ref alloc_stats::bytes is always 0, @ref alloc_stats::high_water is the
+ * highest fill level any arena reached.
+ */
+alloc_stats arena_stats() noexcept;
+
+/**
+ * @brief Standard allocator taking its memory from an arena
+ * @see   <a href="http://en.cppreference.com/w/cpp/concept/Allocator">
+ *          Allocator
+ *        </a>
+ */
+template <class T>
+class arena_allocator {
+  template <class U>
+  friend class arena_allocator;
+
+ public:
+  using value_type = T;
+
+  inline explicit arena_allocator(arena& a) noexcept : m_arena{&a} {}
+  template <class U>
+  inline arena_allocator(const arena_allocator<U>& other) noexcept
+      : m_arena{other.m_arena} {}
+
+  inline T* allocate(size_t n) {
+    void* p = m_arena->allocate(n * sizeof(T), alignof(T));
+    if (!p) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(p);
+  }
+
+  inline void deallocate(T*, size_t) noexcept {
+    // released with the arena
+  }
+
+  template <class U>
+  inline bool operator==(const arena_allocator<U>& other) const noexcept {
+    return m_arena == other.m_arena;
+  }
+  template <class U>
+  inline bool operator!=(const arena_allocator<U>& other) const noexcept {
+    return m_arena != other.m_arena;
+  }
+
+ private:
+  arena* m_arena;
+};
+
+} // namespace riot
+
+/**
+ * @brief Construct an object in @p a, the result is nullptr if it is full
+ */
+inline void* operator new(std::size_t size, riot::arena& a) noexcept {
+  return a.allocate(size);
+}
+
+/**
+ * @brief Construct an array in @p a, the result is nullptr if it is full
+ */
+inline void* operator new[](std::size_t size, riot::arena& a) noexcept {
+  return a.allocate(size);
+}
+
+/**
+ * @brief Only called if a constructor throws, the memory is released with
+ *        the arena
+ */
+inline void operator delete(void*, riot::arena&) noexcept {}
+
+/**
+ * @copydoc operator delete(void*, riot::arena&)
+ */
+inline void operator delete[](void*, riot::arena&) noexcept {}
+
+/**
+ * @brief Print the statistics of the C++ allocators, used by the `heap`
+ *        shell command
+ */
+extern "C" void cpp_alloc_print_stats(void);
+
+#endif // RIOT_ALLOC_HPP
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Move-only type erased `void()` callable with inline storage
+ *
+ * Callables of up to RIOT_TASK_BUFFER_SIZE bytes that can be moved without
+ * throwing are stored inside the task, larger ones are moved to the heap.
+ *
+ * @}
+ */
+
+#ifndef RIOT_DETAIL_TASK_HPP
+#define RIOT_DETAIL_TASK_HPP
+
+#include <new>
+#include <utility>
+#include <type_traits>
+
+/**
+ * @brief Size of the inline storage of a task
+ */
+#ifndef RIOT_TASK_BUFFER_SIZE
+#define RIOT_TASK_BUFFER_SIZE (4 * sizeof(void*))
+#endif
+
+namespace riot {
+namespace detail {
+
+/**
+ * @brief A unit of work for a @ref riot::thread_pool
+ */
+class task {
+  using storage = std::aligned_storage<RIOT_TASK_BUFFER_SIZE>::type;
+
+  struct ops {
+    void (*invoke)(void*);
+    void (*move)(void* dst, void* src) noexcept;
+    void (*destroy)(void*) noexcept;
+  };
+
+  template <class F>
+  struct inline_ops {
+    static void invoke(void* s) { (*static_cast<F*>(s))(); }
+    static void move(void* dst, void* src) noexcept {
+      new (dst) F(std::move(*static_cast<F*>(src)));
+      static_cast<F*>(src)->~F();
+    }
+    static void destroy(void* s) noexcept { static_cast<F*>(s)->~F(); }
+    static const ops table;
+  };
+
+  template <class F>
+  struct heap_ops {
+    static void invoke(void* s) { (**static_cast<F**>(s))(); }
+    static void move(void* dst, void* src) noexcept {
+      *static_cast<F**>(dst) = *static_cast<F**>(src);
+    }
+    static void destroy(void* s) noexcept { delete *static_cast<F**>(s); }
+    static const ops table;
+  };
+
+  template <class F>
+  using fits = std::integral_constant<
+    bool, sizeof(F) <= sizeof(storage) && alignof(F) <= alignof(storage)
+            && std::is_nothrow_move_constructible<F>::value>;
+
+  template <class F>
+  void init(F&& f, std::true_type) {
+    using fun = typename std::decay<F>::type;
+    new (&m_storage) fun(std::forward<F>(f));
+    m_ops = &inline_ops<fun>::table;
+  }
+
+  template <class F>
+  void init(F&& f, std::false_type) {
+    using fun = typename std::decay<F>::type;
+    *reinterpret_cast<fun**>(&m_storage) = new fun(std::forward<F>(f));
+    m_ops = &heap_ops<fun>::table;
+  }
+
+ public:
+  inline task() noexcept : m_ops{nullptr} {}
+
+  template <class F, class = typename std::enable_if<!std::is_same<
+                       typename std::decay<F>::type, task>::value>::type>
+  task(F&& f) : m_ops{nullptr} {
+    init(std::forward<F>(f), fits<typename std::decay<F>::type>{});
+  }
+
+  inline task(task&& other) noexcept : m_ops{other.m_ops} {
+    if (m_ops) {
+      m_ops->move(&m_storage, &other.m_storage);
+      other.m_ops = nullptr;
+    }
+  }
+
+  inline task& operator=(task&& other) noexcept {
+    if (this != &other) {
+      reset();
+      if (other.m_ops) {
+        other.m_ops->move(&m_storage, &other.m_storage);
+        m_ops = other.m_ops;
+        other.m_ops = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  task(const task&) = delete;
+  task& operator=(const task&) = delete;
+
+  inline ~task() { reset(); }
+
+  /**
+   * @brief Destroy the stored callable
+   */
+  inline void reset() noexcept {
+    if (m_ops) {
+      m_ops->destroy(&m_storage);
+      m_ops = nullptr;
+    }
+  }
+
+  inline explicit operator bool() const noexcept { return m_ops != nullptr; }
+
+  inline void operator()() { m_ops->invoke(&m_storage); }
+
+ private:
+  storage m_storage;
+  const ops* m_ops;
+};
+
+template <class F>
+const task::ops task::inline_ops<F>::table = {
+  &task::inline_ops<F>::invoke, &task::inline_ops<F>::move,
+  &task::inline_ops<F>::destroy};
+
+template <class F>
+const task::ops task::heap_ops<F>::table = {
+  &task::heap_ops<F>::invoke, &task::heap_ops<F>::move,
+  &task::heap_ops<F>::destroy};
+
+} // namespace detail
+} // namespace riot
+
+#endif // RIOT_DETAIL_TASK_HPP
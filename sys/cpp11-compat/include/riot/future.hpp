@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++11 future and promise replacement
+ * @see     <a href="http://en.cppreference.com/w/cpp/thread/future">
+ *            std::future
+ *          </a>
+ *
+ * Exceptions are not transported: if a promise is destroyed before it got a
+ * value, e.g. because the task computing it threw, future::get() throws a
+ * riot::future_error.
+ *
+ * @}
+ */
+
+#ifndef RIOT_FUTURE_HPP
+#define RIOT_FUTURE_HPP
+
+#include <new>
+#include <atomic>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include "riot/mutex.hpp"
+#include "riot/condition_variable.hpp"
+
+namespace riot {
+
+/**
+ * @brief Thrown on misuse of a future or promise, and by future::get() if
+ *        the promise was broken
+ */
+class future_error : public std::logic_error {
+ public:
+  explicit future_error(const char* what) : std::logic_error(what) {}
+};
+
+namespace detail {
+
+/**
+ * @brief State shared by a promise and its future
+ */
+class shared_state_base {
+ public:
+  enum state_t { pending, ready, broken };
+
+  inline shared_state_base() : m_refs{2}, m_state{pending} {}
+  virtual ~shared_state_base() {}
+
+  inline void release() noexcept {
+    if (--m_refs == 0) {
+      delete this;
+    }
+  }
+
+  inline bool is_ready() {
+    lock_guard<mutex> lk(m_mtx);
+    return m_state != pending;
+  }
+
+  inline state_t wait() {
+    unique_lock<mutex> lk(m_mtx);
+    while (m_state == pending) {
+      m_cv.wait(lk);
+    }
+    return m_state;
+  }
+
+  inline void set_state(state_t state) {
+    {
+      lock_guard<mutex> lk(m_mtx);
+      m_state = state;
+    }
+    m_cv.notify_all();
+  }
+
+ private:
+  mutex m_mtx;
+  condition_variable m_cv;
+  std::atomic<unsigned> m_refs;
+  state_t m_state;
+};
+
+template <class T>
+class shared_state : public shared_state_base {
+ public:
+  ~shared_state() {
+    if (m_has_value) {
+      value().~T();
+    }
+  }
+
+  template <class U>
+  void set(U&& val) {
+    new (&m_value) T(std::forward<U>(val));
+    m_has_value = true;
+    set_state(ready);
+  }
+
+  inline T& value() { return *reinterpret_cast<T*>(&m_value); }
+
+ private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_value;
+  bool m_has_value = false;
+};
+
+template <>
+class shared_state<void> : public shared_state_base {
+ public:
+  inline void set() { set_state(ready); }
+};
+
+} // namespace detail
+
+template <class T>
+class promise;
+
+/**
+ * @brief C++11 compliant implementation of future, without shared_future and
+ *        without timed waits
+ * @see   <a href="http://en.cppreference.com/w/cpp/thread/future">
+ *          std::future
+ *        </a>
+ */
+template <class T>
+class future {
+  static_assert(!std::is_reference<T>::value,
+                "futures of references are not supported");
+  friend class promise<T>;
+
+ public:
+  inline future() noexcept : m_state{nullptr} {}
+  inline future(future&& other) noexcept : m_state{other.m_state} {
+    other.m_state = nullptr;
+  }
+  inline future& operator=(future&& other) noexcept {
+    std::swap(m_state, other.m_state);
+    return *this;
+  }
+  future(const future&) = delete;
+  future& operator=(const future&) = delete;
+
+  inline ~future() {
+    if (m_state) {
+      m_state->release();
+    }
+  }
+
+  inline bool valid() const noexcept { return m_state != nullptr; }
+
+  /**
+   * @brief Returns true if get() would not block
+   */
+  inline bool is_ready() const {
+    check();
+    return m_state->is_ready();
+  }
+
+  inline void wait() const {
+    check();
+    m_state->wait();
+  }
+
+  /**
+   * @brief Wait for the value and return it, the future is invalid
+   *        afterwards
+   */
+  T get();
+
+ private:
+  inline explicit future(detail::shared_state<T>* state) : m_state{state} {}
+
+  inline void check() const {
+    if (!m_state) {
+      throw future_error("no state");
+    }
+  }
+
+  detail::shared_state<T>* m_state;
+};
+
+/**
+ * @brief C++11 compliant implementation of promise, without set_exception()
+ * @see   <a href="http://en.cppreference.com/w/cpp/thread/promise">
+ *          std::promise
+ *        </a>
+ */
+template <class T>
+class promise {
+ public:
+  inline promise()
+      : m_state{new detail::shared_state<T>}, m_retrieved{false}, m_set{false} {
+  }
+  inline promise(promise&& other) noexcept : m_state{other.m_state},
+                                             m_retrieved{other.m_retrieved},
+                                             m_set{other.m_set} {
+    other.m_state = nullptr;
+  }
+  inline promise& operator=(promise&& other) noexcept {
+    promise tmp{std::move(other)};
+    swap(tmp);
+    return *this;
+  }
+  promise(const promise&) = delete;
+  promise& operator=(const promise&) = delete;
+
+  inline ~promise() {
+    if (m_state) {
+      if (!m_set) {
+        m_state->set_state(detail::shared_state_base::broken);
+      }
+      if (!m_retrieved) {
+        /* nobody else is going to drop the future's reference */
+        m_state->release();
+      }
+      m_state->release();
+    }
+  }
+
+  inline void swap(promise& other) noexcept {
+    std::swap(m_state, other.m_state);
+    std::swap(m_retrieved, other.m_retrieved);
+    std::swap(m_set, other.m_set);
+  }
+
+  future<T> get_future() {
+    if (!m_state || m_retrieved) {
+      throw future_error("future already retrieved");
+    }
+    m_retrieved = true;
+    return future<T>{m_state};
+  }
+
+  template <class U = T>
+  typename std::enable_if<!std::is_void<U>::value>::type set_value(U&& val) {
+    check_unset();
+    m_state->set(std::forward<U>(val));
+  }
+
+  template <class U = T>
+  typename std::enable_if<std::is_void<U>::value>::type set_value() {
+    check_unset();
+    m_state->set();
+  }
+
+ private:
+  inline void check_unset() {
+    if (!m_state || m_set) {
+      throw future_error("promise already satisfied");
+    }
+    m_set = true;
+  }
+
+  detail::shared_state<T>* m_state;
+  bool m_retrieved;
+  bool m_set;
+};
+
+namespace detail {
+
+template <class T>
+inline T take(shared_state<T>* state) {
+  return std::move(state->value());
+}
+
+template <>
+inline void take(shared_state<void>*) {}
+
+} // namespace detail
+
+template <class T>
+T future<T>::get() {
+  check();
+  detail::shared_state<T>* state = m_state;
+  m_state = nullptr;
+  /* drops our reference when leaving, whether we return or throw */
+  struct releaser {
+    detail::shared_state<T>* s;
+    ~releaser() { s->release(); }
+  } guard{state};
+  if (state->wait() == detail::shared_state_base::broken) {
+    throw future_error("broken promise");
+  }
+  return detail::take(state);
+}
+
+} // namespace riot
+
+#endif // RIOT_FUTURE_HPP
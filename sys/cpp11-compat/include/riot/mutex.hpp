@@ -39,12 +39,14 @@ namespace riot {
  * @see   <a href="http://en.cppreference.com/w/cpp/thread/mutex">
  *          std::mutex
  *        </a>
+ * @note  Wraps a @ref mutex_t and therefore supports priority inheritance
+ *        when the `core_mutex_priority_inheritance` module is used.
  */
 class mutex {
  public:
   using native_handle_type = mutex_t*;
 
-  inline constexpr mutex() noexcept : m_mtx{0} {}
+  inline constexpr mutex() noexcept : m_mtx{} {}
   ~mutex();
 
   void lock();
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++ front-end for @ref sys_schema
+ *
+ * Derives the schema of a struct at compile time: member types and sizes
+ * come from `decltype`, key hashes are computed by a constexpr function, so
+ * the table only has to list the members.
+ *
+ * @code
+ * struct telemetry {
+ *   int16_t temp;
+ *   uint32_t uptime;
+ *   char name[16];
+ * };
+ *
+ * RIOT_SCHEMA(telemetry,
+ *             RIOT_SCHEMA_FIELD(telemetry, temp),
+ *             RIOT_SCHEMA_FIELD(telemetry, uptime),
+ *             RIOT_SCHEMA_FIELD(telemetry, name));
+ *
+ * telemetry t;
+ * riot::schema::encode(t, writer);
+ * @endcode
+ *
+ * RIOT_SCHEMA() must be used in the global namespace. Members that are
+ * structs themselves need a RIOT_SCHEMA() of their own, declared before.
+ *
+ * @}
+ */
+
+#ifndef RIOT_SCHEMA_HPP
+#define RIOT_SCHEMA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "schema.h"
+
+namespace riot {
+namespace schema {
+
+/**
+ * @brief 32 bit FNV-1a hash of @p str, computed at compile time
+ * @note  Must produce the same result as schema_hash()
+ */
+constexpr uint32_t hash(const char* str, uint32_t h = 2166136261u) {
+  return *str ? hash(str + 1, (h ^ static_cast<uint8_t>(*str)) * 16777619u)
+              : h;
+}
+
+/**
+ * @brief Schema of struct @p T, specialized by RIOT_SCHEMA()
+ */
+template <class T>
+struct descriptor;
+
+/**
+ * @brief Maps a member type to its @ref schema_type_t
+ */
+template <class T, class Enable = void>
+struct type_of;
+
+/** @cond INTERNAL */
+#define RIOT_SCHEMA_TYPE(ctype, stype)                                         \
+  template <>                                                                  \
+  struct type_of<ctype> : std::integral_constant<uint8_t, stype> {}
+
+RIOT_SCHEMA_TYPE(bool, SCHEMA_BOOL);
+RIOT_SCHEMA_TYPE(int8_t, SCHEMA_INT8);
+RIOT_SCHEMA_TYPE(int16_t, SCHEMA_INT16);
+RIOT_SCHEMA_TYPE(int32_t, SCHEMA_INT32);
+RIOT_SCHEMA_TYPE(int64_t, SCHEMA_INT64);
+RIOT_SCHEMA_TYPE(uint8_t, SCHEMA_UINT8);
+RIOT_SCHEMA_TYPE(uint16_t, SCHEMA_UINT16);
+RIOT_SCHEMA_TYPE(uint32_t, SCHEMA_UINT32);
+RIOT_SCHEMA_TYPE(uint64_t, SCHEMA_UINT64);
+RIOT_SCHEMA_TYPE(float, SCHEMA_FLOAT);
+RIOT_SCHEMA_TYPE(double, SCHEMA_DOUBLE);
+
+#undef RIOT_SCHEMA_TYPE
+
+template <size_t N>
+struct type_of<char[N]> : std::integral_constant<uint8_t, SCHEMA_STRING> {
+  static_assert(N <= UINT16_MAX, "string member too large");
+};
+
+template <class T>
+struct type_of<T, typename std::enable_if<std::is_class<T>::value>::type>
+  : std::integral_constant<uint8_t, SCHEMA_STRUCT> {};
+
+template <class T>
+typename std::enable_if<std::is_class<T>::value, schema_t*>::type sub() {
+  return &descriptor<T>::get();
+}
+
+template <class T>
+typename std::enable_if<!std::is_class<T>::value, schema_t*>::type sub() {
+  return nullptr;
+}
+/** @endcond */
+
+#if defined(MODULE_CBOR) || defined(DOXYGEN)
+/**
+ * @brief Encode @p obj as a CBOR map
+ * @see   schema_cbor_encode()
+ */
+template <class T>
+inline int encode(const T& obj, cbor_writer_t& writer) {
+  return schema_cbor_encode(&descriptor<T>::get(), &obj, &writer);
+}
+
+/**
+ * @brief Decode the CBOR map at @p cursor into @p obj
+ * @see   schema_cbor_decode()
+ */
+template <class T>
+inline int decode(T& obj, cbor_cursor_t& cursor) {
+  return schema_cbor_decode(&descriptor<T>::get(), &obj, &cursor);
+}
+#endif
+
+#if defined(MODULE_UBJSON) || defined(DOXYGEN)
+/**
+ * @brief Encode @p obj as a UBJSON object
+ * @see   schema_ubjson_encode()
+ */
+template <class T>
+inline ssize_t encode(const T& obj, ubjson_cookie_t& cookie) {
+  return schema_ubjson_encode(&descriptor<T>::get(), &obj, &cookie);
+}
+
+/**
+ * @brief Decode a UBJSON object into @p obj
+ * @see   schema_ubjson_decode()
+ */
+template <class T>
+inline int decode(T& obj, ubjson_cookie_t& cookie, ubjson_read_t read) {
+  return schema_ubjson_decode(&descriptor<T>::get(), &obj, &cookie, read);
+}
+#endif
+
+} // namespace schema
+} // namespace riot
+
+/**
+ * @brief Describe member @p member of struct @p type
+ */
+#define RIOT_SCHEMA_FIELD(type, member)                                        \
+  schema_field_t {                                                             \
+    #member, ::riot::schema::hash(#member),                                    \
+    static_cast<uint16_t>(offsetof(type, member)),                             \
+    static_cast<uint16_t>(sizeof(type::member)),                               \
+    static_cast<uint8_t>(sizeof(#member) - 1),                                 \
+    ::riot::schema::type_of<decltype(type::member)>::value,                    \
+    ::riot::schema::sub<decltype(type::member)>()                              \
+  }
+
+/**
+ * @brief Define the schema of struct @p type from a list of
+ *        RIOT_SCHEMA_FIELD()
+ */
+#define RIOT_SCHEMA(type, ...)                                                 \
+  namespace riot {                                                             \
+  namespace schema {                                                           \
+  template <>                                                                  \
+  struct descriptor<type> {                                                    \
+    static_assert(std::is_standard_layout<type>::value,                        \
+                  "schema requires a standard layout type");                   \
+    static schema_t& get() {                                                   \
+      static const schema_field_t fields[] = { __VA_ARGS__ };                  \
+      static constexpr size_t num = sizeof(fields) / sizeof(fields[0]);        \
+      static_assert(num <= SCHEMA_MAX_FIELDS, "too many fields");              \
+      static uint8_t index[SCHEMA_INDEX_SIZE(num)];                            \
+      static schema_t s = { fields, index, num, sizeof(index) - 1, false };    \
+      return s;                                                                \
+    }                                                                          \
+  };                                                                           \
+  }                                                                            \
+  }
+
+#endif // RIOT_SCHEMA_HPP
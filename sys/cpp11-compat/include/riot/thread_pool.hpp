@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Fixed size pool of worker threads executing tasks
+ *
+ * All stacks of a pool are allocated once when it is created. Tasks are kept
+ * in a bounded ring buffer; small callables are stored in the buffer itself,
+ * see @ref RIOT_TASK_BUFFER_SIZE, so posting them does not allocate.
+ *
+ * @code
+ * riot::thread_pool pool{2, THREAD_STACKSIZE_DEFAULT};
+ * auto f = riot::async(pool, [](int x) { return x * x; }, 7);
+ * int result = f.get();
+ * @endcode
+ *
+ * @}
+ */
+
+#ifndef RIOT_THREAD_POOL_HPP
+#define RIOT_THREAD_POOL_HPP
+
+#include <tuple>
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+#include "thread.h"
+
+#include "riot/mutex.hpp"
+#include "riot/future.hpp"
+#include "riot/condition_variable.hpp"
+
+#include "riot/detail/task.hpp"
+#include "riot/detail/thread_util.hpp"
+
+namespace riot {
+
+namespace detail {
+
+template <class R, class F, class Tuple, long... Is>
+inline void fulfil(promise<R>& p, F& f, Tuple& args, int_list<Is...>) {
+  p.set_value(f(std::get<Is>(args)...));
+}
+
+template <class F, class Tuple, long... Is>
+inline void fulfil(promise<void>& p, F& f, Tuple& args, int_list<Is...>) {
+  f(std::get<Is>(args)...);
+  p.set_value();
+}
+
+/**
+ * @brief Task that calls a function and hands its result to a promise
+ *
+ * If the function throws, the promise is broken when the task is destroyed.
+ */
+template <class R, class F, class... Args>
+struct bound_task {
+  promise<R> result;
+  F fun;
+  std::tuple<Args...> args;
+
+  void operator()() {
+    try {
+      fulfil(result, fun, args, get_indices<sizeof...(Args)>());
+    }
+    catch (...) {
+      // nop
+    }
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Fixed number of worker threads taking tasks from a bounded queue
+ *
+ * Destroying the pool executes the queued tasks and waits for the workers
+ * to exit. A task must not wait for a task queued behind it, and must not
+ * post to its own pool when the queue may be full.
+ */
+class thread_pool {
+ public:
+  /**
+   * @brief Start @p workers threads with @p stack_size bytes of stack each
+   *
+   * @param[in] workers     number of worker threads
+   * @param[in] stack_size  stack size of each worker
+   * @param[in] capacity    number of tasks that can be queued
+   * @param[in] priority    priority of the workers
+   */
+  explicit thread_pool(unsigned workers = 1,
+                       size_t stack_size = THREAD_STACKSIZE_MAIN,
+                       unsigned capacity = 8,
+                       uint8_t priority = THREAD_PRIORITY_MAIN - 1);
+  ~thread_pool();
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  inline unsigned size() const noexcept { return m_workers; }
+
+  /**
+   * @brief Queue @p f for execution, blocks while the queue is full
+   */
+  template <class F>
+  void post(F&& f) {
+    /* moved into the queue, so the callable is built outside the lock */
+    push(detail::task{std::forward<F>(f)});
+  }
+
+  /**
+   * @brief Queue `f(args...)` for execution
+   * @returns future for the result
+   */
+  template <class F, class... Args>
+  future<typename std::result_of<typename std::decay<F>::type(
+    typename std::decay<Args>::type...)>::type>
+  submit(F&& f, Args&&... args) {
+    using result_type = typename std::result_of<typename std::decay<F>::type(
+      typename std::decay<Args>::type...)>::type;
+    using task_type = detail::bound_task<result_type,
+                                         typename std::decay<F>::type,
+                                         typename std::decay<Args>::type...>;
+    promise<result_type> p;
+    auto result = p.get_future();
+    post(task_type{std::move(p), std::forward<F>(f),
+                   std::make_tuple(std::forward<Args>(args)...)});
+    return result;
+  }
+
+ private:
+  static void* worker(void* arg);
+  void push(detail::task&& t);
+  bool pop(detail::task& t);
+  void shutdown() noexcept;
+
+  mutex m_mtx;
+  condition_variable m_not_empty;
+  condition_variable m_not_full;
+  std::unique_ptr<detail::task[]> m_queue;
+  std::unique_ptr<char[]> m_stacks;
+  unsigned m_capacity;
+  unsigned m_head;
+  unsigned m_count;
+  unsigned m_workers;
+  volatile unsigned m_running;
+  volatile kernel_pid_t m_joining_thread;
+  bool m_stop;
+};
+
+/**
+ * @brief Run `f(args...)` on @p pool
+ * @see   <a href="http://en.cppreference.com/w/cpp/thread/async">
+ *          std::async
+ *        </a>
+ */
+template <class F, class... Args>
+inline auto async(thread_pool& pool, F&& f, Args&&... args)
+  -> decltype(pool.submit(std::forward<F>(f), std::forward<Args>(args)...)) {
+  return pool.submit(std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+} // namespace riot
+
+#endif // RIOT_THREAD_POOL_HPP
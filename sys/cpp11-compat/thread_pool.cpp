@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Fixed size pool of worker threads executing tasks
+ *
+ * @}
+ */
+
+#include <system_error>
+
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+
+#include "riot/thread_pool.hpp"
+
+using namespace std;
+
+namespace riot {
+
+thread_pool::thread_pool(unsigned workers, size_t stack_size,
+                         unsigned capacity, uint8_t priority)
+    : m_queue{new detail::task[capacity]},
+      m_stacks{new char[workers * stack_size]},
+      m_capacity{capacity},
+      m_head{0},
+      m_count{0},
+      m_workers{0},
+      m_running{0},
+      m_joining_thread{KERNEL_PID_UNDEF},
+      m_stop{false} {
+  for (unsigned i = 0; i < workers; ++i) {
+    unsigned state = irq_disable();
+    kernel_pid_t pid = thread_create(&m_stacks[i * stack_size], stack_size,
+                                     priority, THREAD_CREATE_WOUT_YIELD,
+                                     &thread_pool::worker, this,
+                                     "riot_cpp_pool");
+    if (pid > KERNEL_PID_UNDEF) {
+      ++m_running;
+    }
+    irq_restore(state);
+    if (pid <= KERNEL_PID_UNDEF) {
+      shutdown();
+      throw system_error(make_error_code(errc::resource_unavailable_try_again),
+                         "Failed to create worker thread.");
+    }
+    ++m_workers;
+  }
+}
+
+thread_pool::~thread_pool() { shutdown(); }
+
+void thread_pool::shutdown() noexcept {
+  {
+    lock_guard<mutex> lk(m_mtx);
+    m_stop = true;
+  }
+  m_not_empty.notify_all();
+
+  /* the stacks must not go away before the workers switched away from them,
+   * so the last worker wakes us from within sched_task_exit() */
+  unsigned state = irq_disable();
+  while (m_running > 0) {
+    m_joining_thread = sched_active_pid;
+    sched_set_status((thread_t*)sched_active_thread, STATUS_SLEEPING);
+    irq_restore(state);
+    thread_yield_higher();
+    state = irq_disable();
+  }
+  irq_restore(state);
+}
+
+void thread_pool::push(detail::task&& t) {
+  {
+    unique_lock<mutex> lk(m_mtx);
+    while (m_count == m_capacity && !m_stop) {
+      m_not_full.wait(lk);
+    }
+    if (m_stop) {
+      throw system_error(make_error_code(errc::operation_not_permitted),
+                         "Thread pool is shutting down.");
+    }
+    unsigned tail = m_head + m_count;
+    if (tail >= m_capacity) {
+      tail -= m_capacity;
+    }
+    m_queue[tail] = move(t);
+    ++m_count;
+  }
+  m_not_empty.notify_one();
+}
+
+bool thread_pool::pop(detail::task& t) {
+  {
+    unique_lock<mutex> lk(m_mtx);
+    while (m_count == 0 && !m_stop) {
+      m_not_empty.wait(lk);
+    }
+    if (m_count == 0) {
+      return false;
+    }
+    t = move(m_queue[m_head]);
+    if (++m_head == m_capacity) {
+      m_head = 0;
+    }
+    --m_count;
+  }
+  m_not_full.notify_one();
+  return true;
+}
+
+void* thread_pool::worker(void* arg) {
+  auto pool = static_cast<thread_pool*>(arg);
+  {
+    detail::task t;
+    while (pool->pop(t)) {
+      try {
+        t();
+      }
+      catch (...) {
+        // nop
+      }
+      t.reset();
+    }
+  }
+
+  irq_disable();
+  if (--pool->m_running == 0
+      && pool->m_joining_thread != KERNEL_PID_UNDEF) {
+    thread_t* other = (thread_t*)thread_get(pool->m_joining_thread);
+    if (other && other->status == STATUS_SLEEPING) {
+      sched_set_status(other, STATUS_PENDING);
+    }
+  }
+  sched_task_exit();
+  return nullptr;
+}
+
+} // namespace riot
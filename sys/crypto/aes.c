@@ -36,6 +36,7 @@
 #include <stdint.h>
 #include "crypto/aes.h"
 #include "crypto/ciphers.h"
+#include "aes_backend.h"
 
 /**
  * Interface to the aes cipher
@@ -45,10 +46,39 @@ static const cipher_interface_t aes_interface = {
     AES_KEY_SIZE,
     aes_init,
     aes_encrypt,
-    aes_decrypt
+    aes_decrypt,
+    aes_encrypt_blocks,
+    aes_decrypt_blocks
 };
 const cipher_id_t CIPHER_AES_128 = &aes_interface;
 
+int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize)
+{
+    uint8_t i;
+
+    // Make sure that context is large enough. If this is not the case,
+    // you should build with -DAES
+    if(CIPHER_MAX_CONTEXT_SIZE < AES_KEY_SIZE) {
+        return 0;
+    }
+
+    //key must be at least CIPHERS_MAX_KEY_SIZE Bytes long
+    if (keySize < CIPHERS_MAX_KEY_SIZE) {
+        //fill up by concatenating key to as long as needed
+        for (i = 0; i < CIPHERS_MAX_KEY_SIZE; i++) {
+            context->context[i] = key[(i % keySize)];
+        }
+    }
+    else {
+        for (i = 0; i < CIPHERS_MAX_KEY_SIZE; i++) {
+            context->context[i] = key[i];
+        }
+    }
+
+    return 1;
+}
+
+#if AES_USE_TTABLE
 static const u32 Te0[256] = {
     0xc66363a5U, 0xf87c7c84U, 0xee777799U, 0xf67b7b8dU,
     0xfff2f20dU, 0xd66b6bbdU, 0xde6f6fb1U, 0x91c5c554U,
@@ -720,32 +750,6 @@ static const u32 rcon[] = {
 };
 
 
-int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize)
-{
-    uint8_t i;
-
-    // Make sure that context is large enough. If this is not the case,
-    // you should build with -DAES
-    if(CIPHER_MAX_CONTEXT_SIZE < AES_KEY_SIZE) {
-        return 0;
-    }
-
-    //key must be at least CIPHERS_MAX_KEY_SIZE Bytes long
-    if (keySize < CIPHERS_MAX_KEY_SIZE) {
-        //fill up by concatenating key to as long as needed
-        for (i = 0; i < CIPHERS_MAX_KEY_SIZE; i++) {
-            context->context[i] = key[(i % keySize)];
-        }
-    }
-    else {
-        for (i = 0; i < CIPHERS_MAX_KEY_SIZE; i++) {
-            context->context[i] = key[i];
-        }
-    }
-
-    return 1;
-}
-
 /**
  * Expand the cipher key into the encryption key schedule.
  */
@@ -931,24 +935,13 @@ static int aes_set_decrypt_key(const unsigned char *userKey, const int bits,
     return 0;
 }
 
-#ifndef AES_ASM
 /*
- * Encrypt a single block
+ * Encrypt a single block with an already expanded key schedule
  * in and out can overlap
  */
-int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
-                uint8_t *cipherBlock)
+static void _encrypt_block(const AES_KEY *key, const uint8_t *plainBlock,
+                           uint8_t *cipherBlock)
 {
-    //setup AES_KEY
-    int res;
-    AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-    res = aes_set_encrypt_key((unsigned char *)context->context,
-                                   AES_KEY_SIZE * 8, &aeskey);
-    if (res < 0) {
-        return res;
-    }
-
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef FULL_UNROLL
@@ -1188,27 +1181,15 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
         (Te4[(t2) & 0xff]       & 0x000000ff) ^
         rk[3];
     PUTU32(cipherBlock + 12, s3);
-    return 1;
 }
 
 /*
- * Decrypt a single block
+ * Decrypt a single block with an already expanded key schedule
  * in and out can overlap
  */
-int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
-                uint8_t *plainBlock)
+static void _decrypt_block(const AES_KEY *key, const uint8_t *cipherBlock,
+                           uint8_t *plainBlock)
 {
-    //setup AES_KEY
-    int res;
-    AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
-    res = aes_set_decrypt_key((unsigned char *)context->context,
-                              AES_KEY_SIZE * 8, &aeskey);
-
-    if (res < 0) {
-        return res;
-    }
-
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 #ifndef FULL_UNROLL
@@ -1448,7 +1429,78 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
         (Td4[(t0) & 0xff]       & 0x000000ff) ^
         rk[3];
     PUTU32(plainBlock + 12, s3);
+}
+
+#endif /* AES_USE_TTABLE */
+
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *plain,
+                       uint8_t *cipher, size_t nblocks)
+{
+#if AES_USE_NI
+    return aes_ni_encrypt_blocks(context->context, plain, cipher, nblocks);
+#elif AES_USE_CT
+    return aes_ct_encrypt_blocks(context->context, plain, cipher, nblocks);
+#else
+    /* the key schedule is expanded only once for all blocks */
+    AES_KEY aeskey;
+    int res = aes_set_encrypt_key(context->context, AES_KEY_SIZE * 8, &aeskey);
+
+    if (res < 0) {
+        return res;
+    }
+
+    for (size_t i = 0; i < nblocks; i++) {
+        _encrypt_block(&aeskey, plain, cipher);
+        plain += AES_BLOCK_SIZE;
+        cipher += AES_BLOCK_SIZE;
+    }
+
+    return 1;
+#endif
+}
+
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *cipher,
+                       uint8_t *plain, size_t nblocks)
+{
+#if AES_USE_NI
+    return aes_ni_decrypt_blocks(context->context, cipher, plain, nblocks);
+#elif AES_USE_CT
+    return aes_ct_decrypt_blocks(context->context, cipher, plain, nblocks);
+#else
+    AES_KEY aeskey;
+    int res = aes_set_decrypt_key(context->context, AES_KEY_SIZE * 8, &aeskey);
+
+    if (res < 0) {
+        return res;
+    }
+
+    for (size_t i = 0; i < nblocks; i++) {
+        _decrypt_block(&aeskey, cipher, plain);
+        cipher += AES_BLOCK_SIZE;
+        plain += AES_BLOCK_SIZE;
+    }
+
     return 1;
+#endif
+}
+
+/*
+ * Encrypt a single block
+ * in and out can overlap
+ */
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
+{
+    return aes_encrypt_blocks(context, plainBlock, cipherBlock, 1);
+}
+
+/*
+ * Decrypt a single block
+ * in and out can overlap
+ */
+int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                uint8_t *plainBlock)
+{
+    return aes_decrypt_blocks(context, cipherBlock, plainBlock, 1);
 }
 
-#endif /* AES_ASM */
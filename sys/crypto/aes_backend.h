@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Selection of the AES block function backend
+ *
+ * Three backends implement the multi-block AES functions:
+ *
+ * - AES-NI, used automatically when the compiler targets a x86 CPU with the
+ *   AES instruction set extension (e.g. `CFLAGS += -maes -msse2` on native)
+ * - a constant-time implementation with a bitsliced S-box, selected by
+ *   `USEMODULE += crypto_aes_ct`
+ * - the default T-table implementation in aes.c
+ *
+ * @}
+ */
+
+#ifndef AES_BACKEND_H
+#define AES_BACKEND_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__AES__) && defined(__SSE2__) && !defined(AES_NO_NI)
+#define AES_USE_NI      (1)
+#else
+#define AES_USE_NI      (0)
+#endif
+
+#if !AES_USE_NI && defined(MODULE_CRYPTO_AES_CT)
+#define AES_USE_CT      (1)
+#else
+#define AES_USE_CT      (0)
+#endif
+
+#define AES_USE_TTABLE  (!AES_USE_NI && !AES_USE_CT)
+
+/**
+ * @brief   Encrypt @p nblocks blocks using AES-NI
+ *
+ * @param[in]  key      AES_KEY_SIZE bytes of raw key
+ * @param[in]  in       input blocks
+ * @param[out] out      output blocks, may be equal to @p in
+ * @param[in]  nblocks  number of blocks
+ *
+ * @return  1
+ */
+int aes_ni_encrypt_blocks(const uint8_t *key, const uint8_t *in, uint8_t *out,
+                          size_t nblocks);
+
+/**
+ * @brief   Decrypt @p nblocks blocks using AES-NI
+ *
+ * @see aes_ni_encrypt_blocks()
+ */
+int aes_ni_decrypt_blocks(const uint8_t *key, const uint8_t *in, uint8_t *out,
+                          size_t nblocks);
+
+/**
+ * @brief   Encrypt @p nblocks blocks with the constant-time implementation
+ *
+ * @param[in]  key      AES_KEY_SIZE bytes of raw key
+ * @param[in]  in       input blocks
+ * @param[out] out      output blocks, may be equal to @p in
+ * @param[in]  nblocks  number of blocks
+ *
+ * @return  1
+ */
+int aes_ct_encrypt_blocks(const uint8_t *key, const uint8_t *in, uint8_t *out,
+                          size_t nblocks);
+
+/**
+ * @brief   Decrypt @p nblocks blocks with the constant-time implementation
+ *
+ * @see aes_ct_encrypt_blocks()
+ */
+int aes_ct_decrypt_blocks(const uint8_t *key, const uint8_t *in, uint8_t *out,
+                          size_t nblocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AES_BACKEND_H */
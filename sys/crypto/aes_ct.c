@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Constant-time AES-128 with a bitsliced S-box
+ *
+ * The T-table implementation leaks key dependent memory access patterns
+ * through the data cache. This implementation does not use any lookup
+ * tables: the S-box is computed as inversion in GF(2^8) followed by the
+ * affine transformation, evaluated on a bitsliced representation of two
+ * blocks at a time (bit b of all 32 state bytes lives in one 32 bit word).
+ * ShiftRows, MixColumns and AddRoundKey only use data independent
+ * operations on the byte representation.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "aes_backend.h"
+
+#if AES_USE_CT
+
+#define ROUNDS          (10)
+#define PAR_BLOCKS      (2)
+#define STATE_SIZE      (PAR_BLOCKS * AES_BLOCK_SIZE)
+
+static const uint8_t rcon[ROUNDS] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+};
+
+/* transpose an 8x8 bit matrix, row j is byte j of x */
+static inline uint64_t _transpose8(uint64_t x)
+{
+    uint64_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+/* bit b of byte j of the state is stored as bit j of q[b] */
+static void _pack(uint32_t q[8], const uint8_t *st)
+{
+    memset(q, 0, 8 * sizeof(uint32_t));
+    for (unsigned g = 0; g < STATE_SIZE / 8; g++) {
+        uint64_t x = 0;
+        for (unsigned j = 0; j < 8; j++) {
+            x |= (uint64_t)st[8 * g + j] << (8 * j);
+        }
+        x = _transpose8(x);
+        for (unsigned b = 0; b < 8; b++) {
+            q[b] |= (uint32_t)((x >> (8 * b)) & 0xff) << (8 * g);
+        }
+    }
+}
+
+static void _unpack(uint8_t *st, const uint32_t q[8])
+{
+    for (unsigned g = 0; g < STATE_SIZE / 8; g++) {
+        uint64_t x = 0;
+        for (unsigned b = 0; b < 8; b++) {
+            x |= (uint64_t)((q[b] >> (8 * g)) & 0xff) << (8 * b);
+        }
+        x = _transpose8(x);
+        for (unsigned j = 0; j < 8; j++) {
+            st[8 * g + j] = (uint8_t)(x >> (8 * j));
+        }
+    }
+}
+
+/* reduce a product of degree <= 14 modulo x^8 + x^4 + x^3 + x + 1 */
+static void _gf_reduce(uint32_t r[8], uint32_t p[15])
+{
+    for (int k = 14; k >= 8; k--) {
+        p[k - 4] ^= p[k];
+        p[k - 5] ^= p[k];
+        p[k - 7] ^= p[k];
+        p[k - 8] ^= p[k];
+    }
+    memcpy(r, p, 8 * sizeof(uint32_t));
+}
+
+static void _gf_mul(uint32_t r[8], const uint32_t a[8], const uint32_t b[8])
+{
+    uint32_t p[15] = { 0 };
+
+    for (unsigned i = 0; i < 8; i++) {
+        for (unsigned j = 0; j < 8; j++) {
+            p[i + j] ^= a[i] & b[j];
+        }
+    }
+    _gf_reduce(r, p);
+}
+
+static void _gf_sqr(uint32_t r[8], const uint32_t a[8])
+{
+    uint32_t p[15] = { 0 };
+
+    /* squaring is linear in GF(2^8) */
+    for (unsigned i = 0; i < 8; i++) {
+        p[2 * i] = a[i];
+    }
+    _gf_reduce(r, p);
+}
+
+/* a^-1 = a^254 (0 is mapped to 0) */
+static void _gf_inv(uint32_t q[8])
+{
+    uint32_t x2[8], x3[8], x12[8], x14[8], t[8];
+
+    _gf_sqr(x2, q);
+    _gf_mul(x3, x2, q);
+    _gf_sqr(t, x3);             /* x^6 */
+    _gf_sqr(x12, t);
+    _gf_mul(x14, x12, x2);
+    _gf_mul(t, x12, x3);        /* x^15 */
+    _gf_sqr(t, t);              /* x^30 */
+    _gf_sqr(t, t);              /* x^60 */
+    _gf_sqr(t, t);              /* x^120 */
+    _gf_sqr(t, t);              /* x^240 */
+    _gf_mul(q, t, x14);
+}
+
+static void _sub_bytes(uint8_t *st)
+{
+    uint32_t q[8], r[8];
+
+    _pack(q, st);
+    _gf_inv(q);
+    /* affine transformation with constant 0x63 */
+    for (unsigned i = 0; i < 8; i++) {
+        r[i] = q[i] ^ q[(i + 4) & 7] ^ q[(i + 5) & 7] ^ q[(i + 6) & 7] ^
+               q[(i + 7) & 7] ^ (0 - ((0x63U >> i) & 1));
+    }
+    _unpack(st, r);
+}
+
+static void _inv_sub_bytes(uint8_t *st)
+{
+    uint32_t q[8], r[8];
+
+    _pack(q, st);
+    /* inverse affine transformation with constant 0x05 */
+    for (unsigned i = 0; i < 8; i++) {
+        r[i] = q[(i + 2) & 7] ^ q[(i + 5) & 7] ^ q[(i + 7) & 7] ^
+               (0 - ((0x05U >> i) & 1));
+    }
+    _gf_inv(r);
+    _unpack(st, r);
+}
+
+static inline uint8_t _xtime(uint8_t a)
+{
+    return (uint8_t)((a << 1) ^ (0x1b & (0 - (a >> 7))));
+}
+
+static void _shift_rows(uint8_t *s)
+{
+    uint8_t t[AES_BLOCK_SIZE];
+
+    for (unsigned c = 0; c < 4; c++) {
+        for (unsigned r = 0; r < 4; r++) {
+            t[r + 4 * c] = s[r + 4 * ((c + r) & 3)];
+        }
+    }
+    memcpy(s, t, AES_BLOCK_SIZE);
+}
+
+static void _inv_shift_rows(uint8_t *s)
+{
+    uint8_t t[AES_BLOCK_SIZE];
+
+    for (unsigned c = 0; c < 4; c++) {
+        for (unsigned r = 0; r < 4; r++) {
+            t[r + 4 * ((c + r) & 3)] = s[r + 4 * c];
+        }
+    }
+    memcpy(s, t, AES_BLOCK_SIZE);
+}
+
+static void _mix_columns(uint8_t *s)
+{
+    for (unsigned c = 0; c < 4; c++) {
+        uint8_t *a = &s[4 * c];
+        uint8_t t = a[0] ^ a[1] ^ a[2] ^ a[3];
+        uint8_t a0 = a[0];
+
+        a[0] ^= t ^ _xtime(a[0] ^ a[1]);
+        a[1] ^= t ^ _xtime(a[1] ^ a[2]);
+        a[2] ^= t ^ _xtime(a[2] ^ a[3]);
+        a[3] ^= t ^ _xtime(a[3] ^ a0);
+    }
+}
+
+static void _inv_mix_columns(uint8_t *s)
+{
+    for (unsigned c = 0; c < 4; c++) {
+        uint8_t *a = &s[4 * c];
+        uint8_t u = _xtime(_xtime(a[0] ^ a[2]));
+        uint8_t v = _xtime(_xtime(a[1] ^ a[3]));
+
+        a[0] ^= u;
+        a[1] ^= v;
+        a[2] ^= u;
+        a[3] ^= v;
+    }
+    _mix_columns(s);
+}
+
+static void _add_round_key(uint8_t *st, const uint8_t *rk)
+{
+    for (unsigned i = 0; i < STATE_SIZE; i++) {
+        st[i] ^= rk[i % AES_BLOCK_SIZE];
+    }
+}
+
+static void _expand_key(uint8_t rk[AES_BLOCK_SIZE * (ROUNDS + 1)],
+                        const uint8_t *key)
+{
+    memcpy(rk, key, AES_KEY_SIZE);
+    for (unsigned r = 1; r <= ROUNDS; r++) {
+        uint8_t *prev = &rk[AES_BLOCK_SIZE * (r - 1)];
+        uint8_t *cur = &rk[AES_BLOCK_SIZE * r];
+        uint8_t t[STATE_SIZE] = { 0 };
+
+        /* RotWord followed by SubWord */
+        t[0] = prev[13];
+        t[1] = prev[14];
+        t[2] = prev[15];
+        t[3] = prev[12];
+        _sub_bytes(t);
+        t[0] ^= rcon[r - 1];
+
+        for (unsigned i = 0; i < AES_BLOCK_SIZE; i++) {
+            cur[i] = prev[i] ^ ((i < 4) ? t[i] : cur[i - 4]);
+        }
+    }
+}
+
+int aes_ct_encrypt_blocks(const uint8_t *key, const uint8_t *in, uint8_t *out,
+                          size_t nblocks)
+{
+    uint8_t rk[AES_BLOCK_SIZE * (ROUNDS + 1)];
+
+    _expand_key(rk, key);
+
+    while (nblocks) {
+        uint8_t st[STATE_SIZE] = { 0 };
+        size_t n = (nblocks < PAR_BLOCKS) ? nblocks : PAR_BLOCKS;
+
+        memcpy(st, in, n * AES_BLOCK_SIZE);
+        _add_round_key(st, rk);
+        for (unsigned r = 1; r <= ROUNDS; r++) {
+            _sub_bytes(st);
+            for (unsigned b = 0; b < PAR_BLOCKS; b++) {
+                _shift_rows(&st[b * AES_BLOCK_SIZE]);
+                if (r != ROUNDS) {
+                    _mix_columns(&st[b * AES_BLOCK_SIZE]);
+                }
+            }
+            _add_round_key(st, &rk[r * AES_BLOCK_SIZE]);
+        }
+        memcpy(out, st, n * AES_BLOCK_SIZE);
+
+        in += n * AES_BLOCK_SIZE;
+        out += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+
+    return 1;
+}
+
+int aes_ct_decrypt_blocks(const uint8_t *key, const uint8_t *in, uint8_t *out,
+                          size_t nblocks)
+{
+    uint8_t rk[AES_BLOCK_SIZE * (ROUNDS + 1)];
+
+    _expand_key(rk, key);
+
+    while (nblocks) {
+        uint8_t st[STATE_SIZE] = { 0 };
+        size_t n = (nblocks < PAR_BLOCKS) ? nblocks : PAR_BLOCKS;
+
+        memcpy(st, in, n * AES_BLOCK_SIZE);
+        _add_round_key(st, &rk[ROUNDS * AES_BLOCK_SIZE]);
+        for (unsigned r = ROUNDS; r > 0; r--) {
+            for (unsigned b = 0; b < PAR_BLOCKS; b++) {
+                _inv_shift_rows(&st[b * AES_BLOCK_SIZE]);
+            }
+            _inv_sub_bytes(st);
+            _add_round_key(st, &rk[(r - 1) * AES_BLOCK_SIZE]);
+            if (r != 1) {
+                for (unsigned b = 0; b < PAR_BLOCKS; b++) {
+                    _inv_mix_columns(&st[b * AES_BLOCK_SIZE]);
+                }
+            }
+        }
+        memcpy(out, st, n * AES_BLOCK_SIZE);
+
+        in += n * AES_BLOCK_SIZE;
+        out += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+
+    return 1;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* AES_USE_CT */
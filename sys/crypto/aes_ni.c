@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       AES-128 using the x86 AES-NI instructions
+ *
+ * Used on native when building with `CFLAGS += -maes -msse2` on a host that
+ * supports AES-NI. Four blocks are processed interleaved to hide the latency
+ * of the AESENC/AESDEC instructions.
+ *
+ * @}
+ */
+
+#include "crypto/aes.h"
+#include "aes_backend.h"
+
+#if AES_USE_NI
+
+#include <wmmintrin.h>
+
+#define ROUNDS          (10)
+
+static inline __m128i _expand_step(__m128i key, __m128i gen)
+{
+    gen = _mm_shuffle_epi32(gen, 0xff);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, gen);
+}
+
+#define EXPAND(k, rcon) _expand_step(k, _mm_aeskeygenassist_si128(k, rcon))
+
+static void _expand_key(__m128i rk[ROUNDS + 1], const uint8_t *key)
+{
+    rk[0] = _mm_loadu_si128((const __m128i *)key);
+    rk[1] = EXPAND(rk[0], 0x01);
+    rk[2] = EXPAND(rk[1], 0x02);
+    rk[3] = EXPAND(rk[2], 0x04);
+    rk[4] = EXPAND(rk[3], 0x08);
+    rk[5] = EXPAND(rk[4], 0x10);
+    rk[6] = EXPAND(rk[5], 0x20);
+    rk[7] = EXPAND(rk[6], 0x40);
+    rk[8] = EXPAND(rk[7], 0x80);
+    rk[9] = EXPAND(rk[8], 0x1b);
+    rk[10] = EXPAND(rk[9], 0x36);
+}
+
+int aes_ni_encrypt_blocks(const uint8_t *key, const uint8_t *in, uint8_t *out,
+                          size_t nblocks)
+{
+    __m128i rk[ROUNDS + 1];
+    const __m128i *src = (const __m128i *)in;
+    __m128i *dst = (__m128i *)out;
+
+    _expand_key(rk, key);
+
+    for (; nblocks >= 4; nblocks -= 4, src += 4, dst += 4) {
+        __m128i b0 = _mm_xor_si128(_mm_loadu_si128(src), rk[0]);
+        __m128i b1 = _mm_xor_si128(_mm_loadu_si128(src + 1), rk[0]);
+        __m128i b2 = _mm_xor_si128(_mm_loadu_si128(src + 2), rk[0]);
+        __m128i b3 = _mm_xor_si128(_mm_loadu_si128(src + 3), rk[0]);
+        for (unsigned r = 1; r < ROUNDS; r++) {
+            b0 = _mm_aesenc_si128(b0, rk[r]);
+            b1 = _mm_aesenc_si128(b1, rk[r]);
+            b2 = _mm_aesenc_si128(b2, rk[r]);
+            b3 = _mm_aesenc_si128(b3, rk[r]);
+        }
+        _mm_storeu_si128(dst, _mm_aesenclast_si128(b0, rk[ROUNDS]));
+        _mm_storeu_si128(dst + 1, _mm_aesenclast_si128(b1, rk[ROUNDS]));
+        _mm_storeu_si128(dst + 2, _mm_aesenclast_si128(b2, rk[ROUNDS]));
+        _mm_storeu_si128(dst + 3, _mm_aesenclast_si128(b3, rk[ROUNDS]));
+    }
+
+    for (; nblocks; nblocks--, src++, dst++) {
+        __m128i b = _mm_xor_si128(_mm_loadu_si128(src), rk[0]);
+        for (unsigned r = 1; r < ROUNDS; r++) {
+            b = _mm_aesenc_si128(b, rk[r]);
+        }
+        _mm_storeu_si128(dst, _mm_aesenclast_si128(b, rk[ROUNDS]));
+    }
+
+    return 1;
+}
+
+int aes_ni_decrypt_blocks(const uint8_t *key, const uint8_t *in, uint8_t *out,
+                          size_t nblocks)
+{
+    __m128i rk[ROUNDS + 1], dk[ROUNDS + 1];
+    const __m128i *src = (const __m128i *)in;
+    __m128i *dst = (__m128i *)out;
+
+    /* equivalent inverse cipher: reversed schedule with InvMixColumns */
+    _expand_key(rk, key);
+    dk[0] = rk[ROUNDS];
+    for (unsigned r = 1; r < ROUNDS; r++) {
+        dk[r] = _mm_aesimc_si128(rk[ROUNDS - r]);
+    }
+    dk[ROUNDS] = rk[0];
+
+    for (; nblocks >= 4; nblocks -= 4, src += 4, dst += 4) {
+        __m128i b0 = _mm_xor_si128(_mm_loadu_si128(src), dk[0]);
+        __m128i b1 = _mm_xor_si128(_mm_loadu_si128(src + 1), dk[0]);
+        __m128i b2 = _mm_xor_si128(_mm_loadu_si128(src + 2), dk[0]);
+        __m128i b3 = _mm_xor_si128(_mm_loadu_si128(src + 3), dk[0]);
+        for (unsigned r = 1; r < ROUNDS; r++) {
+            b0 = _mm_aesdec_si128(b0, dk[r]);
+            b1 = _mm_aesdec_si128(b1, dk[r]);
+            b2 = _mm_aesdec_si128(b2, dk[r]);
+            b3 = _mm_aesdec_si128(b3, dk[r]);
+        }
+        _mm_storeu_si128(dst, _mm_aesdeclast_si128(b0, dk[ROUNDS]));
+        _mm_storeu_si128(dst + 1, _mm_aesdeclast_si128(b1, dk[ROUNDS]));
+        _mm_storeu_si128(dst + 2, _mm_aesdeclast_si128(b2, dk[ROUNDS]));
+        _mm_storeu_si128(dst + 3, _mm_aesdeclast_si128(b3, dk[ROUNDS]));
+    }
+
+    for (; nblocks; nblocks--, src++, dst++) {
+        __m128i b = _mm_xor_si128(_mm_loadu_si128(src), dk[0]);
+        for (unsigned r = 1; r < ROUNDS; r++) {
+            b = _mm_aesdec_si128(b, dk[r]);
+        }
+        _mm_storeu_si128(dst, _mm_aesdeclast_si128(b, dk[ROUNDS]));
+    }
+
+    return 1;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* AES_USE_NI */
@@ -25,9 +25,9 @@
  * Please notice:
  *  - This implementation of the ChaCha stream cipher is very stripped down.
  *  - It assumes a little-endian system.
- *  - It is implemented for little code and data size, but will likely be
- *    slower than the refenrence implementation. Optimized implementation will
- *    out-perform the code even more.
+ *  - Several blocks are generated in parallel on SSE2 (4 blocks) and AVX2
+ *    (8 blocks) capable x86 targets. Other targets use a scalar block
+ *    function that keeps the whole state in local variables.
  */
 
 #include "crypto/chacha.h"
@@ -39,35 +39,194 @@
 
 #include <string.h>
 
-static void _r(uint32_t *d, uint32_t *a, const uint32_t *b, unsigned c)
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define QR(a, b, c, d) \
+    do { \
+        a += b; d ^= a; d = ROTL(d, 16); \
+        c += d; b ^= c; b = ROTL(b, 12); \
+        a += b; d ^= a; d = ROTL(d,  8); \
+        c += d; b ^= c; b = ROTL(b,  7); \
+    } while (0)
+
+static void _block(uint8_t *output, const uint32_t input[16], unsigned rounds)
 {
-    *a += *b;
-    uint32_t tmp = *a ^ *d;
-    *d = (tmp << c) | (tmp >> (32 - c));
+    uint32_t x0 = input[0], x1 = input[1], x2 = input[2], x3 = input[3];
+    uint32_t x4 = input[4], x5 = input[5], x6 = input[6], x7 = input[7];
+    uint32_t x8 = input[8], x9 = input[9], x10 = input[10], x11 = input[11];
+    uint32_t x12 = input[12], x13 = input[13], x14 = input[14], x15 = input[15];
+
+    for (unsigned i = 0; i < rounds; i += 2) {
+        /* column round */
+        QR(x0, x4, x8, x12);
+        QR(x1, x5, x9, x13);
+        QR(x2, x6, x10, x14);
+        QR(x3, x7, x11, x15);
+        /* diagonal round */
+        QR(x0, x5, x10, x15);
+        QR(x1, x6, x11, x12);
+        QR(x2, x7, x8, x13);
+        QR(x3, x4, x9, x14);
+    }
+
+    uint32_t out[16] = {
+        x0 + input[0], x1 + input[1], x2 + input[2], x3 + input[3],
+        x4 + input[4], x5 + input[5], x6 + input[6], x7 + input[7],
+        x8 + input[8], x9 + input[9], x10 + input[10], x11 + input[11],
+        x12 + input[12], x13 + input[13], x14 + input[14], x15 + input[15],
+    };
+    memcpy(output, out, 64);
+}
+
+#if defined(__SSE2__)
+/* block counters of @p lanes consecutive blocks, including the carry */
+static void _lane_counters(const uint32_t input[16], unsigned lanes,
+                           uint32_t lo[], uint32_t hi[])
+{
+    for (unsigned l = 0; l < lanes; l++) {
+        lo[l] = input[12] + l;
+        hi[l] = input[13] + (lo[l] < input[12]);
+    }
 }
 
-static void _doubleround(void *output_, const uint32_t input[16], uint8_t rounds)
+#define ROTL_4(x, n) \
+    _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - (n)))
+
+#define QR_4(a, b, c, d) \
+    do { \
+        a = _mm_add_epi32(a, b); d = ROTL_4(_mm_xor_si128(d, a), 16); \
+        c = _mm_add_epi32(c, d); b = ROTL_4(_mm_xor_si128(b, c), 12); \
+        a = _mm_add_epi32(a, b); d = ROTL_4(_mm_xor_si128(d, a),  8); \
+        c = _mm_add_epi32(c, d); b = ROTL_4(_mm_xor_si128(b, c),  7); \
+    } while (0)
+
+/* four blocks at once, lane l of x[i] holds word i of block l */
+static void _blocks_4(uint8_t *output, const uint32_t input[16], unsigned rounds)
+{
+    __m128i x[16], in[16];
+    uint32_t lo[4], hi[4];
+
+    _lane_counters(input, 4, lo, hi);
+    for (unsigned i = 0; i < 16; i++) {
+        in[i] = _mm_set1_epi32(input[i]);
+    }
+    in[12] = _mm_set_epi32(lo[3], lo[2], lo[1], lo[0]);
+    in[13] = _mm_set_epi32(hi[3], hi[2], hi[1], hi[0]);
+    memcpy(x, in, sizeof(x));
+
+    for (unsigned i = 0; i < rounds; i += 2) {
+        QR_4(x[0], x[4], x[8], x[12]);
+        QR_4(x[1], x[5], x[9], x[13]);
+        QR_4(x[2], x[6], x[10], x[14]);
+        QR_4(x[3], x[7], x[11], x[15]);
+        QR_4(x[0], x[5], x[10], x[15]);
+        QR_4(x[1], x[6], x[11], x[12]);
+        QR_4(x[2], x[7], x[8], x[13]);
+        QR_4(x[3], x[4], x[9], x[14]);
+    }
+
+    /* transpose 4x4 word groups back into block order */
+    for (unsigned w = 0; w < 16; w += 4) {
+        __m128i a = _mm_add_epi32(x[w], in[w]);
+        __m128i b = _mm_add_epi32(x[w + 1], in[w + 1]);
+        __m128i c = _mm_add_epi32(x[w + 2], in[w + 2]);
+        __m128i d = _mm_add_epi32(x[w + 3], in[w + 3]);
+        __m128i t0 = _mm_unpacklo_epi32(a, b);
+        __m128i t1 = _mm_unpacklo_epi32(c, d);
+        __m128i t2 = _mm_unpackhi_epi32(a, b);
+        __m128i t3 = _mm_unpackhi_epi32(c, d);
+        uint8_t *out = output + 4 * w;
+
+        _mm_storeu_si128((__m128i *)(out + 0 * 64), _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128((__m128i *)(out + 1 * 64), _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128((__m128i *)(out + 2 * 64), _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128((__m128i *)(out + 3 * 64), _mm_unpackhi_epi64(t2, t3));
+    }
+}
+#endif /* __SSE2__ */
+
+#if defined(__AVX2__)
+#define ROTL_8(x, n) \
+    _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+#define QR_8(a, b, c, d) \
+    do { \
+        a = _mm256_add_epi32(a, b); d = ROTL_8(_mm256_xor_si256(d, a), 16); \
+        c = _mm256_add_epi32(c, d); b = ROTL_8(_mm256_xor_si256(b, c), 12); \
+        a = _mm256_add_epi32(a, b); d = ROTL_8(_mm256_xor_si256(d, a),  8); \
+        c = _mm256_add_epi32(c, d); b = ROTL_8(_mm256_xor_si256(b, c),  7); \
+    } while (0)
+
+/* eight blocks at once, lane l of x[i] holds word i of block l */
+static void _blocks_8(uint8_t *output, const uint32_t input[16], unsigned rounds)
 {
-    uint32_t *output = (uint32_t *) output_;
-    memcpy(output, input, 64);
+    __m256i x[16], in[16];
+    uint32_t lo[8], hi[8];
 
-    rounds *= 4;
-    for (unsigned i = 0; i < rounds; ++i) {
-        uint32_t *a = &output[((i + ((i & 4) ? 0 : 0)) & 3) + (4 * 0)];
-        uint32_t *b = &output[((i + ((i & 4) ? 1 : 0)) & 3) + (4 * 1)];
-        uint32_t *c = &output[((i + ((i & 4) ? 2 : 0)) & 3) + (4 * 2)];
-        uint32_t *d = &output[((i + ((i & 4) ? 3 : 0)) & 3) + (4 * 3)];
+    _lane_counters(input, 8, lo, hi);
+    for (unsigned i = 0; i < 16; i++) {
+        in[i] = _mm256_set1_epi32(input[i]);
+    }
+    in[12] = _mm256_set_epi32(lo[7], lo[6], lo[5], lo[4],
+                              lo[3], lo[2], lo[1], lo[0]);
+    in[13] = _mm256_set_epi32(hi[7], hi[6], hi[5], hi[4],
+                              hi[3], hi[2], hi[1], hi[0]);
+    memcpy(x, in, sizeof(x));
 
-        _r(d, a, b, 16);
-        _r(b, c, d, 12);
-        _r(d, a, b,  8);
-        _r(b, c, d,  7);
+    for (unsigned i = 0; i < rounds; i += 2) {
+        QR_8(x[0], x[4], x[8], x[12]);
+        QR_8(x[1], x[5], x[9], x[13]);
+        QR_8(x[2], x[6], x[10], x[14]);
+        QR_8(x[3], x[7], x[11], x[15]);
+        QR_8(x[0], x[5], x[10], x[15]);
+        QR_8(x[1], x[6], x[11], x[12]);
+        QR_8(x[2], x[7], x[8], x[13]);
+        QR_8(x[3], x[4], x[9], x[14]);
     }
 
-    for (unsigned i = 0; i < 16; ++i) {
-        output[i] += input[i];
+    /* the unpack instructions work per 128 bit half, so the low half
+     * yields blocks 0-3 and the high half blocks 4-7 */
+    for (unsigned w = 0; w < 16; w += 4) {
+        __m256i a = _mm256_add_epi32(x[w], in[w]);
+        __m256i b = _mm256_add_epi32(x[w + 1], in[w + 1]);
+        __m256i c = _mm256_add_epi32(x[w + 2], in[w + 2]);
+        __m256i d = _mm256_add_epi32(x[w + 3], in[w + 3]);
+        __m256i t0 = _mm256_unpacklo_epi32(a, b);
+        __m256i t1 = _mm256_unpacklo_epi32(c, d);
+        __m256i t2 = _mm256_unpackhi_epi32(a, b);
+        __m256i t3 = _mm256_unpackhi_epi32(c, d);
+        __m256i r[4] = {
+            _mm256_unpacklo_epi64(t0, t1), _mm256_unpackhi_epi64(t0, t1),
+            _mm256_unpacklo_epi64(t2, t3), _mm256_unpackhi_epi64(t2, t3),
+        };
+        uint8_t *out = output + 4 * w;
+
+        for (unsigned k = 0; k < 4; k++) {
+            _mm_storeu_si128((__m128i *)(out + k * 64),
+                             _mm256_castsi256_si128(r[k]));
+            _mm_storeu_si128((__m128i *)(out + (k + 4) * 64),
+                             _mm256_extracti128_si256(r[k], 1));
+        }
     }
 }
+#endif /* __AVX2__ */
+
+static inline void _inc_counter(chacha_ctx *ctx, uint32_t blocks)
+{
+    uint32_t lo = ctx->state[12] + blocks;
+
+    if (lo < ctx->state[12]) {
+        ++ctx->state[13];
+    }
+    ctx->state[12] = lo;
+}
 
 int chacha_init(chacha_ctx *ctx,
                 unsigned rounds,
@@ -100,21 +259,57 @@ int chacha_init(chacha_ctx *ctx,
     return 0;
 }
 
+void chacha_keystream_blocks(chacha_ctx *ctx, void *x, size_t nblocks)
+{
+    uint8_t *out = x;
+
+#if defined(__AVX2__)
+    for (; nblocks >= 8; nblocks -= 8, out += 8 * 64) {
+        _blocks_8(out, ctx->state, ctx->rounds);
+        _inc_counter(ctx, 8);
+    }
+#endif
+#if defined(__SSE2__)
+    for (; nblocks >= 4; nblocks -= 4, out += 4 * 64) {
+        _blocks_4(out, ctx->state, ctx->rounds);
+        _inc_counter(ctx, 4);
+    }
+#endif
+    for (; nblocks; nblocks--, out += 64) {
+        _block(out, ctx->state, ctx->rounds);
+        _inc_counter(ctx, 1);
+    }
+}
+
 void chacha_keystream_bytes(chacha_ctx *ctx, void *x)
 {
-    _doubleround(x, ctx->state, ctx->rounds);
+    chacha_keystream_blocks(ctx, x, 1);
+}
+
+void chacha_encrypt_bytes_n(chacha_ctx *ctx, const uint8_t *m, uint8_t *c,
+                            size_t len)
+{
+    uint8_t x[CHACHA_PAR_BLOCKS * 64];
 
-    ++ctx->state[12];
-    if (ctx->state[12] == 0) {
-        ++ctx->state[13];
+    while (len) {
+        size_t nblocks = (len + 63) / 64;
+        if (nblocks > CHACHA_PAR_BLOCKS) {
+            nblocks = CHACHA_PAR_BLOCKS;
+        }
+
+        chacha_keystream_blocks(ctx, x, nblocks);
+
+        size_t n = (len < nblocks * 64) ? len : nblocks * 64;
+        for (size_t i = 0; i < n; ++i) {
+            c[i] = m[i] ^ x[i];
+        }
+        m += n;
+        c += n;
+        len -= n;
     }
 }
 
 void chacha_encrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8_t *c)
 {
-    uint8_t x[64];
-    chacha_keystream_bytes(ctx, x);
-    for (unsigned i = 0 ; i < 64; ++i) {
-        c[i] = m[i] ^ x[i];
-    }
+    chacha_encrypt_bytes_n(ctx, m, c, 64);
 }
@@ -35,30 +35,76 @@ static chacha_ctx _chacha_prng_ctx = {
     .state = { RIOT_CHACHA_PRNG_DEFAULT },
     .rounds = 8,
 };
-static uint32_t _chacha_prng_data[64];
-static signed _chacha_prng_pos = 0;
+#define PRNG_BUF_SIZE (CHACHA_PRNG_BLOCKS * 64)
+
+static uint32_t _chacha_prng_data[PRNG_BUF_SIZE / sizeof(uint32_t)];
+/* number of bytes already handed out from _chacha_prng_data */
+static size_t _chacha_prng_pos = PRNG_BUF_SIZE;
 static mutex_t _chacha_prng_mutex = MUTEX_INIT;
 
+static void _refill(void)
+{
+    chacha_keystream_blocks(&_chacha_prng_ctx, _chacha_prng_data,
+                            CHACHA_PRNG_BLOCKS);
+    _chacha_prng_pos = 0;
+}
+
 void chacha_prng_seed(const void *data, size_t bytes)
 {
     mutex_lock(&_chacha_prng_mutex);
 
     memcpy(_chacha_prng_ctx.state, data, bytes);
-    _chacha_prng_pos = 0;
+    /* discard output of the old state */
+    _chacha_prng_pos = PRNG_BUF_SIZE;
 
     mutex_unlock(&_chacha_prng_mutex);
 }
 
 uint32_t chacha_prng_next(void)
 {
+    uint32_t result;
+
     mutex_lock(&_chacha_prng_mutex);
 
-    if (--_chacha_prng_pos < 0) {
-        _chacha_prng_pos = 15;
-        chacha_keystream_bytes(&_chacha_prng_ctx, _chacha_prng_data);
+    if (_chacha_prng_pos + sizeof(result) > PRNG_BUF_SIZE) {
+        _refill();
     }
-    uint32_t result = _chacha_prng_data[_chacha_prng_pos];
+    memcpy(&result, (uint8_t *)_chacha_prng_data + _chacha_prng_pos,
+           sizeof(result));
+    _chacha_prng_pos += sizeof(result);
 
     mutex_unlock(&_chacha_prng_mutex);
     return result;
 }
+
+void chacha_prng_bytes(void *buf, size_t len)
+{
+    uint8_t *out = buf;
+
+    mutex_lock(&_chacha_prng_mutex);
+
+    while (len) {
+        size_t avail = PRNG_BUF_SIZE - _chacha_prng_pos;
+
+        if (avail == 0 && len >= 64) {
+            /* bypass the buffer for whole blocks */
+            size_t nblocks = len / 64;
+            chacha_keystream_blocks(&_chacha_prng_ctx, out, nblocks);
+            out += nblocks * 64;
+            len -= nblocks * 64;
+            continue;
+        }
+        if (avail == 0) {
+            _refill();
+            avail = PRNG_BUF_SIZE;
+        }
+
+        size_t n = (len < avail) ? len : avail;
+        memcpy(out, (uint8_t *)_chacha_prng_data + _chacha_prng_pos, n);
+        _chacha_prng_pos += n;
+        out += n;
+        len -= n;
+    }
+
+    mutex_unlock(&_chacha_prng_mutex);
+}
@@ -44,6 +44,50 @@ int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 }
 
 
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t nblocks)
+{
+    const cipher_interface_t *iface = cipher->interface;
+
+    if (iface->encrypt_blocks) {
+        return iface->encrypt_blocks(&cipher->context, input, output, nblocks);
+    }
+
+    for (size_t i = 0; i < nblocks; i++) {
+        size_t offset = i * iface->block_size;
+        int res = iface->encrypt(&cipher->context, input + offset,
+                                 output + offset);
+        if (res != 1) {
+            return res;
+        }
+    }
+
+    return 1;
+}
+
+
+int cipher_decrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t nblocks)
+{
+    const cipher_interface_t *iface = cipher->interface;
+
+    if (iface->decrypt_blocks) {
+        return iface->decrypt_blocks(&cipher->context, input, output, nblocks);
+    }
+
+    for (size_t i = 0; i < nblocks; i++) {
+        size_t offset = i * iface->block_size;
+        int res = iface->decrypt(&cipher->context, input + offset,
+                                 output + offset);
+        if (res != 1) {
+            return res;
+        }
+    }
+
+    return 1;
+}
+
+
 int cipher_get_block_size(const cipher_t* cipher)
 {
     return cipher->interface->block_size;
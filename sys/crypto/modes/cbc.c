@@ -57,32 +57,43 @@ int cipher_encrypt_cbc(cipher_t* cipher, uint8_t iv[16],
 int cipher_decrypt_cbc(cipher_t* cipher, uint8_t iv[16],
                        uint8_t* input, size_t length, uint8_t* output)
 {
-    size_t offset = 0;
-    uint8_t* input_block, *output_block, *input_block_last, block_size;
-
+    size_t offset = 0, batch;
+    uint8_t block_size, plain[CIPHER_MODES_BATCH_SIZE],
+            input_block_last[CIPHER_MAX_BLOCK_SIZE],
+            input_block[CIPHER_MAX_BLOCK_SIZE];
 
     block_size = cipher_get_block_size(cipher);
     if (length % block_size != 0) {
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
-    input_block_last = iv;
-    do {
-        input_block = input + offset;
-        output_block = output + offset;
+    /* unlike encryption, CBC decryption of all blocks is independent */
+    batch = sizeof(plain) / block_size;
+    memcpy(input_block_last, iv, block_size);
+    while (offset < length) {
+        size_t nblocks = (length - offset) / block_size;
+        if (nblocks > batch) {
+            nblocks = batch;
+        }
 
-        if (cipher_decrypt(cipher, input_block, output_block) != 1) {
+        if (cipher_decrypt_blocks(cipher, input + offset, plain,
+                                  nblocks) != 1) {
             return CIPHER_ERR_DEC_FAILED;
         }
 
-        /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
-        for (uint8_t i = 0; i < block_size; ++i) {
-            output_block[i] ^= input_block_last[i];
-        }
+        for (size_t n = 0; n < nblocks; n++, offset += block_size) {
+            /* input and output may be the same buffer */
+            memcpy(input_block, input + offset, block_size);
 
-        input_block_last = input_block;
-        offset += block_size;
-    } while (offset < length);
+            /* CBC-Mode: XOR plaintext with ciphertext of (n-1)-th block */
+            for (uint8_t i = 0; i < block_size; ++i) {
+                output[offset + i] = plain[n * block_size + i] ^
+                                     input_block_last[i];
+            }
+
+            memcpy(input_block_last, input_block, block_size);
+        }
+    }
 
     return offset;
 }
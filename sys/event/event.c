@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Event queue implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "assert.h"
+#include "event.h"
+#include "irq.h"
+#include "thread_flags.h"
+
+void event_queue_init(event_queue_t *queue)
+{
+    assert(queue);
+    memset(queue, '\0', sizeof(*queue));
+    queue->waiter = (thread_t *)sched_active_thread;
+}
+
+void event_queue_claim(event_queue_t *queue)
+{
+    assert(queue);
+    queue->waiter = (thread_t *)sched_active_thread;
+}
+
+void event_post(event_queue_t *queue, event_t *event)
+{
+    assert(queue && event);
+
+    unsigned state = irq_disable();
+    if (!event->list_node.next) {
+        clist_insert(&queue->event_list, &event->list_node);
+    }
+    thread_t *waiter = queue->waiter;
+    irq_restore(state);
+
+    /* without an owner yet, the event is picked up by its first
+     * event_wait() */
+    if (waiter) {
+        thread_flags_set(waiter, THREAD_FLAG_EVENT);
+    }
+}
+
+void event_cancel(event_queue_t *queue, event_t *event)
+{
+    assert(queue);
+    assert(event);
+
+    unsigned state = irq_disable();
+    clist_remove(&queue->event_list, &event->list_node);
+    event->list_node.next = NULL;
+    irq_restore(state);
+}
+
+event_t *event_get(event_queue_t *queue)
+{
+    unsigned state = irq_disable();
+    event_t *result = (event_t *)clist_remove_head(&queue->event_list);
+    if (result) {
+        /* must happen before an ISR can post the event again */
+        result->list_node.next = NULL;
+    }
+    irq_restore(state);
+
+    return result;
+}
+
+event_t *event_wait(event_queue_t *queue)
+{
+    assert(queue->waiter == (thread_t *)sched_active_thread);
+
+    event_t *result;
+
+    while (!(result = event_get(queue))) {
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+    }
+
+    return result;
+}
+
+void event_loop(event_queue_t *queue)
+{
+    event_t *event;
+
+    while ((event = event_wait(queue))) {
+        event->handler(event);
+    }
+}
@@ -21,6 +21,7 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 
 #ifdef __WITH_AVRLIBC__
@@ -34,20 +35,70 @@ ssize_t write(int fildes, const void *buf, size_t nbyte);
 
 static const char _hex_chars[16] = "0123456789ABCDEF";
 
+/* all two digit decimal numbers, so conversions need one division per two
+ * digits */
+static const char _dec_pairs[200] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const uint32_t _pow10[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+    1000000000,
+};
+
+/* longest output of any fmt_writer_*() call, "-18446744073709551615.0000000" */
+#define FMT_WRITER_FIELD_MAX    (32U)
+
 static inline int _is_digit(char c)
 {
     return (c >= '0' && c <= '9');
 }
 
-static inline unsigned pwr(unsigned val, unsigned exp)
+static inline int _hex_value(char c)
 {
-    unsigned res = 1;
+    if (_is_digit(c)) {
+        return c - '0';
+    }
+    c |= 0x20;  /* lower case */
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
 
-    for (unsigned i = 0; i < exp; i++) {
-        res *= val;
+static inline size_t _dec_len(uint32_t val)
+{
+    size_t len = 1;
+
+    while ((len < 10) && (val >= _pow10[len])) {
+        len++;
     }
+    return len;
+}
 
-    return res;
+/* writes exactly @p width digits of @p val, with leading zeros */
+static void _dec_pad(char *out, uint32_t val, size_t width)
+{
+    char *ptr = out + width;
+
+    while (ptr - out >= 2) {
+        uint32_t q = val / 100;
+        const char *pair = &_dec_pairs[(val - q * 100) * 2];
+        *--ptr = pair[1];
+        *--ptr = pair[0];
+        val = q;
+    }
+    if (ptr > out) {
+        *--ptr = (val % 10) + '0';
+    }
 }
 
 size_t fmt_byte_hex(char *out, uint8_t byte)
@@ -104,21 +155,30 @@ size_t fmt_u64_hex(char *out, uint64_t val)
 
 size_t fmt_u32_dec(char *out, uint32_t val)
 {
-    size_t len = 1;
+    size_t len = _dec_len(val);
+
+    if (out) {
+        _dec_pad(out, val, len);
+    }
 
-    /* count needed characters */
-    for (uint32_t tmp = val; (tmp > 9); len++) {
-        tmp /= 10;
+    return len;
+}
+
+size_t fmt_u64_dec(char *out, uint64_t val)
+{
+    if (val <= UINT32_MAX) {
+        return fmt_u32_dec(out, val);
     }
 
+    /* split off the lowest nine digits until the rest fits 32 bits */
+    uint64_t upper = val / 1000000000;
+    size_t len = fmt_u64_dec(out, upper);
+
     if (out) {
-        char *ptr = out + len;
-        do {
-            *--ptr = (val % 10) + '0';
-        } while ((val /= 10));
+        _dec_pad(out + len, val - upper * 1000000000, 9);
     }
 
-    return len;
+    return len + 9;
 }
 
 size_t fmt_u16_dec(char *out, uint16_t val)
@@ -128,14 +188,15 @@ size_t fmt_u16_dec(char *out, uint16_t val)
 
 size_t fmt_s32_dec(char *out, int32_t val)
 {
+    uint32_t absolute = val;
     int negative = (val < 0);
     if (negative) {
         if (out) {
             *out++ = '-';
         }
-        val *= -1;
+        absolute = -absolute;
     }
-    return fmt_u32_dec(out, val) + negative;
+    return fmt_u32_dec(out, absolute) + negative;
 }
 
 size_t fmt_s16_dec(char *out, int16_t val)
@@ -143,46 +204,91 @@ size_t fmt_s16_dec(char *out, int16_t val)
     return fmt_s32_dec(out, val);
 }
 
-size_t fmt_s16_dfp(char *out, int16_t val, unsigned fp_digits)
+size_t fmt_s32_dfp(char *out, int32_t val, unsigned fp_digits)
 {
-    int16_t absolute, divider;
+    uint32_t absolute = val;
     size_t pos = 0;
-    size_t div_len, len;
-    unsigned e;
-    char tmp[4];
 
-    if (fp_digits > 4) {
+    if (fp_digits > 9) {
         return 0;
     }
     if (fp_digits == 0) {
-        return fmt_s16_dec(out, val);
+        return fmt_s32_dec(out, val);
     }
     if (val < 0) {
         if (out) {
-            out[pos++] = '-';
+            out[pos] = '-';
         }
-        val *= -1;
+        pos++;
+        absolute = -absolute;
     }
 
-    e = pwr(10, fp_digits);
-    absolute = (val / (int)e);
-    divider = val - (absolute * e);
+    uint32_t integer = absolute / _pow10[fp_digits];
 
-    pos += fmt_s16_dec(&out[pos], absolute);
+    pos += fmt_u32_dec(out ? &out[pos] : NULL, integer);
 
-    if (!out) {
-        return pos + 1 + fp_digits;     /* abs len + decimal point + divider */
+    if (out) {
+        out[pos] = '.';
+        _dec_pad(&out[pos + 1], absolute - integer * _pow10[fp_digits],
+                 fp_digits);
+    }
+
+    return pos + 1 + fp_digits;
+}
+
+size_t fmt_s16_dfp(char *out, int16_t val, unsigned fp_digits)
+{
+    if (fp_digits > 4) {
+        return 0;
     }
+    return fmt_s32_dfp(out, val, fp_digits);
+}
 
-    out[pos++] = '.';
-    len = pos + fp_digits;
-    div_len = fmt_s16_dec(tmp, divider);
+size_t fmt_float(char *out, float f, unsigned precision)
+{
+    size_t pos = 0;
 
-    while (pos < (len - div_len)) {
-        out[pos++] = '0';
+    if (precision > 7) {
+        precision = 7;
+    }
+    if (f != f) {
+        return fmt_str(out, "nan");
     }
-    for (size_t i = 0; i < div_len; i++) {
-        out[pos++] = tmp[i];
+    if (f < 0) {
+        if (out) {
+            out[pos] = '-';
+        }
+        pos++;
+        f = -f;
+    }
+
+    uint32_t frac = 0;
+
+    if (f < 4294967296.0f) {
+        uint32_t integer = f;
+
+        /* round half up, carrying into the integer part */
+        frac = (f - integer) * _pow10[precision] + 0.5f;
+        if (frac >= _pow10[precision]) {
+            frac -= _pow10[precision];
+            integer++;
+        }
+        pos += fmt_u32_dec(out ? &out[pos] : NULL, integer);
+    }
+    else if (f < 18446744073709551616.0f) {
+        /* floats this large have no fractional part */
+        pos += fmt_u64_dec(out ? &out[pos] : NULL, (uint64_t)f);
+    }
+    else {
+        return pos + fmt_str(out ? &out[pos] : NULL, "inf");
+    }
+
+    if (precision) {
+        if (out) {
+            out[pos] = '.';
+            _dec_pad(&out[pos + 1], frac, precision);
+        }
+        pos += 1 + precision;
     }
 
     return pos;
@@ -204,6 +310,73 @@ uint32_t scn_u32_dec(const char *str, size_t n)
     return res;
 }
 
+int32_t scn_s32_dec(const char *str, size_t n)
+{
+    int negative = 0;
+
+    if (n && (*str == '-' || *str == '+')) {
+        negative = (*str == '-');
+        str++;
+        n--;
+    }
+
+    uint32_t res = scn_u32_dec(str, n);
+    return negative ? -res : res;
+}
+
+uint32_t scn_u32_hex(const char *str, size_t n)
+{
+    uint32_t res = 0;
+    while (n--) {
+        int digit = _hex_value(*str++);
+        if (digit < 0) {
+            break;
+        }
+        res = (res << 4) | digit;
+    }
+    return res;
+}
+
+int32_t scn_s32_dfp(const char *str, size_t n, unsigned fp_digits)
+{
+    int negative = 0;
+    uint32_t res = 0;
+    unsigned frac_digits = 0;
+    int frac = 0;
+
+    if (n && (*str == '-' || *str == '+')) {
+        negative = (*str == '-');
+        str++;
+        n--;
+    }
+
+    while (n--) {
+        char c = *str++;
+        if (c == '.' && !frac) {
+            frac = 1;
+            continue;
+        }
+        if (!_is_digit(c)) {
+            break;
+        }
+        if (frac) {
+            if (frac_digits == fp_digits) {
+                /* truncate surplus fractional digits */
+                continue;
+            }
+            frac_digits++;
+        }
+        res = res * 10 + (c - '0');
+    }
+
+    while (frac_digits < fp_digits) {
+        res *= 10;
+        frac_digits++;
+    }
+
+    return negative ? -res : res;
+}
+
 void print(const char *s, size_t n)
 {
 #ifdef __WITH_AVRLIBC__
@@ -235,6 +408,20 @@ void print_s32_dec(int32_t val)
     print(buf, len);
 }
 
+void print_u64_dec(uint64_t val)
+{
+    char buf[20];
+    size_t len = fmt_u64_dec(buf, val);
+    print(buf, len);
+}
+
+void print_float(float f, unsigned precision)
+{
+    char buf[FMT_WRITER_FIELD_MAX];
+    size_t len = fmt_float(buf, f, precision);
+    print(buf, len);
+}
+
 void print_u32_hex(uint32_t val)
 {
     char buf[8];
@@ -252,3 +439,111 @@ void print_str(const char* str)
 {
     print(str, fmt_strlen(str));
 }
+
+void fmt_writer_init(fmt_writer_t *writer, char *buf, size_t size,
+                     fmt_write_t write)
+{
+    writer->write = write ? write : print;
+    writer->buf = buf;
+    writer->size = size;
+    writer->pos = 0;
+}
+
+void fmt_writer_flush(fmt_writer_t *writer)
+{
+    if (writer->pos) {
+        writer->write(writer->buf, writer->pos);
+        writer->pos = 0;
+    }
+}
+
+void fmt_writer_write(fmt_writer_t *writer, const char *s, size_t n)
+{
+    if (n > writer->size - writer->pos) {
+        fmt_writer_flush(writer);
+        if (n >= writer->size) {
+            writer->write(s, n);
+            return;
+        }
+    }
+    memcpy(&writer->buf[writer->pos], s, n);
+    writer->pos += n;
+}
+
+void fmt_writer_char(fmt_writer_t *writer, char c)
+{
+    if (writer->pos == writer->size) {
+        fmt_writer_flush(writer);
+        if (!writer->size) {
+            writer->write(&c, 1);
+            return;
+        }
+    }
+    writer->buf[writer->pos++] = c;
+}
+
+/* Returns where to format a field of up to FMT_WRITER_FIELD_MAX characters,
+ * in place in the buffer if it is large enough, in @p tmp otherwise. */
+static char *_field_start(fmt_writer_t *writer, char *tmp)
+{
+    if (writer->size - writer->pos < FMT_WRITER_FIELD_MAX) {
+        fmt_writer_flush(writer);
+        if (writer->size < FMT_WRITER_FIELD_MAX) {
+            return tmp;
+        }
+    }
+    return &writer->buf[writer->pos];
+}
+
+static void _field_end(fmt_writer_t *writer, const char *field,
+                       const char *tmp, size_t len)
+{
+    if (field == tmp) {
+        fmt_writer_write(writer, tmp, len);
+    }
+    else {
+        writer->pos += len;
+    }
+}
+
+void fmt_writer_u32_dec(fmt_writer_t *writer, uint32_t val)
+{
+    char tmp[FMT_WRITER_FIELD_MAX];
+    char *field = _field_start(writer, tmp);
+    _field_end(writer, field, tmp, fmt_u32_dec(field, val));
+}
+
+void fmt_writer_s32_dec(fmt_writer_t *writer, int32_t val)
+{
+    char tmp[FMT_WRITER_FIELD_MAX];
+    char *field = _field_start(writer, tmp);
+    _field_end(writer, field, tmp, fmt_s32_dec(field, val));
+}
+
+void fmt_writer_u64_dec(fmt_writer_t *writer, uint64_t val)
+{
+    char tmp[FMT_WRITER_FIELD_MAX];
+    char *field = _field_start(writer, tmp);
+    _field_end(writer, field, tmp, fmt_u64_dec(field, val));
+}
+
+void fmt_writer_u32_hex(fmt_writer_t *writer, uint32_t val)
+{
+    char tmp[FMT_WRITER_FIELD_MAX];
+    char *field = _field_start(writer, tmp);
+    _field_end(writer, field, tmp, fmt_u32_hex(field, val));
+}
+
+void fmt_writer_s32_dfp(fmt_writer_t *writer, int32_t val, unsigned fp_digits)
+{
+    char tmp[FMT_WRITER_FIELD_MAX];
+    char *field = _field_start(writer, tmp);
+    _field_end(writer, field, tmp, fmt_s32_dfp(field, val, fp_digits));
+}
+
+void fmt_writer_float(fmt_writer_t *writer, float f, unsigned precision)
+{
+    char tmp[FMT_WRITER_FIELD_MAX];
+    char *field = _field_start(writer, tmp);
+    _field_end(writer, field, tmp, fmt_float(field, f, precision));
+}
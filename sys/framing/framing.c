@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_framing
+ * @{
+ *
+ * @file
+ * @brief       Byte stuffing implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "framing.h"
+
+/* word with every byte set to 0x01 and 0x80 respectively */
+#define ONES            ((uintptr_t)-1 / 0xff)
+#define HIGHS           (ONES << 7)
+/* nonzero if any byte of v is 0 */
+#define HAS_ZERO(v)     (((v) - ONES) & ~(v) & HIGHS)
+
+const framing_t framing_slip = { 0xc0, 0xdb, 0xdc, 0xdd };
+const framing_t framing_hdlc = { 0x7e, 0x7d, 0x7e ^ 0x20, 0x7d ^ 0x20 };
+
+size_t framing_plain_len(const framing_t *f, const uint8_t *data, size_t len)
+{
+    const uint8_t *pos = data;
+    const uint8_t *stop = data + len;
+
+    while ((pos < stop) && ((uintptr_t)pos & (sizeof(uintptr_t) - 1))) {
+        if ((*pos == f->end) || (*pos == f->esc)) {
+            return pos - data;
+        }
+        pos++;
+    }
+
+    uintptr_t end = ONES * f->end;
+    uintptr_t esc = ONES * f->esc;
+
+    while ((size_t)(stop - pos) >= sizeof(uintptr_t)) {
+        uintptr_t word;
+
+        memcpy(&word, pos, sizeof(word));
+        if (HAS_ZERO(word ^ end) | HAS_ZERO(word ^ esc)) {
+            break;
+        }
+        pos += sizeof(word);
+    }
+
+    while ((pos < stop) && (*pos != f->end) && (*pos != f->esc)) {
+        pos++;
+    }
+
+    return pos - data;
+}
+
+void framing_encode(const framing_t *f, const uint8_t *src, size_t len,
+                    framing_write_t write, void *arg)
+{
+    while (len) {
+        size_t n = framing_plain_len(f, src, len);
+
+        if (n) {
+            write(arg, src, n);
+            src += n;
+            len -= n;
+            if (!len) {
+                break;
+            }
+        }
+
+        uint8_t seq[2] = { f->esc, (*src == f->end) ? f->esc_end : f->esc_esc };
+        write(arg, seq, sizeof(seq));
+        src++;
+        len--;
+    }
+}
+
+size_t framing_encode_buf(const framing_t *f, uint8_t *dst, const uint8_t *src,
+                          size_t len)
+{
+    uint8_t *out = dst;
+
+    while (len) {
+        size_t n = framing_plain_len(f, src, len);
+
+        memcpy(out, src, n);
+        out += n;
+        src += n;
+        len -= n;
+        if (!len) {
+            break;
+        }
+
+        *out++ = f->esc;
+        *out++ = (*src == f->end) ? f->esc_end : f->esc_esc;
+        src++;
+        len--;
+    }
+
+    return out - dst;
+}
+
+size_t framing_decode(const framing_t *f, uint8_t *dst, const uint8_t *src,
+                      size_t len, uint8_t *esc)
+{
+    uint8_t *out = dst;
+
+    while (len) {
+        if (*esc) {
+            *esc = 0;
+            if (*src == f->esc_end) {
+                *out++ = f->end;
+            }
+            else if (*src == f->esc_esc) {
+                *out++ = f->esc;
+            }
+            src++;
+            len--;
+            continue;
+        }
+
+        const uint8_t *pos = memchr(src, f->esc, len);
+        size_t n = pos ? (size_t)(pos - src) : len;
+
+        if (out != src) {
+            memmove(out, src, n);
+        }
+        out += n;
+        src += n;
+        len -= n;
+        if (len) {
+            *esc = 1;
+            src++;
+            len--;
+        }
+    }
+
+    return out - dst;
+}
@@ -49,36 +49,40 @@
 #include "hashes/sha256.h"
 #include "board.h"
 
-#ifdef __BIG_ENDIAN__
-/* Copy a vector of big-endian uint32_t into a vector of bytes */
-#define be32enc_vect memcpy
-
-/* Copy a vector of bytes into a vector of big-endian uint32_t */
-#define be32dec_vect memcpy
+#if defined(__SHA__) && defined(__SSE4_1__) && !defined(SHA256_NO_SHA_NI)
+#define SHA256_USE_SHA_NI   (1)
+#include <immintrin.h>
+#else
+#define SHA256_USE_SHA_NI   (0)
+#endif
+
+/* Decode a big-endian uint32_t from (possibly unaligned) memory */
+static inline uint32_t be32dec(const unsigned char *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
 
-#else /* !__BIG_ENDIAN__ */
+/* Encode a uint32_t into (possibly unaligned) memory in big-endian form */
+static inline void be32enc(unsigned char *p, uint32_t x)
+{
+    p[0] = (unsigned char)(x >> 24);
+    p[1] = (unsigned char)(x >> 16);
+    p[2] = (unsigned char)(x >> 8);
+    p[3] = (unsigned char)x;
+}
 
 /*
  * Encode a length len/4 vector of (uint32_t) into a length len vector of
  * (unsigned char) in big-endian form.  Assumes len is a multiple of 4.
  */
-static void be32enc_vect(void *dst_, const void *src_, size_t len)
+static void be32enc_vect(unsigned char *dst, const uint32_t *src, size_t len)
 {
-    uint32_t *dst = dst_;
-    const uint32_t *src = src_;
     for (size_t i = 0; i < len / 4; i++) {
-        dst[i] = __builtin_bswap32(src[i]);
+        be32enc(&dst[4 * i], src[i]);
     }
 }
 
-/*
- * Decode a big-endian length len vector of (unsigned char) into a length
- * len/4 vector of (uint32_t).  Assumes len is a multiple of 4.
- */
-#define be32dec_vect be32enc_vect
-
-#endif /* __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__ */
-
 /* Elementary functions used by SHA256 */
 #define Ch(x, y, z) ((x & (y ^ z)) ^ z)
 #define Maj(x, y, z)    ((x & (y | z)) | (y & z))
@@ -108,43 +112,130 @@ static const uint32_t K[64] = {
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
 };
 
+static const uint32_t IV[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+#if SHA256_USE_SHA_NI
 /*
- * SHA256 block compression function.  The 256-bit state is transformed via
- * the 512-bit input block to produce a new state.
+ * SHA256 block compression using the x86 SHA extensions. The state is kept
+ * in the ABEF/CDGH layout expected by SHA256RNDS2 for all blocks.
  */
-static void sha256_transform(uint32_t *state, const unsigned char block[64])
+static void sha256_transform_blocks(uint32_t *state, const unsigned char *data,
+                                    size_t nblocks)
 {
-    uint32_t W[64];
-    uint32_t S[8];
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                        0x0405060700010203ULL);
+    __m128i state0, state1, tmp, msg[4];
+
+    tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+    state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);             /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);       /* EFGH */
+    state0 = _mm_alignr_epi8(tmp, state1, 8);       /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);    /* CDGH */
+
+    for (; nblocks; nblocks--, data += 64) {
+        __m128i abef = state0, cdgh = state1;
+
+        for (int g = 0; g < 16; g++) {
+            __m128i cur;
+
+            if (g < 4) {
+                msg[g] = _mm_shuffle_epi8(
+                    _mm_loadu_si128((const __m128i *)(data + 16 * g)), mask);
+            }
+            cur = msg[g & 3];
+
+            tmp = _mm_add_epi32(cur, _mm_loadu_si128((const __m128i *)&K[4 * g]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, tmp);
+            if (g >= 3 && g <= 14) {
+                __m128i next = _mm_add_epi32(msg[(g + 1) & 3],
+                                             _mm_alignr_epi8(cur, msg[(g - 1) & 3], 4));
+                msg[(g + 1) & 3] = _mm_sha256msg2_epu32(next, cur);
+            }
+            tmp = _mm_shuffle_epi32(tmp, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, tmp);
+            if (g >= 1 && g <= 12) {
+                msg[(g - 1) & 3] = _mm_sha256msg1_epu32(msg[(g - 1) & 3], cur);
+            }
+        }
 
-    /* 1. Prepare message schedule W. */
-    be32dec_vect(W, block, 64);
-    for (int i = 16; i < 64; i++) {
-        W[i] = s1(W[i - 2]) + W[i - 7] + s0(W[i - 15]) + W[i - 16];
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
     }
 
-    /* 2. Initialize working variables. */
-    memcpy(S, state, 32);
+    tmp = _mm_shuffle_epi32(state0, 0x1B);          /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);       /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);    /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);       /* ABEF */
+    _mm_storeu_si128((__m128i *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+#else /* !SHA256_USE_SHA_NI */
 
-    /* 3. Mix. */
-    for (int i = 0; i < 64; ++i) {
-        uint32_t e = S[(68 - i) % 8], f = S[(69 - i) % 8];
-        uint32_t g = S[(70 - i) % 8], h = S[(71 - i) % 8];
-        uint32_t t0 = h + S1(e) + Ch(e, f, g) + W[i] + K[i];
+/* One round; the caller rotates the roles of the working variables */
+#define RND(a, b, c, d, e, f, g, h, i) \
+    do { \
+        uint32_t t0 = h + S1(e) + Ch(e, f, g) + K[i] + W[(i) & 15]; \
+        uint32_t t1 = S0(a) + Maj(a, b, c); \
+        d += t0; \
+        h = t0 + t1; \
+    } while (0)
+
+/*
+ * SHA256 block compression function.  The 256-bit state is transformed via
+ * the 512-bit input block to produce a new state.  The message schedule is
+ * kept in a rolling window of 16 words and the rounds are unrolled by eight
+ * so that no working variables have to be shuffled.
+ */
+static void sha256_transform(uint32_t *state, const unsigned char *block)
+{
+    uint32_t W[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
 
-        uint32_t a = S[(64 - i) % 8], b = S[(65 - i) % 8];
-        uint32_t c = S[(66 - i) % 8], d = S[(67 - i) % 8];
-        uint32_t t1 = S0(a) + Maj(a, b, c);
+    for (int i = 0; i < 16; i++) {
+        W[i] = be32dec(&block[4 * i]);
+    }
 
-        S[(67 - i) % 8] = d + t0;
-        S[(71 - i) % 8] = t0 + t1;
+    for (int i = 0; i < 64; i += 8) {
+        if (i >= 16) {
+            for (int j = i; j < i + 8; j++) {
+                W[j & 15] += s1(W[(j - 2) & 15]) + W[(j - 7) & 15] +
+                             s0(W[(j - 15) & 15]);
+            }
+        }
+        RND(a, b, c, d, e, f, g, h, i + 0);
+        RND(h, a, b, c, d, e, f, g, i + 1);
+        RND(g, h, a, b, c, d, e, f, i + 2);
+        RND(f, g, h, a, b, c, d, e, i + 3);
+        RND(e, f, g, h, a, b, c, d, i + 4);
+        RND(d, e, f, g, h, a, b, c, i + 5);
+        RND(c, d, e, f, g, h, a, b, i + 6);
+        RND(b, c, d, e, f, g, h, a, i + 7);
     }
 
-    /* 4. Mix local working variables into global state */
-    for (int i = 0; i < 8; i++) {
-        state[i] += S[i];
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+static void sha256_transform_blocks(uint32_t *state, const unsigned char *data,
+                                    size_t nblocks)
+{
+    for (; nblocks; nblocks--, data += 64) {
+        sha256_transform(state, data);
     }
 }
+#endif /* SHA256_USE_SHA_NI */
 
 static unsigned char PAD[64] = {
     0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -179,14 +270,7 @@ void sha256_init(sha256_context_t *ctx)
     ctx->count[0] = ctx->count[1] = 0;
 
     /* Magic initialization constants */
-    ctx->state[0] = 0x6A09E667;
-    ctx->state[1] = 0xBB67AE85;
-    ctx->state[2] = 0x3C6EF372;
-    ctx->state[3] = 0xA54FF53A;
-    ctx->state[4] = 0x510E527F;
-    ctx->state[5] = 0x9B05688C;
-    ctx->state[6] = 0x1F83D9AB;
-    ctx->state[7] = 0x5BE0CD19;
+    memcpy(ctx->state, IV, sizeof(IV));
 }
 
 /* Add bytes into the hash */
@@ -215,18 +299,18 @@ void sha256_update(sha256_context_t *ctx, const void *in, size_t len)
     /* Finish the current block */
     const unsigned char *src = in;
 
-    memcpy(&ctx->buf[r], src, 64 - r);
-    sha256_transform(ctx->state, ctx->buf);
-    src += 64 - r;
-    len -= 64 - r;
-
-    /* Perform complete blocks */
-    while (len >= 64) {
-        sha256_transform(ctx->state, src);
-        src += 64;
-        len -= 64;
+    if (r) {
+        memcpy(&ctx->buf[r], src, 64 - r);
+        sha256_transform_blocks(ctx->state, ctx->buf, 1);
+        src += 64 - r;
+        len -= 64 - r;
     }
 
+    /* Perform complete blocks directly from the input */
+    sha256_transform_blocks(ctx->state, src, len / 64);
+    src += len & ~(size_t)63;
+    len &= 63;
+
     /* Copy left over data into buffer */
     memcpy(ctx->buf, src, len);
 }
@@ -263,11 +347,157 @@ unsigned char *sha256(const unsigned char *d, size_t n, unsigned char *md)
     return md;
 }
 
-const unsigned char *hmac_sha256(const unsigned char *key,
-                                 size_t key_length,
-                                 const unsigned *message,
-                                 size_t message_length,
-                                 unsigned char *result)
+#if SHA256_USE_SHA_NI
+void sha256_multi(const void *const msgs[], const size_t lens[], size_t n,
+                  unsigned char digests[][SHA256_DIGEST_LENGTH])
+{
+    /* a single SHA-NI stream is faster than interleaved scalar lanes */
+    for (size_t i = 0; i < n; i++) {
+        sha256(msgs[i], lens[i], digests[i]);
+    }
+}
+#else
+/*
+ * Compress one block for each lane. All lanes run the same instruction
+ * stream on independent data so the compiler can interleave (or vectorize)
+ * them; only lanes in active_mask store back their result.
+ */
+/* One round on all lanes, see RND() */
+#define RND_LANES(a, b, c, d, e, f, g, h, i) \
+    for (int l = 0; l < SHA256_MULTI_LANES; l++) { \
+        uint32_t t0 = h[l] + S1(e[l]) + Ch(e[l], f[l], g[l]) + K[i] + \
+                      W[(i) & 15][l]; \
+        uint32_t t1 = S0(a[l]) + Maj(a[l], b[l], c[l]); \
+        d[l] += t0; \
+        h[l] = t0 + t1; \
+    }
+
+static void sha256_transform_lanes(uint32_t state[8][SHA256_MULTI_LANES],
+                                   const unsigned char *const blocks[],
+                                   unsigned active_mask)
+{
+    uint32_t W[16][SHA256_MULTI_LANES];
+    uint32_t a[SHA256_MULTI_LANES], b[SHA256_MULTI_LANES];
+    uint32_t c[SHA256_MULTI_LANES], d[SHA256_MULTI_LANES];
+    uint32_t e[SHA256_MULTI_LANES], f[SHA256_MULTI_LANES];
+    uint32_t g[SHA256_MULTI_LANES], h[SHA256_MULTI_LANES];
+
+    for (int i = 0; i < 16; i++) {
+        for (int l = 0; l < SHA256_MULTI_LANES; l++) {
+            W[i][l] = be32dec(&blocks[l][4 * i]);
+        }
+    }
+    memcpy(a, state[0], sizeof(a));
+    memcpy(b, state[1], sizeof(b));
+    memcpy(c, state[2], sizeof(c));
+    memcpy(d, state[3], sizeof(d));
+    memcpy(e, state[4], sizeof(e));
+    memcpy(f, state[5], sizeof(f));
+    memcpy(g, state[6], sizeof(g));
+    memcpy(h, state[7], sizeof(h));
+
+    for (int i = 0; i < 64; i += 8) {
+        if (i >= 16) {
+            for (int j = i; j < i + 8; j++) {
+                for (int l = 0; l < SHA256_MULTI_LANES; l++) {
+                    W[j & 15][l] += s1(W[(j - 2) & 15][l]) + W[(j - 7) & 15][l] +
+                                    s0(W[(j - 15) & 15][l]);
+                }
+            }
+        }
+        RND_LANES(a, b, c, d, e, f, g, h, i + 0);
+        RND_LANES(h, a, b, c, d, e, f, g, i + 1);
+        RND_LANES(g, h, a, b, c, d, e, f, i + 2);
+        RND_LANES(f, g, h, a, b, c, d, e, i + 3);
+        RND_LANES(e, f, g, h, a, b, c, d, i + 4);
+        RND_LANES(d, e, f, g, h, a, b, c, i + 5);
+        RND_LANES(c, d, e, f, g, h, a, b, i + 6);
+        RND_LANES(b, c, d, e, f, g, h, a, i + 7);
+    }
+
+    for (int l = 0; l < SHA256_MULTI_LANES; l++) {
+        if (active_mask & (1U << l)) {
+            state[0][l] += a[l];
+            state[1][l] += b[l];
+            state[2][l] += c[l];
+            state[3][l] += d[l];
+            state[4][l] += e[l];
+            state[5][l] += f[l];
+            state[6][l] += g[l];
+            state[7][l] += h[l];
+        }
+    }
+}
+
+void sha256_multi(const void *const msgs[], const size_t lens[], size_t n,
+                  unsigned char digests[][SHA256_DIGEST_LENGTH])
+{
+    for (size_t base = 0; base < n; base += SHA256_MULTI_LANES) {
+        uint32_t state[8][SHA256_MULTI_LANES];
+        /* padded final block(s) of each message */
+        unsigned char tail[SHA256_MULTI_LANES][2 * SHA256_INTERNAL_BLOCK_SIZE];
+        size_t full[SHA256_MULTI_LANES], total[SHA256_MULTI_LANES];
+        size_t max_blocks = 0;
+
+        memset(tail, 0, sizeof(tail));
+        for (int l = 0; l < SHA256_MULTI_LANES; l++) {
+            for (int i = 0; i < 8; i++) {
+                state[i][l] = IV[i];
+            }
+            full[l] = total[l] = 0;
+            if (base + l >= n) {
+                continue;
+            }
+
+            size_t len = lens[base + l];
+            size_t r = len % SHA256_INTERNAL_BLOCK_SIZE;
+            uint64_t bits = (uint64_t)len << 3;
+
+            full[l] = len / SHA256_INTERNAL_BLOCK_SIZE;
+            memcpy(tail[l], (const unsigned char *)msgs[base + l] +
+                   full[l] * SHA256_INTERNAL_BLOCK_SIZE, r);
+            tail[l][r] = 0x80;
+            size_t tail_blocks = (r < 56) ? 1 : 2;
+            be32enc(&tail[l][tail_blocks * 64 - 8], (uint32_t)(bits >> 32));
+            be32enc(&tail[l][tail_blocks * 64 - 4], (uint32_t)bits);
+            total[l] = full[l] + tail_blocks;
+            if (total[l] > max_blocks) {
+                max_blocks = total[l];
+            }
+        }
+
+        for (size_t k = 0; k < max_blocks; k++) {
+            const unsigned char *blocks[SHA256_MULTI_LANES];
+            unsigned active = 0;
+
+            for (int l = 0; l < SHA256_MULTI_LANES; l++) {
+                if (k < full[l]) {
+                    blocks[l] = (const unsigned char *)msgs[base + l] +
+                                k * SHA256_INTERNAL_BLOCK_SIZE;
+                }
+                else if (k < total[l]) {
+                    blocks[l] = &tail[l][(k - full[l]) * SHA256_INTERNAL_BLOCK_SIZE];
+                }
+                else {
+                    /* finished lane, compress something and drop the result */
+                    blocks[l] = tail[l];
+                    continue;
+                }
+                active |= 1U << l;
+            }
+            sha256_transform_lanes(state, blocks, active);
+        }
+
+        for (int l = 0; l < SHA256_MULTI_LANES && base + l < n; l++) {
+            for (int i = 0; i < 8; i++) {
+                be32enc(&digests[base + l][4 * i], state[i][l]);
+            }
+        }
+    }
+}
+#endif /* SHA256_USE_SHA_NI */
+
+void hmac_sha256_init(hmac_context_t *ctx, const void *key, size_t key_length)
 {
     unsigned char k[SHA256_INTERNAL_BLOCK_SIZE];
     memset((void *)k, 0x00, SHA256_INTERNAL_BLOCK_SIZE);
@@ -292,36 +522,77 @@ const unsigned char *hmac_sha256(const unsigned char *key,
         i_key_pad[i] = 0x36^k[i];
     }
 
-    /*
-     * Create the inner hash
-     * tmp = hash(i_key_pad CONCAT message)
-     */
-    sha256_context_t c;
+    /* both keypads fill exactly one block, so they are absorbed right away */
+    sha256_init(&ctx->c_in);
+    sha256_update(&ctx->c_in, i_key_pad, SHA256_INTERNAL_BLOCK_SIZE);
+    sha256_init(&ctx->c_out);
+    sha256_update(&ctx->c_out, o_key_pad, SHA256_INTERNAL_BLOCK_SIZE);
+}
+
+void hmac_sha256_update(hmac_context_t *ctx, const void *data, size_t len)
+{
+    sha256_update(&ctx->c_in, data, len);
+}
+
+void hmac_sha256_final(hmac_context_t *ctx, unsigned char *digest)
+{
     unsigned char tmp[SHA256_DIGEST_LENGTH];
 
-    sha256_init(&c);
-    sha256_update(&c, i_key_pad, SHA256_INTERNAL_BLOCK_SIZE);
-    sha256_update(&c, message, message_length);
-    sha256_final(tmp, &c);
+    /* tmp = hash(i_key_pad CONCAT message) */
+    sha256_final(tmp, &ctx->c_in);
 
+    /* result = hash(o_key_pad CONCAT tmp) */
+    sha256_update(&ctx->c_out, tmp, SHA256_DIGEST_LENGTH);
+    sha256_final(digest, &ctx->c_out);
+}
+
+const unsigned char *hmac_sha256(const unsigned char *key,
+                                 size_t key_length,
+                                 const unsigned *message,
+                                 size_t message_length,
+                                 unsigned char *result)
+{
+    hmac_context_t ctx;
     static unsigned char m[SHA256_DIGEST_LENGTH];
 
     if (result == NULL) {
         result = m;
     }
 
-    /*
-     * Create the outer hash
-     * result = hash(o_key_pad CONCAT tmp)
-     */
-    sha256_init(&c);
-    sha256_update(&c, o_key_pad, SHA256_INTERNAL_BLOCK_SIZE);
-    sha256_update(&c, tmp, SHA256_DIGEST_LENGTH);
-    sha256_final(result, &c);
+    hmac_sha256_init(&ctx, key, key_length);
+    hmac_sha256_update(&ctx, message, message_length);
+    hmac_sha256_final(&ctx, result);
 
     return result;
 }
 
+/**
+ * @brief helper to compute sha256 of a single chain element
+ *
+ * A 32 byte message fits into one padded block, so the generic
+ * update/final path with its buffering is skipped.
+ *
+ * @param[out] out  the resulting element, may be equal to @p in
+ * @param[in]  in   the element to hash
+ */
+static void sha256_element(unsigned char out[SHA256_DIGEST_LENGTH],
+                           const unsigned char in[SHA256_DIGEST_LENGTH])
+{
+    unsigned char block[SHA256_INTERNAL_BLOCK_SIZE];
+    uint32_t state[8];
+
+    memcpy(block, in, SHA256_DIGEST_LENGTH);
+    memset(block + SHA256_DIGEST_LENGTH, 0,
+           SHA256_INTERNAL_BLOCK_SIZE - SHA256_DIGEST_LENGTH);
+    block[SHA256_DIGEST_LENGTH] = 0x80;
+    /* message length in bits: 256 */
+    block[SHA256_INTERNAL_BLOCK_SIZE - 2] = 0x01;
+
+    memcpy(state, IV, sizeof(IV));
+    sha256_transform_blocks(state, block, 1);
+    be32enc_vect(out, state, SHA256_DIGEST_LENGTH);
+}
+
 /**
  * @brief helper to compute sha256 inplace for the given buffer
  *
@@ -330,10 +601,7 @@ const unsigned char *hmac_sha256(const unsigned char *key,
  */
 static inline void sha256_inplace(unsigned char element[SHA256_DIGEST_LENGTH])
 {
-    sha256_context_t ctx;
-    sha256_init(&ctx);
-    sha256_update(&ctx, element, SHA256_DIGEST_LENGTH);
-    sha256_final(element, &ctx);
+    sha256_element(element, element);
 }
 
 unsigned char *sha256_chain(const unsigned char *seed, size_t seed_length,
@@ -382,10 +650,7 @@ unsigned char *sha256_chain_with_waypoints(const unsigned char *seed,
 
         /* perform consecutive iterations starting at index 1*/
         for (size_t i = 1; i < elements; ++i) {
-            sha256_context_t ctx;
-            sha256_init(&ctx);
-            sha256_update(&ctx, waypoints[(i - 1)].element, SHA256_DIGEST_LENGTH);
-            sha256_final(waypoints[i].element, &ctx);
+            sha256_element(waypoints[i].element, waypoints[(i - 1)].element);
             waypoints[i].index = i;
         }
 
@@ -458,3 +723,83 @@ int sha256_chain_verify_element(unsigned char *element,
     /* return if the computed element equals the tail_element */
     return (memcmp(tmp_element, tail_element, SHA256_DIGEST_LENGTH) != 0);
 }
+
+void sha256_chain_verifier_init(sha256_chain_verifier_t *verifier,
+                                sha256_chain_idx_elm_t *waypoints,
+                                size_t size,
+                                const unsigned char *tail_element,
+                                size_t chain_length)
+{
+    assert(size >= 1);
+    assert(chain_length >= 1);
+
+    verifier->waypoints = waypoints;
+    verifier->size = size;
+    verifier->used = 1;
+
+    waypoints[0].index = chain_length - 1;
+    memcpy(waypoints[0].element, tail_element, SHA256_DIGEST_LENGTH);
+}
+
+int sha256_chain_verifier_check(sha256_chain_verifier_t *verifier,
+                                const unsigned char *element,
+                                size_t element_index)
+{
+    sha256_chain_idx_elm_t *wp = verifier->waypoints;
+    size_t lo = 0, hi = verifier->used;
+    unsigned char tmp_element[SHA256_DIGEST_LENGTH];
+
+    /* the last waypoint is the tail, nothing lies beyond it */
+    if (element_index > wp[verifier->used - 1].index) {
+        return 1;
+    }
+
+    /* find the nearest verified waypoint at or above element_index */
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (wp[mid].index < element_index) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    memcpy(tmp_element, element, SHA256_DIGEST_LENGTH);
+    for (size_t i = element_index; i < wp[lo].index; ++i) {
+        sha256_inplace(tmp_element);
+    }
+
+    if (memcmp(tmp_element, wp[lo].element, SHA256_DIGEST_LENGTH) != 0) {
+        return 1;
+    }
+
+    if (wp[lo].index == element_index) {
+        return 0;
+    }
+
+    /* remember the verified element as new waypoint */
+    if (verifier->used == verifier->size) {
+        if (lo + 1 < verifier->used) {
+            /* it makes the waypoint it was checked against redundant */
+            memcpy(wp[lo].element, element, SHA256_DIGEST_LENGTH);
+            wp[lo].index = element_index;
+            return 0;
+        }
+        if (lo == 0) {
+            /* only the tail is stored, which must never be evicted */
+            return 0;
+        }
+        /* drop the waypoint right below the new one */
+        memmove(&wp[lo - 1], &wp[lo], sizeof(*wp));
+        lo--;
+        verifier->used--;
+    }
+
+    memmove(&wp[lo + 1], &wp[lo], (verifier->used - lo) * sizeof(*wp));
+    memcpy(wp[lo].element, element, SHA256_DIGEST_LENGTH);
+    wp[lo].index = element_index;
+    verifier->used++;
+
+    return 0;
+}
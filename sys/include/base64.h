@@ -11,6 +11,26 @@
  * @defgroup    sys_base64 base64 encoder decoder
  * @ingroup     sys
  * @brief       base64 encoder and decoder
+ *
+ * Besides base64_encode() and base64_decode(), which convert a whole buffer
+ * at once, there is an incremental interface for data that arrives or is
+ * sent in chunks of arbitrary size:
+ *
+ * @code
+ * base64_decode_ctx_t ctx;
+ * base64_decode_init(&ctx);
+ * while ((len = read_chunk(chunk, sizeof(chunk)))) {
+ *     out_len = base64_decode_update(&ctx, chunk, len, out);
+ *     ...
+ * }
+ * out_len = base64_decode_finish(&ctx, out);
+ * @endcode
+ *
+ * Symbols are converted with lookup tables, a block of four symbols at a
+ * time. On x86 CPUs with SSSE3, e.g. on native, 16 symbols are processed at
+ * once. While decoding, any bytes that are no base64 symbols, such as line
+ * breaks and padding, are skipped.
+ *
  * @{
  *
  * @brief       encoding and decoding functions for base64
@@ -20,6 +40,7 @@
 #ifndef _BASE64_ENCODER_DECODER_H
 #define _BASE64_ENCODER_DECODER_H
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -32,6 +53,98 @@ extern "C" {
 #define BASE64_ERROR_DATA_IN          (-3) /**< error value for invalid input buffer           */
 #define BASE64_ERROR_DATA_IN_SIZE     (-4) /**< error value for invalid output buffer size     */
 
+/**
+ * @brief   Number of characters needed to encode @p len bytes, with padding
+ */
+#define BASE64_ENCODE_SIZE(len)       ((((len) + 2) / 3) * 4)
+
+/**
+ * @brief   Upper bound for the number of bytes decoded from @p len
+ *          characters, and the output of one base64_decode_update() call
+ */
+#define BASE64_DECODE_SIZE(len)       ((((len) + 3) / 4) * 3)
+
+/**
+ * @brief   State of an incremental encoder
+ */
+typedef struct {
+    unsigned char buf[3];   /**< input bytes not encoded yet */
+    uint8_t len;            /**< number of bytes in base64_encode_ctx_t::buf */
+} base64_encode_ctx_t;
+
+/**
+ * @brief   State of an incremental decoder
+ */
+typedef struct {
+    uint32_t bits;          /**< symbols of the current block */
+    uint8_t n;              /**< number of symbols in base64_decode_ctx_t::bits */
+} base64_decode_ctx_t;
+
+/**
+ * @brief   Start encoding
+ */
+void base64_encode_init(base64_encode_ctx_t *ctx);
+
+/**
+ * @brief   Encode a chunk of data
+ *
+ * Up to two bytes are kept in @p ctx until the next call, as only blocks of
+ * three bytes are encoded.
+ *
+ * @param[in,out] ctx   encoder state
+ * @param[in] data      bytes to encode
+ * @param[in] len       number of bytes in @p data
+ * @param[out] out      output buffer, must hold BASE64_ENCODE_SIZE(@p len)
+ *                      characters
+ *
+ * @return  number of characters written to @p out
+ */
+size_t base64_encode_update(base64_encode_ctx_t *ctx, const unsigned char *data,
+                            size_t len, unsigned char *out);
+
+/**
+ * @brief   Encode the remaining bytes and add padding
+ *
+ * @param[in,out] ctx   encoder state, ready for new data afterwards
+ * @param[out] out      output buffer, must hold 4 characters
+ *
+ * @return  number of characters written to @p out, 0 or 4
+ */
+size_t base64_encode_finish(base64_encode_ctx_t *ctx, unsigned char *out);
+
+/**
+ * @brief   Start decoding
+ */
+void base64_decode_init(base64_decode_ctx_t *ctx);
+
+/**
+ * @brief   Decode a chunk of base64 text
+ *
+ * Bytes that are no base64 symbols are skipped. Up to three symbols are
+ * kept in @p ctx until the next call, as only blocks of four symbols are
+ * decoded.
+ *
+ * @param[in,out] ctx   decoder state
+ * @param[in] in        characters to decode
+ * @param[in] len       number of characters in @p in
+ * @param[out] out      output buffer, must hold BASE64_DECODE_SIZE(@p len)
+ *                      bytes
+ *
+ * @return  number of bytes written to @p out
+ */
+size_t base64_decode_update(base64_decode_ctx_t *ctx, const unsigned char *in,
+                            size_t len, unsigned char *out);
+
+/**
+ * @brief   Decode the symbols of an incomplete last block
+ *
+ * @param[in,out] ctx   decoder state, ready for new text afterwards
+ * @param[out] out      output buffer, must hold 2 bytes
+ *
+ * @return  number of bytes written to @p out
+ */
+size_t base64_decode_finish(base64_decode_ctx_t *ctx, unsigned char *out);
+
 /**
  * @brief           Encodes a given datum to base64 and save the result to the given destination.
  * @param[in]       data_in           pointer to the datum to encode
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_bloom_blocked Blocked Bloom filter
+ * @ingroup     sys
+ * @brief       Cache friendly Bloom filter with a counting variant
+ *
+ * Unlike @ref sys_bloom, which runs k independent hash functions over the
+ * whole key and sets k bits anywhere in the filter, this filter hashes the
+ * key once into 64 bits. The upper half selects a block of
+ * @ref BLOOM_BLOCKED_BLOCK_SIZE bytes, the lower half yields all k positions
+ * within that block by double hashing (Kirsch and Mitzenmacher, "Less
+ * Hashing, Same Performance"), extended by a third term as proposed by
+ * Dillinger and Manolios. Adding or checking a key thus costs one hash and
+ * touches one cache line.
+ *
+ * Confining the bits of a key to a block raises the false positive rate over
+ * a classic filter of the same size. With 256 bit blocks and k = 6, it goes
+ * from 2.2 % to 2.6 % at 8 bits per key and from 0.09 % to 0.18 % at 16 bits
+ * per key.
+ *
+ * The counting variant (@ref bloom_counting_t) keeps a 4 bit counter instead
+ * of a bit per position, so keys can be removed again. Counters saturate at
+ * 15 and are never decremented from there, so removing keys never causes
+ * false negatives.
+ *
+ * For both variants, the hash can also be supplied by the caller, e.g.
+ * if a key is checked against several filters.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Blocked Bloom filter interface
+ */
+
+#ifndef BLOOM_BLOCKED_H
+#define BLOOM_BLOCKED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of a block in bytes, a power of two
+ *
+ * Should match the cache line size of the CPU, if it has a cache.
+ */
+#ifndef BLOOM_BLOCKED_BLOCK_SIZE
+#define BLOOM_BLOCKED_BLOCK_SIZE    (32U)
+#endif
+
+/**
+ * @brief   A blocked Bloom filter
+ */
+typedef struct {
+    uint8_t *a;             /**< the blocks */
+    size_t blocks;          /**< number of blocks */
+    unsigned k;             /**< positions per key */
+} bloom_blocked_t;
+
+/**
+ * @brief   A counting blocked Bloom filter
+ */
+typedef struct {
+    uint8_t *a;             /**< the blocks, two counters per byte */
+    size_t blocks;          /**< number of blocks */
+    unsigned k;             /**< positions per key */
+} bloom_counting_t;
+
+/**
+ * @brief   Hash @p len bytes of @p data into 64 bits
+ *
+ * Processes the key a word at a time. The result depends on the byte order
+ * of the CPU.
+ */
+uint64_t bloom_blocked_hash(const void *data, size_t len);
+
+/**
+ * @brief   Initialize and clear a filter
+ *
+ * @param[out] bloom    filter to initialize
+ * @param[in] buf       memory of the filter, ideally aligned to
+ *                      @ref BLOOM_BLOCKED_BLOCK_SIZE
+ * @param[in] size      size of @p buf in bytes, a non-zero multiple of
+ *                      @ref BLOOM_BLOCKED_BLOCK_SIZE
+ * @param[in] k         positions per key, 1 to 16
+ */
+void bloom_blocked_init(bloom_blocked_t *bloom, uint8_t *buf, size_t size,
+                        unsigned k);
+
+/**
+ * @brief   Remove all keys from @p bloom
+ */
+void bloom_blocked_clear(bloom_blocked_t *bloom);
+
+/**
+ * @brief   Add a key by its hash
+ *
+ * @param[in,out] bloom filter
+ * @param[in] hash      hash of the key as by bloom_blocked_hash()
+ */
+void bloom_blocked_add_hash(bloom_blocked_t *bloom, uint64_t hash);
+
+/**
+ * @brief   Check a key by its hash
+ *
+ * @return  false if the key was never added
+ * @return  true if the key was probably added
+ */
+bool bloom_blocked_check_hash(const bloom_blocked_t *bloom, uint64_t hash);
+
+/**
+ * @brief   Add @p len bytes of @p buf as key
+ */
+static inline void bloom_blocked_add(bloom_blocked_t *bloom, const void *buf,
+                                     size_t len)
+{
+    bloom_blocked_add_hash(bloom, bloom_blocked_hash(buf, len));
+}
+
+/**
+ * @brief   Check whether @p len bytes of @p buf were added as key
+ *
+ * @return  false if the key was never added
+ * @return  true if the key was probably added
+ */
+static inline bool bloom_blocked_check(const bloom_blocked_t *bloom,
+                                       const void *buf, size_t len)
+{
+    return bloom_blocked_check_hash(bloom, bloom_blocked_hash(buf, len));
+}
+
+/**
+ * @brief   Initialize and clear a counting filter
+ *
+ * @param[out] bloom    filter to initialize
+ * @param[in] buf       memory of the filter, ideally aligned to
+ *                      @ref BLOOM_BLOCKED_BLOCK_SIZE
+ * @param[in] size      size of @p buf in bytes, a non-zero multiple of
+ *                      @ref BLOOM_BLOCKED_BLOCK_SIZE
+ * @param[in] k         positions per key, 1 to 16
+ */
+void bloom_counting_init(bloom_counting_t *bloom, uint8_t *buf, size_t size,
+                         unsigned k);
+
+/**
+ * @brief   Remove all keys from @p bloom
+ */
+void bloom_counting_clear(bloom_counting_t *bloom);
+
+/**
+ * @brief   Add a key to a counting filter by its hash
+ */
+void bloom_counting_add_hash(bloom_counting_t *bloom, uint64_t hash);
+
+/**
+ * @brief   Remove a key from a counting filter by its hash
+ *
+ * Only remove keys that were added before, other keys' counters would be
+ * decremented otherwise.
+ */
+void bloom_counting_remove_hash(bloom_counting_t *bloom, uint64_t hash);
+
+/**
+ * @brief   Check a key against a counting filter by its hash
+ *
+ * @return  false if the key is not in the filter
+ * @return  true if the key is probably in the filter
+ */
+bool bloom_counting_check_hash(const bloom_counting_t *bloom, uint64_t hash);
+
+/**
+ * @brief   Add @p len bytes of @p buf as key to a counting filter
+ */
+static inline void bloom_counting_add(bloom_counting_t *bloom, const void *buf,
+                                      size_t len)
+{
+    bloom_counting_add_hash(bloom, bloom_blocked_hash(buf, len));
+}
+
+/**
+ * @brief   Remove @p len bytes of @p buf as key from a counting filter
+ */
+static inline void bloom_counting_remove(bloom_counting_t *bloom,
+                                         const void *buf, size_t len)
+{
+    bloom_counting_remove_hash(bloom, bloom_blocked_hash(buf, len));
+}
+
+/**
+ * @brief   Check whether @p len bytes of @p buf are in a counting filter
+ *
+ * @return  false if the key is not in the filter
+ * @return  true if the key is probably in the filter
+ */
+static inline bool bloom_counting_check(const bloom_counting_t *bloom,
+                                        const void *buf, size_t len)
+{
+    return bloom_counting_check_hash(bloom, bloom_blocked_hash(buf, len));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOOM_BLOCKED_H */
+/** @} */
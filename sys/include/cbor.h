@@ -94,6 +94,14 @@
  * -  24-31: (Reserved)      - No support
  * - 32-255: (Unassigned)    - No support
  *
+ * @par Cursor based decoding and streaming encoding
+ * Besides the offset based functions operating on a @ref cbor_stream_t,
+ * there is a cursor API (cbor_cursor_init(), cbor_get_int64(),
+ * cbor_get_text(), ...) which decodes items in place without copying strings
+ * and skips uninteresting items as a whole, and a writer API
+ * (cbor_writer_init(), cbor_put_uint(), ...) which encodes into a callback
+ * or a packet buffer snip chain instead of a fixed buffer.
+ *
  * @todo API for Indefinite-Length Byte Strings and Text Strings
  *       (see https://tools.ietf.org/html/rfc7049#section-2.2.2)
  */
@@ -114,6 +122,10 @@
 #include <time.h>
 #endif /* CBOR_NO_CTIME */
 
+#ifdef MODULE_GNRC_PKTBUF
+#include "net/gnrc/pktbuf.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -642,6 +654,540 @@ bool cbor_at_break(const cbor_stream_t *stream, size_t offset);
  */
 bool cbor_at_end(const cbor_stream_t *stream, size_t offset);
 
+/**
+ * @name Cursor based decoder
+ *
+ * The cursor API decodes CBOR items in place: strings are returned as views
+ * into the input buffer instead of being copied out, and items which are not
+ * of interest can be skipped as a whole.
+ *
+ * Basic usage (iterating over the keys and values of a map):
+ * @code
+ * cbor_cursor_t doc, map;
+ * cbor_cursor_init(&doc, buf, len);
+ * if (cbor_cursor_enter(&doc, &map) < 0) {
+ *     return;
+ * }
+ * while (cbor_cursor_peek(&map) != CBOR_ITEM_END) {
+ *     int64_t key;
+ *     if (cbor_get_int64(&map, &key) < 0) {
+ *         return;
+ *     }
+ *     if (key == 0) {
+ *         const char *name;
+ *         size_t name_len;
+ *         cbor_get_text(&map, &name, &name_len);
+ *     }
+ *     else {
+ *         cbor_cursor_skip(&map);
+ *     }
+ * }
+ * cbor_cursor_leave(&doc, &map);
+ * @endcode
+ *
+ * All `cbor_get_*()` functions only advance the cursor on success, so a
+ * caller may retry with a different type after a -EINVAL.
+ * @{
+ */
+
+/**
+ * @brief   Maximum nesting of indefinite length items cbor_cursor_skip() can
+ *          handle
+ *
+ * Definite length arrays and maps are skipped without recursion and are not
+ * limited by this value.
+ */
+#ifndef CBOR_CURSOR_MAX_NESTING
+#define CBOR_CURSOR_MAX_NESTING     (8)
+#endif
+
+/**
+ * @brief   Type of the item at a cursor's position, see cbor_cursor_peek()
+ */
+typedef enum {
+    CBOR_ITEM_INVALID = 0,      /**< malformed or truncated input */
+    CBOR_ITEM_END,              /**< no items left in the current container */
+    CBOR_ITEM_UINT,             /**< unsigned integer (major type 0) */
+    CBOR_ITEM_NEGINT,           /**< negative integer (major type 1) */
+    CBOR_ITEM_BYTES,            /**< byte string (major type 2) */
+    CBOR_ITEM_TEXT,             /**< text string (major type 3) */
+    CBOR_ITEM_ARRAY,            /**< array (major type 4) */
+    CBOR_ITEM_MAP,              /**< map (major type 5) */
+    CBOR_ITEM_TAG,              /**< semantic tag (major type 6) */
+    CBOR_ITEM_BOOL,             /**< true or false */
+    CBOR_ITEM_NULL,             /**< null */
+    CBOR_ITEM_UNDEFINED,        /**< undefined */
+    CBOR_ITEM_FLOAT,            /**< half, single or double precision float */
+    CBOR_ITEM_SIMPLE,           /**< any other simple value */
+} cbor_item_type_t;
+
+/**
+ * @brief   Read position within a CBOR encoded buffer
+ *
+ * A cursor iterates over the items of one level: either the top level
+ * sequence of items in a buffer or the items of a single array or map.
+ * The cursor does not own the buffer, which has to stay valid as long as the
+ * cursor or any view returned from it is used.
+ */
+typedef struct {
+    const uint8_t *pos;         /**< next item to decode */
+    const uint8_t *end;         /**< end of the buffer */
+    size_t remaining;           /**< items left on this level, SIZE_MAX if
+                                     bound by a break or the buffer end */
+    bool indefinite;            /**< level is terminated by a break */
+} cbor_cursor_t;
+
+/**
+ * @brief   Initialize @p cursor to iterate over the top level items in a buffer
+ *
+ * @param[out] cursor   cursor to initialize
+ * @param[in] buf       CBOR encoded data
+ * @param[in] len       length of @p buf in bytes
+ */
+void cbor_cursor_init(cbor_cursor_t *cursor, const uint8_t *buf, size_t len);
+
+/**
+ * @brief   Initialize @p cursor to iterate over the items in @p stream,
+ *          starting at @p offset
+ *
+ * @param[out] cursor   cursor to initialize
+ * @param[in] stream    stream holding the encoded data
+ * @param[in] offset    offset of the first item within @p stream
+ */
+void cbor_cursor_init_stream(cbor_cursor_t *cursor, const cbor_stream_t *stream,
+                             size_t offset);
+
+/**
+ * @brief   Get the type of the next item without consuming it
+ *
+ * @param[in] cursor    cursor to peek at
+ *
+ * @return  type of the next item
+ * @return  CBOR_ITEM_END if there are no more items on this level
+ * @return  CBOR_ITEM_INVALID if the input is malformed
+ */
+cbor_item_type_t cbor_cursor_peek(const cbor_cursor_t *cursor);
+
+/**
+ * @brief   Skip the next item, including all items nested in it
+ *
+ * String payloads are jumped over using their length and definite length
+ * arrays and maps are skipped by counting, without recursion.
+ *
+ * @param[in,out] cursor    cursor to advance
+ *
+ * @return  0 on success
+ * @return  -ENOENT if there is no item left on this level
+ * @return  -EBADMSG if the item is malformed, truncated or nested too deeply
+ */
+int cbor_cursor_skip(cbor_cursor_t *cursor);
+
+/**
+ * @brief   Enter the array or map at the position of @p cursor
+ *
+ * @p cursor itself is not advanced; call cbor_cursor_leave() when done with
+ * @p inner. For maps, @p inner iterates over keys and values alternately.
+ *
+ * @param[in] cursor    cursor positioned at an array or map
+ * @param[out] inner    cursor for the items of the container
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the next item is not an array or map
+ * @return  -EBADMSG if the header is malformed
+ */
+int cbor_cursor_enter(const cbor_cursor_t *cursor, cbor_cursor_t *inner);
+
+/**
+ * @brief   Leave a container entered with cbor_cursor_enter()
+ *
+ * Items of the container which have not been consumed through @p inner are
+ * skipped, afterwards @p cursor points behind the container.
+ *
+ * @param[in,out] cursor    cursor passed to cbor_cursor_enter()
+ * @param[in] inner         cursor of the container
+ *
+ * @return  0 on success
+ * @return  -EBADMSG if the rest of the container is malformed
+ */
+int cbor_cursor_leave(cbor_cursor_t *cursor, const cbor_cursor_t *inner);
+
+/**
+ * @brief   Decode an unsigned integer
+ *
+ * @param[in,out] cursor    cursor to decode from
+ * @param[out] val          decoded value
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the next item is not an unsigned integer
+ * @return  -EBADMSG if the item is truncated
+ */
+int cbor_get_uint(cbor_cursor_t *cursor, uint64_t *val);
+
+/**
+ * @brief   Decode a signed or unsigned integer
+ *
+ * @param[in,out] cursor    cursor to decode from
+ * @param[out] val          decoded value
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the next item is not an integer
+ * @return  -ERANGE if the value does not fit into an int64_t
+ * @return  -EBADMSG if the item is truncated
+ */
+int cbor_get_int64(cbor_cursor_t *cursor, int64_t *val);
+
+/**
+ * @brief   Decode a signed or unsigned integer into an int
+ *
+ * @see cbor_get_int64()
+ */
+int cbor_get_int(cbor_cursor_t *cursor, int *val);
+
+/**
+ * @brief   Decode a boolean value
+ *
+ * @param[in,out] cursor    cursor to decode from
+ * @param[out] val          decoded value
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the next item is not true or false
+ */
+int cbor_get_bool(cbor_cursor_t *cursor, bool *val);
+
+/**
+ * @brief   Consume a null value
+ *
+ * @param[in,out] cursor    cursor to decode from
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the next item is not null
+ */
+int cbor_get_null(cbor_cursor_t *cursor);
+
+#ifndef CBOR_NO_FLOAT
+/**
+ * @brief   Decode a half, single or double precision float
+ *
+ * @param[in,out] cursor    cursor to decode from
+ * @param[out] val          decoded value
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the next item is not a float
+ * @return  -EBADMSG if the item is truncated
+ */
+int cbor_get_double(cbor_cursor_t *cursor, double *val);
+
+/**
+ * @brief   Decode a half, single or double precision float into a float
+ *
+ * @see cbor_get_double()
+ */
+int cbor_get_float(cbor_cursor_t *cursor, float *val);
+#endif /* CBOR_NO_FLOAT */
+
+/**
+ * @brief   Get a view of a definite length byte string
+ *
+ * @param[in,out] cursor    cursor to decode from
+ * @param[out] data         start of the string within the buffer
+ * @param[out] len          length of the string
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the next item is not a byte string
+ * @return  -ENOTSUP if the string has indefinite length (use
+ *          cbor_cursor_enter() on it to walk its chunks)
+ * @return  -EBADMSG if the string is truncated
+ */
+int cbor_get_bytes(cbor_cursor_t *cursor, const uint8_t **data, size_t *len);
+
+/**
+ * @brief   Get a view of a definite length text string
+ *
+ * @note    The string is *not* zero-terminated.
+ *
+ * @see cbor_get_bytes()
+ */
+int cbor_get_text(cbor_cursor_t *cursor, const char **str, size_t *len);
+
+/**
+ * @brief   Decode a semantic tag
+ *
+ * The tagged item follows and is decoded separately. Tag and item count as a
+ * single item of the enclosing container.
+ *
+ * @param[in,out] cursor    cursor to decode from
+ * @param[out] tag          tag number
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the next item is not a tag
+ * @return  -EBADMSG if the tag is truncated
+ */
+int cbor_get_tag(cbor_cursor_t *cursor, uint64_t *tag);
+/** @} */
+
+/**
+ * @name Streaming encoder
+ *
+ * The writer hands encoded data to a callback in chunks of up to
+ * @ref CBOR_WRITER_BUFSIZE bytes, so a document can be produced without
+ * allocating a buffer for all of it. Strings larger than the staging buffer
+ * are passed to the callback directly.
+ *
+ * Errors are sticky: once a `cbor_put_*()` call failed, all following calls
+ * return the same error, so it suffices to check the result of
+ * cbor_writer_finish().
+ * @{
+ */
+
+/**
+ * @brief   Size of the writer's staging buffer
+ *
+ * Must be large enough for the longest item header (9 bytes).
+ */
+#ifndef CBOR_WRITER_BUFSIZE
+#define CBOR_WRITER_BUFSIZE         (32)
+#endif
+
+/**
+ * @brief   Sink for encoded data
+ *
+ * @param[in] arg   argument given to cbor_writer_init()
+ * @param[in] data  encoded data
+ * @param[in] len   length of @p data, never 0
+ *
+ * @return  0 on success
+ * @return  negative errno on error; the writer will stop calling the sink
+ */
+typedef int (*cbor_writer_cb_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Streaming CBOR encoder
+ */
+typedef struct {
+    cbor_writer_cb_t cb;                /**< sink for encoded data */
+    void *arg;                          /**< argument for @ref cb */
+    size_t len;                         /**< total number of bytes encoded */
+    int error;                          /**< first error that occurred */
+    uint8_t fill;                       /**< bytes in @ref buf */
+    uint8_t buf[CBOR_WRITER_BUFSIZE];   /**< staging buffer */
+} cbor_writer_t;
+
+/**
+ * @brief   Initialize a writer passing encoded data to @p cb
+ *
+ * @param[out] writer   writer to initialize
+ * @param[in] cb        sink for encoded data
+ * @param[in] arg       argument for @p cb
+ */
+void cbor_writer_init(cbor_writer_t *writer, cbor_writer_cb_t cb, void *arg);
+
+/**
+ * @brief   Initialize a writer appending to @p stream
+ *
+ * The writer fails with -ENOBUFS once @p stream is full.
+ *
+ * @param[out] writer   writer to initialize
+ * @param[in] stream    stream to append to
+ */
+void cbor_writer_init_stream(cbor_writer_t *writer, cbor_stream_t *stream);
+
+#if defined(MODULE_GNRC_PKTBUF) || defined(DOXYGEN)
+/**
+ * @brief   Initialize a writer appending to a packet snip chain
+ *
+ * Every flush of the writer appends a new snip of type GNRC_NETTYPE_UNDEF
+ * to the chain at @p pkt, which may be NULL initially. The writer fails with
+ * -ENOMEM once the packet buffer is full; the chain built so far is left to
+ * the caller to release.
+ *
+ * @param[out] writer   writer to initialize
+ * @param[in,out] pkt   head of the snip chain
+ */
+void cbor_writer_init_pktbuf(cbor_writer_t *writer, gnrc_pktsnip_t **pkt);
+#endif
+
+/**
+ * @brief   Pass all staged data to the sink
+ *
+ * @param[in,out] writer    writer to flush
+ *
+ * @return  0 on success
+ * @return  the writer's error if encoding or the sink failed before
+ */
+int cbor_writer_flush(cbor_writer_t *writer);
+
+/**
+ * @brief   Finish encoding
+ *
+ * Flushes the writer. On success, cbor_writer_t::len holds the length of the
+ * encoded document.
+ *
+ * @param[in,out] writer    writer to finish
+ *
+ * @return  0 on success
+ * @return  the writer's error if encoding or the sink failed before
+ */
+int cbor_writer_finish(cbor_writer_t *writer);
+
+/**
+ * @brief   Encode an unsigned integer
+ *
+ * @param[in,out] writer    writer to encode to
+ * @param[in] val           value to encode
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_uint(cbor_writer_t *writer, uint64_t val);
+
+/**
+ * @brief   Encode a signed integer
+ *
+ * @param[in,out] writer    writer to encode to
+ * @param[in] val           value to encode
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_int(cbor_writer_t *writer, int64_t val);
+
+/**
+ * @brief   Encode a boolean value
+ *
+ * @param[in,out] writer    writer to encode to
+ * @param[in] val           value to encode
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_bool(cbor_writer_t *writer, bool val);
+
+/**
+ * @brief   Encode a null value
+ *
+ * @param[in,out] writer    writer to encode to
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_null(cbor_writer_t *writer);
+
+#ifndef CBOR_NO_FLOAT
+/**
+ * @brief   Encode a single precision float
+ *
+ * @param[in,out] writer    writer to encode to
+ * @param[in] val           value to encode
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_float(cbor_writer_t *writer, float val);
+
+/**
+ * @brief   Encode a double precision float
+ *
+ * @param[in,out] writer    writer to encode to
+ * @param[in] val           value to encode
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_double(cbor_writer_t *writer, double val);
+#endif /* CBOR_NO_FLOAT */
+
+/**
+ * @brief   Encode a byte string
+ *
+ * @param[in,out] writer    writer to encode to
+ * @param[in] data          string to encode
+ * @param[in] len           length of @p data
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_bytes(cbor_writer_t *writer, const void *data, size_t len);
+
+/**
+ * @brief   Encode a text string
+ *
+ * @param[in,out] writer    writer to encode to
+ * @param[in] str           string to encode, need not be zero-terminated
+ * @param[in] len           length of @p str
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_text(cbor_writer_t *writer, const char *str, size_t len);
+
+/**
+ * @brief   Encode the header of an array of @p len items
+ *
+ * @param[in,out] writer    writer to encode to
+ * @param[in] len           number of items that follow
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_array(cbor_writer_t *writer, size_t len);
+
+/**
+ * @brief   Encode the header of a map of @p len key-value pairs
+ *
+ * @param[in,out] writer    writer to encode to
+ * @param[in] len           number of key-value pairs that follow
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_map(cbor_writer_t *writer, size_t len);
+
+/**
+ * @brief   Encode the header of an indefinite length array
+ *
+ * Terminate the array with cbor_put_break().
+ *
+ * @param[in,out] writer    writer to encode to
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_array_indefinite(cbor_writer_t *writer);
+
+/**
+ * @brief   Encode the header of an indefinite length map
+ *
+ * Terminate the map with cbor_put_break().
+ *
+ * @param[in,out] writer    writer to encode to
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_map_indefinite(cbor_writer_t *writer);
+
+/**
+ * @brief   Encode a break, terminating an indefinite length item
+ *
+ * @param[in,out] writer    writer to encode to
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_break(cbor_writer_t *writer);
+
+/**
+ * @brief   Encode a semantic tag for the item that follows
+ *
+ * @param[in,out] writer    writer to encode to
+ * @param[in] tag           tag number
+ *
+ * @return  0 on success
+ * @return  negative errno on error
+ */
+int cbor_put_tag(cbor_writer_t *writer, uint64_t tag);
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
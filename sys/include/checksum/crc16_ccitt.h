@@ -17,6 +17,12 @@
  *              crc16_ccitt_update() with the desired start value
  *              instead of crc16_ccitt_calc().
  *
+ *              The CRC is computed with slicing-by-4 on 32 bit platforms,
+ *              which processes four bytes per iteration with four lookup
+ *              tables of 512 bytes each. Define `CRC16_CCITT_SLICES` to 8
+ *              for slicing-by-8 (4 KiB of tables) or to 1 for the classic
+ *              byte wise algorithm with a single table.
+ *
  * @{
  * @file
  * @author      Ludwig Knüpfer <ludwig.knuepfer@fu-berlin.de>
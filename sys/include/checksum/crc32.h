@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc32 CRC32
+ * @ingroup     sys_checksum
+ *
+ * @brief       CRC32 checksum algorithms
+ * @details     Two variants of the reflected 32 bit CRC with an initial value
+ *              and final XOR of 0xFFFFFFFF are provided:
+ *              - crc32_ieee_calc() with the polynomial 0x04C11DB7 used by
+ *                Ethernet, zlib and PNG, check value 0xCBF43926
+ *              - crc32c_calc() with the Castagnoli polynomial 0x1EDC6F41
+ *                used by iSCSI, SCTP and ext4, check value 0xE3069283
+ *
+ *              Both are computed with slicing-by-4 on 32 bit platforms, i.e.
+ *              four bytes per iteration with four lookup tables of 1 KiB
+ *              each. Define `CRC32_SLICES` to 8 for slicing-by-8 (8 KiB of
+ *              tables per polynomial) or to 1 for the classic byte wise
+ *              algorithm with a single table.
+ *
+ *              On x86 CPUs with SSE 4.2, e.g. on native, crc32c_update() uses
+ *              the `crc32` instruction. CPUs with a CRC unit for the IEEE
+ *              polynomial can define `HAVE_CRC32_HW` in their cpu_conf.h and
+ *              implement crc32_hw_update(), which crc32_ieee_update() then
+ *              calls instead.
+ *
+ * @{
+ * @file
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief           Update CRC32 with the IEEE polynomial
+ *
+ * @param[in]  crc  0 for the first block, the return value of the previous
+ *                  call otherwise
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of all memory areas passed so far
+ */
+uint32_t crc32_ieee_update(uint32_t crc, const unsigned char *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC32 with the IEEE polynomial
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area
+ */
+static inline uint32_t crc32_ieee_calc(const unsigned char *buf, size_t len)
+{
+    return crc32_ieee_update(0, buf, len);
+}
+
+/**
+ * @brief           Update CRC32 with the Castagnoli polynomial
+ *
+ * @param[in]  crc  0 for the first block, the return value of the previous
+ *                  call otherwise
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of all memory areas passed so far
+ */
+uint32_t crc32c_update(uint32_t crc, const unsigned char *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC32 with the Castagnoli polynomial
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area
+ */
+static inline uint32_t crc32c_calc(const unsigned char *buf, size_t len)
+{
+    return crc32c_update(0, buf, len);
+}
+
+/**
+ * @brief           CRC32 with the IEEE polynomial in hardware, provided by
+ *                  the CPU if it defines `HAVE_CRC32_HW`
+ *
+ * Must behave exactly like crc32_ieee_update().
+ */
+uint32_t crc32_hw_update(uint32_t crc, const unsigned char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC32_H */
+
+/** @} */
@@ -122,6 +122,42 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
 int aes_decrypt(const cipher_context_t *context, const uint8_t *cipher_block,
                 uint8_t *plain_block);
 
+/**
+ * @brief   encrypts nblocks consecutive blocks
+ *
+ * The key schedule is expanded only once per call. Depending on the build
+ * this uses AES-NI (x86 with `-maes`), the constant-time implementation
+ * (module `crypto_aes_ct`) or the default T-table implementation.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            encryption
+ * @param       plain         the plaintext blocks
+ * @param       cipher        where to store the ciphertext, may be equal to
+ *                            @p plain
+ * @param       nblocks       number of blocks
+ *
+ * @return  1 or negative value if the key cannot be expanded
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *plain,
+                       uint8_t *cipher, size_t nblocks);
+
+/**
+ * @brief   decrypts nblocks consecutive blocks
+ *
+ * @see aes_encrypt_blocks()
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            decryption
+ * @param       cipher        the ciphertext blocks
+ * @param       plain         where to store the plaintext, may be equal to
+ *                            @p cipher
+ * @param       nblocks       number of blocks
+ *
+ * @return  1 or negative value if the key cannot be expanded
+ */
+int aes_decrypt_blocks(const cipher_context_t *context, const uint8_t *cipher,
+                       uint8_t *plain, size_t nblocks);
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,6 +41,24 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Number of blocks the keystream generator computes in parallel
+ */
+#if defined(__AVX2__)
+#define CHACHA_PAR_BLOCKS (8)
+#elif defined(__SSE2__)
+#define CHACHA_PAR_BLOCKS (4)
+#else
+#define CHACHA_PAR_BLOCKS (1)
+#endif
+
+/**
+ * @brief Number of keystream blocks the PRNG buffers
+ */
+#ifndef CHACHA_PRNG_BLOCKS
+#define CHACHA_PRNG_BLOCKS (4)
+#endif
+
 /**
  * @brief A ChaCha cipher stream context.
  * @details Initialize with chacha_init().
@@ -82,6 +100,17 @@ int chacha_init(chacha_ctx *ctx,
  */
 void chacha_keystream_bytes(chacha_ctx *ctx, void *x);
 
+/**
+ * @brief Generate the next @p nblocks blocks of the keystream.
+ *
+ * @details Up to CHACHA_PAR_BLOCKS blocks are computed at once.
+ *
+ * @param[in,out] ctx      The ChaCha context
+ * @param[out]    x        The keystream (`sizeof(x) == 64 * nblocks`).
+ * @param[in]     nblocks  Number of blocks to generate.
+ */
+void chacha_keystream_blocks(chacha_ctx *ctx, void *x, size_t nblocks);
+
 /**
  * @brief Encode or decode a block of data.
  *
@@ -97,6 +126,21 @@ void chacha_keystream_bytes(chacha_ctx *ctx, void *x);
  */
 void chacha_encrypt_bytes(chacha_ctx *ctx, const uint8_t *m, uint8_t *c);
 
+/**
+ * @brief Encode or decode @p len bytes of data.
+ *
+ * @details The keystream is generated CHACHA_PAR_BLOCKS blocks at a time.
+ *          If @p len is not a multiple of 64 the rest of the last keystream
+ *          block is discarded, so a following call starts with a new block.
+ *
+ * @param[in,out] ctx The ChaCha context.
+ * @param[in]     m   The input.
+ * @param[out]    c   The output, may be equal to @p m.
+ * @param[in]     len Length of @p m and @p c in bytes.
+ */
+void chacha_encrypt_bytes_n(chacha_ctx *ctx, const uint8_t *m, uint8_t *c,
+                            size_t len);
+
 /**
  * @copydoc chacha_encrypt_bytes()
  */
@@ -133,6 +177,17 @@ void chacha_prng_seed(const void *data, size_t bytes);
  */
 uint32_t chacha_prng_next(void);
 
+/**
+ * @brief Fill a buffer from the pseudo-random number generator.
+ *
+ * @details Buffered output is used first, larger requests are generated
+ *          directly into @p buf, CHACHA_PAR_BLOCKS blocks at a time.
+ *
+ * @param[out] buf   Destination buffer.
+ * @param[in]  len   Number of bytes to generate.
+ */
+void chacha_prng_bytes(void *buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
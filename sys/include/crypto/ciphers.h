@@ -22,6 +22,7 @@
 #ifndef __CIPHERS_H_
 #define __CIPHERS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -41,6 +42,14 @@ extern "C" {
 #define CIPHERS_MAX_KEY_SIZE 20
 #define CIPHER_MAX_BLOCK_SIZE 16
 
+/**
+ * @brief   Size of the buffer the block cipher modes use to pass several
+ *          blocks at once to cipher_encrypt_blocks()
+ */
+#ifndef CIPHER_MODES_BATCH_SIZE
+#define CIPHER_MODES_BATCH_SIZE (4 * CIPHER_MAX_BLOCK_SIZE)
+#endif
+
 
 /**
  * Context sizes needed for the different ciphers.
@@ -97,6 +106,20 @@ typedef struct cipher_interface_st {
     /** the decrypt function */
     int (*decrypt)(const cipher_context_t* ctx, const uint8_t* cipher_block,
                    uint8_t* plain_block);
+
+    /**
+     * @brief   the multi-block encrypt function (optional, may be NULL)
+     *
+     * Encrypts @p nblocks consecutive blocks from @p plain to @p cipher.
+     * Implementations can use this to expand the key schedule only once per
+     * call and to process several blocks in parallel.
+     */
+    int (*encrypt_blocks)(const cipher_context_t* ctx, const uint8_t* plain,
+                          uint8_t* cipher, size_t nblocks);
+
+    /** the multi-block decrypt function (optional, may be NULL) */
+    int (*decrypt_blocks)(const cipher_context_t* ctx, const uint8_t* cipher,
+                          uint8_t* plain, size_t nblocks);
 } cipher_interface_t;
 
 
@@ -155,6 +178,42 @@ int cipher_encrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output);
 
 
+/**
+ * @brief Encrypt @p nblocks consecutive blocks of BLOCK_SIZE length
+ *
+ * Uses the multi-block function of the cipher if it provides one and falls
+ * back to calling cipher_encrypt() for each block otherwise. @p input and
+ * @p output may be the same buffer.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to input data to encrypt
+ * @param output     pointer to allocated memory for encrypted data. It has to
+ *                   be of size nblocks * BLOCK_SIZE
+ * @param nblocks    number of blocks to encrypt
+ *
+ * @return           1 on success, negative value on error
+ */
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t nblocks);
+
+
+/**
+ * @brief Decrypt @p nblocks consecutive blocks of BLOCK_SIZE length
+ *
+ * @see cipher_encrypt_blocks()
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to input data to decrypt
+ * @param output     pointer to allocated memory for decrypted data. It has to
+ *                   be of size nblocks * BLOCK_SIZE
+ * @param nblocks    number of blocks to decrypt
+ *
+ * @return           1 on success, negative value on error
+ */
+int cipher_decrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t nblocks);
+
+
 /**
  * @brief Get block size of cipher
  * *
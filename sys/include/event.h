@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event Event Queue
+ * @ingroup     sys
+ * @brief       Provides an event loop
+ *
+ * This module offers an event queue framework like libevent or libuv.
+ *
+ * An event queue is basically a FIFO queue of events, with some functions to
+ * efficiently and safely handle adding and getting events to / from such a
+ * queue.
+ *
+ * An event queue is bound to a thread, but any thread or ISR can put events
+ * into a queue. Events are plain structures containing a handler function,
+ * so many subsystems can share the stack and the message queue of a single
+ * thread instead of spending a thread each. Handing work from one subsystem
+ * to another in the same thread is a plain function call instead of a
+ * context switch.
+ *
+ * An event can be queued only once at a time. Posting an event that is
+ * already queued has no effect. Events are not copied, so they must stay
+ * valid until they have been handled or canceled.
+ *
+ * Example:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * #include "event.h"
+ *
+ * static void handler(event_t *event)
+ * {
+ *     printf("triggered 0x%08x\n", (unsigned)event);
+ * }
+ *
+ * static event_t event = { .handler = handler };
+ * static event_queue_t queue;
+ *
+ * int main(void)
+ * {
+ *     event_queue_init(&queue);
+ *     event_loop(&queue);
+ * }
+ *
+ * [...] event_post(&queue, &event);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Delayed events are provided by the `event_timeout` module
+ * (@ref event/timeout.h), events that carry a callback and an argument by
+ * @ref event/callback.h.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event API
+ */
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <stdint.h>
+
+#include "clist.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Thread flag used by event queues to wake up their thread
+ */
+#ifndef THREAD_FLAG_EVENT
+#define THREAD_FLAG_EVENT   (0x1)
+#endif
+
+/**
+ * @brief   event_queue_t static initializer
+ *
+ * The queue has no owner yet, its thread must call event_queue_claim()
+ * before waiting on it. Events can be posted before.
+ */
+#define EVENT_QUEUE_INIT    { .waiter = NULL }
+
+/**
+ * @brief   event_t forward declaration
+ */
+typedef struct event event_t;
+
+/**
+ * @brief   event handler type definition
+ */
+typedef void (*event_handler_t)(event_t *);
+
+/**
+ * @brief   event structure
+ */
+struct event {
+    clist_node_t list_node;     /**< event queue list entry, NULL if the
+                                     event is not queued */
+    event_handler_t handler;    /**< pointer to event handler function */
+};
+
+/**
+ * @brief   event queue structure
+ */
+typedef struct {
+    clist_node_t event_list;    /**< list of queued events */
+    thread_t *waiter;           /**< thread owning the event queue */
+} event_queue_t;
+
+/**
+ * @brief   Initialize an event queue
+ *
+ * This will set the calling thread as owner of @p queue.
+ *
+ * @param[out]  queue   event queue object to initialize
+ */
+void event_queue_init(event_queue_t *queue);
+
+/**
+ * @brief   Set the calling thread as owner of a statically initialized queue
+ *
+ * @param[in,out] queue event queue initialized by @ref EVENT_QUEUE_INIT
+ */
+void event_queue_claim(event_queue_t *queue);
+
+/**
+ * @brief   Queue an event
+ *
+ * Can be called from interrupt context.
+ *
+ * @param[in]   queue   event queue to queue event in
+ * @param[in]   event   event to queue in event queue
+ */
+void event_post(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Cancel a queued event
+ *
+ * This will remove a queued event from an event queue. Can be called from
+ * interrupt context.
+ *
+ * @note    Due to the underlying list implementation, this will run in O(n).
+ *
+ * @param[in]   queue   event queue to remove event from
+ * @param[in]   event   event to remove from queue
+ */
+void event_cancel(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Get next event from event queue, non-blocking
+ *
+ * In order to handle an event retrieved using this function,
+ * call event->handler(event).
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @returns     pointer to next event
+ * @returns     NULL if no event available
+ */
+event_t *event_get(event_queue_t *queue);
+
+/**
+ * @brief   Get next event from event queue, blocking
+ *
+ * This function will block until an event becomes available.
+ *
+ * In order to handle an event retrieved using this function,
+ * call event->handler(event).
+ *
+ * @warning This function can only be called by the thread owning @p queue.
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @returns     pointer to next event
+ */
+event_t *event_wait(event_queue_t *queue);
+
+/**
+ * @brief   Simple event loop
+ *
+ * This function will forever sit in a loop, waiting for events to be queued
+ * and executing their handlers.
+ *
+ * It is pretty much defined as:
+ *
+ *     while ((event = event_wait(queue))) {
+ *         event->handler(event);
+ *     }
+ *
+ * @param[in]   queue   event queue to process
+ */
+void event_loop(event_queue_t *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_H */
+/** @} */
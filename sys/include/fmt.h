@@ -11,6 +11,27 @@
  * @ingroup     sys
  * @brief       Provides simple string formatting functions
  *
+ * The fmt_* functions convert values into a buffer and return the number of
+ * characters written. They are much smaller and faster than printf(), as
+ * they need no format string parsing and convert two decimal digits per
+ * division.
+ *
+ * To send many small pieces of output, e.g. lines of CSV telemetry, use a
+ * @ref fmt_writer_t. It formats values straight into a buffer, which is only
+ * passed to the output function once it is full or flushed:
+ *
+ * @code
+ * char buf[64];
+ * fmt_writer_t w;
+ *
+ * fmt_writer_init(&w, buf, sizeof(buf), print);
+ * fmt_writer_u32_dec(&w, xtimer_now());
+ * fmt_writer_char(&w, ',');
+ * fmt_writer_s32_dfp(&w, temperature, 2);
+ * fmt_writer_char(&w, '\n');
+ * fmt_writer_flush(&w);
+ * @endcode
+ *
  * @{
  *
  * @file
@@ -101,6 +122,19 @@ size_t fmt_u64_hex(char *out, uint64_t val);
  */
 size_t fmt_u32_dec(char *out, uint32_t val);
 
+/**
+ * @brief Convert a uint64 value to decimal string.
+ *
+ * If @p out is NULL, will only return the number of bytes that would have
+ * been written.
+ *
+ * @param[out]  out  Pointer to output buffer, or NULL
+ * @param[in]   val  Value to convert
+ *
+ * @return      nr of digits written to (or needed in) @p out
+ */
+size_t fmt_u64_dec(char *out, uint64_t val);
+
 /**
  * @brief Convert a uint16 value to decimal string.
  *
@@ -172,6 +206,44 @@ size_t fmt_s16_dec(char *out, int16_t val);
  */
 size_t fmt_s16_dfp(char *out, int16_t val, unsigned fp_digits);
 
+/**
+ * @brief Convert 32-bit fixed point number to a decimal string
+ *
+ * Same as fmt_s16_dfp(), but for 32-bit values and up to 9 digits after the
+ * decimal point.
+ *
+ * @param[out] out          Pointer to the output buffer, or NULL
+ * @param[in]  val          Fixed point value
+ * @param[in]  fp_digits    Number of digits after the decimal point, <= 9
+ *
+ * @return      Length of the resulting string
+ * @return      0 if @p fp_digits is > 9
+ */
+size_t fmt_s32_dfp(char *out, int32_t val, unsigned fp_digits);
+
+/**
+ * @brief Convert a float value to a decimal string
+ *
+ * Writes the integer part, a decimal point and @p precision digits, rounded
+ * half up, e.g. "-12.35" for -12.345 and a precision of 2. Without a
+ * precision, the decimal point is left out. NaN and values beyond the range
+ * of a uint64 are written as "nan" and "inf" resp. "-inf".
+ *
+ * Does not need the float support of printf(), only float arithmetics and
+ * conversions. At most 29 characters are written.
+ *
+ * If @p out is NULL, will only return the number of bytes that would have
+ * been written.
+ *
+ * @param[out] out          Pointer to the output buffer, or NULL
+ * @param[in]  f            Value to convert
+ * @param[in]  precision    Number of digits after the decimal point, values
+ *                          above 7 are treated as 7
+ *
+ * @return      Length of the resulting string
+ */
+size_t fmt_float(char *out, float f, unsigned precision);
+
 /**
  * @brief Count characters until '\0' (exclusive) in @p str
  *
@@ -202,10 +274,50 @@ size_t fmt_str(char *out, const char *str);
  * @param[out]  str  Pointer to string to read from
  * @param[in]   n    Maximum nr of characters to consider
  *
- * @return      nr of digits read
+ * @return      converted value
  */
 uint32_t scn_u32_dec(const char *str, size_t n);
 
+/**
+ * @brief Convert an optionally signed decimal number to int32
+ *
+ * Accepts a leading '-' or '+', otherwise behaves like scn_u32_dec().
+ *
+ * @param[in]   str  Pointer to string to read from
+ * @param[in]   n    Maximum nr of characters to consider
+ *
+ * @return      converted value
+ */
+int32_t scn_s32_dec(const char *str, size_t n);
+
+/**
+ * @brief Convert hex digits to uint32
+ *
+ * Will convert up to @p n digits, upper or lower case, without a "0x"
+ * prefix. Stops at any non-hex-digit or '\0' character.
+ *
+ * @param[in]   str  Pointer to string to read from
+ * @param[in]   n    Maximum nr of characters to consider
+ *
+ * @return      converted value
+ */
+uint32_t scn_u32_hex(const char *str, size_t n);
+
+/**
+ * @brief Convert a decimal number to a 32-bit fixed point value
+ *
+ * The counterpart of fmt_s32_dfp(): "-35.48" becomes -3548 for
+ * @p fp_digits = 2, "12.1" becomes 1210 and "7" becomes 700. Surplus
+ * digits after the decimal point are cut off.
+ *
+ * @param[in]   str         Pointer to string to read from
+ * @param[in]   n           Maximum nr of characters to consider
+ * @param[in]   fp_digits   Number of digits after the decimal point
+ *
+ * @return      converted value
+ */
+int32_t scn_s32_dfp(const char *str, size_t n, unsigned fp_digits);
+
 /**
  * @brief Print string to stdout
  *
@@ -230,6 +342,21 @@ void print_u32_dec(uint32_t val);
  */
 void print_s32_dec(int32_t val);
 
+/**
+ * @brief Print uint64 value to stdout
+ *
+ * @param[in]   val  Value to print
+ */
+void print_u64_dec(uint64_t val);
+
+/**
+ * @brief Print float value to stdout
+ *
+ * @param[in]   f           Value to print
+ * @param[in]   precision   Number of digits after the decimal point
+ */
+void print_float(float f, unsigned precision);
+
 /**
  * @brief Print uint32 value as hex to stdout
  *
@@ -251,6 +378,96 @@ void print_u64_hex(uint64_t val);
  */
 void print_str(const char* str);
 
+/**
+ * @brief Output function of a @ref fmt_writer_t, e.g. print()
+ */
+typedef void (*fmt_write_t)(const char *s, size_t n);
+
+/**
+ * @brief Buffered writer
+ */
+typedef struct {
+    fmt_write_t write;      /**< output function */
+    char *buf;              /**< buffer */
+    size_t size;            /**< size of fmt_writer_t::buf */
+    size_t pos;             /**< number of characters in fmt_writer_t::buf */
+} fmt_writer_t;
+
+/**
+ * @brief Initialize a buffered writer
+ *
+ * Values are formatted in place if @p size is at least 32 characters, via
+ * a temporary buffer otherwise.
+ *
+ * @param[out]  writer  Writer to initialize
+ * @param[in]   buf     Buffer to collect output in
+ * @param[in]   size    Size of @p buf
+ * @param[in]   write   Output function, print() if NULL
+ */
+void fmt_writer_init(fmt_writer_t *writer, char *buf, size_t size,
+                     fmt_write_t write);
+
+/**
+ * @brief Pass all buffered output to the output function
+ *
+ * @param[in,out] writer  Writer to flush
+ */
+void fmt_writer_flush(fmt_writer_t *writer);
+
+/**
+ * @brief Append @p n characters to a writer
+ *
+ * Chunks that do not fit the buffer are passed on directly.
+ *
+ * @param[in,out] writer  Writer to append to
+ * @param[in]     s       Characters to append
+ * @param[in]     n       Number of characters
+ */
+void fmt_writer_write(fmt_writer_t *writer, const char *s, size_t n);
+
+/**
+ * @brief Append a character to a writer
+ */
+void fmt_writer_char(fmt_writer_t *writer, char c);
+
+/**
+ * @brief Append a null-terminated string to a writer
+ */
+static inline void fmt_writer_str(fmt_writer_t *writer, const char *str)
+{
+    fmt_writer_write(writer, str, fmt_strlen(str));
+}
+
+/**
+ * @brief Append a uint32 value to a writer, see fmt_u32_dec()
+ */
+void fmt_writer_u32_dec(fmt_writer_t *writer, uint32_t val);
+
+/**
+ * @brief Append an int32 value to a writer, see fmt_s32_dec()
+ */
+void fmt_writer_s32_dec(fmt_writer_t *writer, int32_t val);
+
+/**
+ * @brief Append a uint64 value to a writer, see fmt_u64_dec()
+ */
+void fmt_writer_u64_dec(fmt_writer_t *writer, uint64_t val);
+
+/**
+ * @brief Append a uint32 value as hex to a writer, see fmt_u32_hex()
+ */
+void fmt_writer_u32_hex(fmt_writer_t *writer, uint32_t val);
+
+/**
+ * @brief Append a fixed point value to a writer, see fmt_s32_dfp()
+ */
+void fmt_writer_s32_dfp(fmt_writer_t *writer, int32_t val, unsigned fp_digits);
+
+/**
+ * @brief Append a float value to a writer, see fmt_float()
+ */
+void fmt_writer_float(fmt_writer_t *writer, float f, unsigned precision);
+
 #ifdef __cplusplus
 }
 #endif
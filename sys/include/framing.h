@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_framing Byte stuffing
+ * @ingroup     sys
+ * @brief       Escaping and unescaping of byte stuffed serial frames
+ *
+ * SLIP (RFC 1055) and the HDLC-like framing used by ethos (RFC 1662) both
+ * mark frame boundaries with a delimiter byte and replace every delimiter
+ * or escape byte in the payload by the escape byte followed by a
+ * substitute. They only differ in the four bytes involved, which are
+ * described by a @ref framing_t.
+ *
+ * Instead of handling every byte on its own, the functions search for the
+ * next byte that needs escaping a machine word at a time and copy
+ * everything in front of it at once, so payloads with few special bytes are
+ * processed at almost memcpy() speed.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Byte stuffing interface
+ */
+
+#ifndef FRAMING_H
+#define FRAMING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Description of a byte stuffing scheme
+ */
+typedef struct {
+    uint8_t end;            /**< frame delimiter */
+    uint8_t esc;            /**< escape byte */
+    uint8_t esc_end;        /**< substitute for framing_t::end after the escape byte */
+    uint8_t esc_esc;        /**< substitute for framing_t::esc after the escape byte */
+} framing_t;
+
+/**
+ * @brief   SLIP framing (0xc0, 0xdb, 0xdc, 0xdd)
+ */
+extern const framing_t framing_slip;
+
+/**
+ * @brief   HDLC-like framing as used by ethos (0x7e, 0x7d, substitutes XOR 0x20)
+ */
+extern const framing_t framing_hdlc;
+
+/**
+ * @brief   Signature of the output function of framing_encode()
+ *
+ * @param[in] arg       argument given to framing_encode()
+ * @param[in] data      encoded bytes
+ * @param[in] len       number of bytes in @p data
+ */
+typedef void (*framing_write_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Get the number of leading bytes of @p data that need no escaping
+ *
+ * @param[in] f         framing to use
+ * @param[in] data      bytes to scan
+ * @param[in] len       number of bytes in @p data
+ *
+ * @return  offset of the first framing_t::end or framing_t::esc byte
+ * @return  @p len if there is none
+ */
+size_t framing_plain_len(const framing_t *f, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Escape @p len bytes and pass the result to @p write
+ *
+ * Runs of bytes that need no escaping are passed to @p write in one piece.
+ * Frame delimiters are not written.
+ *
+ * @param[in] f         framing to use
+ * @param[in] src       payload to escape
+ * @param[in] len       number of bytes in @p src
+ * @param[in] write     output function
+ * @param[in] arg       argument for @p write
+ */
+void framing_encode(const framing_t *f, const uint8_t *src, size_t len,
+                    framing_write_t write, void *arg);
+
+/**
+ * @brief   Escape @p len bytes into a buffer
+ *
+ * @param[in] f         framing to use
+ * @param[out] dst      output buffer, must hold 2 * @p len bytes
+ * @param[in] src       payload to escape
+ * @param[in] len       number of bytes in @p src
+ *
+ * @return  number of bytes written to @p dst
+ */
+size_t framing_encode_buf(const framing_t *f, uint8_t *dst, const uint8_t *src,
+                          size_t len);
+
+/**
+ * @brief   Unescape @p len bytes of a frame
+ *
+ * A frame may be decoded in several pieces, e.g. both halves of a wrapped
+ * ring buffer, with @p esc carrying the state from one piece to the next.
+ * Escape sequences with an unknown substitute are dropped.
+ *
+ * @param[in] f         framing to use
+ * @param[out] dst      output buffer, must hold @p len bytes, may be @p src
+ * @param[in] src       escaped bytes, without frame delimiters
+ * @param[in] len       number of bytes in @p src
+ * @param[in,out] esc   set to 0 before decoding the first piece of a frame
+ *
+ * @return  number of bytes written to @p dst
+ */
+size_t framing_decode(const framing_t *f, uint8_t *dst, const uint8_t *src,
+                      size_t len, uint8_t *esc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FRAMING_H */
+/** @} */
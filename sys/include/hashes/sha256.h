@@ -45,6 +45,7 @@
 #define _SHA256_H_
 
 #include <inttypes.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -57,6 +58,15 @@ extern "C" {
  */
 #define SHA256_INTERNAL_BLOCK_SIZE (64)
 
+/**
+ * @brief Number of messages sha256_multi() hashes in lockstep
+ *
+ * Each lane needs about 300 bytes of stack.
+ */
+#ifndef SHA256_MULTI_LANES
+#define SHA256_MULTI_LANES  (4)
+#endif
+
 /**
  * @brief Context for ciper operatins based on sha256
  */
@@ -79,6 +89,34 @@ typedef struct {
     unsigned char element[SHA256_DIGEST_LENGTH];
 } sha256_chain_idx_elm_t;
 
+/**
+ * @brief Context for streaming hmac-sha256 computations
+ */
+typedef struct {
+    /** context for the inner hash, keyed with the inner keypad */
+    sha256_context_t c_in;
+    /** context for the outer hash, keyed with the outer keypad */
+    sha256_context_t c_out;
+} hmac_context_t;
+
+/**
+ * @brief Cache of verified elements of a sha256-chain
+ *
+ * Elements of a hash chain are usually disclosed in descending index order.
+ * Every successfully verified element is remembered as waypoint, so
+ * verifying the next element only costs as many hash computations as its
+ * distance to the nearest waypoint above it, instead of its distance to the
+ * tail element.
+ */
+typedef struct {
+    /** verified elements sorted by ascending index, the last one is the tail */
+    sha256_chain_idx_elm_t *waypoints;
+    /** number of entries in waypoints */
+    size_t size;
+    /** number of used entries in waypoints */
+    size_t used;
+} sha256_chain_verifier_t;
+
 /**
  * @brief SHA-256 initialization.  Begins a SHA-256 operation.
  *
@@ -116,6 +154,49 @@ void sha256_final(unsigned char digest[32], sha256_context_t *ctx);
  */
 unsigned char *sha256(const unsigned char *d, size_t n, unsigned char *md);
 
+/**
+ * @brief Hash several independent messages at once
+ *
+ * Without hardware support the messages are processed in groups of
+ * SHA256_MULTI_LANES in lockstep, which lets the compiler interleave the
+ * independent computations. This is faster than hashing them one after
+ * another when hashing many short messages.
+ *
+ * @param[in]  msgs     pointers to the messages
+ * @param[in]  lens     lengths of the messages in bytes
+ * @param[in]  n        number of messages
+ * @param[out] digests  the resulting digests, one per message
+ */
+void sha256_multi(const void *const msgs[], const size_t lens[], size_t n,
+                  unsigned char digests[][SHA256_DIGEST_LENGTH]);
+
+/**
+ * @brief Start a streaming hmac-sha256 computation
+ *
+ * @param[out] ctx          hmac_context_t handle to init
+ * @param[in]  key          key used in the hmac-sha256 computation
+ * @param[in]  key_length   the size in bytes of the key
+ */
+void hmac_sha256_init(hmac_context_t *ctx, const void *key, size_t key_length);
+
+/**
+ * @brief Add bytes to the message authenticated by a hmac-sha256
+ *
+ * @param ctx   hmac_context_t handle to use
+ * @param data  pointer to the input buffer
+ * @param len   length of the buffer
+ */
+void hmac_sha256_update(hmac_context_t *ctx, const void *data, size_t len);
+
+/**
+ * @brief Finish a streaming hmac-sha256 computation
+ *
+ * @param ctx          hmac_context_t handle to use
+ * @param[out] digest  the computed hmac-sha256,
+ *                     length MUST be SHA256_DIGEST_LENGTH
+ */
+void hmac_sha256_final(hmac_context_t *ctx, unsigned char *digest);
+
 /**
  * @brief function to compute a hmac-sha256 from a given message
  *
@@ -203,6 +284,38 @@ int sha256_chain_verify_element(unsigned char *element,
                                 unsigned char *tail_element,
                                 size_t chain_length);
 
+/**
+ * @brief Initialize a cache for the incremental verification of a chain
+ *
+ * @param[out] verifier      the verifier to initialize
+ * @param[in] waypoints      storage for verified elements, at least one
+ * @param[in] size           number of entries in @p waypoints
+ * @param[in] tail_element   the last element of the sha256-chain
+ * @param[in] chain_length   the number of elements in the chain
+ */
+void sha256_chain_verifier_init(sha256_chain_verifier_t *verifier,
+                                sha256_chain_idx_elm_t *waypoints,
+                                size_t size,
+                                const unsigned char *tail_element,
+                                size_t chain_length);
+
+/**
+ * @brief Verify if a given element is part of the chain and cache it
+ *
+ * The element is hashed up to the nearest cached waypoint. On success it is
+ * stored as new waypoint, evicting a redundant one if the cache is full.
+ *
+ * @param[in,out] verifier     an initialized verifier
+ * @param[in] element          the chain element to be verified
+ * @param[in] element_index    the position in the chain
+ *
+ * @returns 0 if element is verified to be part of the chain at element_index
+ *          1 if the element cannot be verified as part of the chain
+ */
+int sha256_chain_verifier_check(sha256_chain_verifier_t *verifier,
+                                const unsigned char *element,
+                                size_t element_index);
+
 #ifdef __cplusplus
 }
 #endif
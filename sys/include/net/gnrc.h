@@ -63,10 +63,8 @@
  *     static msg_t _msg_q[Q_SZ];
  *     (void)arg;
  *     msg_init_queue(_msg_q, Q_SZ);
- *     gnrc_netreg_entry me_reg = {
- *             .demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL,
- *             .pid = thread_getpid()
- *         };
+ *     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+ *                                                             thread_getpid());
  *     gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me_reg);
  *     while (1) {
  *         msg_receive(&msg);
@@ -114,7 +112,7 @@
  *     reply.content.value = -ENOTSUP;
  *     msg_init_queue(_msg_q, Q_SZ);
  *     gnrc_pktsnip_t *pkt = NULL;
- *     gnrc_netreg_entry me_reg = { .demux_ctx = 80, .pid = thread_getpid() };
+ *     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(80, thread_getpid());
  *     gnrc_netreg_register(GNRC_NETTYPE_UDP, &me_reg);
  *
  *     while (1) {
@@ -83,11 +83,35 @@ struct conn_udp {
 static inline void gnrc_conn_reg(gnrc_netreg_entry_t *entry, gnrc_nettype_t type,
                                  uint32_t demux_ctx)
 {
-    entry->pid = sched_active_pid;
-    entry->demux_ctx = demux_ctx;
+    gnrc_netreg_entry_init_pid(entry, demux_ctx, sched_active_pid);
     gnrc_netreg_register(type, entry);
 }
 
+#if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
+/**
+ * @brief   Create a UDP connection that gets its packets through a callback
+ *
+ * Same as conn_udp_create(), but received packets are handed to @p cb in
+ * the context of the UDP thread instead of being sent to the calling thread.
+ * conn_udp_recvfrom() can not be used on such a connection.
+ *
+ * @note    Only available with module `gnrc_netapi_callbacks`
+ *
+ * @param[out] conn     The connection
+ * @param[in] addr      The local address
+ * @param[in] addr_len  Length of @p addr
+ * @param[in] family    Address family of @p addr
+ * @param[in] port      The local port
+ * @param[in] cb        Callback for received packets
+ * @param[in] ctx       Context passed to @p cb
+ *
+ * @return  0 on success, the same errors as conn_udp_create() otherwise
+ */
+int gnrc_conn_udp_create_cb(struct conn_udp *conn, const void *addr,
+                            size_t addr_len, int family, uint16_t port,
+                            gnrc_netreg_cb_t cb, void *ctx);
+#endif
+
 /**
  * @brief   Sets local address for a connection
  *
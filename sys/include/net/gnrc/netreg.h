@@ -38,6 +38,22 @@ extern "C" {
  */
 #define GNRC_NETREG_DEMUX_CTX_ALL   (0xffff0000)
 
+#if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
+/**
+ * @brief   Callback that takes over delivery for a registry entry
+ *
+ * Called in the context of the dispatching thread instead of sending a
+ * message to gnrc_netreg_entry_t::pid. The callback owns one reference to
+ * @p pkt and must release it eventually. It must not block.
+ *
+ * @param[in] cmd       @ref net_gnrc_netapi command type, e.g.
+ *                      @ref GNRC_NETAPI_MSG_TYPE_RCV
+ * @param[in] pkt       the dispatched packet
+ * @param[in] ctx       gnrc_netreg_entry_t::ctx
+ */
+typedef void (*gnrc_netreg_cb_t)(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx);
+#endif
+
 /**
  * @brief   Entry to the @ref net_gnrc_netreg
  */
@@ -58,8 +74,84 @@ typedef struct gnrc_netreg_entry {
      */
     uint32_t demux_ctx;
     kernel_pid_t pid;       /**< The PID of the registering thread */
+#if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
+    /**
+     * @brief   Deliver packets by calling this function instead of sending
+     *          them to @ref pid, NULL for message delivery
+     *
+     * @note    Only available with module `gnrc_netapi_callbacks`
+     */
+    gnrc_netreg_cb_t cb;
+    void *ctx;              /**< Context passed to @ref cb */
+#endif
 } gnrc_netreg_entry_t;
 
+/**
+ * @brief   Static initializer for an entry that gets packets as messages
+ *
+ * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *                      for the registry entry
+ * @param[in] pid       The PID of the registering thread
+ */
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, pid, \
+                                                      NULL, NULL }
+#else
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, pid }
+#endif
+
+/**
+ * @brief   Initializes an entry that gets packets as messages
+ *
+ * Entries must be initialized by this, by gnrc_netreg_entry_init_cb() or
+ * by @ref GNRC_NETREG_ENTRY_INIT_PID before they are registered, so no
+ * field holds a stale value.
+ *
+ * @param[out] entry    A registry entry
+ * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *                      for the registry entry
+ * @param[in] pid       The PID of the registering thread
+ */
+static inline void gnrc_netreg_entry_init_pid(gnrc_netreg_entry_t *entry,
+                                              uint32_t demux_ctx,
+                                              kernel_pid_t pid)
+{
+    entry->next = NULL;
+    entry->demux_ctx = demux_ctx;
+    entry->pid = pid;
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+    entry->cb = NULL;
+    entry->ctx = NULL;
+#endif
+}
+
+#if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
+/**
+ * @brief   Initializes an entry that gets packets through a callback
+ *
+ * @note    Only available with module `gnrc_netapi_callbacks`
+ *
+ * @param[out] entry    A registry entry
+ * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *                      for the registry entry
+ * @param[in] pid       The PID of the registering thread, may be
+ *                      @ref KERNEL_PID_UNDEF
+ * @param[in] cb        Callback for the packets, see @ref gnrc_netreg_cb_t
+ * @param[in] ctx       Context passed to @p cb
+ */
+static inline void gnrc_netreg_entry_init_cb(gnrc_netreg_entry_t *entry,
+                                             uint32_t demux_ctx,
+                                             kernel_pid_t pid,
+                                             gnrc_netreg_cb_t cb, void *ctx)
+{
+    entry->next = NULL;
+    entry->demux_ctx = demux_ctx;
+    entry->pid = pid;
+    entry->cb = cb;
+    entry->ctx = ctx;
+}
+#endif
+
 /**
  * @brief   Initializes module.
  */
@@ -73,13 +165,16 @@ void gnrc_netreg_init(void);
  *
  * @param[in] type      Type of the protocol. Must not be < GNRC_NETTYPE_UNDEF or
  *                      >= GNRC_NETTYPE_NUMOF.
- * @param[in] entry     An entry you want to add to the registry with
- *                      gnrc_netreg_entry_t::pid and gnrc_netreg_entry_t::demux_ctx set.
+ * @param[in] entry     An entry you want to add to the registry, initialized
+ *                      by gnrc_netreg_entry_init_pid(),
+ *                      gnrc_netreg_entry_init_cb() or
+ *                      @ref GNRC_NETREG_ENTRY_INIT_PID.
  *
  * @warning Call gnrc_netreg_unregister() *before* you leave the context you
  *          allocated @p entry in. Otherwise it might get overwritten.
  *
- * @pre The calling thread must provide a message queue.
+ * @pre The calling thread must provide a message queue, unless
+ *      gnrc_netreg_entry_t::cb is set.
  *
  * @return  0 on success
  * @return  -EINVAL if @p type was < GNRC_NETTYPE_UNDEF or >= GNRC_NETTYPE_NUMOF
@@ -44,17 +44,29 @@ extern "C" {
 #define GNRC_SLIP_BUFSIZE       (1500U)
 #endif
 
+/**
+ * @brief   Size of the buffer collecting outgoing bytes
+ *
+ * Packets are passed to the UART in chunks of this size.
+ */
+#ifndef GNRC_SLIP_TX_BUFSIZE
+#define GNRC_SLIP_TX_BUFSIZE    (64U)
+#endif
+
 /**
  * @brief   Device descriptor for SLIP devices
  */
 typedef struct {
     uart_t uart;                    /**< the UART interface */
-    ringbuffer_t in_buf;            /**< RX buffer */
+    ringbuffer_t in_buf;            /**< RX buffer, holds escaped packets */
     ringbuffer_t out_buf;           /**< TX buffer */
     char rx_mem[GNRC_SLIP_BUFSIZE]; /**< memory used by RX buffer */
+    uart_txbuf_t out;               /**< write combining buffer for sends */
+    uint8_t tx_mem[GNRC_SLIP_TX_BUFSIZE]; /**< memory used by gnrc_slip_dev_t::out */
     uint32_t in_bytes;              /**< the number of bytes received of a
                                      *   currently incoming packet */
-    uint16_t in_esc;                /**< receiver is in escape mode */
+    uint16_t in_drop;               /**< the RX buffer overflowed, drop the
+                                     *   currently incoming packet */
     kernel_pid_t slip_pid;          /**< PID of the device thread */
 } gnrc_slip_dev_t;
 
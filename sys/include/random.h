@@ -11,6 +11,16 @@
  * @defgroup    sys_random Random
  * @ingroup     sys
  * @brief       Random number generator
+ *
+ * The generator is selected with one of the `prng_*` modules:
+ * - `prng_tinymt32`: Tiny Mersenne Twister, the default
+ * - `prng_mersenne`: Mersenne Twister MT19937, 2.5 KiB of state
+ * - `prng_minstd`: Park-Miller "minimal standard" generator
+ * - `prng_musl_lcg`: 64 bit linear congruential generator of musl
+ * - `prng_xoshiro`: xoshiro128**, the fastest of them, with independent
+ *   streams for threads, see @ref sys_xoshiro
+ *
+ * All of them take a constant time per call to random_uint32().
  * @{
  *
  * @file
@@ -21,6 +31,11 @@
 #define RANDOM_H
 
 #include <inttypes.h>
+#include <stddef.h>
+
+#if defined(MODULE_PRNG_XOSHIRO) || defined(DOXYGEN)
+#include "xoshiro.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,6 +69,34 @@ void random_init_by_array(uint32_t init_key[], int key_length);
  */
 uint32_t random_uint32(void);
 
+/**
+ * @brief   fills @p buf with @p size random bytes
+ *
+ * Faster than calling random_uint32() for every four bytes, in particular
+ * with `prng_xoshiro`.
+ *
+ * @param[out] buf  buffer to fill
+ * @param[in] size  number of bytes to write to @p buf
+ */
+void random_bytes(uint8_t *buf, size_t size);
+
+#if defined(MODULE_PRNG_XOSHIRO) || defined(DOXYGEN)
+/**
+ * @brief   splits off a stream of its own for a thread, `prng_xoshiro` only
+ *
+ * @p stream gets the current state of the generator, which is then advanced
+ * by 2^64 steps with xoshiro_jump(). Unless it draws more than 2^64 words,
+ * the sequence of @p stream does not overlap with those of other streams and
+ * of random_uint32(). Draw from @p stream with xoshiro_next() and
+ * xoshiro_bytes(), which need no locking as long as only one thread uses it.
+ *
+ * Like random_uint32(), this function is not thread-safe.
+ *
+ * @param[out] stream   state for the new stream
+ */
+void random_xoshiro_stream(xoshiro_t *stream);
+#endif
+
 /**
  * @brief   generates a random number r with a <= r < b.
  *
@@ -11,6 +11,11 @@
  * @ingroup     sys
  * @brief       Global sensor/actuator registry for SAUL devices
  *
+ * Besides the linked list exported as @ref saul_reg, the registry keeps the
+ * first @ref SAUL_REG_INDEX_NUMOF entries in a table, so saul_reg_find_nth()
+ * takes constant time and the other lookups scan an array instead of chasing
+ * pointers. Entries beyond the table are still found through the list.
+ *
  * @{
  *
  * @file
@@ -31,6 +36,13 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of registry entries kept in the lookup table
+ */
+#ifndef SAUL_REG_INDEX_NUMOF
+#define SAUL_REG_INDEX_NUMOF    (16U)
+#endif
+
 /**
  * @brief   SAUL registry entry
  */
@@ -50,6 +62,9 @@ typedef struct {
 
 /**
  * @brief   Export the SAUL registry as global variable
+ *
+ * @warning Only modify the registry through saul_reg_add() and saul_reg_rm(),
+ *          the lookup table would go stale otherwise.
  */
 extern saul_reg_t *saul_reg;
 
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_saul_sampler SAUL sampler
+ * @ingroup     sys
+ * @brief       Periodic sampling of SAUL devices into a ring buffer
+ *
+ * A sampling plan is an array of @ref saul_sampler_entry_t, each naming a
+ * registered device and the period to read it with. The sampler runs the
+ * plan in a thread of its own, woken by a single xtimer for the earliest
+ * deadline. All reads due within @ref SAUL_SAMPLER_SLACK of a wake-up are
+ * done as one batch. The readings are stored as timestamped
+ * @ref saul_sample_t records in a lock-free ring buffer (@ref sys_tsrb),
+ * from which one consumer thread takes them:
+ *
+ * @code
+ * static saul_sampler_entry_t plan[] = {
+ *     { .period = 10 * MS_IN_USEC },
+ *     { .period = 100 * MS_IN_USEC },
+ * };
+ * static saul_sample_t ring[32];
+ * static saul_sampler_t sampler;
+ *
+ * plan[0].dev = saul_reg_find_name("accel");
+ * plan[1].dev = saul_reg_find_name("temp");
+ * saul_sampler_init(&sampler, plan, 2, ring, sizeof(ring));
+ * saul_sampler_start(&sampler, stack, sizeof(stack), THREAD_PRIORITY_MAIN - 1);
+ *
+ * while (1) {
+ *     saul_sample_t s;
+ *     saul_sampler_wait(&sampler);
+ *     while (saul_sampler_get(&sampler, &s, 1)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ *
+ * Deadlines advance by a fixed period, so sampling does not drift. A device
+ * that misses a whole period is counted as late and rescheduled from the
+ * current time instead of being read several times in a row.
+ *
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampler interface
+ */
+
+#ifndef SAUL_SAMPLER_H
+#define SAUL_SAMPLER_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "phydat.h"
+#include "saul_reg.h"
+#include "thread.h"
+#include "tsrb.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Reads due this many microseconds from now are done right away
+ */
+#ifndef SAUL_SAMPLER_SLACK
+#define SAUL_SAMPLER_SLACK      (500U)
+#endif
+
+/**
+ * @brief   Thread flag used by saul_sampler_wait()
+ */
+#ifndef SAUL_SAMPLER_THREAD_FLAG
+#define SAUL_SAMPLER_THREAD_FLAG    (0x1 << 11)
+#endif
+
+/**
+ * @brief   One device of a sampling plan
+ */
+typedef struct {
+    saul_reg_t *dev;        /**< device to read */
+    uint32_t period;        /**< sampling period in microseconds */
+    uint32_t next;          /**< next deadline, managed by the sampler */
+} saul_sampler_entry_t;
+
+/**
+ * @brief   A reading as stored in the ring buffer, 16 bytes
+ */
+typedef struct {
+    uint32_t time;          /**< xtimer_now() at the time of reading */
+    int16_t jitter;         /**< microseconds after the deadline, negative
+                             *   if read early, saturating */
+    uint8_t entry;          /**< index of the device in the plan */
+    int8_t dim;             /**< dimensions of @p data as returned by the
+                             *   driver, or a negative errno value */
+    phydat_t data;          /**< the reading */
+} saul_sample_t;
+
+/**
+ * @brief   Statistics of a sampler
+ */
+typedef struct {
+    uint32_t samples;       /**< readings stored */
+    uint32_t errors;        /**< reads failed by the driver */
+    uint32_t dropped;       /**< readings lost because the ring was full */
+    uint32_t late;          /**< deadlines skipped because the sampler was
+                             *   behind by more than a period */
+    uint32_t jitter_max;    /**< largest distance of a reading from its
+                             *   deadline in microseconds */
+    uint64_t jitter_sum;    /**< sum of the distances of all readings from
+                             *   their deadlines in microseconds */
+} saul_sampler_stats_t;
+
+/**
+ * @brief   A sampler
+ */
+typedef struct {
+    saul_sampler_entry_t *entries;  /**< sampling plan */
+    unsigned numof;                 /**< number of entries in the plan */
+    tsrb_t ring;                    /**< readings not taken yet */
+    xtimer_t timer;                 /**< wakes the sampler thread */
+    kernel_pid_t pid;               /**< sampler thread */
+    thread_t *waiter;               /**< thread in saul_sampler_wait() */
+    saul_sampler_stats_t stats;     /**< statistics */
+} saul_sampler_t;
+
+/**
+ * @brief   Initialize @p sampler to run the plan @p entries
+ *
+ * @param[out] sampler      sampler to initialize
+ * @param[in] entries       sampling plan, must stay valid
+ * @param[in] numof         number of entries in @p entries, at most 256
+ * @param[in] buf           ring buffer memory
+ * @param[in] size          size of @p buf in bytes, a power of two and a
+ *                          multiple of sizeof(saul_sample_t)
+ *
+ * @return  0 on success
+ * @return  -EINVAL on an invalid plan or buffer size
+ */
+int saul_sampler_init(saul_sampler_t *sampler, saul_sampler_entry_t *entries,
+                      unsigned numof, saul_sample_t *buf, unsigned size);
+
+/**
+ * @brief   Start the sampler thread, every device is read right away
+ *
+ * @return  PID of the sampler thread
+ * @return  negative value if the thread could not be created
+ */
+kernel_pid_t saul_sampler_start(saul_sampler_t *sampler, char *stack,
+                                int stacksize, char priority);
+
+/**
+ * @brief   Take up to @p max readings out of the ring buffer
+ *
+ * Must only be called by one thread at a time.
+ *
+ * @return  number of readings written to @p dst
+ */
+unsigned saul_sampler_get(saul_sampler_t *sampler, saul_sample_t *dst,
+                          unsigned max);
+
+/**
+ * @brief   Block until there is a reading in the ring buffer
+ */
+void saul_sampler_wait(saul_sampler_t *sampler);
+
+/**
+ * @brief   Get a consistent copy of the statistics of @p sampler
+ */
+void saul_sampler_get_stats(saul_sampler_t *sampler,
+                            saul_sampler_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAUL_SAMPLER_H */
+/** @} */
@@ -0,0 +1,330 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_schema Schema driven serialization
+ * @ingroup     sys
+ * @brief       Encode and decode C structs from a table of field descriptors
+ *
+ * Instead of writing encoder and decoder code per message type, a struct is
+ * described once by a table of @ref schema_field_t. Generic engines walk the
+ * table to encode a struct as a CBOR map or UBJSON object, keyed by the field
+ * names, and to decode such a map or object back into the struct. On decode,
+ * keys are dispatched to fields through a hash index, so the cost per key
+ * does not grow with the number of fields.
+ *
+ * @code
+ * typedef struct {
+ *     int16_t temp;
+ *     uint32_t uptime;
+ *     char name[16];
+ * } telemetry_t;
+ *
+ * static SCHEMA_DEFINE(telemetry_schema,
+ *     SCHEMA_FIELD(telemetry_t, temp, SCHEMA_INT16),
+ *     SCHEMA_FIELD(telemetry_t, uptime, SCHEMA_UINT32),
+ *     SCHEMA_FIELD(telemetry_t, name, SCHEMA_STRING),
+ * );
+ *
+ * schema_cbor_encode(&telemetry_schema, &record, &writer);
+ * @endcode
+ *
+ * C++ users can let the compiler derive the table from the struct, see
+ * riot/schema.hpp in @ref cpp11-compat.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Schema driven serialization interface
+ */
+
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef MODULE_CBOR
+#include "cbor.h"
+#endif
+#ifdef MODULE_UBJSON
+#include "ubjson.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of fields in a schema
+ */
+#define SCHEMA_MAX_FIELDS       (127)
+
+/**
+ * @brief   Maximum nesting of structs and of skipped UBJSON containers
+ */
+#ifndef SCHEMA_MAX_NESTING
+#define SCHEMA_MAX_NESTING      (4)
+#endif
+
+/**
+ * @brief   Longest key the UBJSON decoder can match against a field name
+ *
+ * Longer keys are skipped as unknown.
+ */
+#ifndef SCHEMA_UBJSON_KEY_MAX
+#define SCHEMA_UBJSON_KEY_MAX   (32)
+#endif
+
+/**
+ * @brief   Size of the hash index for a schema with @p n fields
+ *
+ * The smallest power of two that keeps the index at most half full.
+ */
+#define SCHEMA_INDEX_SIZE(n)    ((n) <= 4 ? 8 : (n) <= 8 ? 16 : (n) <= 16 ? 32 : \
+                                 (n) <= 32 ? 64 : (n) <= 64 ? 128 : 256)
+
+/**
+ * @brief   Type of a struct member described by a @ref schema_field_t
+ */
+typedef enum {
+    SCHEMA_BOOL,        /**< bool */
+    SCHEMA_INT8,        /**< int8_t */
+    SCHEMA_INT16,       /**< int16_t */
+    SCHEMA_INT32,       /**< int32_t */
+    SCHEMA_INT64,       /**< int64_t */
+    SCHEMA_UINT8,       /**< uint8_t */
+    SCHEMA_UINT16,      /**< uint16_t */
+    SCHEMA_UINT32,      /**< uint32_t */
+    SCHEMA_UINT64,      /**< uint64_t */
+    SCHEMA_FLOAT,       /**< float */
+    SCHEMA_DOUBLE,      /**< double */
+    SCHEMA_STRING,      /**< zero-terminated char array */
+    SCHEMA_STRUCT,      /**< nested struct, see schema_field_t::sub */
+} schema_type_t;
+
+/**
+ * @brief   Schema forward declaration
+ */
+typedef struct schema schema_t;
+
+/**
+ * @brief   Descriptor of a single struct member
+ *
+ * Use SCHEMA_FIELD() or SCHEMA_FIELD_STRUCT() to fill it in.
+ */
+typedef struct {
+    const char *name;   /**< key of the member in the encoded data */
+    uint32_t hash;      /**< schema_hash() of @ref name, 0 to let
+                             schema_init() compute it */
+    uint16_t offset;    /**< offset of the member in the struct */
+    uint16_t size;      /**< size of the member */
+    uint8_t name_len;   /**< length of @ref name */
+    uint8_t type;       /**< member type, one of @ref schema_type_t */
+    schema_t *sub;      /**< schema of the member if it is a struct */
+} schema_field_t;
+
+/**
+ * @brief   Schema of a struct
+ *
+ * Use SCHEMA_DEFINE() to define one.
+ */
+struct schema {
+    const schema_field_t *fields;   /**< field descriptors */
+    uint8_t *index;                 /**< hash index, field number + 1 per
+                                         slot, built by schema_init() */
+    uint8_t num;                    /**< number of fields */
+    uint8_t mask;                   /**< size of @ref index - 1 */
+    bool ready;                     /**< index has been built */
+};
+
+/**
+ * @brief   Describe member @p member of struct type @p type as @p stype
+ */
+#define SCHEMA_FIELD(type, member, stype) \
+    { #member, 0, offsetof(type, member), sizeof(((type *)0)->member), \
+      sizeof(#member) - 1, stype, NULL }
+
+/**
+ * @brief   Describe member @p member of struct type @p type as a nested
+ *          struct with schema @p schema
+ */
+#define SCHEMA_FIELD_STRUCT(type, member, schema) \
+    { #member, 0, offsetof(type, member), sizeof(((type *)0)->member), \
+      sizeof(#member) - 1, SCHEMA_STRUCT, &(schema) }
+
+/**
+ * @brief   Define schema @p name from a list of field descriptors
+ *
+ * Expands to the definition of the field table, the hash index and the
+ * schema itself. Prefix it with `static` to keep all three local.
+ */
+#define SCHEMA_DEFINE(name, ...) \
+    const schema_field_t name ## _fields[] = { __VA_ARGS__ }; \
+    uint8_t name ## _index[SCHEMA_INDEX_SIZE(sizeof(name ## _fields) / \
+                                             sizeof(schema_field_t))]; \
+    schema_t name = { name ## _fields, name ## _index, \
+                      sizeof(name ## _fields) / sizeof(schema_field_t), \
+                      sizeof(name ## _index) - 1, false }
+
+/**
+ * @brief   Hash a key (32 bit FNV-1a)
+ *
+ * @param[in] key   key to hash, need not be zero-terminated
+ * @param[in] len   length of @p key
+ *
+ * @return  hash of @p key
+ */
+uint32_t schema_hash(const char *key, size_t len);
+
+/**
+ * @brief   Build the hash index of @p schema
+ *
+ * The engines call this on first use. Call it once at startup if a schema is
+ * going to be used from several threads concurrently.
+ *
+ * @param[in,out] schema    schema to initialize
+ */
+void schema_init(schema_t *schema);
+
+/**
+ * @brief   Find the field with key @p key
+ *
+ * @param[in] schema    schema to search
+ * @param[in] key       key to look up, need not be zero-terminated
+ * @param[in] len       length of @p key
+ *
+ * @return  the field with key @p key
+ * @return  NULL if there is no such field
+ */
+const schema_field_t *schema_find(schema_t *schema, const char *key, size_t len);
+
+/**
+ * @brief   Store a signed integer in the field @p field of @p obj
+ *
+ * Integers may also be stored in float and double fields.
+ *
+ * @param[in] field     field to store to
+ * @param[out] obj      struct containing the field
+ * @param[in] val       value to store
+ *
+ * @return  0 on success
+ * @return  -ERANGE if @p val does not fit into the field
+ * @return  -EINVAL if the field is not numeric
+ */
+int schema_store_int(const schema_field_t *field, void *obj, int64_t val);
+
+/**
+ * @brief   Store an unsigned integer in the field @p field of @p obj
+ *
+ * @see schema_store_int()
+ */
+int schema_store_uint(const schema_field_t *field, void *obj, uint64_t val);
+
+/**
+ * @brief   Store a floating point value in the field @p field of @p obj
+ *
+ * @param[in] field     field to store to
+ * @param[out] obj      struct containing the field
+ * @param[in] val       value to store
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the field is not a float or double
+ */
+int schema_store_double(const schema_field_t *field, void *obj, double val);
+
+/**
+ * @brief   Store a string in the field @p field of @p obj
+ *
+ * @param[in] field     field to store to
+ * @param[out] obj      struct containing the field
+ * @param[in] str       string to store, need not be zero-terminated
+ * @param[in] len       length of @p str
+ *
+ * @return  0 on success
+ * @return  -EOVERFLOW if @p str and its terminating zero do not fit
+ * @return  -EINVAL if the field is not a string
+ */
+int schema_store_string(const schema_field_t *field, void *obj,
+                        const char *str, size_t len);
+
+#if defined(MODULE_CBOR) || defined(DOXYGEN)
+/**
+ * @brief   Encode @p obj as a CBOR map
+ *
+ * @param[in] schema    schema of @p obj
+ * @param[in] obj       struct to encode
+ * @param[in,out] writer    writer to encode to
+ *
+ * @return  0 on success
+ * @return  the writer's error on failure
+ */
+int schema_cbor_encode(schema_t *schema, const void *obj, cbor_writer_t *writer);
+
+/**
+ * @brief   Decode the CBOR map at @p cursor into @p obj
+ *
+ * Keys that are not text strings or that have no field in @p schema are
+ * skipped, fields without a key in the map are left untouched.
+ *
+ * @param[in] schema    schema of @p obj
+ * @param[out] obj      struct to decode into
+ * @param[in,out] cursor    cursor positioned at the map
+ *
+ * @return  number of fields decoded on the top level
+ * @return  -EINVAL if a value does not match its field's type
+ * @return  -ERANGE if a number does not fit into its field
+ * @return  -EOVERFLOW if a string does not fit into its field
+ * @return  -EBADMSG if the input is malformed
+ */
+int schema_cbor_decode(schema_t *schema, void *obj, cbor_cursor_t *cursor);
+#endif
+
+#if defined(MODULE_UBJSON) || defined(DOXYGEN)
+/**
+ * @brief   Encode @p obj as a UBJSON object
+ *
+ * @param[in] schema    schema of @p obj
+ * @param[in] obj       struct to encode
+ * @param[in] cookie    cookie set up with ubjson_write_init()
+ *
+ * @return  number of bytes written
+ * @return  the negative result of the write function on failure
+ */
+ssize_t schema_ubjson_encode(schema_t *schema, const void *obj,
+                             ubjson_cookie_t *cookie);
+
+/**
+ * @brief   Decode a UBJSON object into @p obj
+ *
+ * The object is parsed directly, without going through the per value
+ * callback of ubjson_read(). @p read is used as in ubjson_read(), so the
+ * cookie can be wrapped in the caller's data structure.
+ *
+ * Unknown keys are skipped, fields without a key in the object are left
+ * untouched.
+ *
+ * @param[in] schema    schema of @p obj
+ * @param[out] obj      struct to decode into
+ * @param[in] cookie    cookie passed to @p read
+ * @param[in] read      function that is called to receive more data
+ *
+ * @return  number of fields decoded on the top level
+ * @return  negative errno as in schema_cbor_decode()
+ */
+int schema_ubjson_decode(schema_t *schema, void *obj, ubjson_cookie_t *cookie,
+                         ubjson_read_t read);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEMA_H */
+/** @} */
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_tlsf_heap Real-time heap
+ * @ingroup     sys
+ * @brief       Two-level segregated fit allocator with independent heaps
+ *
+ * Free blocks are kept in size class lists selected by a two-level bitmap,
+ * so allocating and freeing take constant time regardless of the number of
+ * blocks in the heap. Every heap is a @ref tlsf_heap_t managing one or more
+ * caller supplied memory areas, so subsystems can get a heap of their own
+ * from a static array:
+ *
+ * @code
+ * static uint8_t buf[2048];
+ * static tlsf_heap_t heap;
+ *
+ * tlsf_heap_init(&heap, "coap", buf, sizeof(buf));
+ * void *p = tlsf_heap_alloc(&heap, 100);
+ * @endcode
+ *
+ * Operations lock out interrupts for their (bounded) duration. With the
+ * `tlsf_malloc` module, malloc() and friends of newlib are served by a heap
+ * spanning the whole RAM left over by the application. This also makes
+ * malloc() usable from several threads, which newlib's allocator is not in
+ * RIOT as no malloc lock is provided. The module is opt-in because it costs
+ * the control structure and a header per block in RAM, which matters more
+ * than bounded allocation time on most applications.
+ *
+ * All heaps are listed by the `heap` shell command.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Real-time heap interface
+ */
+
+#ifndef TLSF_HEAP_H
+#define TLSF_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   log2 of the smallest block size the heap cannot hold anymore
+ *
+ * Memory areas larger than that are split into several pools.
+ */
+#ifndef TLSF_HEAP_FL_MAX
+#define TLSF_HEAP_FL_MAX        (20)
+#endif
+
+/**
+ * @brief   log2 of the number of lists per power of two
+ */
+#define TLSF_HEAP_SL_LOG2       (3)
+
+/**
+ * @brief   Alignment of all blocks, also the per block overhead
+ */
+#define TLSF_HEAP_ALIGN         (2 * sizeof(void *))
+
+/**
+ * @cond INTERNAL
+ */
+#define TLSF_HEAP_ALIGN_LOG2    ((sizeof(void *) == 8) ? 4 : 3)
+#define TLSF_HEAP_FL_SHIFT      (TLSF_HEAP_SL_LOG2 + TLSF_HEAP_ALIGN_LOG2)
+#define TLSF_HEAP_FL_COUNT      (TLSF_HEAP_FL_MAX - TLSF_HEAP_FL_SHIFT + 1)
+#define TLSF_HEAP_SL_COUNT      (1 << TLSF_HEAP_SL_LOG2)
+/** @endcond */
+
+/**
+ * @brief   A heap
+ *
+ * All members are private.
+ */
+typedef struct tlsf_heap {
+    struct tlsf_heap *next;         /**< next heap in the list of all heaps */
+    const char *name;               /**< name shown by the `heap` command */
+    void *pools;                    /**< memory areas of the heap */
+    size_t size;                    /**< bytes usable for blocks */
+    size_t used;                    /**< bytes in allocated blocks */
+    size_t high_water;              /**< maximum of @ref used */
+    unsigned failed;                /**< failed allocations */
+    unsigned fl_bitmap;             /**< first level lists that are not empty */
+    unsigned sl_bitmap[TLSF_HEAP_FL_COUNT]; /**< same, per second level */
+    void *blocks[TLSF_HEAP_FL_COUNT][TLSF_HEAP_SL_COUNT]; /**< free lists */
+} tlsf_heap_t;
+
+/**
+ * @brief   State of a heap as reported by tlsf_heap_get_stats()
+ */
+typedef struct {
+    size_t size;                    /**< bytes usable for blocks */
+    size_t used;                    /**< bytes in allocated blocks */
+    size_t high_water;              /**< maximum of @ref used */
+    size_t free;                    /**< bytes in free blocks */
+    size_t largest_free;            /**< largest free block */
+    unsigned used_blocks;           /**< number of allocated blocks */
+    unsigned free_blocks;           /**< number of free blocks */
+    unsigned failed;                /**< failed allocations */
+} tlsf_heap_stats_t;
+
+/**
+ * @brief   Initialize @p heap to manage @p mem
+ *
+ * The heap is added to the list of heaps printed by tlsf_heap_print_stats().
+ *
+ * @param[out] heap     heap to initialize
+ * @param[in] name      name of the heap
+ * @param[in] mem       memory area, need not be aligned
+ * @param[in] size      size of @p mem
+ *
+ * @return  0 on success
+ * @return  -1 if @p mem is too small
+ */
+int tlsf_heap_init(tlsf_heap_t *heap, const char *name, void *mem, size_t size);
+
+/**
+ * @brief   Add another memory area to @p heap
+ *
+ * @param[in,out] heap  heap to extend
+ * @param[in] mem       memory area, need not be aligned
+ * @param[in] size      size of @p mem
+ *
+ * @return  0 on success
+ * @return  -1 if @p mem is too small
+ */
+int tlsf_heap_add_pool(tlsf_heap_t *heap, void *mem, size_t size);
+
+/**
+ * @brief   Allocate @p size bytes, aligned to @ref TLSF_HEAP_ALIGN
+ *
+ * @return  the memory, NULL if there is no large enough free block
+ */
+void *tlsf_heap_alloc(tlsf_heap_t *heap, size_t size);
+
+/**
+ * @brief   Allocate zeroed memory for @p count elements of @p size bytes
+ *
+ * @return  the memory, NULL if there is no large enough free block
+ */
+void *tlsf_heap_calloc(tlsf_heap_t *heap, size_t count, size_t size);
+
+/**
+ * @brief   Allocate @p size bytes aligned to @p align, a power of two
+ *
+ * @return  the memory, NULL if there is no large enough free block
+ */
+void *tlsf_heap_memalign(tlsf_heap_t *heap, size_t align, size_t size);
+
+/**
+ * @brief   Resize @p ptr to @p size bytes
+ *
+ * The block is grown in place if the following block is free, otherwise it
+ * is moved.
+ *
+ * @return  the resized memory
+ * @return  NULL if there is no large enough free block, @p ptr is untouched
+ *          then
+ */
+void *tlsf_heap_realloc(tlsf_heap_t *heap, void *ptr, size_t size);
+
+/**
+ * @brief   Release @p ptr, NULL is ignored
+ */
+void tlsf_heap_free(tlsf_heap_t *heap, void *ptr);
+
+/**
+ * @brief   Get the number of bytes usable in the block of @p ptr
+ *
+ * @return  at least the size @p ptr was requested with, 0 for NULL
+ */
+size_t tlsf_heap_usable_size(void *ptr);
+
+/**
+ * @brief   Get usage and fragmentation of @p heap
+ *
+ * @note    Walks all blocks with interrupts disabled, so it is not constant
+ *          time.
+ */
+void tlsf_heap_get_stats(tlsf_heap_t *heap, tlsf_heap_stats_t *stats);
+
+/**
+ * @brief   Print the statistics of all heaps
+ */
+void tlsf_heap_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TLSF_HEAP_H */
+/** @} */
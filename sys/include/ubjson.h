@@ -377,7 +377,7 @@ static inline ssize_t ubjson_get_float(ubjson_cookie_t *__restrict cookie, ssize
         float f;
         int32_t i;
     } value;
-    ubjson_read_callback_result_t result = ubjson_get_i32(cookie, UBJSON_INT32_INT32, &value.i);
+    ssize_t result = ubjson_get_i32(cookie, UBJSON_INT32_INT32, &value.i);
     *dest = value.f;
     return result;
 }
@@ -396,7 +396,7 @@ static inline ssize_t ubjson_get_double(ubjson_cookie_t *__restrict cookie, ssiz
         double f;
         int64_t i;
     } value;
-    ubjson_read_callback_result_t result = ubjson_get_i64(cookie, -1, &value.i);
+    ssize_t result = ubjson_get_i64(cookie, -1, &value.i);
     *dest = value.f;
     return result;
 }
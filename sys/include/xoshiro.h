@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_xoshiro xoshiro128**
+ * @ingroup     sys
+ * @brief       Fast pseudo random number generator with jump-ahead
+ *
+ * xoshiro128** by David Blackman and Sebastiano Vigna generates a 32 bit
+ * word from 128 bits of state with a few shifts, rotations and XORs and two
+ * multiplications by constants, in constant time. Its period is 2^128 - 1.
+ * It is not cryptographically secure.
+ *
+ * xoshiro_jump() advances a generator by 2^64 steps as if xoshiro_next() was
+ * called that many times. Generators split off one state by repeated jumps
+ * produce non-overlapping sequences, so every thread can have a stream of its
+ * own without any locking:
+ *
+ * @code
+ * xoshiro_t streams[THREADS];
+ *
+ * xoshiro_init(&streams[0], seed);
+ * for (unsigned i = 1; i < THREADS; i++) {
+ *     streams[i] = streams[i - 1];
+ *     xoshiro_jump(&streams[i]);
+ * }
+ * @endcode
+ *
+ * The module `prng_xoshiro` makes it the backend of @ref sys_random.
+ *
+ * @see     http://xoshiro.di.unimi.it/
+ *
+ * @{
+ *
+ * @file
+ * @brief       xoshiro128** interface
+ */
+
+#ifndef XOSHIRO_H
+#define XOSHIRO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   State of a generator
+ */
+typedef struct {
+    uint32_t s[4];          /**< must not be all zero */
+} xoshiro_t;
+
+/**
+ * @brief   Seed @p x from @p seed
+ *
+ * The state is derived from @p seed with splitmix64, so similar seeds give
+ * unrelated sequences.
+ */
+void xoshiro_init(xoshiro_t *x, uint32_t seed);
+
+/**
+ * @brief   Get the next 32 bit word of @p x
+ */
+static inline uint32_t xoshiro_next(xoshiro_t *x)
+{
+    uint32_t *s = x->s;
+    uint32_t r = s[1] * 5;
+    r = ((r << 7) | (r >> 25)) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+
+    return r;
+}
+
+/**
+ * @brief   Fill @p buf with @p size bytes of @p x
+ *
+ * The bytes are the words of xoshiro_next() in the byte order of the CPU,
+ * a word cut short at the end is lost.
+ */
+void xoshiro_bytes(xoshiro_t *x, uint8_t *buf, size_t size);
+
+/**
+ * @brief   Advance @p x by 2^64 steps
+ */
+void xoshiro_jump(xoshiro_t *x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XOSHIRO_H */
+/** @} */
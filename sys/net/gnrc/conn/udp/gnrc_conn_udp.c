@@ -23,8 +23,9 @@
 
 #include "net/conn/udp.h"
 
-int conn_udp_create(conn_udp_t *conn, const void *addr, size_t addr_len,
-                    int family, uint16_t port)
+/* sets up everything but the registration */
+static int _create(conn_udp_t *conn, const void *addr, size_t addr_len,
+                   int family)
 {
     conn->l4_type = GNRC_NETTYPE_UDP;
     switch (family) {
@@ -37,7 +38,6 @@ int conn_udp_create(conn_udp_t *conn, const void *addr, size_t addr_len,
                 conn->l3_type = GNRC_NETTYPE_IPV6;
                 conn->local_addr_len = addr_len;
                 conn_udp_close(conn);       /* unregister possibly registered netreg entry */
-                gnrc_conn_reg(&conn->netreg_entry, conn->l4_type, (uint32_t)port);
             }
             else {
                 return -EADDRNOTAVAIL;
@@ -47,12 +47,39 @@ int conn_udp_create(conn_udp_t *conn, const void *addr, size_t addr_len,
         default:
             (void)addr;
             (void)addr_len;
-            (void)port;
             return -EAFNOSUPPORT;
     }
     return 0;
 }
 
+int conn_udp_create(conn_udp_t *conn, const void *addr, size_t addr_len,
+                    int family, uint16_t port)
+{
+    int res = _create(conn, addr, addr_len, family);
+
+    if (res == 0) {
+        gnrc_conn_reg(&conn->netreg_entry, conn->l4_type, (uint32_t)port);
+    }
+    return res;
+}
+
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+int gnrc_conn_udp_create_cb(conn_udp_t *conn, const void *addr,
+                            size_t addr_len, int family, uint16_t port,
+                            gnrc_netreg_cb_t cb, void *ctx)
+{
+    int res = _create(conn, addr, addr_len, family);
+
+    if (res == 0) {
+        /* the PID marks the connection as registered for conn_udp_close() */
+        gnrc_netreg_entry_init_cb(&conn->netreg_entry, (uint32_t)port,
+                                  sched_active_pid, cb, ctx);
+        gnrc_netreg_register(conn->l4_type, &conn->netreg_entry);
+    }
+    return res;
+}
+#endif
+
 void conn_udp_close(conn_udp_t *conn)
 {
     assert(conn->l4_type == GNRC_NETTYPE_UDP);
@@ -24,6 +24,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "framing.h"
+#include "irq.h"
 #include "kernel_types.h"
 #include "msg.h"
 #include "net/gnrc.h"
@@ -39,9 +41,6 @@
 #include "debug.h"
 
 #define _SLIP_END               ('\xc0')
-#define _SLIP_ESC               ('\xdb')
-#define _SLIP_END_ESC           ('\xdc')
-#define _SLIP_ESC_ESC           ('\xdd')
 
 #define _SLIP_MSG_TYPE          (0xc1dc)    /* chosen randomly */
 #define _SLIP_NAME              "SLIP"
@@ -49,81 +48,118 @@
 
 #define _SLIP_DEV(arg)    ((gnrc_slip_dev_t *)arg)
 
-/* UART callbacks */
-static void _slip_rx_cb(void *arg, uint8_t data)
+/* drop the last @p bytes added to the RX buffer */
+static inline void _slip_drop_tail(gnrc_slip_dev_t *dev, size_t bytes)
 {
-    if (data == (uint8_t)_SLIP_END) {
-        msg_t msg;
-
-        msg.type = _SLIP_MSG_TYPE;
-        msg.content.value = _SLIP_DEV(arg)->in_bytes;
-
-        msg_send_int(&msg, _SLIP_DEV(arg)->slip_pid);
-
-        _SLIP_DEV(arg)->in_bytes = 0;
-    }
-    else if (_SLIP_DEV(arg)->in_esc) {
-        _SLIP_DEV(arg)->in_esc = 0;
-
-        switch (data) {
-            case ((uint8_t)_SLIP_END_ESC):
-                if (ringbuffer_add_one(&_SLIP_DEV(arg)->in_buf, _SLIP_END) < 0) {
-                    _SLIP_DEV(arg)->in_bytes++;
-                }
+    dev->in_buf.avail -= bytes;
+}
 
-                break;
+/* UART callbacks */
+static void _slip_rx_cb(void *arg, const uint8_t *data, size_t len)
+{
+    gnrc_slip_dev_t *dev = _SLIP_DEV(arg);
+
+    /* frames are stored escaped, the SLIP thread unescapes them when copying
+     * them into the packet buffer */
+    while (len) {
+        const uint8_t *end = memchr(data, (uint8_t)_SLIP_END, len);
+        size_t n = end ? (size_t)(end - data) : len;
+        size_t added = ringbuffer_add(&dev->in_buf, (const char *)data, n);
+
+        dev->in_bytes += added;
+        if (added < n) {
+            dev->in_drop = 1;
+        }
+        if (!end) {
+            break;
+        }
 
-            case ((uint8_t)_SLIP_ESC_ESC):
-                if (ringbuffer_add_one(&_SLIP_DEV(arg)->in_buf, _SLIP_ESC) < 0) {
-                    _SLIP_DEV(arg)->in_bytes++;
-                }
+        if (dev->in_drop) {
+            DEBUG("slip: RX buffer full, dropping packet\n");
+            _slip_drop_tail(dev, dev->in_bytes);
+        }
+        else if (dev->in_bytes) {
+            msg_t msg;
 
-                break;
+            msg.type = _SLIP_MSG_TYPE;
+            msg.content.value = dev->in_bytes;
 
-            default:
-                break;
-        }
-    }
-    else if (data == (uint8_t)_SLIP_ESC) {
-        _SLIP_DEV(arg)->in_esc = 1;
-    }
-    else {
-        if (ringbuffer_add_one(&_SLIP_DEV(arg)->in_buf, data) < 0) {
-            _SLIP_DEV(arg)->in_bytes++;
+            if (msg_send_int(&msg, dev->slip_pid) <= 0) {
+                _slip_drop_tail(dev, dev->in_bytes);
+            }
         }
+        dev->in_bytes = 0;
+        dev->in_drop = 0;
+
+        data = end + 1;
+        len -= n + 1;
     }
 }
 
-/* SLIP receive handler */
-static void _slip_receive(gnrc_slip_dev_t *dev, size_t bytes)
+/* copy the escaped packet of @p bytes at the head of the RX buffer into the
+ * packet buffer, unescaping it on the way */
+static gnrc_pktsnip_t *_slip_unescape(gnrc_slip_dev_t *dev, size_t bytes)
 {
     gnrc_pktsnip_t *pkt, *hdr;
+    ringbuffer_t *rb = &dev->in_buf;
 
     hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
     if (hdr == NULL) {
         DEBUG("slip: no space left in packet buffer\n");
-        return;
+        return NULL;
     }
 
     ((gnrc_netif_hdr_t *)(hdr->data))->if_pid = thread_getpid();
 
+    /* the unescaped packet is at most as long as its escaped form */
     pkt = gnrc_pktbuf_add(hdr, NULL, bytes, GNRC_NETTYPE_UNDEF);
 
     if (pkt == NULL) {
         DEBUG("slip: no space left in packet buffer\n");
         gnrc_pktbuf_release(hdr);
-        return;
+        return NULL;
     }
 
-    if (ringbuffer_get(&dev->in_buf, pkt->data, bytes) != bytes) {
-        DEBUG("slip: could not read %u bytes from ringbuffer\n", (unsigned)bytes);
+    /* the ISR only appends behind the bytes of this packet, so they can be
+     * read without locking */
+    size_t first = rb->size - rb->start;
+    uint8_t esc = 0;
+    size_t len;
+
+    if (first > bytes) {
+        first = bytes;
+    }
+    len = framing_decode(&framing_slip, pkt->data,
+                         (uint8_t *)&rb->buf[rb->start], first, &esc);
+    len += framing_decode(&framing_slip, (uint8_t *)pkt->data + len,
+                          (uint8_t *)rb->buf, bytes - first, &esc);
+
+    if ((len == 0) ||
+        ((len < bytes) && (gnrc_pktbuf_realloc_data(pkt, len) != 0))) {
+        DEBUG("slip: could not shrink packet to %u bytes\n", (unsigned)len);
         gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+
+    return pkt;
+}
+
+/* SLIP receive handler */
+static void _slip_receive(gnrc_slip_dev_t *dev, size_t bytes)
+{
+    gnrc_pktsnip_t *pkt = _slip_unescape(dev, bytes);
+
+    unsigned state = irq_disable();
+    ringbuffer_remove(&dev->in_buf, bytes);
+    irq_restore(state);
+
+    if (pkt == NULL) {
         return;
     }
 #if ENABLE_DEBUG && defined(MODULE_OD)
     else {
         DEBUG("slip: received data\n");
-        od_hex_dump(pkt->data, bytes, OD_WIDTH_DEFAULT);
+        od_hex_dump(pkt->data, pkt->size, OD_WIDTH_DEFAULT);
     }
 #endif
 
@@ -139,9 +175,9 @@ static void _slip_receive(gnrc_slip_dev_t *dev, size_t bytes)
     }
 }
 
-static inline void _slip_send_char(gnrc_slip_dev_t *dev, char c)
+static void _slip_write(void *arg, const uint8_t *data, size_t len)
 {
-    uart_write(dev->uart, (uint8_t *)&c, 1);
+    uart_txbuf_write((uart_txbuf_t *)arg, data, len);
 }
 
 /* SLIP send handler */
@@ -153,33 +189,12 @@ static void _slip_send(gnrc_slip_dev_t *dev, gnrc_pktsnip_t *pkt)
 
     while (ptr != NULL) {
         DEBUG("slip: send pktsnip of length %u over UART_%d\n", (unsigned)ptr->size, dev->uart);
-        char *data = ptr->data;
-
-        for (size_t i = 0; i < ptr->size; i++) {
-            switch (data[i]) {
-                case _SLIP_END:
-                    DEBUG("slip: encountered END byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_END_ESC);
-                    break;
-
-                case _SLIP_ESC:
-                    DEBUG("slip: encountered ESC byte on send: stuff with ESC\n");
-                    _slip_send_char(dev, _SLIP_ESC);
-                    _slip_send_char(dev, _SLIP_ESC_ESC);
-                    break;
-
-                default:
-                    _slip_send_char(dev, data[i]);
-
-                    break;
-            }
-        }
-
+        framing_encode(&framing_slip, ptr->data, ptr->size, _slip_write, &dev->out);
         ptr = ptr->next;
     }
 
-    _slip_send_char(dev, _SLIP_END);
+    uart_txbuf_putc(&dev->out, (uint8_t)_SLIP_END);
+    uart_txbuf_flush(&dev->out);
 
     gnrc_pktbuf_release(pkt);
 }
@@ -250,16 +265,17 @@ kernel_pid_t gnrc_slip_init(gnrc_slip_dev_t *dev, uart_t uart, uint32_t baudrate
     /* reset device descriptor fields */
     dev->uart = uart;
     dev->in_bytes = 0;
-    dev->in_esc = 0;
+    dev->in_drop = 0;
     dev->slip_pid = KERNEL_PID_UNDEF;
 
     /* initialize buffers */
     ringbuffer_init(&dev->in_buf, dev->rx_mem, sizeof(dev->rx_mem));
+    uart_txbuf_init(&dev->out, uart, dev->tx_mem, sizeof(dev->tx_mem));
 
     /* initialize UART */
     DEBUG("slip: initialize UART_%d with baudrate %" PRIu32 "\n", uart,
           baudrate);
-    if (uart_init(uart, baudrate, _slip_rx_cb, dev) < 0) {
+    if (uart_init_buf(uart, baudrate, _slip_rx_cb, dev) < 0) {
         DEBUG("slip: error initializing UART_%i with baudrate %" PRIu32 "\n",
               uart, baudrate);
         return -ENODEV;
@@ -84,6 +84,13 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
         gnrc_pktbuf_hold(pkt, numof - 1);
 
         while (sendto) {
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+            if (sendto->cb) {
+                sendto->cb(cmd, pkt, sendto->ctx);
+                sendto = gnrc_netreg_getnext(sendto);
+                continue;
+            }
+#endif
             if (_snd_rcv(sendto->pid, cmd, pkt) < 1) {
                 /* unable to dispatch packet */
                 gnrc_pktbuf_release(pkt);
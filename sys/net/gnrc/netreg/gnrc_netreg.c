@@ -39,7 +39,11 @@ void gnrc_netreg_init(void)
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
 {
     /* only threads with a message queue are allowed to register at gnrc */
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+    assert(entry->cb || sched_threads[entry->pid]->msg_array);
+#else
     assert(sched_threads[entry->pid]->msg_array);
+#endif
 
     if (_INVALID_TYPE(type)) {
         return -EINVAL;
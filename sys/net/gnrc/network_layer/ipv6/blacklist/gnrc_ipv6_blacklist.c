@@ -31,16 +31,15 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 int gnrc_ipv6_blacklist_add(const ipv6_addr_t *addr)
 {
-    for (int i = 0; i < GNRC_IPV6_BLACKLIST_SIZE; i++) {
-        if (!bf_isset(gnrc_ipv6_blacklist_set, i)) {
-            bf_set(gnrc_ipv6_blacklist_set, i);
-            memcpy(&gnrc_ipv6_blacklist[i], addr, sizeof(*addr));
-            DEBUG("IPv6 blacklist: blacklisted %s\n",
-                  ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
-            return 0;
-        }
+    int i = bf_get_unset(gnrc_ipv6_blacklist_set, GNRC_IPV6_BLACKLIST_SIZE);
+
+    if (i < 0) {
+        return -1;
     }
-    return -1;
+    memcpy(&gnrc_ipv6_blacklist[i], addr, sizeof(*addr));
+    DEBUG("IPv6 blacklist: blacklisted %s\n",
+          ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
+    return 0;
 }
 
 void gnrc_ipv6_blacklist_del(const ipv6_addr_t *addr)
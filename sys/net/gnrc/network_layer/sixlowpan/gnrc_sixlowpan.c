@@ -315,8 +315,8 @@ static void *_event_loop(void *args)
     (void)args;
     msg_init_queue(msg_q, GNRC_SIXLOWPAN_MSG_QUEUE_SIZE);
 
-    me_reg.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
-    me_reg.pid = thread_getpid();
+    gnrc_netreg_entry_init_pid(&me_reg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               thread_getpid());
 
     /* register interest in all 6LoWPAN packets */
     gnrc_netreg_register(GNRC_NETTYPE_SIXLOWPAN, &me_reg);
@@ -222,8 +222,8 @@ static void *_event_loop(void *arg)
     /* initialize message queue */
     msg_init_queue(msg_queue, GNRC_UDP_MSG_QUEUE_SIZE);
     /* register UPD at netreg */
-    netreg.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
-    netreg.pid = thread_getpid();
+    gnrc_netreg_entry_init_pid(&netreg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               thread_getpid());
     gnrc_netreg_register(GNRC_NETTYPE_UDP, &netreg);
 
     /* dispatch NETAPI messages */
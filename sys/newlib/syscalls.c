@@ -42,6 +42,11 @@
 
 #include "uart_stdio.h"
 
+#ifdef MODULE_TLSF_MALLOC
+#include <malloc.h>
+#include "tlsf_heap.h"
+#endif
+
 #ifdef MODULE_XTIMER
 #include <sys/time.h>
 #include "div.h"
@@ -112,6 +117,102 @@ void *_sbrk_r(struct _reent *r, ptrdiff_t incr)
     return res;
 }
 
+#ifdef MODULE_TLSF_MALLOC
+/**
+ * @brief   Heap serving malloc() and friends, spanning the whole heap area
+ */
+static tlsf_heap_t _malloc_heap;
+static int _malloc_heap_ready;
+
+static tlsf_heap_t *_get_malloc_heap(void)
+{
+    if (!_malloc_heap_ready) {
+        unsigned state = irq_disable();
+        if (!_malloc_heap_ready) {
+            /* take over the memory left to _sbrk_r(), it fails from now on */
+            tlsf_heap_init(&_malloc_heap, "malloc", heap_top,
+                           &_eheap - heap_top);
+            heap_top = &_eheap;
+            _malloc_heap_ready = 1;
+        }
+        irq_restore(state);
+    }
+    return &_malloc_heap;
+}
+
+void *_malloc_r(struct _reent *r, size_t size)
+{
+    void *res = tlsf_heap_alloc(_get_malloc_heap(), size);
+    if (!res) {
+        r->_errno = ENOMEM;
+    }
+    return res;
+}
+
+void *_calloc_r(struct _reent *r, size_t count, size_t size)
+{
+    void *res = tlsf_heap_calloc(_get_malloc_heap(), count, size);
+    if (!res) {
+        r->_errno = ENOMEM;
+    }
+    return res;
+}
+
+void *_memalign_r(struct _reent *r, size_t align, size_t size)
+{
+    void *res = tlsf_heap_memalign(_get_malloc_heap(), align, size);
+    if (!res) {
+        r->_errno = ENOMEM;
+    }
+    return res;
+}
+
+void *_realloc_r(struct _reent *r, void *ptr, size_t size)
+{
+    void *res = tlsf_heap_realloc(_get_malloc_heap(), ptr, size);
+    if (!res && size) {
+        r->_errno = ENOMEM;
+    }
+    return res;
+}
+
+void _free_r(struct _reent *r, void *ptr)
+{
+    (void)r;
+    tlsf_heap_free(_get_malloc_heap(), ptr);
+}
+
+/* newlib's versions of the following inspect its own allocator's state, and
+ * nano-malloc's mallinfo would drag in a second definition of _malloc_r */
+size_t _malloc_usable_size_r(struct _reent *r, void *ptr)
+{
+    (void)r;
+    return tlsf_heap_usable_size(ptr);
+}
+
+struct mallinfo _mallinfo_r(struct _reent *r)
+{
+    struct mallinfo info;
+    tlsf_heap_stats_t stats;
+
+    (void)r;
+    tlsf_heap_get_stats(_get_malloc_heap(), &stats);
+    memset(&info, 0, sizeof(info));
+    info.arena = stats.size;
+    info.ordblks = stats.free_blocks;
+    info.uordblks = stats.used;
+    info.fordblks = stats.free;
+    info.usmblks = stats.high_water;
+    return info;
+}
+
+void _malloc_stats_r(struct _reent *r)
+{
+    (void)r;
+    tlsf_heap_print_stats();
+}
+#endif
+
 /**
  * @brief Get the process-ID of the current thread
  *
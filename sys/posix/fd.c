@@ -24,11 +24,13 @@
 
 #include "fd.h"
 
+#ifndef FD_MAX
 #ifdef CPU_MSP430
 #define FD_MAX 5
 #else
 #define FD_MAX 15
 #endif
+#endif
 
 static fd_t fd_table[FD_MAX];
 
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_sockets
+ * @{
+ */
+
+/**
+ * @file
+ * @brief   Input/output multiplexing
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/poll.h.html">
+ *              The Open Group Base Specifications Issue 7, <poll.h>
+ *          </a>
+ *
+ * Only sockets can be waited for. A socket is readable when a datagram is
+ * queued for it. Sockets that are not backed by a receive queue (see
+ * @ref posix_sockets) are always reported readable and writable.
+ */
+#ifndef POLL_H
+#define POLL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Event flags
+ * @{
+ */
+#define POLLIN      (0x0001)    /**< Data other than high-priority data may be
+                                 *   read without blocking */
+#define POLLPRI     (0x0002)    /**< High priority data may be read without
+                                 *   blocking (never reported) */
+#define POLLOUT     (0x0004)    /**< Normal data may be written without
+                                 *   blocking */
+#define POLLERR     (0x0008)    /**< An error has occurred (revents only) */
+#define POLLHUP     (0x0010)    /**< Device has been disconnected (revents
+                                 *   only) */
+#define POLLNVAL    (0x0020)    /**< Invalid fd member (revents only) */
+#define POLLRDNORM  (POLLIN)    /**< Normal data may be read without
+                                 *   blocking */
+#define POLLWRNORM  (POLLOUT)   /**< Equivalent to POLLOUT */
+/** @} */
+
+/**
+ * @brief   Type for the number of file descriptors passed to poll()
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   File descriptor to wait for
+ */
+struct pollfd {
+    int fd;         /**< The following descriptor being polled */
+    short events;   /**< The input event flags */
+    short revents;  /**< The output event flags */
+};
+
+/**
+ * @brief   Wait for events on several sockets
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/poll.html">
+ *              The Open Group Base Specification Issue 7, poll
+ *          </a>
+ *
+ * The calling thread sleeps on @ref SOCKET_THREAD_FLAG until one of the
+ * sockets receives a datagram or @p timeout expires, so a single thread can
+ * serve any number of sockets. Entries with a negative
+ * pollfd::fd are ignored.
+ *
+ * @param[in,out] fds   Sockets to wait for and the events of interest.
+ * @param[in] nfds      Number of entries in @p fds.
+ * @param[in] timeout   Timeout in milliseconds, -1 to wait indefinitely, 0
+ *                      to return immediately.
+ *
+ * @return  Number of entries in @p fds with a non-zero pollfd::revents.
+ * @return  0 if the timeout expired.
+ * @return  -1 on error, errno is set to indicate the error.
+ */
+int poll(struct pollfd fds[], nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POLL_H */
+/** @} */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  posix_sockets
+ * @{
+ */
+
+/**
+ * @file
+ * @brief   Synchronous I/O multiplexing
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/sys_select.h.html">
+ *              The Open Group Base Specifications Issue 7, <sys/select.h>
+ *          </a>
+ *
+ * `fd_set` and the `FD_*` macros are taken from the C library if it
+ * provides them. select() is implemented on top of poll() and shares its
+ * restrictions.
+ */
+#ifndef SYS_SELECT_H
+#define SYS_SELECT_H
+
+#ifdef CPU_NATIVE
+/* the host's headers depend on its own fd_set, select() is declared there */
+#include_next <sys/select.h>
+#else
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef FD_SET
+/**
+ * @brief   Maximum number of file descriptors in an fd_set
+ */
+#define FD_SETSIZE      (32)
+
+/**
+ * @brief   Set of file descriptors
+ */
+typedef struct {
+    uint32_t fds_bits[(FD_SETSIZE + 31) / 32];  /**< one bit per descriptor */
+} fd_set;
+
+/**
+ * @name    File descriptor set manipulation
+ * @{
+ */
+#define FD_CLR(fd, set)     ((set)->fds_bits[(fd) / 32] &= ~(1ul << ((fd) % 32)))
+#define FD_ISSET(fd, set)   (((set)->fds_bits[(fd) / 32] & (1ul << ((fd) % 32))) != 0)
+#define FD_SET(fd, set)     ((set)->fds_bits[(fd) / 32] |= (1ul << ((fd) % 32)))
+#define FD_ZERO(set)        memset((set), 0, sizeof(fd_set))
+/** @} */
+#endif
+
+/**
+ * @brief   Wait for some of a set of sockets to become ready
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/select.html">
+ *              The Open Group Base Specification Issue 7, select
+ *          </a>
+ *
+ * @param[in] nfds          Range of descriptors to test, 0 to @p nfds - 1.
+ * @param[in,out] readfds   Descriptors to check for being readable.
+ * @param[in,out] writefds  Descriptors to check for being writable.
+ * @param[in,out] errorfds  Descriptors to check for pending errors.
+ * @param[in] timeout       Maximum time to wait, NULL to wait indefinitely.
+ *
+ * @return  Total number of bits set in the three sets.
+ * @return  -1 on error, errno is set to indicate the error.
+ */
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CPU_NATIVE */
+
+#endif /* SYS_SELECT_H */
+/** @} */
@@ -69,6 +69,35 @@ extern "C" {
 #define SOCK_STREAM     (4)     /**< Stream socket */
 /** @} */
 
+/**
+ * @brief   Flag for the type argument of socket() to create a non-blocking
+ *          socket (as on Linux)
+ *
+ * Calls on a non-blocking socket that would block fail with `EAGAIN`
+ * instead.
+ */
+#define SOCK_NONBLOCK   (0x0800)
+
+/**
+ * @name    Message flags
+ * @brief   Flags for recv(), recvfrom(), send() and sendto()
+ * @{
+ */
+#define MSG_DONTWAIT    (0x0040)    /**< Do not block, fail with `EAGAIN` */
+#define MSG_TRUNC       (0x0020)    /**< Return the real length of a
+                                     *   datagram, even if it was truncated */
+/** @} */
+
+/**
+ * @brief   Thread flag used to wake up a thread blocked in recv(),
+ *          recvfrom(), poll() or select()
+ *
+ * Applications must not use this flag for their own purposes.
+ */
+#ifndef SOCKET_THREAD_FLAG
+#define SOCKET_THREAD_FLAG  (0x1 << 12)
+#endif
+
 #define SOL_SOCKET      (-1)    /**< Options to be accessed at socket level, not protocol level */
 
 /**
@@ -308,8 +337,8 @@ int listen(int socket, int backlog);
  * @param[out] buffer   Points to a buffer where the message should be stored.
  * @param[in] length    Specifies the length in bytes of the buffer pointed to
  *                      by the buffer argument.
- * @param[in] flags     Specifies the type of message reception. Support for
- *                      values other than 0 is not implemented yet.
+ * @param[in] flags     Specifies the type of message reception. Only
+ *                      @ref MSG_DONTWAIT and @ref MSG_TRUNC are supported.
  *
  * @return  Upon successful completion, recv() shall return the length of the
  *          message in bytes. If no messages are available to be received and
@@ -334,8 +363,9 @@ ssize_t recv(int socket, void *buffer, size_t length, int flags);
  *                          stored.
  * @param[in] length        Specifies the length in bytes of the buffer pointed
  *                          to by the buffer argument.
- * @param[in] flags         Specifies the type of message reception. Support
- *                          for values other than 0 is not implemented yet.
+ * @param[in] flags         Specifies the type of message reception. Only
+ *                          @ref MSG_DONTWAIT and @ref MSG_TRUNC are
+ *                          supported.
  * @param[out] address      A null pointer, or points to a sockaddr structure
  *                          in which the sending address is to be stored. The
  *                          length and format of the address depend on the
@@ -397,8 +427,9 @@ ssize_t send(int socket, const void *buffer, size_t length, int flags);
  * @param[in] socket        Specifies the socket file descriptor.
  * @param[in] buffer        Points to the buffer containing the message to send.
  * @param[in] length        Specifies the length of the message in bytes.
- * @param[in] flags         Specifies the type of message reception. Support
- *                          for values other than 0 is not implemented yet.
+ * @param[in] flags         Specifies the type of message reception. Only
+ *                          @ref MSG_DONTWAIT and @ref MSG_TRUNC are
+ *                          supported.
  * @param[in] address       Points to a sockaddr structure containing the
  *                          destination address. The length and format of the
  *                          address depend on the address family of the socket.
@@ -434,7 +465,7 @@ ssize_t sendto(int socket, const void *buffer, size_t length, int flags,
  *                      and defined in @ref socket.h.
  * @param[in] type      Specifies the type of socket to be created. Valued
  *                      values are prefixed with ``SOCK_`` and defined in
- *                      @ref socket.h.
+ *                      @ref socket.h. May be or-ed with @ref SOCK_NONBLOCK.
  * @param[in] protocol  Specifies a particular protocol to be used with the
  *                      socket. Specifying a protocol of 0 causes socket() to
  *                      use an unspecified default protocol appropriate for
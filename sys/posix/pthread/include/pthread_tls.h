@@ -23,21 +23,28 @@ extern "C" {
 #endif
 
 /**
- * @brief   Internal representation of a thread-specific key.
- * @internal
+ * @brief   Maximum number of thread-specific keys that can exist at a time.
+ * @details Every pthread reserves one pointer per key, so that
+ *          pthread_getspecific() and pthread_setspecific() are a plain
+ *          array access.
  */
-struct __pthread_tls_key;
+#ifndef PTHREAD_KEYS_NUMOF
+#define PTHREAD_KEYS_NUMOF (8)
+#endif
 
 /**
- * @brief   A single thread-specific datum.
- * @internal
+ * @brief   Maximum number of times the destructors of a thread are run
+ *          while it exits.
  */
-struct __pthread_tls_datum;
+#ifndef PTHREAD_DESTRUCTOR_ITERATIONS
+#define PTHREAD_DESTRUCTOR_ITERATIONS (4)
+#endif
 
 /**
- * @brief   A thread-specific key.
+ * @brief   A thread-specific key, valid keys are in the range
+ *          1 .. PTHREAD_KEYS_NUMOF.
  */
-typedef struct __pthread_tls_key *pthread_key_t;
+typedef unsigned int pthread_key_t;
 
 /**
  * @brief Returns the requested tls
@@ -78,10 +85,11 @@ int pthread_key_delete(pthread_key_t key);
 void __pthread_keys_exit(int self_id);
 
 /**
- * @brief Returns the pointer to the head of the list of thread-specific data.
+ * @brief Returns the PTHREAD_KEYS_NUMOF thread-specific values of pthread
+ *        `self_id`, `NULL` if there is no such thread.
  * @internal
  */
-struct __pthread_tls_datum **__pthread_get_tls_head(int self_id) PURE;
+void **__pthread_get_tls(int self_id) PURE;
 
 #ifdef __cplusplus
 }
@@ -44,6 +44,18 @@
 #   define PTHREAD_STACKSIZE THREAD_STACKSIZE_DEFAULT
 #endif
 
+/**
+ * @brief   Number of preallocated control blocks and stacks
+ *
+ * Threads that do not bring their own stack and need at most
+ * PTHREAD_STACKSIZE bytes of it are taken from this pool. An entry becomes
+ * available again as soon as its thread was joined, or for detached threads,
+ * as soon as it exited. Set to 0 to allocate every thread from the heap.
+ */
+#ifndef PTHREAD_POOL_SIZE
+#   define PTHREAD_POOL_SIZE (0)
+#endif
+
 #include "debug.h"
 
 typedef enum {
@@ -63,9 +75,7 @@ typedef struct {
     void *(*start_routine)(void *);
     void *arg;
 
-    char *stack;
-
-    struct __pthread_tls_datum *tls_head;
+    void *tls[PTHREAD_KEYS_NUMOF];
 
     __pthread_cleanup_datum_t *cleanup_top;
 } pthread_thread_t;
@@ -73,10 +83,92 @@ typedef struct {
 static pthread_thread_t *volatile pthread_sched_threads[MAXTHREADS];
 static mutex_t pthread_mutex;
 
+/**
+ * @brief   pthread_t of every kernel thread, 0 if it is not a pthread
+ */
+static uint8_t pthread_of_pid[KERNEL_PID_LAST + 1];
+
+#if PTHREAD_POOL_SIZE > 0
+typedef struct {
+    pthread_thread_t pt;    /* must be first, see pool_entry() */
+    bool used;
+    char stack[PTHREAD_STACKSIZE];
+} pthread_pool_entry_t;
+
+static pthread_pool_entry_t pthread_pool[PTHREAD_POOL_SIZE];
+
+static inline pthread_pool_entry_t *pool_entry(pthread_thread_t *pt)
+{
+    pthread_pool_entry_t *entry = (pthread_pool_entry_t *) pt;
+    if (entry >= pthread_pool && entry < pthread_pool + PTHREAD_POOL_SIZE) {
+        return entry;
+    }
+    return NULL;
+}
+#endif
+
 static volatile kernel_pid_t pthread_reaper_pid = KERNEL_PID_UNDEF;
 
 static char pthread_reaper_stack[PTHREAD_REAPER_STACKSIZE];
 
+/**
+ * @brief   Allocate the control block and, unless @p attr supplies one, the
+ *          stack of a new thread
+ */
+static pthread_thread_t *alloc_thread(const pthread_attr_t *attr,
+                                      char **stack, size_t *stack_size)
+{
+    pthread_thread_t *pt;
+    bool own_stack = attr && attr->ss_sp && attr->ss_size > 0;
+    size_t size = attr && attr->ss_size > 0 ? attr->ss_size : PTHREAD_STACKSIZE;
+
+#if PTHREAD_POOL_SIZE > 0
+    if (!own_stack && size <= PTHREAD_STACKSIZE) {
+        unsigned state = irq_disable();
+        for (unsigned i = 0; i < PTHREAD_POOL_SIZE; i++) {
+            if (!pthread_pool[i].used) {
+                pthread_pool[i].used = true;
+                irq_restore(state);
+
+                memset(&pthread_pool[i].pt, 0, sizeof(pthread_thread_t));
+                *stack = pthread_pool[i].stack;
+                *stack_size = sizeof(pthread_pool[i].stack);
+                return &pthread_pool[i].pt;
+            }
+        }
+        irq_restore(state);
+    }
+#endif
+
+    if (own_stack) {
+        pt = malloc(sizeof(pthread_thread_t));
+        *stack = attr->ss_sp;
+    }
+    else {
+        /* control block and stack share one allocation, so they are
+         * released together */
+        pt = malloc(sizeof(pthread_thread_t) + size);
+        *stack = (char *) (pt + 1);
+    }
+    if (pt) {
+        memset(pt, 0, sizeof(pthread_thread_t));
+    }
+    *stack_size = size;
+    return pt;
+}
+
+static void free_thread(pthread_thread_t *pt)
+{
+#if PTHREAD_POOL_SIZE > 0
+    pthread_pool_entry_t *entry = pool_entry(pt);
+    if (entry) {
+        entry->used = false;
+        return;
+    }
+#endif
+    free(pt);
+}
+
 static void *pthread_start_routine(void *pt_)
 {
     pthread_thread_t *pt = pt_;
@@ -117,27 +209,33 @@ static void *pthread_reaper(void *arg)
 
 int pthread_create(pthread_t *newthread, const pthread_attr_t *attr, void *(*start_routine)(void *), void *arg)
 {
-    pthread_thread_t *pt = calloc(1, sizeof(pthread_thread_t));
+    char *stack;
+    size_t stack_size;
+    pthread_thread_t *pt = alloc_thread(attr, &stack, &stack_size);
+    if (!pt) {
+        return -1;
+    }
 
-    kernel_pid_t pthread_pid = insert(pt);
-    if (pthread_pid == KERNEL_PID_UNDEF) {
-        free(pt);
+    int pthread_id = insert(pt);
+    if (pthread_id < 0) {
+        free_thread(pt);
         return -1;
     }
-    *newthread = pthread_pid;
+    *newthread = pthread_id;
 
     pt->status = attr && attr->detached ? PTS_DETACHED : PTS_RUNNING;
     pt->start_routine = start_routine;
     pt->arg = arg;
 
-    bool autofree = attr == NULL || attr->ss_sp == NULL || attr->ss_size == 0;
-    size_t stack_size = attr && attr->ss_size > 0 ? attr->ss_size : PTHREAD_STACKSIZE;
-    void *stack = autofree ? malloc(stack_size) : attr->ss_sp;
-    pt->stack = autofree ? stack : NULL;
+#if PTHREAD_POOL_SIZE > 0
+    bool needs_reaper = !pool_entry(pt);
+#else
+    bool needs_reaper = true;
+#endif
 
-    if (autofree && pthread_reaper_pid != KERNEL_PID_UNDEF) {
+    if (needs_reaper && pthread_reaper_pid == KERNEL_PID_UNDEF) {
         mutex_lock(&pthread_mutex);
-        if (pthread_reaper_pid != KERNEL_PID_UNDEF) {
+        if (pthread_reaper_pid == KERNEL_PID_UNDEF) {
             /* volatile pid to overcome problems with double checking */
             volatile kernel_pid_t pid = thread_create(pthread_reaper_stack,
                                              PTHREAD_REAPER_STACKSIZE,
@@ -151,20 +249,25 @@ int pthread_create(pthread_t *newthread, const pthread_attr_t *attr, void *(*sta
         mutex_unlock(&pthread_mutex);
     }
 
-    pt->thread_pid = thread_create(stack,
-                                   stack_size,
-                                   THREAD_PRIORITY_MAIN,
-                                   THREAD_CREATE_WOUT_YIELD |
-                                   THREAD_CREATE_STACKTEST,
-                                   pthread_start_routine,
-                                   pt,
-                                   "pthread");
-    if (pt->thread_pid == KERNEL_PID_UNDEF) {
-        free(pt->stack);
-        free(pt);
-        pthread_sched_threads[pthread_pid-1] = NULL;
+    /* the new thread must not run before it can be found by pthread_self() */
+    unsigned state = irq_disable();
+    kernel_pid_t pid = thread_create(stack,
+                                     stack_size,
+                                     THREAD_PRIORITY_MAIN,
+                                     THREAD_CREATE_WOUT_YIELD |
+                                     THREAD_CREATE_STACKTEST,
+                                     pthread_start_routine,
+                                     pt,
+                                     "pthread");
+    if (pid == KERNEL_PID_UNDEF) {
+        irq_restore(state);
+        pthread_sched_threads[pthread_id-1] = NULL;
+        free_thread(pt);
         return -1;
     }
+    pt->thread_pid = pid;
+    pthread_of_pid[pid] = pthread_id;
+    irq_restore(state);
 
     sched_switch(THREAD_PRIORITY_MAIN);
 
@@ -194,24 +297,44 @@ void pthread_exit(void *retval)
             __pthread_keys_exit(self_id);
         }
 
-        self->thread_pid = KERNEL_PID_UNDEF;
         DEBUG("pthread_exit(%p), self == %p\n", retval, (void *) self);
-        if (self->status != PTS_DETACHED) {
+
+        /* Nothing below may be interrupted by a joining or detaching thread,
+         * and our stack must stay untouched until sched_task_exit() switched
+         * away from it. */
+        irq_disable();
+        pthread_of_pid[self->thread_pid] = 0;
+        self->thread_pid = KERNEL_PID_UNDEF;
+
+        if (self->status == PTS_DETACHED) {
+            /* nobody is going to join us, so release everything now */
+            pthread_sched_threads[self_id - 1] = NULL;
+#if PTHREAD_POOL_SIZE > 0
+            pthread_pool_entry_t *entry = pool_entry(self);
+            if (entry) {
+                entry->used = false;
+            }
+            else
+#endif
+            {
+                msg_t m;
+                m.content.ptr = (char *) self;
+                msg_send_int(&m, pthread_reaper_pid);
+            }
+        }
+        else {
             self->returnval = retval;
             self->status = PTS_ZOMBIE;
 
             if (self->joining_thread) {
-                /* our thread got an other thread waiting for us */
-                thread_wakeup(self->joining_thread);
+                /* our thread got an other thread waiting for us, it gets
+                 * scheduled once we are gone */
+                thread_t *other = (thread_t *) thread_get(self->joining_thread);
+                if (other && other->status == STATUS_SLEEPING) {
+                    sched_set_status(other, STATUS_PENDING);
+                }
             }
         }
-
-        irq_disable();
-        if (self->stack) {
-            msg_t m;
-            m.content.ptr = self->stack;
-            msg_send_int(&m, pthread_reaper_pid);
-        }
     }
 
     sched_task_exit();
@@ -229,26 +352,33 @@ int pthread_join(pthread_t th, void **thread_return)
         return -1;
     }
 
+    unsigned state = irq_disable();
     switch (other->status) {
         case (PTS_RUNNING):
             other->joining_thread = sched_active_pid;
             /* go blocked, I'm waking up if other thread exits */
-            thread_sleep();
-            /* no break */
+            sched_set_status((thread_t *) sched_active_thread, STATUS_SLEEPING);
+            irq_restore(state);
+            thread_yield_higher();
+            break;
         case (PTS_ZOMBIE):
-            if (thread_return) {
-                *thread_return = other->returnval;
-            }
-            free(other);
-            /* we only need to free the pthread layer struct,
-            native thread stack is freed by other */
-            pthread_sched_threads[th-1] = NULL;
-            return 0;
+            irq_restore(state);
+            break;
         case (PTS_DETACHED):
+            irq_restore(state);
             return -1;
+        default:
+            irq_restore(state);
+            return -2;
     }
 
-    return -2;
+    if (thread_return) {
+        *thread_return = other->returnval;
+    }
+    /* the other thread is gone, so its stack can go too */
+    pthread_sched_threads[th-1] = NULL;
+    free_thread(other);
+    return 0;
 }
 
 int pthread_detach(pthread_t th)
@@ -263,13 +393,15 @@ int pthread_detach(pthread_t th)
         return -1;
     }
 
+    unsigned state = irq_disable();
     if (other->status == PTS_ZOMBIE) {
-        free(other);
-        /* we only need to free the pthread layer struct,
-        native thread stack is freed by other */
+        irq_restore(state);
         pthread_sched_threads[th-1] = NULL;
+        free_thread(other);
     } else {
+        /* pthread_exit() releases the thread from now on */
         other->status = PTS_DETACHED;
+        irq_restore(state);
     }
 
     return 0;
@@ -277,17 +409,7 @@ int pthread_detach(pthread_t th)
 
 pthread_t pthread_self(void)
 {
-    pthread_t result = 0;
-    mutex_lock(&pthread_mutex);
-    kernel_pid_t pid = sched_active_pid; /* sched_active_pid is volatile */
-    for (int i = 0; i < MAXTHREADS; i++) {
-        if (pthread_sched_threads[i] && pthread_sched_threads[i]->thread_pid == pid) {
-            result = i+1;
-            break;
-        }
-    }
-    mutex_unlock(&pthread_mutex);
-    return result;
+    return pthread_of_pid[sched_active_pid];
 }
 
 int pthread_cancel(pthread_t th)
@@ -364,8 +486,11 @@ void __pthread_cleanup_pop(__pthread_cleanup_datum_t *datum, int execute)
     }
 }
 
-struct __pthread_tls_datum **__pthread_get_tls_head(int self_id)
+void **__pthread_get_tls(int self_id)
 {
+    if (self_id < 1 || self_id > MAXTHREADS) {
+        return NULL;
+    }
     pthread_thread_t *self = pthread_sched_threads[self_id-1];
-    return self ? &self->tls_head : NULL;
+    return self ? self->tls : NULL;
 }
@@ -16,131 +16,67 @@
  * @}
  */
 
-#include <malloc.h>
+#include <stdbool.h>
 
 #include "pthread.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
-typedef struct __pthread_tls_datum {
-    pthread_key_t key;
-    struct __pthread_tls_datum *next;
-    void *value;
-} tls_data_t;
-
-struct __pthread_tls_key {
+/**
+ * @brief   The keys, key `k` is stored at index `k - 1`.
+ */
+static struct {
+    bool used;
     void (*destructor)(void *);
-};
+} tls_keys[PTHREAD_KEYS_NUMOF];
 
 /**
- * @brief   Used while manipulating the TLS of a pthread.
+ * @brief   Used while creating or deleting keys.
  */
 static mutex_t tls_mutex;
 
-/**
- * @brief        Find a thread-specific datum.
- * @param[in]    tls    Pointer to the list of the thread-specific datums.
- * @param[in]    key    The key to look up.
- * @param[out]   prev   The datum before the result. `NULL` if the result is the first key. Spurious if the key was not found.
- * @returns      The datum or `NULL`.
- */
-static tls_data_t *find_specific(tls_data_t **tls, pthread_key_t key, tls_data_t **prev)
+static inline bool key_valid(pthread_key_t key)
 {
-    tls_data_t *specific = *tls;
-    *prev = NULL;
-
-    while (specific) {
-        if (specific->key == key) {
-            return specific;
-        }
-
-        *prev = specific;
-        specific = specific->next;
-    }
-
-    return 0;
+    /* key 0 wraps around and is rejected, too */
+    return (key - 1) < PTHREAD_KEYS_NUMOF && tls_keys[key - 1].used;
 }
 
-/**
- * @brief       Find or allocate a thread specific datum.
- * @details     The `key` must be initialized.
- *              The result will be the head of the thread-specific datums afterwards.
- * @param[in]   key   The key to lookup.
- * @returns     The datum. `NULL` on ENOMEM or if the caller is not a pthread.
- */
-static tls_data_t *get_specific(pthread_key_t key)
+int pthread_key_create(pthread_key_t *key, void (*destructor)(void *))
 {
-    pthread_t self_id = pthread_self();
-    if (self_id == 0) {
-        DEBUG("ERROR called pthread_self() returned 0 in \"%s\"!\n", __func__);
-        return NULL;
-    }
+    mutex_lock(&tls_mutex);
+    for (unsigned i = 0; i < PTHREAD_KEYS_NUMOF; i++) {
+        if (!tls_keys[i].used) {
+            tls_keys[i].used = true;
+            tls_keys[i].destructor = destructor;
+            mutex_unlock(&tls_mutex);
 
-    tls_data_t **tls = __pthread_get_tls_head(self_id);
-    tls_data_t *prev, *specific = find_specific(tls, key, &prev);
-
-    /* Did the datum already exist? */
-    if (specific) {
-        if (prev) {
-            /* Move the datum to the front for a faster next lookup. */
-            /* Let's pretend that we have a totally degenerated splay tree. ;-) */
-            prev->next = specific->next;
-            specific->next = *tls;
-            *tls = specific;
+            *key = i + 1;
+            return 0;
         }
-        return specific;
-    }
-
-    /* Allocate new datum. */
-    specific = malloc(sizeof (*specific));
-    if (specific) {
-        specific->key = key;
-        specific->next = *tls;
-        specific->value = NULL;
-        *tls = specific;
-    }
-    else {
-        DEBUG("ERROR out of memory in %s!\n", __func__);
-    }
-    return specific;
-}
-
-int pthread_key_create(pthread_key_t *key, void (*destructor)(void *))
-{
-    *key = malloc(sizeof (**key));
-    if (!*key) {
-        return ENOMEM;
     }
+    mutex_unlock(&tls_mutex);
 
-    (*key)->destructor = destructor;
-    return 0;
+    DEBUG("ERROR all %d keys in use in %s!\n", PTHREAD_KEYS_NUMOF, __func__);
+    return EAGAIN;
 }
 
 int pthread_key_delete(pthread_key_t key)
 {
-    if (!key) {
+    mutex_lock(&tls_mutex);
+    if (!key_valid(key)) {
+        mutex_unlock(&tls_mutex);
         return EINVAL;
     }
 
-    mutex_lock(&tls_mutex);
+    /* the key may be handed out again, so it has to start out as NULL */
     for (unsigned i = 1; i <= MAXTHREADS; ++i) {
-        tls_data_t **tls = __pthread_get_tls_head(i);
-        if (!tls) {
-            continue;
-        }
-
-        tls_data_t *prev, *specific = find_specific(tls, key, &prev);
-        if (specific) {
-            if (prev) {
-                prev->next = specific->next;
-            }
-            else {
-                *tls = specific->next;
-            }
-            free(specific);
+        void **tls = __pthread_get_tls(i);
+        if (tls) {
+            tls[key - 1] = NULL;
         }
     }
+    tls_keys[key - 1].used = false;
     mutex_unlock(&tls_mutex);
 
     return 0;
@@ -148,51 +84,58 @@ int pthread_key_delete(pthread_key_t key)
 
 void *pthread_getspecific(pthread_key_t key)
 {
-    if (!key) {
+    void **tls = __pthread_get_tls(pthread_self());
+    if (!tls || !key_valid(key)) {
         return NULL;
     }
 
-    mutex_lock(&tls_mutex);
-    tls_data_t *specific = get_specific(key);
-    void *result = specific ? specific->value : NULL;
-    mutex_unlock(&tls_mutex);
-
-    return result;
+    return tls[key - 1];
 }
 
 int pthread_setspecific(pthread_key_t key, const void *value)
 {
-    if (!key) {
+    if (!key_valid(key)) {
         return EINVAL;
     }
 
-    mutex_lock(&tls_mutex);
-    tls_data_t *specific = get_specific(key);
-    if (specific) {
-        specific->value = (void *) value;
+    void **tls = __pthread_get_tls(pthread_self());
+    if (!tls) {
+        DEBUG("ERROR called pthread_self() returned 0 in \"%s\"!\n", __func__);
+        return ENOMEM;
     }
-    mutex_unlock(&tls_mutex);
 
-    return specific ? 0 : ENOMEM;
+    tls[key - 1] = (void *) value;
+    return 0;
 }
 
 void __pthread_keys_exit(int self_id)
 {
-    tls_data_t **tls = __pthread_get_tls_head(self_id);
+    void **tls = __pthread_get_tls(self_id);
 
-    /* Calling the dtor could cause another pthread_exit(), so we dehead and free defore calling it. */
-    mutex_lock(&tls_mutex);
-    for (tls_data_t *specific; (specific = *tls); ) {
-        *tls = specific->next;
-        void *value = specific->value;
-        void (*destructor)(void *) = specific->key->destructor;
-        free(specific);
+    /* A destructor may set new values, so repeat until all are gone. The
+     * value is cleared before its destructor is called. */
+    for (unsigned n = 0; n < PTHREAD_DESTRUCTOR_ITERATIONS; n++) {
+        bool called = false;
+
+        for (unsigned i = 0; i < PTHREAD_KEYS_NUMOF; i++) {
+            void *value = tls[i];
+            if (!value) {
+                continue;
+            }
+            tls[i] = NULL;
 
-        if (value && destructor) {
-            mutex_unlock(&tls_mutex);
-            destructor(value);
             mutex_lock(&tls_mutex);
+            void (*destructor)(void *) = tls_keys[i].used ? tls_keys[i].destructor : NULL;
+            mutex_unlock(&tls_mutex);
+
+            if (destructor) {
+                destructor(value);
+                called = true;
+            }
+        }
+
+        if (!called) {
+            break;
         }
     }
-    mutex_unlock(&tls_mutex);
 }
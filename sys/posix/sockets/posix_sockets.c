@@ -18,16 +18,24 @@
 
 #include <arpa/inet.h>
 #include <errno.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <string.h>
 
+#include "bitfield.h"
 #include "fd.h"
+#include "irq.h"
 #include "mutex.h"
 #include "net/conn.h"
 #include "net/ipv4/addr.h"
 #include "net/ipv6/addr.h"
 #include "random.h"
+#include "thread_flags.h"
+#include "timex.h"
+#include "xtimer.h"
 
+#include "poll.h"
+#include "sys/select.h"
 #include "sys/socket.h"
 #include "netinet/in.h"
 
@@ -41,7 +49,35 @@
 #   include "net/conn/udp.h"
 #endif  /* MODULE_CONN_UDP */
 
+/**
+ * @brief   Maximum number of sockets open at the same time
+ */
+#ifndef SOCKET_POOL_SIZE
 #define SOCKET_POOL_SIZE    (4)
+#endif
+
+#if defined(MODULE_GNRC_CONN_UDP) && defined(MODULE_GNRC_NETAPI_CALLBACKS)
+/*
+ * UDP sockets get their own receive queue, fed directly from the registry by
+ * the UDP thread. The calling thread's message queue is not involved, so one
+ * thread can wait on any number of sockets.
+ */
+#define SOCKET_RCV_QUEUE
+
+#include "cib.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6/hdr.h"
+#include "net/udp.h"
+
+/**
+ * @brief   Number of datagrams queued per socket, must be a power of two
+ *
+ * Datagrams arriving at a full queue are dropped.
+ */
+#ifndef SOCKET_RCV_QUEUE_SIZE
+#define SOCKET_RCV_QUEUE_SIZE   (4)
+#endif
+#endif
 
 /**
  * @brief   Unitfied connection type.
@@ -67,13 +103,22 @@ typedef struct {
     int type;
     int protocol;
     bool bound;
+    bool nonblocking;
     socket_conn_t conn;
     uint16_t src_port;
+#ifdef SOCKET_RCV_QUEUE
+    cib_t rcv_cib;
+    gnrc_pktsnip_t *rcv_queue[SOCKET_RCV_QUEUE_SIZE];
+    BITFIELD(waiters, MAXTHREADS);  /* threads to wake up on reception, by
+                                     * PID - KERNEL_PID_FIRST */
+#endif
 } socket_t;
 
 socket_t _pool[SOCKET_POOL_SIZE];
 mutex_t _pool_mutex = MUTEX_INIT;
 
+static int socket_close(int socket);
+
 const struct in6_addr in6addr_any = IN6ADDR_ANY_INIT;
 const struct in6_addr in6addr_loopback = IN6ADDR_LOOPBACK_INIT;
 
@@ -89,14 +134,136 @@ static socket_t *_get_free_socket(void)
 
 static socket_t *_get_socket(int fd)
 {
-    for (int i = 0; i < SOCKET_POOL_SIZE; i++) {
-        if (_pool[i].fd == fd) {
-            return &_pool[i];
+    fd_t *fd_obj = fd_get(fd);
+
+    /* the descriptor table maps straight to the pool, no need for a search */
+    if ((fd_obj == NULL) || !fd_obj->internal_active ||
+        (fd_obj->close != socket_close)) {
+        return NULL;
+    }
+    return &_pool[fd_obj->internal_fd];
+}
+
+/* the error to report when _get_socket() did not find a socket for @p fd */
+static int _socket_errno(int fd)
+{
+    fd_t *fd_obj = fd_get(fd);
+
+    return ((fd_obj == NULL) || !fd_obj->internal_active) ? EBADF : ENOTSOCK;
+}
+
+#ifdef SOCKET_RCV_QUEUE
+/* interrupts must be disabled */
+static inline void _waiter_add(socket_t *s, thread_t *thread)
+{
+    bf_set(s->waiters, thread->pid - KERNEL_PID_FIRST);
+}
+
+/* interrupts must be disabled */
+static inline void _waiter_remove(socket_t *s, thread_t *thread)
+{
+    bf_unset(s->waiters, thread->pid - KERNEL_PID_FIRST);
+}
+
+static void _rcv_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    socket_t *s = ctx;
+    BITFIELD(waiters, MAXTHREADS);
+    int idx;
+
+    if (cmd != GNRC_NETAPI_MSG_TYPE_RCV) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    unsigned state = irq_disable();
+    if ((idx = cib_put(&s->rcv_cib)) < 0) {
+        irq_restore(state);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    s->rcv_queue[idx] = pkt;
+    /* wake up every waiter, those still waiting will register again */
+    memcpy(waiters, s->waiters, sizeof(waiters));
+    memset(s->waiters, 0, sizeof(s->waiters));
+    irq_restore(state);
+    for (unsigned i = 0; i < MAXTHREADS; i++) {
+        if (bf_isset(waiters, i)) {
+            thread_t *waiter = (thread_t *)thread_get(i + KERNEL_PID_FIRST);
+            if (waiter != NULL) {
+                thread_flags_set(waiter, SOCKET_THREAD_FLAG);
+            }
         }
     }
-    return NULL;
 }
 
+static void _rcv_queue_flush(socket_t *s)
+{
+    int idx;
+
+    while ((idx = cib_get(&s->rcv_cib)) >= 0) {
+        gnrc_pktbuf_release(s->rcv_queue[idx]);
+    }
+}
+
+/* only meaningful as long as interrupts stay disabled */
+static inline bool _rcv_queue_empty(socket_t *s)
+{
+    return cib_avail(&s->rcv_cib) == 0;
+}
+
+static int _rcv_queue_get(socket_t *s, bool block, gnrc_pktsnip_t **pkt)
+{
+    while (1) {
+        unsigned state = irq_disable();
+        int idx = cib_get(&s->rcv_cib);
+
+        if (idx >= 0) {
+            *pkt = s->rcv_queue[idx];
+            irq_restore(state);
+            return 0;
+        }
+        if (!block) {
+            irq_restore(state);
+            return -EAGAIN;
+        }
+        _waiter_add(s, (thread_t *)sched_active_thread);
+        irq_restore(state);
+        thread_flags_wait_any(SOCKET_THREAD_FLAG);
+    }
+}
+
+static int _rcv_udp(socket_t *s, void *buffer, size_t length, int flags,
+                    void *addr, size_t *addr_len, uint16_t *port)
+{
+    gnrc_pktsnip_t *pkt, *l3hdr, *l4hdr;
+    size_t size;
+    int res;
+
+    if ((res = _rcv_queue_get(s, !(s->nonblocking || (flags & MSG_DONTWAIT)),
+                              &pkt)) < 0) {
+        return res;
+    }
+    l3hdr = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+    l4hdr = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
+    /* the source can only be reported if it fits the socket's address */
+    if ((s->domain == AF_INET6) && (*addr_len >= sizeof(ipv6_addr_t)) &&
+        (l3hdr != NULL) && (l4hdr != NULL)) {
+        memcpy(addr, &((ipv6_hdr_t *)l3hdr->data)->src, sizeof(ipv6_addr_t));
+        *addr_len = sizeof(ipv6_addr_t);
+        *port = byteorder_ntohs(((udp_hdr_t *)l4hdr->data)->src_port);
+    }
+    else {
+        *addr_len = 0;
+    }
+    /* datagram semantics: the part that does not fit is discarded */
+    size = (pkt->size < length) ? pkt->size : length;
+    memcpy(buffer, pkt->data, size);
+    res = (flags & MSG_TRUNC) ? (int)pkt->size : (int)size;
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+#endif
+
 static inline int _choose_ipproto(int type, int protocol)
 {
     switch (type) {
@@ -191,6 +358,20 @@ static inline int _get_data_from_sockaddr(const struct sockaddr *address, size_t
     return 0;
 }
 
+#ifdef MODULE_CONN_UDP
+static inline int _udp_create(socket_t *s, const void *addr, size_t addr_len,
+                              uint16_t port)
+{
+#ifdef SOCKET_RCV_QUEUE
+    /* packets go to the receive queue from the moment of registration */
+    return gnrc_conn_udp_create_cb(&s->conn.udp, addr, addr_len, s->domain,
+                                   port, _rcv_cb, s);
+#else
+    return conn_udp_create(&s->conn.udp, addr, addr_len, s->domain, port);
+#endif
+}
+#endif
+
 static int _implicit_bind(socket_t *s, void *addr)
 {
     ipv6_addr_t unspec;
@@ -214,8 +395,7 @@ static int _implicit_bind(socket_t *s, void *addr)
 #endif
 #ifdef MODULE_CONN_UDP
         case SOCK_DGRAM:
-            res = conn_udp_create(&s->conn.udp, best_match, sizeof(unspec),
-                                  s->domain, s->src_port);
+            res = _udp_create(s, best_match, sizeof(unspec), s->src_port);
             break;
 #endif
         default:
@@ -235,7 +415,7 @@ static int socket_close(int socket)
 {
     socket_t *s;
     int res = 0;
-    if ((unsigned)(socket - 1) > (SOCKET_POOL_SIZE - 1)) {
+    if ((unsigned)socket >= SOCKET_POOL_SIZE) {
         return -1;
     }
     mutex_lock(&_pool_mutex);
@@ -248,6 +428,9 @@ static int socket_close(int socket)
 #ifdef MODULE_CONN_UDP
                     case SOCK_DGRAM:
                         conn_udp_close(&s->conn.udp);
+#ifdef SOCKET_RCV_QUEUE
+                        _rcv_queue_flush(s);
+#endif
                         break;
 #endif
 #ifdef MODULE_CONN_IP
@@ -298,6 +481,13 @@ int socket(int domain, int type, int protocol)
         mutex_unlock(&_pool_mutex);
         return -1;
     }
+    memset(&s->conn, 0, sizeof(s->conn));
+    s->nonblocking = (type & SOCK_NONBLOCK);
+    type &= ~SOCK_NONBLOCK;
+#ifdef SOCKET_RCV_QUEUE
+    cib_init(&s->rcv_cib, SOCKET_RCV_QUEUE_SIZE);
+    memset(s->waiters, 0, sizeof(s->waiters));
+#endif
     switch (domain) {
         case AF_INET:
         case AF_INET6:
@@ -325,6 +515,10 @@ int socket(int domain, int type, int protocol)
             s->fd = res = fd;
         }
     }
+    if (res < 0) {
+        /* give the slot back */
+        s->domain = AF_UNSPEC;
+    }
     s->bound = false;
     s->src_port = 0;
     mutex_unlock(&_pool_mutex);
@@ -347,7 +541,7 @@ int accept(int socket, struct sockaddr *restrict address,
     s = _get_socket(socket);
     if (s == NULL) {
         mutex_unlock(&_pool_mutex);
-        errno = ENOTSOCK;
+        errno = _socket_errno(socket);
         return -1;
     }
     if (!s->bound) {
@@ -434,11 +628,9 @@ int bind(int socket, const struct sockaddr *address, socklen_t address_len)
     void *addr;
     size_t addr_len;
     network_uint16_t port = { 0 };
-    mutex_lock(&_pool_mutex);
     s = _get_socket(socket);
-    mutex_unlock(&_pool_mutex);
     if (s == NULL) {
-        errno = ENOTSOCK;
+        errno = _socket_errno(socket);
         return -1;
     }
     if (address->sa_family != s->domain) {
@@ -469,8 +661,8 @@ int bind(int socket, const struct sockaddr *address, socklen_t address_len)
 #endif
 #ifdef MODULE_CONN_UDP
         case SOCK_DGRAM:
-            if ((res = conn_udp_create(&s->conn.udp, addr, addr_len, s->domain,
-                                       byteorder_ntohs(port))) < 0) {
+            if ((res = _udp_create(s, addr, addr_len,
+                                   byteorder_ntohs(port))) < 0) {
 
                 errno = -res;
                 return -1;
@@ -497,11 +689,9 @@ int connect(int socket, const struct sockaddr *address, socklen_t address_len)
     void *addr;
     size_t addr_len;
     network_uint16_t port;
-    mutex_lock(&_pool_mutex);
     s = _get_socket(socket);
-    mutex_unlock(&_pool_mutex);
     if (s == NULL) {
-        errno = ENOTSOCK;
+        errno = _socket_errno(socket);
         return -1;
     }
     if (address->sa_family != s->domain) {
@@ -552,11 +742,9 @@ int getpeername(int socket, struct sockaddr *__restrict address,
     void *addr;
     uint16_t *port;
     socklen_t tmp_len;
-    mutex_lock(&_pool_mutex);
     s = _get_socket(socket);
-    mutex_unlock(&_pool_mutex);
     if (s == NULL) {
-        errno = ENOTSOCK;
+        errno = _socket_errno(socket);
         return -1;
     }
     switch (s->domain) {
@@ -616,11 +804,9 @@ int getsockname(int socket, struct sockaddr *__restrict address,
     void *addr;
     uint16_t *port;
     socklen_t tmp_len;
-    mutex_lock(&_pool_mutex);
     s = _get_socket(socket);
-    mutex_unlock(&_pool_mutex);
     if (s == NULL) {
-        errno = ENOTSOCK;
+        errno = _socket_errno(socket);
         return -1;
     }
     if (!s->bound) {
@@ -693,9 +879,11 @@ int listen(int socket, int backlog)
 {
     socket_t *s;
     int res = 0;
-    mutex_lock(&_pool_mutex);
     s = _get_socket(socket);
-    mutex_unlock(&_pool_mutex);
+    if (s == NULL) {
+        errno = _socket_errno(socket);
+        return -1;
+    }
     if (!s->bound) {
         errno = EINVAL;
         return -1;
@@ -744,12 +932,9 @@ ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags,
     size_t addr_len;
     uint16_t *port;
     socklen_t tmp_len;
-    (void)flags;
-    mutex_lock(&_pool_mutex);
     s = _get_socket(socket);
-    mutex_unlock(&_pool_mutex);
     if (s == NULL) {
-        errno = ENOTSOCK;
+        errno = _socket_errno(socket);
         return -1;
     }
     if (!s->bound) {
@@ -772,6 +957,7 @@ ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags,
             break;
         default:
             (void)buffer;
+            (void)flags;
             (void)length;
             (void)address;
             (void)address_len;
@@ -785,8 +971,19 @@ ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags,
     switch (s->type) {
 #ifdef MODULE_CONN_UDP
         case SOCK_DGRAM:
-            if ((res = conn_udp_recvfrom(&s->conn.udp, buffer, length, addr,
-                                         &addr_len, port)) < 0) {
+#ifdef SOCKET_RCV_QUEUE
+            res = _rcv_udp(s, buffer, length, flags, addr, &addr_len, port);
+#else
+            if (s->nonblocking || (flags & MSG_DONTWAIT)) {
+                /* conn_udp_recvfrom() always blocks */
+                res = -EOPNOTSUPP;
+            }
+            else {
+                res = conn_udp_recvfrom(&s->conn.udp, buffer, length, addr,
+                                        &addr_len, port);
+            }
+#endif
+            if (res < 0) {
                 errno = -res;
                 return -1;
             }
@@ -841,11 +1038,9 @@ ssize_t sendto(int socket, const void *buffer, size_t length, int flags,
     network_uint16_t port;
     port.u16 = 0;
     (void)flags;
-    mutex_lock(&_pool_mutex);
     s = _get_socket(socket);
-    mutex_unlock(&_pool_mutex);
     if (s == NULL) {
-        errno = ENOTSOCK;
+        errno = _socket_errno(socket);
         return -1;
     }
     if (address != NULL) {
@@ -947,6 +1142,166 @@ ssize_t sendto(int socket, const void *buffer, size_t length, int flags,
     return res;
 }
 
+static void _poll_timeout(void *arg)
+{
+    thread_flags_set(arg, THREAD_FLAG_TIMEOUT);
+}
+
+/* computes the events of one entry and, if waiter is given, registers it to
+ * be woken up on reception */
+static short _poll_events(const struct pollfd *pfd, thread_t *waiter)
+{
+    socket_t *s = _get_socket(pfd->fd);
+    short revents = POLLOUT;
+
+    if (s == NULL) {
+        return POLLNVAL;
+    }
+#ifdef SOCKET_RCV_QUEUE
+    if (s->type == SOCK_DGRAM) {
+        unsigned state = irq_disable();
+        if (!_rcv_queue_empty(s)) {
+            revents |= POLLIN;
+        }
+        else if (waiter != NULL) {
+            _waiter_add(s, waiter);
+        }
+        irq_restore(state);
+    }
+    else
+#endif
+    {
+        /* can't tell without a receive queue, let recv() block */
+        (void)waiter;
+        revents |= POLLIN;
+    }
+    return revents & (pfd->events | POLLERR | POLLHUP | POLLNVAL);
+}
+
+static int _poll_scan(struct pollfd fds[], nfds_t nfds, thread_t *waiter)
+{
+    int ready = 0;
+
+    for (nfds_t i = 0; i < nfds; i++) {
+        fds[i].revents = (fds[i].fd < 0) ? 0 : _poll_events(&fds[i], waiter);
+        if (fds[i].revents) {
+            ready++;
+        }
+    }
+    return ready;
+}
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+    xtimer_t timer;
+    int ready;
+
+    timer.callback = _poll_timeout;
+    timer.arg = me;
+    thread_flags_clear(THREAD_FLAG_TIMEOUT);
+    if (timeout > 0) {
+        uint64_t offset = (uint64_t)timeout * MS_IN_USEC;
+        _xtimer_set64(&timer, (uint32_t)offset, offset >> 32);
+    }
+    while (((ready = _poll_scan(fds, nfds, (timeout != 0) ? me : NULL)) == 0) &&
+           (timeout != 0)) {
+        if (thread_flags_wait_any(SOCKET_THREAD_FLAG | THREAD_FLAG_TIMEOUT) &
+            THREAD_FLAG_TIMEOUT) {
+            ready = _poll_scan(fds, nfds, NULL);
+            break;
+        }
+    }
+    if (timeout > 0) {
+        xtimer_remove(&timer);
+    }
+#ifdef SOCKET_RCV_QUEUE
+    for (nfds_t i = 0; i < nfds; i++) {
+        socket_t *s = _get_socket(fds[i].fd);
+        if (s != NULL) {
+            unsigned state = irq_disable();
+            _waiter_remove(s, me);
+            irq_restore(state);
+        }
+    }
+#endif
+    return ready;
+}
+
+int select(int nfds, fd_set *readfds, fd_set *writefds, fd_set *errorfds,
+           struct timeval *timeout)
+{
+    /* only sockets can be selected, so there can't be more than the pool */
+    struct pollfd fds[SOCKET_POOL_SIZE];
+    nfds_t n = 0;
+    int tmo = -1, res;
+
+    if (nfds < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (int fd = 0; fd < nfds; fd++) {
+        short events = 0;
+        if ((readfds != NULL) && FD_ISSET(fd, readfds)) {
+            events |= POLLIN;
+        }
+        if ((writefds != NULL) && FD_ISSET(fd, writefds)) {
+            events |= POLLOUT;
+        }
+        if ((events == 0) && ((errorfds == NULL) || !FD_ISSET(fd, errorfds))) {
+            continue;
+        }
+        if ((n == SOCKET_POOL_SIZE) || (_get_socket(fd) == NULL)) {
+            errno = EBADF;
+            return -1;
+        }
+        fds[n].fd = fd;
+        fds[n].events = events;
+        n++;
+    }
+    if (timeout != NULL) {
+        if ((timeout->tv_sec < 0) || (timeout->tv_usec < 0) ||
+            (timeout->tv_usec >= (long)SEC_IN_USEC)) {
+            errno = EINVAL;
+            return -1;
+        }
+        uint64_t ms = ((uint64_t)timeout->tv_sec * SEC_IN_MS) +
+                      ((timeout->tv_usec + 999) / 1000);
+        tmo = (ms > INT_MAX) ? INT_MAX : (int)ms;
+    }
+    if ((res = poll(fds, n, tmo)) < 0) {
+        return -1;
+    }
+    res = 0;
+    for (nfds_t i = 0; i < n; i++) {
+        int fd = fds[i].fd;
+        if (readfds != NULL) {
+            if (fds[i].revents & POLLIN) {
+                res++;
+            }
+            else {
+                FD_CLR(fd, readfds);
+            }
+        }
+        if (writefds != NULL) {
+            if (fds[i].revents & POLLOUT) {
+                res++;
+            }
+            else {
+                FD_CLR(fd, writefds);
+            }
+        }
+        if (errorfds != NULL) {
+            if (fds[i].revents & POLLERR) {
+                res++;
+            }
+            else {
+                FD_CLR(fd, errorfds);
+            }
+        }
+    }
+    return res;
+}
 
 /**
  * @}
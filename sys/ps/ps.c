@@ -58,6 +58,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime | switches"
+#endif
+#ifdef MODULE_SCHED_ROUND_ROBIN
+           " | slices"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -75,7 +78,11 @@ void ps(void)
 #ifdef DEVELHELP
             int stacksz = p->stack_size;                                           /* get stack size */
             overall_stacksz += stacksz;
+#ifdef MODULE_SCHED_STACK_WATERMARK
+            stacksz -= p->stack_lowest - p->stack_start;
+#else
             stacksz -= thread_measure_stack_free(p->stack_start);
+#endif
             overall_used += stacksz;
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
@@ -92,6 +99,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %6.3f%% |  %8d"
+#endif
+#ifdef MODULE_SCHED_ROUND_ROBIN
+                   " | %6u"
 #endif
                    "\n",
                    p->pid,
@@ -104,6 +114,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_ticks, switches
+#endif
+#ifdef MODULE_SCHED_ROUND_ROBIN
+                   , sched_rr_slices[i]
 #endif
                   );
         }
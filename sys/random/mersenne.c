@@ -66,7 +66,7 @@ void random_init(uint32_t s)
         /* 2002/01/09 modified by Makoto Matsumoto             */
     }
 
-    mti = N;
+    mti = 0;
 }
 
 void random_init_by_array(uint32_t *init_key, int key_length)
@@ -99,32 +99,30 @@ void random_init_by_array(uint32_t *init_key, int key_length)
     mt[0] = 0x80000000UL; /* MSB is 1; assuring non-zero initial array */
 }
 
-/** generates N words at one time */
-static void generate_numbers(void)
+uint32_t random_uint32(void)
 {
     if (mti == MTI_UNINITIALIZED) {
         /* if init_genrand() has not been called, a default initial seed is used */
         random_init(5489UL);
     }
 
-    for (int k = 0; k < N; ++k) {
-        uint32_t y = (mt[k] & UPPER_MASK) | (mt[(k + 1) % N] & LOWER_MASK);
-        mt[k] = mt[(k + M) % N] ^ (y >> 1);
-        if (y & 1) {
-            mt[k] ^= MATRIX_A;
-        }
-    }
-
-    mti = 0;
-}
-
-uint32_t random_uint32(void)
-{
-    if (mti >= N) {
-        generate_numbers();
+    /* Twist one word per call instead of all N words at once. mt[k] only
+     * depends on mt[k + 1], which is still from the last round, and on
+     * mt[k + M], which is from the last round or, past the end of mt[],
+     * from this one, just as with twisting all words in a row. This yields
+     * the same sequence, without a latency spike every N calls. */
+    unsigned k = mti;
+    unsigned k1 = (k + 1 < N) ? k + 1 : 0;
+    unsigned km = (k + M < N) ? k + M : k + M - N;
+
+    uint32_t y = (mt[k] & UPPER_MASK) | (mt[k1] & LOWER_MASK);
+    mt[k] = mt[km] ^ (y >> 1);
+    if (y & 1) {
+        mt[k] ^= MATRIX_A;
     }
+    mti = k1;
 
-    uint32_t y = mt[mti++];
+    y = mt[k];
     y ^= y >> 11;
     y ^= (y << 7) & 0x9d2c5680UL;
     y ^= (y << 15) & 0xefc60000UL;
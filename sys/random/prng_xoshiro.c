@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_random
+ * @{
+ *
+ * @file
+ * @brief       Glue-code for xoshiro128**
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "random.h"
+#include "xoshiro.h"
+
+/* any state but all zeros will do until random_init() is called */
+static xoshiro_t _random = { .s = { 0x12345678, 0x9abcdef0, 0x0fedcba9, 0x87654321 } };
+
+void random_init(uint32_t seed)
+{
+    xoshiro_init(&_random, seed);
+}
+
+uint32_t random_uint32(void)
+{
+    return xoshiro_next(&_random);
+}
+
+void random_bytes(uint8_t *buf, size_t size)
+{
+    xoshiro_bytes(&_random, buf, size);
+}
+
+void random_xoshiro_stream(xoshiro_t *stream)
+{
+    *stream = _random;
+    xoshiro_jump(&_random);
+}
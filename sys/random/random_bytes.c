@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_random
+ * @{
+ *
+ * @file
+ * @brief       Bulk interface for PRNGs that only generate words
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "random.h"
+
+void random_bytes(uint8_t *buf, size_t size)
+{
+    for (; size >= sizeof(uint32_t); size -= sizeof(uint32_t)) {
+        uint32_t r = random_uint32();
+        memcpy(buf, &r, sizeof(r));
+        buf += sizeof(r);
+    }
+    if (size) {
+        uint32_t r = random_uint32();
+        memcpy(buf, &r, size);
+    }
+}
@@ -29,11 +29,35 @@
  */
 saul_reg_t *saul_reg = NULL;
 
+/**
+ * @brief   The first SAUL_REG_INDEX_NUMOF entries of the list, in list order
+ */
+static saul_reg_t *_index[SAUL_REG_INDEX_NUMOF];
 
-int saul_reg_add(saul_reg_t *dev)
+/**
+ * @brief   Number of registered devices
+ */
+static unsigned _numof;
+
+/**
+ * @brief   Last entry of the list
+ */
+static saul_reg_t *_tail;
+
+static inline unsigned _indexed(void)
 {
-    saul_reg_t *tmp = saul_reg;
+    return (_numof < SAUL_REG_INDEX_NUMOF) ? _numof : SAUL_REG_INDEX_NUMOF;
+}
 
+/* first entry that is not in the table */
+static inline saul_reg_t *_unindexed(void)
+{
+    return (_numof > SAUL_REG_INDEX_NUMOF) ?
+           _index[SAUL_REG_INDEX_NUMOF - 1]->next : NULL;
+}
+
+int saul_reg_add(saul_reg_t *dev)
+{
     if (dev == NULL) {
         return -ENODEV;
     }
@@ -45,41 +69,69 @@ int saul_reg_add(saul_reg_t *dev)
         saul_reg = dev;
     }
     else {
-        while (tmp->next != NULL) {
-            tmp = tmp->next;
-        }
-        tmp->next = dev;
+        _tail->next = dev;
+    }
+    _tail = dev;
+    if (_numof < SAUL_REG_INDEX_NUMOF) {
+        _index[_numof] = dev;
     }
+    _numof++;
     return 0;
 }
 
 int saul_reg_rm(saul_reg_t *dev)
 {
+    saul_reg_t *prev = NULL;
     saul_reg_t *tmp = saul_reg;
+    unsigned pos = 0;
 
     if (saul_reg == NULL || dev == NULL) {
         return -ENODEV;
     }
-    if (saul_reg == dev) {
-        saul_reg = dev->next;
-    }
-    while (tmp->next && (tmp->next != dev)) {
+    while (tmp && (tmp != dev)) {
+        prev = tmp;
         tmp = tmp->next;
+        pos++;
     }
-    if (tmp->next == dev) {
-        tmp->next = dev->next;
+    if (tmp == NULL) {
+        return -ENODEV;
+    }
+
+    if (prev) {
+        prev->next = dev->next;
     }
     else {
-        return -ENODEV;
+        saul_reg = dev->next;
+    }
+    if (_tail == dev) {
+        _tail = prev;
     }
+
+    /* close the gap in the table, refilling its end from the list */
+    if (pos < SAUL_REG_INDEX_NUMOF) {
+        unsigned last = _indexed() - 1;
+        for (unsigned i = pos; i < last; i++) {
+            _index[i] = _index[i + 1];
+        }
+        _index[last] = (last > 0) ? _index[last - 1]->next :
+                       ((_numof > 1) ? saul_reg : NULL);
+    }
+    _numof--;
     return 0;
 }
 
 saul_reg_t *saul_reg_find_nth(int pos)
 {
-    saul_reg_t *tmp = saul_reg;
+    if (pos < 0) {
+        return NULL;
+    }
+    if ((unsigned)pos < _indexed()) {
+        return _index[pos];
+    }
+
+    saul_reg_t *tmp = _unindexed();
 
-    for (int i = 0; (i < pos) && tmp; i++) {
+    for (int i = SAUL_REG_INDEX_NUMOF; (i < pos) && tmp; i++) {
         tmp = tmp->next;
     }
     return tmp;
@@ -87,7 +139,13 @@ saul_reg_t *saul_reg_find_nth(int pos)
 
 saul_reg_t *saul_reg_find_type(uint8_t type)
 {
-    saul_reg_t *tmp = saul_reg;
+    for (unsigned i = 0; i < _indexed(); i++) {
+        if (_index[i]->driver->type == type) {
+            return _index[i];
+        }
+    }
+
+    saul_reg_t *tmp = _unindexed();
 
     while (tmp) {
         if (tmp->driver->type == type) {
@@ -100,7 +158,13 @@ saul_reg_t *saul_reg_find_type(uint8_t type)
 
 saul_reg_t *saul_reg_find_name(const char *name)
 {
-    saul_reg_t *tmp = saul_reg;
+    for (unsigned i = 0; i < _indexed(); i++) {
+        if (strcmp(_index[i]->name, name) == 0) {
+            return _index[i];
+        }
+    }
+
+    saul_reg_t *tmp = _unindexed();
 
     while (tmp) {
         if (strcmp(tmp->name, name) == 0) {
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_saul_sampler
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampler implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "thread_flags.h"
+#include "saul_sampler.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief   Thread flag set on the sampler thread when a deadline is near
+ */
+#define FLAG_RUN        (0x1)
+
+static void _wakeup(void *arg)
+{
+    saul_sampler_t *sampler = arg;
+
+    thread_flags_set((thread_t *)thread_get(sampler->pid), FLAG_RUN);
+}
+
+static uint32_t _sample(saul_sampler_t *sampler, unsigned i)
+{
+    saul_sampler_entry_t *entry = &sampler->entries[i];
+    saul_sample_t sample;
+    int res = saul_reg_read(entry->dev, &sample.data);
+
+    sample.time = xtimer_now();
+    sample.entry = i;
+    sample.dim = (res < INT8_MIN) ? -EIO : res;
+
+    int32_t jitter = (int32_t)(sample.time - entry->next);
+    uint32_t abs_jitter = (jitter < 0) ? -jitter : jitter;
+    if (jitter > INT16_MAX) {
+        jitter = INT16_MAX;
+    }
+    else if (jitter < INT16_MIN) {
+        jitter = INT16_MIN;
+    }
+    sample.jitter = jitter;
+
+    /* the only writer, so the free space can only grow meanwhile */
+    int stored = 0;
+    if (tsrb_free(&sampler->ring) >= sizeof(sample)) {
+        tsrb_add(&sampler->ring, (const char *)&sample, sizeof(sample));
+        stored = 1;
+    }
+
+    unsigned state = irq_disable();
+    saul_sampler_stats_t *stats = &sampler->stats;
+    if (res < 0) {
+        stats->errors++;
+    }
+    if (stored) {
+        stats->samples++;
+    }
+    else {
+        stats->dropped++;
+    }
+    if (abs_jitter > stats->jitter_max) {
+        stats->jitter_max = abs_jitter;
+    }
+    stats->jitter_sum += abs_jitter;
+    irq_restore(state);
+
+    if (stored && sampler->waiter) {
+        thread_flags_set(sampler->waiter, SAUL_SAMPLER_THREAD_FLAG);
+    }
+
+    return sample.time;
+}
+
+static void _run(saul_sampler_t *sampler)
+{
+    while (1) {
+        uint32_t now = xtimer_now();
+
+        for (unsigned i = 0; i < sampler->numof; i++) {
+            saul_sampler_entry_t *entry = &sampler->entries[i];
+
+            if ((int32_t)(entry->next - now) > (int32_t)SAUL_SAMPLER_SLACK) {
+                continue;
+            }
+            now = _sample(sampler, i);
+            entry->next += entry->period;
+            if ((int32_t)(entry->next - now) <= 0) {
+                DEBUG("saul_sampler: entry %u is late\n", i);
+                unsigned state = irq_disable();
+                sampler->stats.late++;
+                irq_restore(state);
+                entry->next = now + entry->period;
+            }
+        }
+
+        /* sleep until the earliest deadline, unless it is due already */
+        int32_t wait = INT32_MAX;
+        now = xtimer_now();
+        for (unsigned i = 0; i < sampler->numof; i++) {
+            int32_t left = (int32_t)(sampler->entries[i].next - now);
+            if (left < wait) {
+                wait = left;
+            }
+        }
+        if (wait > (int32_t)SAUL_SAMPLER_SLACK) {
+            xtimer_set(&sampler->timer, wait);
+            return;
+        }
+    }
+}
+
+static void *_sampler_thread(void *arg)
+{
+    saul_sampler_t *sampler = arg;
+
+    while (1) {
+        thread_flags_wait_any(FLAG_RUN);
+        _run(sampler);
+    }
+
+    return NULL;
+}
+
+int saul_sampler_init(saul_sampler_t *sampler, saul_sampler_entry_t *entries,
+                      unsigned numof, saul_sample_t *buf, unsigned size)
+{
+    if ((numof == 0) || (numof > 256) || (size < sizeof(saul_sample_t)) ||
+        (size & (size - 1)) || (size % sizeof(saul_sample_t))) {
+        return -EINVAL;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        if ((entries[i].dev == NULL) || (entries[i].period == 0) ||
+            (entries[i].period > INT32_MAX)) {
+            return -EINVAL;
+        }
+    }
+
+    sampler->entries = entries;
+    sampler->numof = numof;
+    tsrb_init(&sampler->ring, (char *)buf, size);
+    sampler->timer.callback = _wakeup;
+    sampler->timer.arg = sampler;
+    sampler->pid = KERNEL_PID_UNDEF;
+    sampler->waiter = NULL;
+    memset(&sampler->stats, 0, sizeof(sampler->stats));
+
+    return 0;
+}
+
+kernel_pid_t saul_sampler_start(saul_sampler_t *sampler, char *stack,
+                                int stacksize, char priority)
+{
+    uint32_t now = xtimer_now();
+
+    for (unsigned i = 0; i < sampler->numof; i++) {
+        sampler->entries[i].next = now;
+    }
+
+    sampler->pid = thread_create(stack, stacksize, priority,
+                                 THREAD_CREATE_STACKTEST, _sampler_thread,
+                                 sampler, "saul_sampler");
+    if (sampler->pid > KERNEL_PID_UNDEF) {
+        _wakeup(sampler);
+    }
+
+    return sampler->pid;
+}
+
+unsigned saul_sampler_get(saul_sampler_t *sampler, saul_sample_t *dst,
+                          unsigned max)
+{
+    unsigned n = tsrb_avail(&sampler->ring) / sizeof(saul_sample_t);
+
+    if (n > max) {
+        n = max;
+    }
+    tsrb_get(&sampler->ring, (char *)dst, n * sizeof(saul_sample_t));
+
+    return n;
+}
+
+void saul_sampler_wait(saul_sampler_t *sampler)
+{
+    sampler->waiter = (thread_t *)sched_active_thread;
+
+    while (tsrb_empty(&sampler->ring)) {
+        thread_flags_wait_any(SAUL_SAMPLER_THREAD_FLAG);
+    }
+}
+
+void saul_sampler_get_stats(saul_sampler_t *sampler,
+                            saul_sampler_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = sampler->stats;
+    irq_restore(state);
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_schema
+ * @{
+ *
+ * @file
+ * @brief       Schema index and field access
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "schema.h"
+
+#define FNV_OFFSET_BASIS    (2166136261u)
+#define FNV_PRIME           (16777619u)
+
+uint32_t schema_hash(const char *key, size_t len)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+
+    while (len--) {
+        hash = (hash ^ (uint8_t)*key++) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+void schema_init(schema_t *schema)
+{
+    if (schema->ready) {
+        return;
+    }
+
+    memset(schema->index, 0, schema->mask + 1);
+
+    for (unsigned i = 0; i < schema->num; i++) {
+        const schema_field_t *field = &schema->fields[i];
+        uint32_t hash = field->hash ? field->hash
+                                    : schema_hash(field->name, field->name_len);
+        unsigned slot = hash & schema->mask;
+
+        while (schema->index[slot]) {
+            slot = (slot + 1) & schema->mask;
+        }
+
+        schema->index[slot] = i + 1;
+    }
+
+    schema->ready = true;
+}
+
+const schema_field_t *schema_find(schema_t *schema, const char *key, size_t len)
+{
+    schema_init(schema);
+
+    unsigned slot = schema_hash(key, len) & schema->mask;
+
+    /* the index is at most half full, so this terminates quickly */
+    while (schema->index[slot]) {
+        const schema_field_t *field = &schema->fields[schema->index[slot] - 1];
+
+        if (field->name_len == len && memcmp(field->name, key, len) == 0) {
+            return field;
+        }
+
+        slot = (slot + 1) & schema->mask;
+    }
+
+    return NULL;
+}
+
+int schema_store_int(const schema_field_t *field, void *obj, int64_t val)
+{
+    void *dst = (uint8_t *)obj + field->offset;
+
+    if (val >= 0) {
+        return schema_store_uint(field, obj, (uint64_t)val);
+    }
+
+    switch (field->type) {
+        case SCHEMA_INT8:
+            if (val < INT8_MIN) {
+                return -ERANGE;
+            }
+            *(int8_t *)dst = val;
+            return 0;
+        case SCHEMA_INT16:
+            if (val < INT16_MIN) {
+                return -ERANGE;
+            }
+            *(int16_t *)dst = val;
+            return 0;
+        case SCHEMA_INT32:
+            if (val < INT32_MIN) {
+                return -ERANGE;
+            }
+            *(int32_t *)dst = val;
+            return 0;
+        case SCHEMA_INT64:
+            *(int64_t *)dst = val;
+            return 0;
+        case SCHEMA_UINT8:
+        case SCHEMA_UINT16:
+        case SCHEMA_UINT32:
+        case SCHEMA_UINT64:
+            return -ERANGE;
+        case SCHEMA_FLOAT:
+        case SCHEMA_DOUBLE:
+            return schema_store_double(field, obj, (double)val);
+        default:
+            return -EINVAL;
+    }
+}
+
+int schema_store_uint(const schema_field_t *field, void *obj, uint64_t val)
+{
+    void *dst = (uint8_t *)obj + field->offset;
+
+    switch (field->type) {
+        case SCHEMA_INT8:
+            if (val > INT8_MAX) {
+                return -ERANGE;
+            }
+            *(int8_t *)dst = val;
+            return 0;
+        case SCHEMA_INT16:
+            if (val > INT16_MAX) {
+                return -ERANGE;
+            }
+            *(int16_t *)dst = val;
+            return 0;
+        case SCHEMA_INT32:
+            if (val > INT32_MAX) {
+                return -ERANGE;
+            }
+            *(int32_t *)dst = val;
+            return 0;
+        case SCHEMA_INT64:
+            if (val > INT64_MAX) {
+                return -ERANGE;
+            }
+            *(int64_t *)dst = val;
+            return 0;
+        case SCHEMA_UINT8:
+            if (val > UINT8_MAX) {
+                return -ERANGE;
+            }
+            *(uint8_t *)dst = val;
+            return 0;
+        case SCHEMA_UINT16:
+            if (val > UINT16_MAX) {
+                return -ERANGE;
+            }
+            *(uint16_t *)dst = val;
+            return 0;
+        case SCHEMA_UINT32:
+            if (val > UINT32_MAX) {
+                return -ERANGE;
+            }
+            *(uint32_t *)dst = val;
+            return 0;
+        case SCHEMA_UINT64:
+            *(uint64_t *)dst = val;
+            return 0;
+        case SCHEMA_FLOAT:
+        case SCHEMA_DOUBLE:
+            return schema_store_double(field, obj, (double)val);
+        default:
+            return -EINVAL;
+    }
+}
+
+int schema_store_double(const schema_field_t *field, void *obj, double val)
+{
+    void *dst = (uint8_t *)obj + field->offset;
+
+    switch (field->type) {
+        case SCHEMA_FLOAT:
+            *(float *)dst = (float)val;
+            return 0;
+        case SCHEMA_DOUBLE:
+            *(double *)dst = val;
+            return 0;
+        default:
+            return -EINVAL;
+    }
+}
+
+int schema_store_string(const schema_field_t *field, void *obj,
+                        const char *str, size_t len)
+{
+    char *dst = (char *)obj + field->offset;
+
+    if (field->type != SCHEMA_STRING) {
+        return -EINVAL;
+    }
+
+    if (len >= field->size) {
+        return -EOVERFLOW;
+    }
+
+    memcpy(dst, str, len);
+    dst[len] = '\0';
+    return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_schema
+ * @{
+ *
+ * @file
+ * @brief       Schema driven CBOR encoder and decoder
+ *
+ * @}
+ */
+
+#ifdef MODULE_CBOR
+
+#include <errno.h>
+#include <string.h>
+
+#include "schema.h"
+
+static int _encode(schema_t *schema, const void *obj, cbor_writer_t *writer,
+                   unsigned depth)
+{
+    cbor_put_map(writer, schema->num);
+
+    for (unsigned i = 0; i < schema->num; i++) {
+        const schema_field_t *field = &schema->fields[i];
+        const void *src = (const uint8_t *)obj + field->offset;
+
+        cbor_put_text(writer, field->name, field->name_len);
+
+        switch (field->type) {
+            case SCHEMA_BOOL:
+                cbor_put_bool(writer, *(const bool *)src);
+                break;
+            case SCHEMA_INT8:
+                cbor_put_int(writer, *(const int8_t *)src);
+                break;
+            case SCHEMA_INT16:
+                cbor_put_int(writer, *(const int16_t *)src);
+                break;
+            case SCHEMA_INT32:
+                cbor_put_int(writer, *(const int32_t *)src);
+                break;
+            case SCHEMA_INT64:
+                cbor_put_int(writer, *(const int64_t *)src);
+                break;
+            case SCHEMA_UINT8:
+                cbor_put_uint(writer, *(const uint8_t *)src);
+                break;
+            case SCHEMA_UINT16:
+                cbor_put_uint(writer, *(const uint16_t *)src);
+                break;
+            case SCHEMA_UINT32:
+                cbor_put_uint(writer, *(const uint32_t *)src);
+                break;
+            case SCHEMA_UINT64:
+                cbor_put_uint(writer, *(const uint64_t *)src);
+                break;
+#ifndef CBOR_NO_FLOAT
+            case SCHEMA_FLOAT:
+                cbor_put_float(writer, *(const float *)src);
+                break;
+            case SCHEMA_DOUBLE:
+                cbor_put_double(writer, *(const double *)src);
+                break;
+#endif
+            case SCHEMA_STRING:
+                cbor_put_text(writer, src, strnlen(src, field->size));
+                break;
+            case SCHEMA_STRUCT:
+                if (!depth) {
+                    return -EINVAL;
+                }
+                _encode(field->sub, src, writer, depth - 1);
+                break;
+            default:
+                return -EINVAL;
+        }
+    }
+
+    /* the writer's errors are sticky, so checking once suffices */
+    return writer->error;
+}
+
+int schema_cbor_encode(schema_t *schema, const void *obj, cbor_writer_t *writer)
+{
+    return _encode(schema, obj, writer, SCHEMA_MAX_NESTING);
+}
+
+static int _decode(schema_t *schema, void *obj, cbor_cursor_t *cursor,
+                   unsigned depth);
+
+static int _decode_value(const schema_field_t *field, void *obj,
+                         cbor_cursor_t *cursor, unsigned depth)
+{
+    int res;
+
+    switch (cbor_cursor_peek(cursor)) {
+        case CBOR_ITEM_UINT: {
+            uint64_t val;
+            if ((res = cbor_get_uint(cursor, &val)) < 0) {
+                return res;
+            }
+            return schema_store_uint(field, obj, val);
+        }
+
+        case CBOR_ITEM_NEGINT: {
+            int64_t val;
+            if ((res = cbor_get_int64(cursor, &val)) < 0) {
+                return res;
+            }
+            return schema_store_int(field, obj, val);
+        }
+
+        case CBOR_ITEM_BOOL:
+            if (field->type != SCHEMA_BOOL) {
+                return -EINVAL;
+            }
+            return cbor_get_bool(cursor, (bool *)((uint8_t *)obj + field->offset));
+
+#ifndef CBOR_NO_FLOAT
+        case CBOR_ITEM_FLOAT: {
+            double val;
+            if ((res = cbor_get_double(cursor, &val)) < 0) {
+                return res;
+            }
+            return schema_store_double(field, obj, val);
+        }
+#endif
+
+        case CBOR_ITEM_TEXT: {
+            const char *str;
+            size_t len;
+            if ((res = cbor_get_text(cursor, &str, &len)) < 0) {
+                return res;
+            }
+            return schema_store_string(field, obj, str, len);
+        }
+
+        case CBOR_ITEM_MAP:
+            if (field->type != SCHEMA_STRUCT || !depth) {
+                return -EINVAL;
+            }
+            res = _decode(field->sub, (uint8_t *)obj + field->offset, cursor,
+                          depth - 1);
+            return (res < 0) ? res : 0;
+
+        case CBOR_ITEM_NULL:
+            /* leave the field as it is */
+            return cbor_get_null(cursor);
+
+        case CBOR_ITEM_INVALID:
+            return -EBADMSG;
+
+        default:
+            return -EINVAL;
+    }
+}
+
+static int _decode(schema_t *schema, void *obj, cbor_cursor_t *cursor,
+                   unsigned depth)
+{
+    cbor_cursor_t map;
+    int res = cbor_cursor_enter(cursor, &map);
+    int count = 0;
+
+    if (res < 0) {
+        return res;
+    }
+
+    schema_init(schema);
+
+    while (cbor_cursor_peek(&map) != CBOR_ITEM_END) {
+        const schema_field_t *field = NULL;
+        const char *key;
+        size_t len;
+
+        if (cbor_get_text(&map, &key, &len) == 0) {
+            field = schema_find(schema, key, len);
+        }
+        else if ((res = cbor_cursor_skip(&map)) < 0) {
+            /* not a text key, skip the key here and its value below */
+            return res;
+        }
+
+        if (!field) {
+            res = cbor_cursor_skip(&map);
+        }
+        else if ((res = _decode_value(field, obj, &map, depth)) == 0) {
+            count++;
+        }
+
+        if (res < 0) {
+            return res;
+        }
+    }
+
+    res = cbor_cursor_leave(cursor, &map);
+    return (res < 0) ? res : count;
+}
+
+int schema_cbor_decode(schema_t *schema, void *obj, cbor_cursor_t *cursor)
+{
+    return _decode(schema, obj, cursor, SCHEMA_MAX_NESTING);
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_CBOR */
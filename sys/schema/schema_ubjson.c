@@ -0,0 +1,525 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_schema
+ * @{
+ *
+ * @file
+ * @brief       Schema driven UBJSON encoder and decoder
+ *
+ * The decoder parses objects directly instead of going through the
+ * callbacks of ubjson_read(), so decoding a value costs one switch on its
+ * marker and one hash lookup for its key.
+ *
+ * @}
+ */
+
+#ifdef MODULE_UBJSON
+
+#include <errno.h>
+#include <string.h>
+
+#include "schema.h"
+#include "ubjson-internal.h"
+
+#define WRITE_CALL(FUN, ...)                                                  \
+    do {                                                                      \
+        ssize_t wrote = (FUN)(__VA_ARGS__);                                   \
+        if (wrote < 0) {                                                      \
+            return wrote;                                                     \
+        }                                                                     \
+        result += wrote;                                                      \
+    } while (0)
+
+static ssize_t _encode(schema_t *schema, const void *obj, ubjson_cookie_t *cookie,
+                       unsigned depth)
+{
+    ssize_t result = 0;
+
+    WRITE_CALL(ubjson_open_object_len, cookie, schema->num);
+
+    for (unsigned i = 0; i < schema->num; i++) {
+        const schema_field_t *field = &schema->fields[i];
+        const void *src = (const uint8_t *)obj + field->offset;
+
+        WRITE_CALL(ubjson_write_key, cookie, field->name, field->name_len);
+
+        switch (field->type) {
+            case SCHEMA_BOOL:
+                WRITE_CALL(ubjson_write_bool, cookie, *(const bool *)src);
+                break;
+            case SCHEMA_INT8:
+                WRITE_CALL(ubjson_write_i32, cookie, *(const int8_t *)src);
+                break;
+            case SCHEMA_INT16:
+                WRITE_CALL(ubjson_write_i32, cookie, *(const int16_t *)src);
+                break;
+            case SCHEMA_INT32:
+                WRITE_CALL(ubjson_write_i32, cookie, *(const int32_t *)src);
+                break;
+            case SCHEMA_INT64:
+                WRITE_CALL(ubjson_write_i64, cookie, *(const int64_t *)src);
+                break;
+            case SCHEMA_UINT8:
+                WRITE_CALL(ubjson_write_i32, cookie, *(const uint8_t *)src);
+                break;
+            case SCHEMA_UINT16:
+                WRITE_CALL(ubjson_write_i32, cookie, *(const uint16_t *)src);
+                break;
+            case SCHEMA_UINT32:
+                WRITE_CALL(ubjson_write_i64, cookie, *(const uint32_t *)src);
+                break;
+            case SCHEMA_UINT64:
+                /* UBJSON has no unsigned 64 bit type */
+                if (*(const uint64_t *)src > INT64_MAX) {
+                    return -ERANGE;
+                }
+                WRITE_CALL(ubjson_write_i64, cookie, *(const uint64_t *)src);
+                break;
+            case SCHEMA_FLOAT:
+                WRITE_CALL(ubjson_write_float, cookie, *(const float *)src);
+                break;
+            case SCHEMA_DOUBLE:
+                WRITE_CALL(ubjson_write_double, cookie, *(const double *)src);
+                break;
+            case SCHEMA_STRING:
+                WRITE_CALL(ubjson_write_string, cookie, src, strnlen(src, field->size));
+                break;
+            case SCHEMA_STRUCT:
+                if (!depth) {
+                    return -EINVAL;
+                }
+                WRITE_CALL(_encode, field->sub, src, cookie, depth - 1);
+                break;
+            default:
+                return -EINVAL;
+        }
+    }
+
+    return result;
+}
+
+ssize_t schema_ubjson_encode(schema_t *schema, const void *obj,
+                             ubjson_cookie_t *cookie)
+{
+    return _encode(schema, obj, cookie, SCHEMA_MAX_NESTING);
+}
+
+static int _read(ubjson_cookie_t *cookie, void *buf, size_t len)
+{
+    if (len && ubjson_get_string(cookie, len, buf) != (ssize_t)len) {
+        return -EBADMSG;
+    }
+
+    return 0;
+}
+
+static int _discard(ubjson_cookie_t *cookie, size_t len)
+{
+    uint8_t buf[16];
+
+    while (len) {
+        size_t chunk = (len < sizeof(buf)) ? len : sizeof(buf);
+
+        if (_read(cookie, buf, chunk) < 0) {
+            return -EBADMSG;
+        }
+
+        len -= chunk;
+    }
+
+    return 0;
+}
+
+/**
+ * Read the next marker, honoring the push-back buffer and skipping no-ops
+ */
+static int _read_marker(ubjson_cookie_t *cookie, char *marker)
+{
+    do {
+        if (cookie->marker) {
+            *marker = cookie->marker;
+            cookie->marker = 0;
+        }
+        else if (_read(cookie, marker, 1) < 0) {
+            return -EBADMSG;
+        }
+    } while (*marker == UBJSON_MARKER_NOOP);
+
+    return 0;
+}
+
+/**
+ * Read the payload of the integer with marker @p marker
+ */
+static int _read_int(ubjson_cookie_t *cookie, char marker, int64_t *val)
+{
+    uint8_t buf[8];
+    unsigned len;
+
+    switch (marker) {
+        case UBJSON_MARKER_INT8:
+        case UBJSON_MARKER_UINT8:
+            len = 1;
+            break;
+        case UBJSON_MARKER_INT16:
+            len = 2;
+            break;
+        case UBJSON_MARKER_INT32:
+            len = 4;
+            break;
+        case UBJSON_MARKER_INT64:
+            len = 8;
+            break;
+        default:
+            return -EINVAL;
+    }
+
+    if (_read(cookie, buf, len) < 0) {
+        return -EBADMSG;
+    }
+
+    uint64_t u = 0;
+
+    for (unsigned i = 0; i < len; i++) {
+        u = (u << 8) | buf[i];
+    }
+
+    switch (marker) {
+        case UBJSON_MARKER_INT8:
+            *val = (int8_t)u;
+            break;
+        case UBJSON_MARKER_INT16:
+            *val = (int16_t)u;
+            break;
+        case UBJSON_MARKER_INT32:
+            *val = (int32_t)u;
+            break;
+        default:
+            *val = (int64_t)u;
+            break;
+    }
+
+    return 0;
+}
+
+/**
+ * Read a length: an integer including its marker
+ */
+static int _read_length(ubjson_cookie_t *cookie, size_t *len)
+{
+    char marker;
+    int64_t val;
+
+    if (_read_marker(cookie, &marker) < 0 || _read_int(cookie, marker, &val) < 0
+        || val < 0 || (uint64_t)val > SIZE_MAX) {
+        return -EBADMSG;
+    }
+
+    *len = (size_t)val;
+    return 0;
+}
+
+/**
+ * Read the optional type and count of a container, cf. _ubjson_read_struct()
+ */
+static int _read_container(ubjson_cookie_t *cookie, char *type, int64_t *count)
+{
+    char marker;
+    size_t len;
+
+    *type = 0;
+    *count = -1;
+
+    if (_read_marker(cookie, &marker) < 0) {
+        return -EBADMSG;
+    }
+
+    if (marker == UBJSON_MARKER_TYPE) {
+        if (_read(cookie, type, 1) < 0 || _read_marker(cookie, &marker) < 0) {
+            return -EBADMSG;
+        }
+    }
+
+    if (marker == UBJSON_MARKER_COUNT) {
+        if (_read_length(cookie, &len) < 0) {
+            return -EBADMSG;
+        }
+        *count = len;
+    }
+    else if (*type) {
+        /* a type requires a count */
+        return -EBADMSG;
+    }
+    else {
+        cookie->marker = marker;
+    }
+
+    return 0;
+}
+
+/**
+ * Check for the end of a container of @p count items at item @p i
+ *
+ * @return 1 at the end, 0 if there are more items, negative errno on error
+ */
+static int _at_end(ubjson_cookie_t *cookie, int64_t count, int64_t i, char end)
+{
+    char marker;
+
+    if (count >= 0) {
+        return i >= count;
+    }
+
+    if (_read_marker(cookie, &marker) < 0) {
+        return -EBADMSG;
+    }
+
+    if (marker == end) {
+        return 1;
+    }
+
+    cookie->marker = marker;
+    return 0;
+}
+
+static int _object(schema_t *schema, void *obj, ubjson_cookie_t *cookie,
+                   unsigned depth);
+
+static int _skip(ubjson_cookie_t *cookie, char marker, unsigned depth)
+{
+    int64_t val;
+    size_t len;
+
+    switch (marker) {
+        case UBJSON_MARKER_NULL:
+        case UBJSON_MARKER_TRUE:
+        case UBJSON_MARKER_FALSE:
+            return 0;
+        case UBJSON_MARKER_INT8:
+        case UBJSON_MARKER_UINT8:
+        case UBJSON_MARKER_INT16:
+        case UBJSON_MARKER_INT32:
+        case UBJSON_MARKER_INT64:
+            return _read_int(cookie, marker, &val);
+        case UBJSON_MARKER_CHAR:
+            return _discard(cookie, 1);
+        case UBJSON_MARKER_FLOAT32:
+            return _discard(cookie, 4);
+        case UBJSON_MARKER_FLOAT64:
+            return _discard(cookie, 8);
+        case UBJSON_MARKER_STRING:
+        case UBJSON_MARKER_HP_NUMBER:
+            if (_read_length(cookie, &len) < 0) {
+                return -EBADMSG;
+            }
+            return _discard(cookie, len);
+        case UBJSON_MARKER_OBJECT_START:
+            if (!depth) {
+                return -EBADMSG;
+            }
+            val = _object(NULL, NULL, cookie, depth - 1);
+            return (val < 0) ? (int)val : 0;
+        case UBJSON_MARKER_ARRAY_START: {
+            char type;
+            int64_t count;
+            int res;
+
+            if (!depth || _read_container(cookie, &type, &count) < 0) {
+                return -EBADMSG;
+            }
+
+            for (int64_t i = 0; (res = _at_end(cookie, count, i,
+                                               UBJSON_MARKER_ARRAY_END)) == 0; i++) {
+                if ((!type && _read_marker(cookie, &marker) < 0)
+                    || _skip(cookie, type ? type : marker, depth - 1) < 0) {
+                    return -EBADMSG;
+                }
+            }
+
+            return (res < 0) ? res : 0;
+        }
+        default:
+            return -EBADMSG;
+    }
+}
+
+static int _value(const schema_field_t *field, void *obj, ubjson_cookie_t *cookie,
+                  char marker, unsigned depth)
+{
+    uint8_t *dst = (uint8_t *)obj + field->offset;
+    int64_t val;
+    size_t len;
+    int res;
+
+    switch (marker) {
+        case UBJSON_MARKER_NULL:
+            /* leave the field as it is */
+            return 0;
+
+        case UBJSON_MARKER_TRUE:
+        case UBJSON_MARKER_FALSE:
+            if (field->type != SCHEMA_BOOL) {
+                return -EINVAL;
+            }
+            *(bool *)dst = (marker == UBJSON_MARKER_TRUE);
+            return 0;
+
+        case UBJSON_MARKER_INT8:
+        case UBJSON_MARKER_UINT8:
+        case UBJSON_MARKER_INT16:
+        case UBJSON_MARKER_INT32:
+        case UBJSON_MARKER_INT64:
+            if ((res = _read_int(cookie, marker, &val)) < 0) {
+                return res;
+            }
+            return schema_store_int(field, obj, val);
+
+        case UBJSON_MARKER_FLOAT32: {
+            union {
+                float f;
+                int32_t i;
+            } u;
+            if ((res = _read_int(cookie, UBJSON_MARKER_INT32, &val)) < 0) {
+                return res;
+            }
+            u.i = (int32_t)val;
+            return schema_store_double(field, obj, u.f);
+        }
+
+        case UBJSON_MARKER_FLOAT64: {
+            union {
+                double d;
+                int64_t i;
+            } u;
+            if ((res = _read_int(cookie, UBJSON_MARKER_INT64, &val)) < 0) {
+                return res;
+            }
+            u.i = val;
+            return schema_store_double(field, obj, u.d);
+        }
+
+        case UBJSON_MARKER_CHAR: {
+            char c;
+            if (_read(cookie, &c, 1) < 0) {
+                return -EBADMSG;
+            }
+            return schema_store_string(field, obj, &c, 1);
+        }
+
+        case UBJSON_MARKER_STRING:
+            if (_read_length(cookie, &len) < 0) {
+                return -EBADMSG;
+            }
+            if (field->type != SCHEMA_STRING) {
+                return -EINVAL;
+            }
+            if (len >= field->size) {
+                return -EOVERFLOW;
+            }
+            /* read straight into the field */
+            if (_read(cookie, dst, len) < 0) {
+                return -EBADMSG;
+            }
+            dst[len] = '\0';
+            return 0;
+
+        case UBJSON_MARKER_OBJECT_START:
+            if (field->type != SCHEMA_STRUCT || !depth) {
+                return -EINVAL;
+            }
+            res = _object(field->sub, dst, cookie, depth - 1);
+            return (res < 0) ? res : 0;
+
+        default:
+            return -EINVAL;
+    }
+}
+
+/**
+ * Decode an object whose start marker was consumed already
+ *
+ * With @p schema == NULL all values are skipped.
+ */
+static int _object(schema_t *schema, void *obj, ubjson_cookie_t *cookie,
+                   unsigned depth)
+{
+    char type, marker;
+    int64_t count;
+    int res, decoded = 0;
+
+    if (_read_container(cookie, &type, &count) < 0) {
+        return -EBADMSG;
+    }
+
+    for (int64_t i = 0; (res = _at_end(cookie, count, i,
+                                       UBJSON_MARKER_OBJECT_END)) == 0; i++) {
+        const schema_field_t *field = NULL;
+        char key[SCHEMA_UBJSON_KEY_MAX];
+        size_t len;
+
+        if (_read_length(cookie, &len) < 0) {
+            return -EBADMSG;
+        }
+
+        if (len > sizeof(key) || !schema) {
+            res = _discard(cookie, len);
+        }
+        else if ((res = _read(cookie, key, len)) == 0) {
+            field = schema_find(schema, key, len);
+        }
+
+        if (res < 0) {
+            return res;
+        }
+
+        if (type) {
+            marker = type;
+        }
+        else if (_read_marker(cookie, &marker) < 0) {
+            return -EBADMSG;
+        }
+
+        if (field) {
+            if ((res = _value(field, obj, cookie, marker, depth)) < 0) {
+                return res;
+            }
+            decoded++;
+        }
+        else if ((res = _skip(cookie, marker, depth)) < 0) {
+            return res;
+        }
+    }
+
+    return (res < 0) ? res : decoded;
+}
+
+int schema_ubjson_decode(schema_t *schema, void *obj, ubjson_cookie_t *cookie,
+                         ubjson_read_t read)
+{
+    char marker;
+
+    cookie->rw.read = read;
+    cookie->marker = 0;
+
+    if (_read_marker(cookie, &marker) < 0) {
+        return -EBADMSG;
+    }
+
+    if (marker != UBJSON_MARKER_OBJECT_START) {
+        return -EINVAL;
+    }
+
+    schema_init(schema);
+    return _object(schema, obj, cookie, SCHEMA_MAX_NESTING);
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_UBJSON */
@@ -20,6 +20,7 @@
 #include <errno.h>
 #include <limits.h>
 
+#include "atomic.h"
 #include "irq.h"
 #include "msg.h"
 #include "xtimer.h"
@@ -73,6 +74,16 @@ int sema_wait_timed_msg(sema_t *sema, uint64_t timeout, msg_t *msg)
     if (sema == NULL) {
         return -EINVAL;
     }
+#if ATOMIC_LOCK_FREE
+    /* fast path: take an available semaphore without disabling interrupts */
+    unsigned avail = sema->value;
+    while (avail != 0) {
+        if (__atomic_compare_exchange_n(&sema->value, &avail, avail - 1, 0,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            return 0;
+        }
+    }
+#endif
     if (timeout != 0) {
         old_state = irq_disable();
         timeout_timer.target = 0, timeout_timer.long_target = 0;
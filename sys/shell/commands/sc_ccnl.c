@@ -219,8 +219,8 @@ int _ccnl_interest(int argc, char **argv)
     for (int cnt = 0; cnt < CCNL_INTEREST_RETRIES; cnt++) {
         gnrc_netreg_entry_t _ne;
         /* register for content chunks */
-        _ne.demux_ctx =  GNRC_NETREG_DEMUX_CTX_ALL;
-        _ne.pid = sched_active_pid;
+        gnrc_netreg_entry_init_pid(&_ne, GNRC_NETREG_DEMUX_CTX_ALL,
+                                   sched_active_pid);
         gnrc_netreg_register(GNRC_NETTYPE_CCN_CHUNK, &_ne);
 
         ccnl_send_interest(CCNL_SUITE_NDNTLV, argv[1], NULL, _int_buf, BUF_SIZE);
@@ -18,14 +18,30 @@
  * @}
  */
 
+#ifdef MODULE_LPC_COMMON
 extern void heap_stats(void);
+#endif
+#ifdef MODULE_CPP11_COMPAT
+extern void cpp_alloc_print_stats(void);
+#endif
+#ifdef MODULE_TLSF_HEAP
+#include "tlsf_heap.h"
+#endif
 
 int _heap_handler(int argc, char **argv)
 {
     (void) argc;
     (void) argv;
 
+#ifdef MODULE_LPC_COMMON
     heap_stats();
+#endif
+#ifdef MODULE_CPP11_COMPAT
+    cpp_alloc_print_stats();
+#endif
+#ifdef MODULE_TLSF_HEAP
+    tlsf_heap_print_stats();
+#endif
 
     return 0;
 }
@@ -29,7 +29,8 @@ extern int _reboot_handler(int argc, char **argv);
 extern int _id_handler(int argc, char **argv);
 #endif
 
-#ifdef MODULE_LPC_COMMON
+#if defined(MODULE_LPC_COMMON) || defined(MODULE_CPP11_COMPAT) || \
+    defined(MODULE_TLSF_HEAP)
 extern int _heap_handler(int argc, char **argv);
 #endif
 
@@ -138,8 +139,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_CONFIG
     {"id", "Gets or sets the node's id.", _id_handler},
 #endif
-#ifdef MODULE_LPC_COMMON
-    {"heap", "Shows the heap state for the LPC2387 on the command shell.", _heap_handler},
+#if defined(MODULE_LPC_COMMON) || defined(MODULE_CPP11_COMPAT) || \
+    defined(MODULE_TLSF_HEAP)
+    {"heap", "Shows the heap state.", _heap_handler},
 #endif
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
@@ -0,0 +1,457 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_tlsf_heap
+ * @{
+ *
+ * @file
+ * @brief       Two-level segregated fit allocator
+ *
+ * Every block starts with a header holding the address of the physically
+ * previous block and the payload size, whose lowest bit marks free blocks.
+ * Free blocks additionally link into the free list of their size class in
+ * the first bytes of their payload. Each pool ends with a zero sized, used
+ * sentinel block, so walking and merging never leave the pool.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "irq.h"
+#include "tlsf_heap.h"
+
+typedef struct block {
+    struct block *prev_phys;    /**< physically previous block, NULL if first */
+    size_t size;                /**< payload size | BLOCK_FREE */
+    struct block *next_free;    /**< next block in the free list, if free */
+    struct block *prev_free;    /**< previous block in the free list, if free */
+} block_t;
+
+typedef struct pool {
+    struct pool *next;
+} pool_t;
+
+#define ALIGN           (TLSF_HEAP_ALIGN)
+#define HDR             (offsetof(block_t, next_free))
+#define BLOCK_FREE      (1u)
+#define SIZE_MIN        (ALIGN)
+#define SMALL_SIZE      (1u << TLSF_HEAP_FL_SHIFT)
+#define POOL_SIZE_MAX   ((size_t)1 << TLSF_HEAP_FL_MAX)
+
+static tlsf_heap_t *heaps;
+
+static inline size_t align_up(size_t x, size_t align)
+{
+    return (x + align - 1) & ~(align - 1);
+}
+
+static inline size_t block_size(const block_t *b)
+{
+    return b->size & ~(size_t)BLOCK_FREE;
+}
+
+static inline bool block_is_free(const block_t *b)
+{
+    return b->size & BLOCK_FREE;
+}
+
+static inline block_t *block_next(const block_t *b)
+{
+    return (block_t *)((char *)b + HDR + block_size(b));
+}
+
+static inline void *block_to_ptr(block_t *b)
+{
+    return (char *)b + HDR;
+}
+
+static inline block_t *ptr_to_block(void *ptr)
+{
+    return (block_t *)((char *)ptr - HDR);
+}
+
+static inline void mapping_insert(size_t size, unsigned *fl, unsigned *sl)
+{
+    if (size < SMALL_SIZE) {
+        *fl = 0;
+        *sl = size / ALIGN;
+    }
+    else {
+        unsigned f = bitarithm_msb(size);
+        *sl = (size >> (f - TLSF_HEAP_SL_LOG2)) ^ TLSF_HEAP_SL_COUNT;
+        *fl = f - TLSF_HEAP_FL_SHIFT + 1;
+    }
+}
+
+/* rounds up, so that every block in the resulting list is large enough */
+static inline void mapping_search(size_t size, unsigned *fl, unsigned *sl)
+{
+    if (size >= SMALL_SIZE) {
+        size += ((size_t)1 << (bitarithm_msb(size) - TLSF_HEAP_SL_LOG2)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+static void remove_free(tlsf_heap_t *heap, block_t *b)
+{
+    unsigned fl, sl;
+    mapping_insert(block_size(b), &fl, &sl);
+
+    if (b->next_free) {
+        b->next_free->prev_free = b->prev_free;
+    }
+    if (b->prev_free) {
+        b->prev_free->next_free = b->next_free;
+    }
+    else {
+        heap->blocks[fl][sl] = b->next_free;
+        if (!b->next_free) {
+            heap->sl_bitmap[fl] &= ~(1u << sl);
+            if (!heap->sl_bitmap[fl]) {
+                heap->fl_bitmap &= ~(1u << fl);
+            }
+        }
+    }
+    b->size &= ~(size_t)BLOCK_FREE;
+}
+
+static void insert_free(tlsf_heap_t *heap, block_t *b)
+{
+    unsigned fl, sl;
+    mapping_insert(block_size(b), &fl, &sl);
+
+    b->size |= BLOCK_FREE;
+    b->prev_free = NULL;
+    b->next_free = heap->blocks[fl][sl];
+    if (b->next_free) {
+        b->next_free->prev_free = b;
+    }
+    heap->blocks[fl][sl] = b;
+    heap->fl_bitmap |= 1u << fl;
+    heap->sl_bitmap[fl] |= 1u << sl;
+}
+
+static block_t *find_free(tlsf_heap_t *heap, size_t size)
+{
+    unsigned fl, sl;
+    mapping_search(size, &fl, &sl);
+    if (fl >= TLSF_HEAP_FL_COUNT) {
+        return NULL;
+    }
+
+    unsigned sl_map = heap->sl_bitmap[fl] & (~0u << sl);
+    if (!sl_map) {
+        unsigned fl_map = (fl + 1 < 8 * sizeof(unsigned)) ?
+                          heap->fl_bitmap & (~0u << (fl + 1)) : 0;
+        if (!fl_map) {
+            return NULL;
+        }
+        fl = bitarithm_lsb(fl_map);
+        sl_map = heap->sl_bitmap[fl];
+    }
+    sl = bitarithm_lsb(sl_map);
+
+    block_t *b = heap->blocks[fl][sl];
+    remove_free(heap, b);
+    return b;
+}
+
+/* cuts the tail of used block b beyond size into a free block */
+static void trim(tlsf_heap_t *heap, block_t *b, size_t size)
+{
+    size_t total = block_size(b);
+    if (total < size + HDR + SIZE_MIN) {
+        return;
+    }
+
+    block_t *rest = (block_t *)((char *)b + HDR + size);
+    rest->prev_phys = b;
+    rest->size = total - size - HDR;
+    b->size = size;
+
+    block_t *next = block_next(rest);
+    if (block_is_free(next)) {
+        remove_free(heap, next);
+        rest->size += HDR + block_size(next);
+        next = block_next(rest);
+    }
+    next->prev_phys = rest;
+    insert_free(heap, rest);
+}
+
+static inline size_t adjust_size(size_t size)
+{
+    return size < SIZE_MIN ? SIZE_MIN : align_up(size, ALIGN);
+}
+
+static void account(tlsf_heap_t *heap, block_t *b)
+{
+    if (b) {
+        heap->used += block_size(b);
+        if (heap->used > heap->high_water) {
+            heap->high_water = heap->used;
+        }
+    }
+    else {
+        heap->failed++;
+    }
+}
+
+int tlsf_heap_add_pool(tlsf_heap_t *heap, void *mem, size_t size)
+{
+    uintptr_t start = align_up((uintptr_t)mem, ALIGN);
+    size_t skip = start - (uintptr_t)mem;
+    if (size < skip + align_up(sizeof(pool_t), ALIGN) + 2 * HDR + SIZE_MIN) {
+        return -1;
+    }
+    size -= skip;
+
+    /* a pool must not hold a block too large for the lists */
+    while (size > POOL_SIZE_MAX) {
+        size_t part = POOL_SIZE_MAX / 2;
+        tlsf_heap_add_pool(heap, (void *)start, part);
+        start += part;
+        size -= part;
+    }
+
+    pool_t *pool = (pool_t *)start;
+    block_t *b = (block_t *)(start + align_up(sizeof(pool_t), ALIGN));
+    size_t payload = (size - align_up(sizeof(pool_t), ALIGN) - 2 * HDR)
+                     & ~(ALIGN - 1);
+
+    b->prev_phys = NULL;
+    b->size = payload;
+    block_t *sentinel = block_next(b);
+    sentinel->prev_phys = b;
+    sentinel->size = 0;
+
+    unsigned state = irq_disable();
+    pool->next = heap->pools;
+    heap->pools = pool;
+    heap->size += payload;
+    insert_free(heap, b);
+    irq_restore(state);
+
+    return 0;
+}
+
+int tlsf_heap_init(tlsf_heap_t *heap, const char *name, void *mem, size_t size)
+{
+    unsigned state = irq_disable();
+    /* a heap may be initialized again, it must not be listed twice */
+    tlsf_heap_t *h = heaps;
+    while (h && h != heap) {
+        h = h->next;
+    }
+    tlsf_heap_t *next = h ? heap->next : heaps;
+
+    memset(heap, 0, sizeof(*heap));
+    heap->next = next;
+    heap->name = name;
+    if (!h) {
+        heaps = heap;
+    }
+    irq_restore(state);
+
+    return tlsf_heap_add_pool(heap, mem, size);
+}
+
+void *tlsf_heap_alloc(tlsf_heap_t *heap, size_t size)
+{
+    size = adjust_size(size);
+
+    unsigned state = irq_disable();
+    block_t *b = find_free(heap, size);
+    if (b) {
+        trim(heap, b, size);
+    }
+    account(heap, b);
+    irq_restore(state);
+
+    return b ? block_to_ptr(b) : NULL;
+}
+
+void *tlsf_heap_calloc(tlsf_heap_t *heap, size_t count, size_t size)
+{
+    size_t total = count * size;
+    if (size && total / size != count) {
+        return NULL;
+    }
+
+    void *ptr = tlsf_heap_alloc(heap, total);
+    if (ptr) {
+        memset(ptr, 0, total);
+    }
+    return ptr;
+}
+
+void *tlsf_heap_memalign(tlsf_heap_t *heap, size_t align, size_t size)
+{
+    if (align <= ALIGN) {
+        return tlsf_heap_alloc(heap, size);
+    }
+    size = adjust_size(size);
+
+    unsigned state = irq_disable();
+    /* leave room to cut off a free block in front of the aligned address */
+    block_t *b = find_free(heap, size + align + HDR + SIZE_MIN);
+    if (b) {
+        uintptr_t ptr = (uintptr_t)block_to_ptr(b);
+        uintptr_t aligned = align_up(ptr, align);
+        if (aligned != ptr) {
+            while (aligned - ptr < HDR + SIZE_MIN) {
+                aligned += align;
+            }
+
+            block_t *ab = ptr_to_block((void *)aligned);
+            ab->prev_phys = b;
+            ab->size = block_size(b) - (aligned - ptr);
+            block_next(ab)->prev_phys = ab;
+            b->size = aligned - ptr - HDR;
+            /* b was free before, so its physical neighbours are used */
+            insert_free(heap, b);
+            b = ab;
+        }
+        trim(heap, b, size);
+    }
+    account(heap, b);
+    irq_restore(state);
+
+    return b ? block_to_ptr(b) : NULL;
+}
+
+void tlsf_heap_free(tlsf_heap_t *heap, void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    block_t *b = ptr_to_block(ptr);
+
+    unsigned state = irq_disable();
+    heap->used -= block_size(b);
+
+    block_t *next = block_next(b);
+    if (block_is_free(next)) {
+        remove_free(heap, next);
+        b->size += HDR + block_size(next);
+        next = block_next(b);
+        next->prev_phys = b;
+    }
+
+    block_t *prev = b->prev_phys;
+    if (prev && block_is_free(prev)) {
+        remove_free(heap, prev);
+        prev->size += HDR + block_size(b);
+        next->prev_phys = prev;
+        b = prev;
+    }
+
+    insert_free(heap, b);
+    irq_restore(state);
+}
+
+void *tlsf_heap_realloc(tlsf_heap_t *heap, void *ptr, size_t size)
+{
+    if (!ptr) {
+        return tlsf_heap_alloc(heap, size);
+    }
+    if (!size) {
+        tlsf_heap_free(heap, ptr);
+        return NULL;
+    }
+
+    block_t *b = ptr_to_block(ptr);
+    size_t cur = block_size(b);
+    size_t want = adjust_size(size);
+
+    unsigned state = irq_disable();
+    block_t *next = block_next(b);
+    if (want > cur && block_is_free(next)
+        && cur + HDR + block_size(next) >= want) {
+        /* grow into the following free block */
+        remove_free(heap, next);
+        b->size += HDR + block_size(next);
+        block_next(b)->prev_phys = b;
+    }
+    if (block_size(b) >= want) {
+        trim(heap, b, want);
+        heap->used += block_size(b) - cur;
+        if (heap->used > heap->high_water) {
+            heap->high_water = heap->used;
+        }
+        irq_restore(state);
+        return ptr;
+    }
+    irq_restore(state);
+
+    void *moved = tlsf_heap_alloc(heap, size);
+    if (moved) {
+        memcpy(moved, ptr, cur);
+        tlsf_heap_free(heap, ptr);
+    }
+    return moved;
+}
+
+size_t tlsf_heap_usable_size(void *ptr)
+{
+    return ptr ? block_size(ptr_to_block(ptr)) : 0;
+}
+
+void tlsf_heap_get_stats(tlsf_heap_t *heap, tlsf_heap_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+
+    unsigned state = irq_disable();
+    stats->size = heap->size;
+    stats->used = heap->used;
+    stats->high_water = heap->high_water;
+    stats->failed = heap->failed;
+
+    for (pool_t *pool = heap->pools; pool; pool = pool->next) {
+        block_t *b = (block_t *)((char *)pool + align_up(sizeof(pool_t), ALIGN));
+        for (; b->size; b = block_next(b)) {
+            size_t size = block_size(b);
+            if (block_is_free(b)) {
+                stats->free += size;
+                stats->free_blocks++;
+                if (size > stats->largest_free) {
+                    stats->largest_free = size;
+                }
+            }
+            else {
+                stats->used_blocks++;
+            }
+        }
+    }
+    irq_restore(state);
+}
+
+void tlsf_heap_print_stats(void)
+{
+    for (tlsf_heap_t *heap = heaps; heap; heap = heap->next) {
+        tlsf_heap_stats_t s;
+        tlsf_heap_get_stats(heap, &s);
+
+        /* share of the free memory not in the largest free block */
+        unsigned frag = s.free ? 100 - (unsigned)((s.largest_free * 100) / s.free) : 0;
+
+        printf("heap %s: %u of %u bytes used (high water %u) in %u blocks, "
+               "%u bytes free in %u blocks, largest %u, fragmentation %u%%, "
+               "%u failed\n",
+               heap->name ? heap->name : "?", (unsigned)s.used,
+               (unsigned)s.size, (unsigned)s.high_water, s.used_blocks,
+               (unsigned)s.free, s.free_blocks, (unsigned)s.largest_free,
+               frag, s.failed);
+    }
+}
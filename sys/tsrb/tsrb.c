@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
 static void _push(tsrb_t *rb, char c)
@@ -41,12 +43,22 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, char *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    size_t avail = tsrb_avail(rb);
+    if (n > avail) {
+        n = avail;
+    }
+
+    /* copy at most two chunks, publish the space only afterwards */
+    unsigned pos = rb->reads & (rb->size - 1);
+    size_t first = rb->size - pos;
+    if (first > n) {
+        first = n;
     }
-    return (n - tmp);
+    memcpy(dst, &rb->buf[pos], first);
+    memcpy(dst + first, rb->buf, n - first);
+    rb->reads += n;
+
+    return n;
 }
 
 int tsrb_add_one(tsrb_t *rb, char c)
@@ -62,10 +74,20 @@ int tsrb_add_one(tsrb_t *rb, char c)
 
 int tsrb_add(tsrb_t *rb, const char *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    size_t free = tsrb_free(rb);
+    if (n > free) {
+        n = free;
     }
-    return (n - tmp);
+
+    /* copy at most two chunks, publish the bytes only afterwards */
+    unsigned pos = rb->writes & (rb->size - 1);
+    size_t first = rb->size - pos;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(&rb->buf[pos], src, first);
+    memcpy(rb->buf, src + first, n - first);
+    rb->writes += n;
+
+    return n;
 }
@@ -39,7 +39,8 @@
 #define UDP_TERMINATE       (0x8328)
 
 static const uint16_t port = 6666;
-static gnrc_netreg_entry_t server = {NULL, GNRC_NETREG_DEMUX_CTX_ALL, KERNEL_PID_UNDEF};
+static gnrc_netreg_entry_t server = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                               KERNEL_PID_UNDEF);
 static char t_stack[THREAD_STACKSIZE_MAIN];
 
 typedef struct {
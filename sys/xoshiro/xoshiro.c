@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_xoshiro
+ * @{
+ *
+ * @file
+ * @brief       xoshiro128** implementation
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "xoshiro.h"
+
+static uint64_t _splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+void xoshiro_init(xoshiro_t *x, uint32_t seed)
+{
+    uint64_t sm = seed;
+
+    for (unsigned i = 0; i < 4; i += 2) {
+        uint64_t z = _splitmix64(&sm);
+        x->s[i] = (uint32_t)z;
+        x->s[i + 1] = (uint32_t)(z >> 32);
+    }
+
+    /* an all zero state would only ever yield zeros */
+    if (!(x->s[0] | x->s[1] | x->s[2] | x->s[3])) {
+        x->s[0] = 1;
+    }
+}
+
+void xoshiro_bytes(xoshiro_t *x, uint8_t *buf, size_t size)
+{
+    /* work on a copy, so the state can stay in registers */
+    xoshiro_t tmp = *x;
+
+    for (; size >= 4 * sizeof(uint32_t); size -= 4 * sizeof(uint32_t)) {
+        uint32_t r[4];
+        r[0] = xoshiro_next(&tmp);
+        r[1] = xoshiro_next(&tmp);
+        r[2] = xoshiro_next(&tmp);
+        r[3] = xoshiro_next(&tmp);
+        memcpy(buf, r, sizeof(r));
+        buf += sizeof(r);
+    }
+    for (; size >= sizeof(uint32_t); size -= sizeof(uint32_t)) {
+        uint32_t r = xoshiro_next(&tmp);
+        memcpy(buf, &r, sizeof(r));
+        buf += sizeof(r);
+    }
+    if (size) {
+        uint32_t r = xoshiro_next(&tmp);
+        memcpy(buf, &r, size);
+    }
+
+    *x = tmp;
+}
+
+void xoshiro_jump(xoshiro_t *x)
+{
+    /* x^(2^64) mod the characteristic polynomial of the generator */
+    static const uint32_t jump[] = {
+        0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b
+    };
+    uint32_t s[4] = { 0, 0, 0, 0 };
+
+    for (unsigned i = 0; i < 4; i++) {
+        for (unsigned b = 0; b < 32; b++) {
+            if (jump[i] & (1UL << b)) {
+                s[0] ^= x->s[0];
+                s[1] ^= x->s[1];
+                s[2] ^= x->s[2];
+                s[3] ^= x->s[3];
+            }
+            xoshiro_next(x);
+        }
+    }
+
+    memcpy(x->s, s, sizeof(s));
+}
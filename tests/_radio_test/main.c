@@ -316,15 +316,15 @@ int main(void)
     /* Creating reading thread */
     DEBUG("Creating reading thread %d\n", channel);
     gnrc_netreg_entry_t dump;
-    dump.pid = thread_create(rawdmp_stack, sizeof(rawdmp_stack), 1, THREAD_CREATE_STACKTEST, rawdump, NULL, "rawdump");
-    dump.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
+    gnrc_netreg_entry_init_pid(&dump, GNRC_NETREG_DEMUX_CTX_ALL,
+                               thread_create(rawdmp_stack, sizeof(rawdmp_stack), 1, THREAD_CREATE_STACKTEST, rawdump, NULL, "rawdump"));
     gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &dump);
 
     /* Creating reading thread */
     DEBUG("Creating shell thread\n");
     gnrc_netreg_entry_t shell;
-    shell.pid = thread_create(shell_stack, sizeof(shell_stack), THREAD_PRIORITY_MIN - 2, THREAD_CREATE_STACKTEST, shell_thread, NULL, "shell");
-    shell.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
+    gnrc_netreg_entry_init_pid(&shell, GNRC_NETREG_DEMUX_CTX_ALL,
+                               thread_create(shell_stack, sizeof(shell_stack), THREAD_PRIORITY_MIN - 2, THREAD_CREATE_STACKTEST, shell_thread, NULL, "shell"));
     gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &shell);
 
     xtimer_sleep(1);
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the speed of atomic increments
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "atomic.h"
+#include "irq.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define PER_ITERATION (16)
+
+static atomic_int_t atomic_counter = ATOMIC_INIT(0);
+static volatile int plain_counter;
+
+static void inc_atomic(void)
+{
+    atomic_inc(&atomic_counter);
+}
+
+static void inc_cas(void)
+{
+    int old;
+
+    do {
+        old = ATOMIC_VALUE(atomic_counter);
+    } while (!atomic_cas(&atomic_counter, old, old + 1));
+}
+
+static void inc_irq_lock(void)
+{
+    unsigned state = irq_disable();
+    plain_counter++;
+    irq_restore(state);
+}
+
+static void inc_plain(void)
+{
+    plain_counter++;
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, void (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        for (unsigned j = 0; j < PER_ITERATION; ++j) {
+            test();
+        }
+        ++count;
+    } while (done == 0);
+
+    printf("+ %s: %lu increments per second\n", name,
+           PER_ITERATION * count / TIMEOUT_S);
+}
+
+#define run_test(test) run_test(#test, test)
+
+int main(void)
+{
+    printf("Start (atomics are %s).\n",
+           ATOMIC_LOCK_FREE ? "lock-free" : "interrupt based");
+
+    run_test(inc_atomic);
+    run_test(inc_cas);
+    run_test(inc_irq_lock);
+    run_test(inc_plain);
+
+    printf("Done.\n");
+    return 0;
+}
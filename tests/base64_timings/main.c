@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the throughput of base64 encoding and decoding
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "base64.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define DATA_LEN (1026U)
+#define LINE_LEN (64U)
+
+static unsigned char data[DATA_LEN];
+static unsigned char encoded[BASE64_ENCODE_SIZE(DATA_LEN)];
+static size_t encoded_len;
+/* encoded with a line break every LINE_LEN characters, as in PEM files */
+static unsigned char wrapped[BASE64_ENCODE_SIZE(DATA_LEN) * 65 / 64 + 1];
+static size_t wrapped_len;
+static unsigned char decoded[DATA_LEN + 4];
+
+static size_t encode(void)
+{
+    size_t len = sizeof(encoded);
+    base64_encode(data, DATA_LEN, encoded, &len);
+    return len;
+}
+
+static size_t decode(void)
+{
+    size_t len = sizeof(decoded);
+    base64_decode(encoded, encoded_len, decoded, &len);
+    return len;
+}
+
+static size_t decode_wrapped(void)
+{
+    size_t len = sizeof(decoded);
+    base64_decode(wrapped, wrapped_len, decoded, &len);
+    return len;
+}
+
+static size_t decode_chunks(void)
+{
+    base64_decode_ctx_t ctx;
+    size_t len = 0;
+
+    base64_decode_init(&ctx);
+    for (size_t pos = 0; pos < encoded_len; pos += 100) {
+        size_t chunk = (encoded_len - pos < 100) ? encoded_len - pos : 100;
+        len += base64_decode_update(&ctx, encoded + pos, chunk, decoded + len);
+    }
+    return len + base64_decode_finish(&ctx, decoded + len);
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, size_t (*test)(void), size_t expect)
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        if (test() != expect) {
+            puts("error");
+        }
+        ++count;
+    } while (done == 0);
+
+    /* binary data per second, in units of 10 kB */
+    unsigned long rate = count * (DATA_LEN / 2) / (TIMEOUT_S * 5000);
+    printf("+ %s: %lu.%02lu MB/s\n", name, rate / 100, rate % 100);
+}
+
+#define run_test(test, expect) run_test(#test, test, expect)
+
+int main(void)
+{
+    uint32_t x = 1;
+
+    for (unsigned i = 0; i < DATA_LEN; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        data[i] = x;
+    }
+
+    encoded_len = encode();
+    for (size_t i = 0; i < encoded_len; i++) {
+        wrapped[wrapped_len++] = encoded[i];
+        if ((i % LINE_LEN) == LINE_LEN - 1) {
+            wrapped[wrapped_len++] = '\n';
+        }
+    }
+
+    puts("Start.");
+
+    run_test(encode, encoded_len);
+    run_test(decode, DATA_LEN);
+    run_test(decode_wrapped, DATA_LEN);
+    run_test(decode_chunks, DATA_LEN);
+
+    puts("Done.");
+    return 0;
+}
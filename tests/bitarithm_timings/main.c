@@ -22,7 +22,11 @@
  * @{
  *
  * @file
- * @brief     Measure the speed of the function in bitarithm.c
+ * @brief     Measure the speed of the functions in bitarithm.h and of
+ *            bf_get_unset()
+ *
+ * The *_soft variants are the portable implementations used on CPUs without
+ * the respective instructions, for comparison.
  *
  * @author    René Kijewski <rene.kijewski@fu-berlin.de>
  *
@@ -30,13 +34,18 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "bitarithm.h"
+#include "bitfield.h"
 #include "xtimer.h"
 
 #define TIMEOUT_S (5ul)
 #define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
 #define PER_ITERATION (4)
+#define FIELD_SIZE (256)
+
+static BITFIELD(field, FIELD_SIZE);
 
 static void callback(void *done_)
 {
@@ -81,13 +90,49 @@ static void run_test(const char *name, unsigned (*test)(unsigned))
 
 #define run_test(test) run_test(#test, test)
 
+/* keeps FIELD_SIZE / 2 slots taken, freeing and taking one per call */
+static void run_bitfield_test(void)
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    unsigned free_slot = 0;
+
+    memset(field, 0, sizeof(field));
+    for (unsigned i = 0; i < FIELD_SIZE / 2; i++) {
+        bf_set(field, i);
+    }
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        bf_unset(field, free_slot);
+        int slot = bf_get_unset(field, FIELD_SIZE);
+        if (slot != (int)free_slot) {
+            printf("error: bf_get_unset() returned %d\r\n", slot);
+            return;
+        }
+        free_slot = (free_slot + 37) % (FIELD_SIZE / 2);
+        ++count;
+    } while (done == 0);
+
+    printf("+ bf_get_unset: %lu iterations per second\r\n", count / TIMEOUT_S);
+}
+
 int main(void)
 {
     printf("Start.\r\n");
 
     run_test(bitarithm_msb);
+    run_test(bitarithm_msb_soft);
     run_test(bitarithm_lsb);
+    run_test(bitarithm_lsb_soft);
     run_test(bitarithm_bits_set);
+    run_test(bitarithm_bits_set_soft);
+    run_bitfield_test();
 
     printf("Done.\r\n");
     return 0;
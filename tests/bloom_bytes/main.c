@@ -26,6 +26,7 @@
 
 #include "hashes.h"
 #include "bloom.h"
+#include "bloom_blocked.h"
 #include "random.h"
 #include "bitfield.h"
 
@@ -43,6 +44,10 @@
 static uint32_t buf[BUF_SIZE];
 static bloom_t bloom;
 BITFIELD(bf, BLOOM_BITS);
+static bloom_blocked_t blocked;
+static bloom_counting_t counting;
+static uint8_t blocked_buf[BLOOM_BITS / 8]
+    __attribute__((aligned(BLOOM_BLOCKED_BLOCK_SIZE)));
 hashfp_t hashes[BLOOM_HASHF] = {
     (hashfp_t) fnv_hash, (hashfp_t) sax_hash, (hashfp_t) sdbm_hash,
     (hashfp_t) djb2_hash, (hashfp_t) kr_hash, (hashfp_t) dek_hash,
@@ -56,15 +61,41 @@ static void buf_fill(uint32_t *buf, int len)
     }
 }
 
-int main(void)
+static void classic_add(const uint8_t *key, size_t len)
 {
-    xtimer_init();
+    bloom_add(&bloom, key, len);
+}
 
-    bloom_init(&bloom, BLOOM_BITS, bf, hashes, BLOOM_HASHF);
+static bool classic_check(const uint8_t *key, size_t len)
+{
+    return bloom_check(&bloom, key, len);
+}
 
-    printf("Testing Bloom filter.\n\n");
-    printf("m: %" PRIu32 " k: %" PRIu32 "\n\n", (uint32_t) bloom.m,
-           (uint32_t) bloom.k);
+static void blocked_add(const uint8_t *key, size_t len)
+{
+    bloom_blocked_add(&blocked, key, len);
+}
+
+static bool blocked_check(const uint8_t *key, size_t len)
+{
+    return bloom_blocked_check(&blocked, key, len);
+}
+
+static void counting_add(const uint8_t *key, size_t len)
+{
+    bloom_counting_add(&counting, key, len);
+}
+
+static bool counting_check(const uint8_t *key, size_t len)
+{
+    return bloom_counting_check(&counting, key, len);
+}
+
+static void run_test(const char *name,
+                     void (*add)(const uint8_t *key, size_t len),
+                     bool (*check)(const uint8_t *key, size_t len))
+{
+    printf("Testing %s.\n\n", name);
 
     random_init(myseed);
 
@@ -73,9 +104,7 @@ int main(void)
     for (int i = 0; i < lenB; i++) {
         buf_fill(buf, BUF_SIZE);
         buf[0] = MAGIC_B;
-        bloom_add(&bloom,
-                  (uint8_t *) buf,
-                  BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t));
+        add((uint8_t *) buf, BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t));
     }
 
     unsigned long t2 = xtimer_now();
@@ -91,9 +120,8 @@ int main(void)
         buf_fill(buf, BUF_SIZE);
         buf[0] = MAGIC_A;
 
-        if (bloom_check(&bloom,
-                        (uint8_t *) buf,
-                        BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t))) {
+        if (check((uint8_t *) buf,
+                  BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t))) {
             in++;
         }
         else {
@@ -109,9 +137,40 @@ int main(void)
     printf("%d elements probably in the filter.\n", in);
     printf("%d elements not in the filter.\n", not_in);
     double false_positive_rate = (double) in / (double) lenA;
-    printf("%f false positive rate.\n", false_positive_rate);
+    printf("%f false positive rate.\n\n", false_positive_rate);
+
+    /* hashing and filter access only, on short keys */
+    unsigned long t5 = xtimer_now();
+    for (uint32_t i = 0; i < lenA; i++) {
+        check((uint8_t *) &i, sizeof(i));
+    }
+    unsigned long t6 = xtimer_now();
+    printf("+ %s: %" PRIu32 " checks of 4 byte keys per second\n\n", name,
+           (uint32_t)((uint64_t)lenA * 1000000 / (t6 - t5 + 1)));
+}
+
+int main(void)
+{
+    xtimer_init();
+
+    bloom_init(&bloom, BLOOM_BITS, bf, hashes, BLOOM_HASHF);
+    bloom_blocked_init(&blocked, blocked_buf, sizeof(blocked_buf), BLOOM_HASHF);
+    bloom_counting_init(&counting, blocked_buf, sizeof(blocked_buf),
+                        BLOOM_HASHF);
 
+    printf("m: %" PRIu32 " k: %" PRIu32 "\n\n", (uint32_t) bloom.m,
+           (uint32_t) bloom.k);
+
+    run_test("Bloom filter", classic_add, classic_check);
     bloom_del(&bloom);
+
+    bloom_blocked_clear(&blocked);
+    run_test("blocked Bloom filter", blocked_add, blocked_check);
+
+    /* same memory, but 4 bits per position */
+    bloom_counting_clear(&counting);
+    run_test("counting blocked Bloom filter", counting_add, counting_check);
+
     printf("\nAll done!\n");
     return 0;
 }
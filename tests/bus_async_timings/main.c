@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Compare blocking and chained asynchronous bus transactions
+ *
+ * Polls a number of simulated sensors on a 400 kHz I2C bus, once with
+ * bus_async_transfer() per sensor and once with all reads chained into one
+ * asynchronous transaction list that resubmits itself from its completion
+ * callback. A thread of lower priority counts loop iterations meanwhile to
+ * show how much CPU time is left to the rest of the application.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "bus_async/sim.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define CLOCK (400000UL)
+#define SENSOR_NUMOF (4U)
+#define SENSOR_ADDR (0x18)
+#define SENSOR_REG (0x28)
+#define SAMPLE_LEN (6U)
+#define FLAG_DONE (0x1)
+
+typedef struct {
+    bus_async_sim_dev_t dev;
+    uint8_t regs[0x40];
+    uint8_t sample[SAMPLE_LEN];
+    bus_async_op_t ops[2];
+} sensor_t;
+
+static const uint8_t reg = SENSOR_REG;
+static sensor_t sensors[SENSOR_NUMOF];
+static bus_async_xfer_t xfers[SENSOR_NUMOF];
+static bus_async_sim_t sim;
+static thread_t *main_thread;
+static volatile int done;
+static volatile uint32_t idle_count;
+static char idle_stack[THREAD_STACKSIZE_DEFAULT];
+
+static void *idle_thread(void *arg)
+{
+    (void)arg;
+    while (1) {
+        idle_count++;
+    }
+    return NULL;
+}
+
+static void setup(void)
+{
+    bus_async_sim_init_i2c(&sim, CLOCK);
+    for (unsigned i = 0; i < SENSOR_NUMOF; i++) {
+        sensor_t *s = &sensors[i];
+
+        for (unsigned r = 0; r < sizeof(s->regs); r++) {
+            s->regs[r] = i + r;
+        }
+        bus_async_sim_add_dev(&sim, &s->dev, SENSOR_ADDR + i, s->regs,
+                              sizeof(s->regs));
+        s->ops[0].out = &reg;
+        s->ops[0].len = 1;
+        s->ops[1].in = s->sample;
+        s->ops[1].len = SAMPLE_LEN;
+        xfers[i].addr = SENSOR_ADDR + i;
+        xfers[i].cs = GPIO_UNDEF;
+        xfers[i].ops = s->ops;
+        xfers[i].ops_numof = 2;
+    }
+}
+
+static void timeout_cb(void *arg)
+{
+    (void)arg;
+    done = 1;
+}
+
+static void run_blocking(void)
+{
+    while (!done) {
+        for (unsigned i = 0; i < SENSOR_NUMOF; i++) {
+            xfers[i].chain = NULL;
+            if (bus_async_transfer(&sim.bus, &xfers[i]) != 0) {
+                puts("error: transfer failed");
+                return;
+            }
+        }
+    }
+}
+
+static void round_done(bus_async_xfer_t *xfer, void *arg)
+{
+    (void)xfer;
+    (void)arg;
+    if (done) {
+        thread_flags_set(main_thread, FLAG_DONE);
+    }
+    else {
+        bus_async_submit(&sim.bus, &xfers[0]);
+    }
+}
+
+static void run_chained(void)
+{
+    for (unsigned i = 0; i < SENSOR_NUMOF; i++) {
+        xfers[i].chain = (i + 1 < SENSOR_NUMOF) ? &xfers[i + 1] : NULL;
+        xfers[i].cb = NULL;
+        xfers[i].thread = NULL;
+    }
+    xfers[SENSOR_NUMOF - 1].cb = round_done;
+
+    bus_async_submit(&sim.bus, &xfers[0]);
+    thread_flags_wait_any(FLAG_DONE);
+}
+
+static void run_idle(void)
+{
+    thread_flags_wait_any(FLAG_DONE);
+}
+
+static void idle_done(void *arg)
+{
+    (void)arg;
+    done = 1;
+    thread_flags_set(main_thread, FLAG_DONE);
+}
+
+static uint32_t baseline;
+
+static void run_test(char *name, void (*func)(void))
+{
+    xtimer_t xt = { .callback = timeout_cb };
+    uint32_t xfers_before = sim.xfers;
+    uint32_t busy_before = sim.busy_us;
+
+    if (func == run_idle) {
+        xt.callback = idle_done;
+    }
+    done = 0;
+    thread_flags_clear(FLAG_DONE);
+
+    uint32_t idle_before = idle_count;
+    xtimer_set(&xt, TIMEOUT);
+    func();
+    uint32_t idle = idle_count - idle_before;
+
+    if (func == run_idle) {
+        baseline = idle;
+        printf("+ %s: %" PRIu32 " idle loops per second\n", name,
+               idle / (uint32_t)TIMEOUT_S);
+        return;
+    }
+
+    uint32_t n = sim.xfers - xfers_before;
+    printf("+ %s: %" PRIu32 " transactions per second, bus busy %" PRIu32
+           "%%, CPU idle %" PRIu32 "%%\n", name, n / (uint32_t)TIMEOUT_S,
+           (sim.busy_us - busy_before) / (uint32_t)(TIMEOUT / 100),
+           baseline ? (uint32_t)((uint64_t)idle * 100 / baseline) : 0);
+}
+
+#define run_test(test) run_test(#test, test)
+
+int main(void)
+{
+    printf("\nStart.\n");
+    printf("%u sensors on a simulated %lu kHz I2C bus, %u bytes per read\n",
+           SENSOR_NUMOF, CLOCK / 1000, SAMPLE_LEN);
+
+    main_thread = (thread_t *)sched_active_thread;
+    setup();
+    thread_create(idle_stack, sizeof(idle_stack), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_STACKTEST, idle_thread, NULL, "idle count");
+
+    run_test(run_idle);
+    run_test(run_blocking);
+    run_test(run_chained);
+
+    printf("\nDone.\n");
+    return 0;
+}
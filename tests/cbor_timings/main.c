@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Compare the offset based CBOR API with the cursor and writer API
+ *            on a SenML pack
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cbor.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+
+#define RECORDS         (8)
+
+/* SenML labels (cf. draft-ietf-core-senml) */
+#define SENML_BN        (-2)
+#define SENML_BT        (-3)
+#define SENML_N         (0)
+#define SENML_U         (1)
+#define SENML_V         (2)
+#define SENML_T         (6)
+
+static const char *names[RECORDS] = {
+    "voltage", "current", "power", "energy",
+    "temperature", "humidity", "pressure", "battery"
+};
+
+static unsigned char buf[512];
+static cbor_stream_t stream;
+static volatile int sink;
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void encode_offset(void)
+{
+    cbor_clear(&stream);
+    cbor_serialize_array(&stream, RECORDS);
+
+    for (int i = 0; i < RECORDS; i++) {
+        cbor_serialize_map(&stream, i ? 4 : 6);
+        if (!i) {
+            cbor_serialize_int(&stream, SENML_BN);
+            cbor_serialize_unicode_string(&stream, "urn:dev:ow:10e2073a01080063;");
+            cbor_serialize_int(&stream, SENML_BT);
+            cbor_serialize_int(&stream, 1276020076);
+        }
+        cbor_serialize_int(&stream, SENML_N);
+        cbor_serialize_unicode_string(&stream, names[i]);
+        cbor_serialize_int(&stream, SENML_U);
+        cbor_serialize_unicode_string(&stream, "V");
+        cbor_serialize_int(&stream, SENML_V);
+        cbor_serialize_int(&stream, 1200 + i);
+        cbor_serialize_int(&stream, SENML_T);
+        cbor_serialize_int(&stream, -i);
+    }
+}
+
+static void encode_writer(void)
+{
+    cbor_writer_t writer;
+
+    cbor_clear(&stream);
+    cbor_writer_init_stream(&writer, &stream);
+    cbor_put_array(&writer, RECORDS);
+
+    for (int i = 0; i < RECORDS; i++) {
+        cbor_put_map(&writer, i ? 4 : 6);
+        if (!i) {
+            cbor_put_int(&writer, SENML_BN);
+            cbor_put_text(&writer, "urn:dev:ow:10e2073a01080063;", 28);
+            cbor_put_int(&writer, SENML_BT);
+            cbor_put_int(&writer, 1276020076);
+        }
+        cbor_put_int(&writer, SENML_N);
+        cbor_put_text(&writer, names[i], strlen(names[i]));
+        cbor_put_int(&writer, SENML_U);
+        cbor_put_text(&writer, "V", 1);
+        cbor_put_int(&writer, SENML_V);
+        cbor_put_int(&writer, 1200 + i);
+        cbor_put_int(&writer, SENML_T);
+        cbor_put_int(&writer, -i);
+    }
+
+    cbor_writer_finish(&writer);
+}
+
+static void decode_offset(void)
+{
+    char str[48];
+    size_t records, pairs;
+    int key, val, sum = 0;
+    size_t offset = cbor_deserialize_array(&stream, 0, &records);
+
+    for (size_t i = 0; i < records; i++) {
+        offset += cbor_deserialize_map(&stream, offset, &pairs);
+        for (size_t j = 0; j < pairs; j++) {
+            offset += cbor_deserialize_int(&stream, offset, &key);
+            if (key == SENML_BN || key == SENML_N || key == SENML_U) {
+                offset += cbor_deserialize_unicode_string(&stream, offset, str, sizeof(str));
+                sum += str[0];
+            }
+            else {
+                offset += cbor_deserialize_int(&stream, offset, &val);
+                sum += val;
+            }
+        }
+    }
+
+    sink = sum;
+}
+
+static void decode_cursor(void)
+{
+    cbor_cursor_t doc, pack, rec;
+    const char *str;
+    size_t len;
+    int key, val, sum = 0;
+
+    cbor_cursor_init_stream(&doc, &stream, 0);
+    cbor_cursor_enter(&doc, &pack);
+
+    while (cbor_cursor_peek(&pack) == CBOR_ITEM_MAP) {
+        cbor_cursor_enter(&pack, &rec);
+        while (cbor_get_int(&rec, &key) == 0) {
+            switch (cbor_cursor_peek(&rec)) {
+                case CBOR_ITEM_TEXT:
+                    cbor_get_text(&rec, &str, &len);
+                    sum += str[0];
+                    break;
+                case CBOR_ITEM_UINT:
+                case CBOR_ITEM_NEGINT:
+                    cbor_get_int(&rec, &val);
+                    sum += val;
+                    break;
+                default:
+                    cbor_cursor_skip(&rec);
+                    break;
+            }
+        }
+        cbor_cursor_leave(&pack, &rec);
+    }
+
+    sink = sum;
+}
+
+/* look up the value of the last record, skipping everything before it */
+static void lookup_cursor(void)
+{
+    cbor_cursor_t doc, pack, rec;
+    int key, val = 0;
+
+    cbor_cursor_init_stream(&doc, &stream, 0);
+    cbor_cursor_enter(&doc, &pack);
+
+    for (int i = 0; i < RECORDS - 1; i++) {
+        cbor_cursor_skip(&pack);
+    }
+
+    cbor_cursor_enter(&pack, &rec);
+    while (cbor_get_int(&rec, &key) == 0) {
+        if (key == SENML_V) {
+            cbor_get_int(&rec, &val);
+            break;
+        }
+        cbor_cursor_skip(&rec);
+    }
+
+    sink = val;
+}
+
+static void run_test(const char *name, void (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    printf("+ %s: %lu per second\n", name, count / TIMEOUT_S);
+}
+
+#define run_test(test) run_test(#test, test)
+
+int main(void)
+{
+    cbor_init(&stream, buf, sizeof(buf));
+
+    encode_offset();
+    printf("Start (SenML pack of %u records, %u bytes).\n",
+           RECORDS, (unsigned)stream.pos);
+
+    run_test(encode_offset);
+    run_test(encode_writer);
+    run_test(decode_offset);
+    run_test(decode_cursor);
+    run_test(lookup_cursor);
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the speed of the ChaCha stream cipher and PRNG
+ *
+ * On boards that define CLOCK_CORECLOCK the result is also given in CPU
+ * cycles per byte.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "periph_conf.h"
+#include "crypto/chacha.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+
+static const uint8_t key[32] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+static const uint8_t nonce[8] = { 8, 7, 6, 5, 4, 3, 2, 1 };
+
+static uint8_t buf[1024];
+static chacha_ctx ctx;
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void single_block(void)
+{
+    chacha_encrypt_bytes(&ctx, buf, buf);
+}
+
+static void bulk_1k(void)
+{
+    chacha_encrypt_bytes_n(&ctx, buf, buf, sizeof(buf));
+}
+
+static void prng_next(void)
+{
+    for (unsigned i = 0; i < 16; i++) {
+        buf[i] = chacha_prng_next();
+    }
+}
+
+static void prng_bytes(void)
+{
+    chacha_prng_bytes(buf, 64);
+}
+
+static void run_test(const char *name, void (*test)(void), unsigned bytes)
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    unsigned long bytes_per_s = bytes * count / TIMEOUT_S;
+    printf("+ %s: %lu bytes per second", name, bytes_per_s);
+#ifdef CLOCK_CORECLOCK
+    /* cycles per byte with two decimals */
+    unsigned long cpb = (unsigned long)((100ull * CLOCK_CORECLOCK) / bytes_per_s);
+    printf(", %lu.%02lu cycles per byte", cpb / 100, cpb % 100);
+#endif
+    puts("");
+}
+
+#define run_test(test, bytes) run_test(#test, test, bytes)
+
+int main(void)
+{
+    printf("Start (%u blocks in parallel).\n", CHACHA_PAR_BLOCKS);
+
+    static const unsigned rounds[] = { 8, 12, 20 };
+    for (unsigned i = 0; i < sizeof(rounds) / sizeof(rounds[0]); i++) {
+        chacha_init(&ctx, rounds[i], key, sizeof(key), nonce);
+        printf("ChaCha%u\n", rounds[i]);
+        run_test(single_block, 64);
+        run_test(bulk_1k, sizeof(buf));
+    }
+
+    puts("PRNG");
+    run_test(prng_next, 16 * sizeof(uint32_t));
+    run_test(prng_bytes, 64);
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the throughput of the checksum algorithms
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "checksum/crc32.h"
+#include "checksum/fletcher16.h"
+#include "checksum/fletcher32.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define BUF_LEN (1024U)
+
+static uint16_t buf[BUF_LEN / 2];
+
+static uint32_t crc16_ccitt(void)
+{
+    return crc16_ccitt_calc((const unsigned char *)buf, BUF_LEN);
+}
+
+static uint32_t crc32_ieee(void)
+{
+    return crc32_ieee_calc((const unsigned char *)buf, BUF_LEN);
+}
+
+static uint32_t crc32c(void)
+{
+    return crc32c_calc((const unsigned char *)buf, BUF_LEN);
+}
+
+static uint32_t fletcher_16(void)
+{
+    return fletcher16((const uint8_t *)buf, BUF_LEN);
+}
+
+static uint32_t fletcher_32(void)
+{
+    return fletcher32(buf, BUF_LEN / 2);
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, uint32_t (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    uint32_t expected = test();
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        if (test() != expected) {
+            puts("error");
+        }
+        ++count;
+    } while (done == 0);
+
+    /* bytes per second, in units of 10 kB */
+    unsigned long rate = count * (BUF_LEN / 16) / (TIMEOUT_S * 625);
+    printf("+ %s: %lu.%02lu MB/s\n", name, rate / 100, rate % 100);
+}
+
+#define run_test(test) run_test(#test, test)
+
+int main(void)
+{
+    uint32_t x = 1;
+
+    for (unsigned i = 0; i < BUF_LEN / 2; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = x;
+    }
+
+    puts("Start.");
+
+    run_test(crc16_ccitt);
+    run_test(crc32_ieee);
+    run_test(crc32c);
+    run_test(fletcher_16);
+    run_test(fletcher_32);
+
+    puts("Done.");
+    return 0;
+}
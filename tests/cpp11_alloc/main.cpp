@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief compare the C++ allocators with plain malloc
+ *
+ * @}
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "xtimer.h"
+
+#include "riot/alloc.hpp"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define PER_ITERATION (8)
+#define OBJ_SIZE (24)
+
+struct object {
+  char data[OBJ_SIZE];
+};
+
+static char arena_buf[PER_ITERATION * OBJ_SIZE + 64];
+static riot::arena arena{arena_buf, sizeof(arena_buf)};
+static void* volatile ptrs[PER_ITERATION];
+
+static void malloc_free() {
+  for (unsigned j = 0; j < PER_ITERATION; ++j) {
+    ptrs[j] = std::malloc(OBJ_SIZE);
+  }
+  for (unsigned j = 0; j < PER_ITERATION; ++j) {
+    std::free(ptrs[j]);
+  }
+}
+
+static void new_delete() {
+  for (unsigned j = 0; j < PER_ITERATION; ++j) {
+    ptrs[j] = new object;
+  }
+  for (unsigned j = 0; j < PER_ITERATION; ++j) {
+    delete static_cast<object*>(ptrs[j]);
+  }
+}
+
+static void arena_scope() {
+  riot::arena::scope scope{arena};
+  for (unsigned j = 0; j < PER_ITERATION; ++j) {
+    ptrs[j] = new (arena) object;
+  }
+}
+
+static void callback(void* done_) {
+  volatile int* done = static_cast<volatile int*>(done_);
+  *done = 1;
+}
+
+static void run_test(const char* name, void (*test)()) {
+  volatile int done = 0;
+  unsigned long count = 0;
+
+  xtimer_t xtimer;
+  xtimer.callback = callback;
+  xtimer.arg = (void*)&done;
+
+  xtimer_set(&xtimer, TIMEOUT);
+
+  do {
+    test();
+    ++count;
+  } while (done == 0);
+
+  printf("+ %s: %lu allocations per second\n", name,
+         PER_ITERATION * count / TIMEOUT_S);
+}
+
+#define run_test(test) run_test(#test, test)
+
+int main() {
+  puts("Start.");
+
+  run_test(malloc_free);
+  run_test(new_delete);
+  run_test(arena_scope);
+
+  cpp_alloc_print_stats();
+
+  puts("Done.");
+  return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test the C++ front-end of the schema module
+ *
+ * @}
+ */
+#include <cstdio>
+#include <cstring>
+
+#include "riot/schema.hpp"
+
+struct position {
+  int32_t lat;
+  int32_t lon;
+};
+
+struct telemetry {
+  bool valid;
+  int16_t temp;
+  uint32_t uptime;
+  uint16_t millivolt;
+  char name[16];
+  position pos;
+};
+
+RIOT_SCHEMA(position,
+            RIOT_SCHEMA_FIELD(position, lat),
+            RIOT_SCHEMA_FIELD(position, lon));
+
+RIOT_SCHEMA(telemetry,
+            RIOT_SCHEMA_FIELD(telemetry, valid),
+            RIOT_SCHEMA_FIELD(telemetry, temp),
+            RIOT_SCHEMA_FIELD(telemetry, uptime),
+            RIOT_SCHEMA_FIELD(telemetry, millivolt),
+            RIOT_SCHEMA_FIELD(telemetry, name),
+            RIOT_SCHEMA_FIELD(telemetry, pos));
+
+static_assert(riot::schema::type_of<decltype(telemetry::name)>::value
+              == SCHEMA_STRING, "char arrays are strings");
+static_assert(riot::schema::type_of<position>::value == SCHEMA_STRUCT,
+              "structs are nested schemas");
+
+static uint8_t buf[128];
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("FAILED: %s\n", #cond);                                          \
+      return 1;                                                                \
+    }                                                                          \
+  } while (0)
+
+static bool equal(const telemetry& a, const telemetry& b) {
+  return a.valid == b.valid && a.temp == b.temp && a.uptime == b.uptime
+         && a.millivolt == b.millivolt && strcmp(a.name, b.name) == 0
+         && a.pos.lat == b.pos.lat && a.pos.lon == b.pos.lon;
+}
+
+int main() {
+  puts("\n************ C++ schema test ***********");
+
+  const telemetry in = { true, -12, 123456, 3300, "sensor-1", { 52516, -13377 } };
+
+  /* hashes computed at compile time match the C implementation */
+  CHECK(riot::schema::hash("uptime") == schema_hash("uptime", 6));
+
+  puts("CBOR round trip ...");
+  {
+    cbor_stream_t stream;
+    cbor_writer_t writer;
+    cbor_cursor_t cursor;
+    telemetry out = {};
+
+    cbor_init(&stream, buf, sizeof(buf));
+    cbor_writer_init_stream(&writer, &stream);
+    CHECK(riot::schema::encode(in, writer) == 0);
+    CHECK(cbor_writer_finish(&writer) == 0);
+    cbor_cursor_init_stream(&cursor, &stream, 0);
+    CHECK(riot::schema::decode(out, cursor) == 6);
+    CHECK(equal(in, out));
+    printf("%u bytes\n", static_cast<unsigned>(stream.pos));
+  }
+  puts("Done\n");
+
+  puts("UBJSON round trip ...");
+  {
+    static size_t len, pos;
+    ubjson_cookie_t cookie;
+    telemetry out = {};
+
+    len = pos = 0;
+    ubjson_write_init(&cookie, [](ubjson_cookie_t*, const void* data,
+                                  size_t n) -> ssize_t {
+      memcpy(&buf[len], data, n);
+      len += n;
+      return n;
+    });
+    CHECK(riot::schema::encode(in, cookie) > 0);
+    CHECK(riot::schema::decode(out, cookie, [](ubjson_cookie_t*, void* data,
+                                                size_t n) -> ssize_t {
+      n = (n < len - pos) ? n : len - pos;
+      memcpy(data, &buf[pos], n);
+      pos += n;
+      return n;
+    }) == 6);
+    CHECK(equal(in, out));
+    printf("%u bytes\n", static_cast<unsigned>(len));
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************");
+
+  return 0;
+}
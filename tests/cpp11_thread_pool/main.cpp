@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test the thread pool and measure tasks per second
+ *
+ * @}
+ */
+
+#include <cstdio>
+#include <cstdint>
+
+#include "xtimer.h"
+
+#include "riot/thread.hpp"
+#include "riot/thread_pool.hpp"
+
+using namespace riot;
+
+#define TASKS (1000u)
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("FAILED: %s\n", #cond);                                          \
+      return 1;                                                                \
+    }                                                                          \
+  } while (0)
+
+static volatile unsigned counter;
+
+static void print_rate(const char* name, uint64_t start) {
+  uint64_t usec = xtimer_now64() - start;
+  if (usec == 0) {
+    usec = 1;
+  }
+  printf("+ %s: %lu tasks per second\n", name,
+         static_cast<unsigned long>(TASKS * 1000000ull / usec));
+}
+
+int main() {
+  puts("\n************ C++ thread pool test ***********");
+
+  puts("Results and argument passing ...");
+  {
+    thread_pool pool{2, THREAD_STACKSIZE_DEFAULT};
+    CHECK(pool.size() == 2);
+
+    auto square = async(pool, [](int x) { return x * x; }, 7);
+    auto nothing = async(pool, [] { ++counter; });
+    CHECK(square.valid());
+    CHECK(square.get() == 49);
+    CHECK(!square.valid());
+    nothing.get();
+    CHECK(counter == 1);
+  }
+  puts("Done\n");
+
+  puts("Broken promise ...");
+  {
+    thread_pool pool;
+    auto f = async(pool, []() -> int { throw 42; });
+    bool broken = false;
+    try {
+      f.get();
+    }
+    catch (const future_error&) {
+      broken = true;
+    }
+    CHECK(broken);
+  }
+  puts("Done\n");
+
+  puts("Queued tasks run before the pool is destroyed ...");
+  {
+    counter = 0;
+    {
+      thread_pool pool{1, THREAD_STACKSIZE_DEFAULT, 4};
+      for (unsigned i = 0; i < 10; ++i) {
+        pool.post([] { ++counter; });
+      }
+    }
+    CHECK(counter == 10);
+  }
+  puts("Done\n");
+
+  puts("Benchmark ...");
+  {
+    thread_pool pool{1, THREAD_STACKSIZE_DEFAULT, 16};
+
+    counter = 0;
+    uint64_t start = xtimer_now64();
+    for (unsigned i = 0; i < TASKS; ++i) {
+      pool.post([] { ++counter; });
+    }
+    pool.submit([] {}).get();
+    print_rate("post", start);
+    CHECK(counter == TASKS);
+
+    start = xtimer_now64();
+    for (unsigned i = 0; i < TASKS; ++i) {
+      CHECK(async(pool, [](unsigned x) { return x + 1; }, i).get() == i + 1);
+    }
+    print_rate("async", start);
+
+    start = xtimer_now64();
+    for (unsigned i = 0; i < TASKS; ++i) {
+      thread t([] { ++counter; });
+      t.join();
+    }
+    print_rate("thread", start);
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("*********************************************");
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure how many ethos frames per second pass a UART
+ *
+ * The UART selected by ETHOS_TEST_UART must be looped back to itself. On
+ * real hardware, connect its RX and TX pins. On native, create a pty that
+ * echoes everything and pass it to the application:
+ *
+ *     socat PTY,link=/tmp/ethos_loop,raw,echo=0 EXEC:cat &
+ *     make term TERMFLAGS="-c /tmp/ethos_loop"
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ethos.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define FRAME_LEN (1500U)
+
+static ethos_t ethos;
+static uint8_t inbuf[2048];
+static uint8_t frame[FRAME_LEN];
+static uint8_t received_frame[FRAME_LEN];
+static volatile unsigned received;
+
+static void _event_cb(netdev2_t *dev, netdev2_event_t event, void *arg)
+{
+    (void)arg;
+
+    if (event == NETDEV2_EVENT_ISR) {
+        /* we are in interrupt context already, fetch the frame right away */
+        if (dev->driver->recv(dev, (char *)received_frame,
+                              sizeof(received_frame), NULL) == FRAME_LEN) {
+            received++;
+        }
+    }
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, uint8_t fill)
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+    struct iovec vector = { .iov_base = frame, .iov_len = sizeof(frame) };
+
+    memset(frame, fill, sizeof(frame));
+    /* let frames from a previous run drain */
+    xtimer_usleep(100 * MS_IN_USEC);
+    received = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        ethos.netdev.driver->send((netdev2_t *)&ethos, &vector, 1);
+        ++count;
+    } while (done == 0);
+
+    printf("+ %s: %lu frames sent, %lu frames received per second\n", name,
+           count / TIMEOUT_S, (unsigned long)received / TIMEOUT_S);
+}
+
+int main(void)
+{
+    ethos_params_t params = {
+        .uart = ETHOS_TEST_UART,
+        .baudrate = ETHOS_TEST_BAUDRATE,
+        .buf = inbuf,
+        .bufsize = sizeof(inbuf),
+    };
+
+    puts("Start.");
+
+    ethos_setup(&ethos, &params);
+    ethos.netdev.event_callback = _event_cb;
+
+    /* no byte needs escaping */
+    run_test("plain", 0x55);
+    /* every byte is escaped, doubling the frame on the line */
+    run_test("escaped", ETHOS_FRAME_DELIMITER);
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares per-packet latency and RAM usage of one thread per
+ *              protocol layer with a single event queue thread
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "event.h"
+#include "msg.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#ifndef LAYERS
+#define LAYERS              (5U)
+#endif
+#ifndef PACKETS
+#define PACKETS             (10000U)
+#endif
+
+#define LAYER_PRIO          (THREAD_PRIORITY_MAIN - 1)
+#define MSG_QUEUE_SIZE      (8U)
+#define FLAG_DONE           (0x2)
+
+static char stacks[LAYERS][THREAD_STACKSIZE_DEFAULT];
+static msg_t msg_queues[LAYERS][MSG_QUEUE_SIZE];
+static kernel_pid_t layer_pids[LAYERS];
+static thread_t *main_thread;
+
+static volatile uint32_t checksum;
+
+/* stands in for the actual protocol processing of a layer */
+static inline void _process(unsigned layer, uint32_t pkt)
+{
+    checksum += pkt ^ layer;
+}
+
+static void *_layer_thread(void *arg)
+{
+    unsigned layer = (unsigned)(uintptr_t)arg;
+    msg_t msg;
+
+    msg_init_queue(msg_queues[layer], MSG_QUEUE_SIZE);
+
+    while (1) {
+        msg_receive(&msg);
+        _process(layer, msg.content.value);
+        if (layer < (LAYERS - 1)) {
+            msg_send(&msg, layer_pids[layer + 1]);
+        }
+        else {
+            thread_flags_set(main_thread, FLAG_DONE);
+        }
+    }
+
+    return NULL;
+}
+
+static event_queue_t queue;
+static char event_stack[THREAD_STACKSIZE_DEFAULT];
+
+typedef struct {
+    event_t super;
+    uint32_t pkt;
+} pkt_event_t;
+
+static void _layer_call(unsigned layer, uint32_t pkt)
+{
+    _process(layer, pkt);
+    if (layer < (LAYERS - 1)) {
+        _layer_call(layer + 1, pkt);
+    }
+    else {
+        thread_flags_set(main_thread, FLAG_DONE);
+    }
+}
+
+static void _pkt_handler(event_t *event)
+{
+    _layer_call(0, ((pkt_event_t *)event)->pkt);
+}
+
+static pkt_event_t pkt_event = { .super.handler = _pkt_handler };
+
+static void *_event_thread(void *arg)
+{
+    (void)arg;
+
+    event_queue_init(&queue);
+    event_loop(&queue);
+
+    return NULL;
+}
+
+static uint32_t _run_threads(void)
+{
+    msg_t msg;
+
+    for (unsigned i = 0; i < LAYERS; i++) {
+        layer_pids[i] = thread_create(stacks[i], sizeof(stacks[i]), LAYER_PRIO,
+                                      THREAD_CREATE_STACKTEST, _layer_thread,
+                                      (void *)(uintptr_t)i, "layer");
+    }
+
+    uint32_t start = xtimer_now();
+    for (uint32_t pkt = 0; pkt < PACKETS; pkt++) {
+        msg.content.value = pkt;
+        msg_send(&msg, layer_pids[0]);
+        thread_flags_wait_any(FLAG_DONE);
+    }
+    return xtimer_now() - start;
+}
+
+static uint32_t _run_events(void)
+{
+    thread_create(event_stack, sizeof(event_stack), LAYER_PRIO,
+                  THREAD_CREATE_STACKTEST, _event_thread, NULL, "events");
+
+    uint32_t start = xtimer_now();
+    for (uint32_t pkt = 0; pkt < PACKETS; pkt++) {
+        pkt_event.pkt = pkt;
+        event_post(&queue, &pkt_event.super);
+        thread_flags_wait_any(FLAG_DONE);
+    }
+    return xtimer_now() - start;
+}
+
+int main(void)
+{
+    puts("event layers benchmark");
+
+    main_thread = (thread_t *)sched_active_thread;
+
+    uint32_t t_threads = _run_threads();
+    unsigned ram_threads = sizeof(stacks) + sizeof(msg_queues);
+    printf("threads: %u layers, %u packets, %" PRIu32 "us per packet, "
+           "%u bytes RAM\n", LAYERS, PACKETS, t_threads / PACKETS, ram_threads);
+
+    uint32_t t_events = _run_events();
+    unsigned ram_events = sizeof(event_stack) + sizeof(queue) + sizeof(pkt_event);
+    printf("events:  %u layers, %u packets, %" PRIu32 "us per packet, "
+           "%u bytes RAM\n", LAYERS, PACKETS, t_events / PACKETS, ram_events);
+
+    puts((t_events < t_threads) ? "[SUCCESS]" : "[FAILED]");
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       event test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "thread.h"
+#include "event.h"
+#include "event/callback.h"
+#include "event/timeout.h"
+#include "xtimer.h"
+
+#define TIMEOUT             (100 * 1000U)   /* 100ms */
+
+static unsigned order;
+static event_queue_t queue = EVENT_QUEUE_INIT;
+static char stack[THREAD_STACKSIZE_MAIN];
+
+static void _check(unsigned expected, const char *name)
+{
+    printf("%s: %s\n", name, (order++ == expected) ? "OK" : "FAILED");
+}
+
+static void handler_first(event_t *event)
+{
+    (void)event;
+    _check(0, "first event");
+}
+
+static void handler_canceled(event_t *event)
+{
+    (void)event;
+    puts("canceled event: FAILED");
+}
+
+static void callback(void *arg)
+{
+    _check(1, "callback event");
+    printf("callback arg: %s\n", (arg == (void *)&queue) ? "OK" : "FAILED");
+}
+
+static uint32_t before;
+
+static void handler_timeout(event_t *event)
+{
+    (void)event;
+    uint32_t diff = xtimer_now() - before;
+    _check(2, "timeout event");
+    printf("timeout after %uus: %s\n", (unsigned)diff,
+           (diff >= TIMEOUT) ? "OK" : "FAILED");
+    puts((order == 3) ? "[SUCCESS]" : "[FAILED]");
+}
+
+static event_t event_first = { .handler = handler_first };
+static event_t event_canceled = { .handler = handler_canceled };
+static event_callback_t event_callback = EVENT_CALLBACK_INIT(callback, &queue);
+static event_t event_timeout_event = { .handler = handler_timeout };
+static event_timeout_t event_timeout;
+
+static void *worker(void *arg)
+{
+    (void)arg;
+
+    event_queue_claim(&queue);
+    event_loop(&queue);
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("event test application.");
+
+    kernel_pid_t pid = thread_create(stack, sizeof(stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_SLEEPING, worker, NULL,
+                                     "events");
+
+    /* queue events while the worker still sleeps and has not claimed the
+     * queue yet */
+
+    event_post(&queue, &event_first);
+    /* posting twice must not queue the event twice */
+    event_post(&queue, &event_first);
+    event_post(&queue, &event_canceled);
+    event_post(&queue, (event_t *)&event_callback);
+    event_cancel(&queue, &event_canceled);
+
+    event_timeout_init(&event_timeout, &queue, &event_timeout_event);
+    before = xtimer_now();
+    event_timeout_set(&event_timeout, TIMEOUT);
+
+    thread_wakeup(pid);
+
+    return 0;
+}
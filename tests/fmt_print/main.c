@@ -15,17 +15,180 @@
  *
  * This test is supposed to check for "compilabilty" of the fmt print_* instructions.
  *
+ * It also compares the speed of formatting CSV telemetry lines with
+ * snprintf(), the fmt_* functions and a fmt_writer_t, and of printing a few
+ * of them with printf(), print_*() and a fmt_writer_t.
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  *
  * @}
  */
 
+#include <inttypes.h>
+#include <stdio.h>
+
 #include "fmt.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define PRINT_LINES (16U)
+
+static char line[64];
+static char writer_buf[256];
+static fmt_writer_t writer;
+static uint32_t counter;
+
+/* a line of telemetry: time, temperature in 0.01 °C, humidity in 0.1 %,
+ * sequence number */
+static uint32_t now;
+static int32_t temp = -2215;
+static int32_t hum = 455;
+
+static size_t line_snprintf(void)
+{
+    int32_t t = (temp < 0) ? -temp : temp;
+    return snprintf(line, sizeof(line), "%" PRIu32 ",%s%" PRId32 ".%02" PRId32
+                    ",%" PRId32 ".%" PRId32 ",%" PRIu32 "\n", now,
+                    (temp < 0) ? "-" : "", t / 100, t % 100, hum / 10,
+                    hum % 10, counter++);
+}
+
+static size_t line_fmt(void)
+{
+    char *pos = line;
+
+    pos += fmt_u32_dec(pos, now);
+    *pos++ = ',';
+    pos += fmt_s32_dfp(pos, temp, 2);
+    *pos++ = ',';
+    pos += fmt_s32_dfp(pos, hum, 1);
+    *pos++ = ',';
+    pos += fmt_u32_dec(pos, counter++);
+    *pos++ = '\n';
+    return pos - line;
+}
+
+static void line_writer(fmt_writer_t *w)
+{
+    fmt_writer_u32_dec(w, now);
+    fmt_writer_char(w, ',');
+    fmt_writer_s32_dfp(w, temp, 2);
+    fmt_writer_char(w, ',');
+    fmt_writer_s32_dfp(w, hum, 1);
+    fmt_writer_char(w, ',');
+    fmt_writer_u32_dec(w, counter++);
+    fmt_writer_char(w, '\n');
+}
+
+static void discard(const char *s, size_t n)
+{
+    (void)s;
+    (void)n;
+}
+
+static size_t line_fmt_writer(void)
+{
+    line_writer(&writer);
+    return 1;
+}
+
+static size_t float_fmt(void)
+{
+    return fmt_float(line, temp / 100.0f, 2);
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, size_t (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    now = xtimer_now();
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        if (test() == 0) {
+            puts("error");
+        }
+        ++count;
+    } while (done == 0);
+
+    printf("+ %s: %lu lines/s\n", name, count / TIMEOUT_S);
+}
+
+#define run_test(test) run_test(#test, test)
+
+static void print_printf(void)
+{
+    int32_t t = (temp < 0) ? -temp : temp;
+    printf("%" PRIu32 ",%s%" PRId32 ".%02" PRId32 ",%" PRId32 ".%" PRId32
+           ",%" PRIu32 "\n", now, (temp < 0) ? "-" : "", t / 100, t % 100,
+           hum / 10, hum % 10, counter++);
+}
+
+static void print_fmt(void)
+{
+    char buf[12];
+
+    print_u32_dec(now);
+    print(",", 1);
+    print(buf, fmt_s32_dfp(buf, temp, 2));
+    print(",", 1);
+    print(buf, fmt_s32_dfp(buf, hum, 1));
+    print(",", 1);
+    print_u32_dec(counter++);
+    print("\n", 1);
+}
+
+static void print_fmt_writer(void)
+{
+    line_writer(&writer);
+}
+
+static void run_print(const char *name, void (*test)(void))
+{
+    uint32_t start = xtimer_now();
+
+    for (unsigned i = 0; i < PRINT_LINES; i++) {
+        test();
+    }
+    fflush(stdout);
+    fmt_writer_flush(&writer);
+
+    printf("+ %s: %u lines in %" PRIu32 " us\n", name, PRINT_LINES,
+           xtimer_now() - start);
+}
+
+#define run_print(test) run_print(#test, test)
 
 int main(void)
 {
     print_str("If you can read this:\n");
     print_str("Test successful.\n");
 
+    puts("Start.");
+
+    fmt_writer_init(&writer, writer_buf, sizeof(writer_buf), discard);
+    run_test(line_snprintf);
+    run_test(line_fmt);
+    run_test(line_fmt_writer);
+    run_test(float_fmt);
+
+    fmt_writer_init(&writer, writer_buf, sizeof(writer_buf), print);
+    run_print(print_printf);
+    run_print(print_fmt);
+    run_print(print_fmt_writer);
+
+    puts("Done.");
     return 0;
 }
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the throughput of SLIP and ethos byte stuffing
+ *
+ * The bytewise_* functions are the per byte loops the drivers used before,
+ * for comparison.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "framing.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define FRAME_LEN (1280U)
+
+static uint8_t frame[FRAME_LEN];
+static uint8_t encoded[2 * FRAME_LEN];
+static size_t encoded_len;
+static uint8_t decoded[2 * FRAME_LEN];
+static const framing_t *framing;
+
+static size_t bytewise_encode(void)
+{
+    uint8_t *out = encoded;
+
+    for (unsigned i = 0; i < FRAME_LEN; i++) {
+        if (frame[i] == framing->end) {
+            *out++ = framing->esc;
+            *out++ = framing->esc_end;
+        }
+        else if (frame[i] == framing->esc) {
+            *out++ = framing->esc;
+            *out++ = framing->esc_esc;
+        }
+        else {
+            *out++ = frame[i];
+        }
+    }
+    return out - encoded;
+}
+
+static size_t bytewise_decode(void)
+{
+    uint8_t *out = decoded;
+    int esc = 0;
+
+    for (unsigned i = 0; i < encoded_len; i++) {
+        uint8_t c = encoded[i];
+        if (esc) {
+            esc = 0;
+            if (c == framing->esc_end) {
+                *out++ = framing->end;
+            }
+            else if (c == framing->esc_esc) {
+                *out++ = framing->esc;
+            }
+        }
+        else if (c == framing->esc) {
+            esc = 1;
+        }
+        else {
+            *out++ = c;
+        }
+    }
+    return out - decoded;
+}
+
+static size_t bulk_encode(void)
+{
+    return framing_encode_buf(framing, encoded, frame, FRAME_LEN);
+}
+
+static size_t bulk_decode(void)
+{
+    uint8_t esc = 0;
+    return framing_decode(framing, decoded, encoded, encoded_len, &esc);
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, size_t (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        if (test() == 0) {
+            puts("error");
+        }
+        ++count;
+    } while (done == 0);
+
+    /* payload bytes per second, in units of 10 kB */
+    unsigned long rate = count * (FRAME_LEN / 16) / (TIMEOUT_S * 625);
+    printf("+ %s %s: %lu.%02lu MB/s\n", (framing == &framing_slip) ?
+           "slip" : "hdlc", name, rate / 100, rate % 100);
+}
+
+#define run_test(test) run_test(#test, test)
+
+int main(void)
+{
+    uint32_t x = 1;
+
+    /* pseudo random payload, about 1 byte in 128 needs escaping */
+    for (unsigned i = 0; i < FRAME_LEN; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        frame[i] = x;
+    }
+
+    puts("Start.");
+
+    framing = &framing_slip;
+    encoded_len = bulk_encode();
+    run_test(bytewise_encode);
+    run_test(bulk_encode);
+    run_test(bytewise_decode);
+    run_test(bulk_decode);
+
+    framing = &framing_hdlc;
+    encoded_len = bulk_encode();
+    run_test(bytewise_encode);
+    run_test(bulk_encode);
+    run_test(bytewise_decode);
+    run_test(bulk_decode);
+
+    puts("Done.");
+    return 0;
+}
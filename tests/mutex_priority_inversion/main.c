@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application reproducing and measuring a priority
+ *              inversion on a mutex
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define PRIO_HIGH               (THREAD_PRIORITY_MAIN - 3)
+#define PRIO_MEDIUM             (THREAD_PRIORITY_MAIN - 2)
+#define PRIO_LOW                (THREAD_PRIORITY_MAIN - 1)
+
+#define LOW_SLEEP               (10 * 1000U)        /* 10ms */
+#define LOW_WORK                (20 * 1000U)        /* 20ms */
+#define MEDIUM_WORK             (500 * 1000U)       /* 500ms */
+
+/* the high priority thread must get the mutex before the medium priority
+ * thread is done */
+#define MAX_WAIT                (MEDIUM_WORK / 2)
+
+static char stack_low[THREAD_STACKSIZE_MAIN];
+static char stack_medium[THREAD_STACKSIZE_MAIN];
+static char stack_high[THREAD_STACKSIZE_MAIN];
+
+static mutex_t res_mtx = MUTEX_INIT;
+static mutex_t other_mtx = MUTEX_INIT;
+static volatile uint32_t high_waited;
+static volatile int low_prio_after;
+
+static void _print(const char *role, const char *what)
+{
+    volatile thread_t *t = sched_active_thread;
+
+    printf("T%i (prio %i, %s): %s\n",
+           (int)t->pid, (int)t->priority, role, what);
+}
+
+static void *t_low(void *arg)
+{
+    (void)arg;
+
+    mutex_lock(&res_mtx);
+    _print("low", "locked mutex");
+
+    /* let the other threads start while holding the mutex */
+    xtimer_usleep(LOW_SLEEP);
+
+    /* take a second mutex while boosted and release both out of order, the
+     * priority must still drop back in the end */
+    mutex_lock(&other_mtx);
+    xtimer_spin(LOW_WORK);
+
+    /* xtimer sleeps on a mutex of its own that is unlocked from the timer
+     * ISR and goes out of scope locked, this must not disturb the boost */
+    xtimer_usleep(LOW_SLEEP);
+    _print("low", "woke up from sleep");
+
+    _print("low", "unlocking mutex");
+    mutex_unlock(&res_mtx);
+    mutex_unlock(&other_mtx);
+    low_prio_after = sched_active_thread->priority;
+
+    return NULL;
+}
+
+static void *t_medium(void *arg)
+{
+    (void)arg;
+
+    _print("medium", "starting busy loop");
+    xtimer_spin(MEDIUM_WORK);
+    _print("medium", "busy loop done");
+
+    return NULL;
+}
+
+static void *t_high(void *arg)
+{
+    (void)arg;
+
+    _print("high", "locking mutex now");
+    uint32_t start = xtimer_now();
+    mutex_lock(&res_mtx);
+    high_waited = xtimer_now() - start;
+    _print("high", "got mutex");
+    mutex_unlock(&res_mtx);
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("Mutex priority inversion test");
+    puts("Please refer to the README.md for more information\n");
+
+    thread_create(stack_low, sizeof(stack_low), PRIO_LOW, 0,
+                  t_low, NULL, "low");
+    thread_create(stack_high, sizeof(stack_high), PRIO_HIGH, 0,
+                  t_high, NULL, "high");
+    thread_create(stack_medium, sizeof(stack_medium), PRIO_MEDIUM, 0,
+                  t_medium, NULL, "medium");
+
+    /* main has the lowest priority, so all threads are done when we get
+     * here */
+    printf("high priority thread waited for %" PRIu32 "us\n", high_waited);
+    printf("low priority thread ended at prio %i\n", low_prio_after);
+    puts(((high_waited < MAX_WAIT) && (low_prio_after == PRIO_LOW)) ?
+         "[SUCCESS]" : "[FAILED]");
+
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Serve many UDP sockets from a single thread with poll() and
+ *              select()
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "poll.h"
+#include "sys/select.h"
+#include "sys/socket.h"
+#include "netinet/in.h"
+
+#define SERVERS         (32)
+#define BASE_PORT       (20000)
+#define ROUNDS          (4)
+/* stay below the message queue sizes of the IPv6 and UDP threads */
+#define BATCH           (4)
+#define POLL_TIMEOUT    (1000)  /* ms */
+
+static struct pollfd fds[SERVERS];
+static unsigned received[SERVERS];
+static int client;
+
+static int fail(const char *what)
+{
+    printf("Test failed: %s (errno %d)\n", what, errno);
+    return 1;
+}
+
+static int send_to(unsigned server)
+{
+    struct sockaddr_in6 dst;
+    uint16_t payload = server;
+
+    memset(&dst, 0, sizeof(dst));
+    dst.sin6_family = AF_INET6;
+    dst.sin6_port = htons(BASE_PORT + server);
+    dst.sin6_addr = in6addr_loopback;
+    return sendto(client, &payload, sizeof(payload), 0,
+                  (struct sockaddr *)&dst, sizeof(dst));
+}
+
+/* receive everything that is ready on socket i, returns number or -1 */
+static int drain(unsigned i)
+{
+    struct sockaddr_in6 src;
+    socklen_t src_len;
+    uint16_t payload;
+    int num = 0;
+    ssize_t res;
+
+    while (1) {
+        src_len = sizeof(src);
+        res = recvfrom(fds[i].fd, &payload, sizeof(payload), 0,
+                       (struct sockaddr *)&src, &src_len);
+        if (res < 0) {
+            return (errno == EAGAIN) ? num : -1;
+        }
+        if ((res != sizeof(payload)) || (payload != i) ||
+            (src.sin6_family != AF_INET6)) {
+            printf("socket %u: unexpected datagram\n", i);
+            return -1;
+        }
+        received[i]++;
+        num++;
+    }
+}
+
+static int serve_poll(void)
+{
+    unsigned next = 0, pending = 0, total = 0;
+
+    while (total < SERVERS * ROUNDS) {
+        /* keep a few datagrams in flight, spread over all sockets */
+        while ((pending < BATCH) && (next < SERVERS * ROUNDS)) {
+            if (send_to((next * 7) % SERVERS) < 0) {
+                return fail("sendto");
+            }
+            next++;
+            pending++;
+        }
+        int ready = poll(fds, SERVERS, POLL_TIMEOUT);
+        if (ready < 0) {
+            return fail("poll");
+        }
+        if (ready == 0) {
+            printf("poll timed out after %u datagrams\n", total);
+            return 1;
+        }
+        for (unsigned i = 0; i < SERVERS; i++) {
+            if (fds[i].revents & POLLIN) {
+                int num = drain(i);
+                if (num <= 0) {
+                    return fail("recvfrom");
+                }
+                pending -= num;
+                total += num;
+            }
+        }
+    }
+    for (unsigned i = 0; i < SERVERS; i++) {
+        if (received[i] != ROUNDS) {
+            printf("socket %u received %u datagrams\n", i, received[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int serve_select(void)
+{
+    struct timeval timeout = { 1, 0 };
+    fd_set readfds;
+    int maxfd = 0;
+
+    if (send_to(SERVERS - 1) < 0) {
+        return fail("sendto");
+    }
+    FD_ZERO(&readfds);
+    for (unsigned i = 0; i < SERVERS; i++) {
+        FD_SET(fds[i].fd, &readfds);
+        if (fds[i].fd > maxfd) {
+            maxfd = fds[i].fd;
+        }
+    }
+    if (select(maxfd + 1, &readfds, NULL, NULL, &timeout) != 1) {
+        return fail("select");
+    }
+    for (unsigned i = 0; i < SERVERS; i++) {
+        if (FD_ISSET(fds[i].fd, &readfds) != (i == SERVERS - 1)) {
+            printf("select reported socket %u wrongly\n", i);
+            return 1;
+        }
+    }
+    return (drain(SERVERS - 1) == 1) ? 0 : fail("recvfrom");
+}
+
+int main(void)
+{
+    puts("posix_sockets_poll test");
+
+    for (unsigned i = 0; i < SERVERS; i++) {
+        struct sockaddr_in6 addr;
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sin6_family = AF_INET6;
+        addr.sin6_port = htons(BASE_PORT + i);
+        fds[i].fd = socket(AF_INET6, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+        fds[i].events = POLLIN;
+        if ((fds[i].fd < 0) ||
+            (bind(fds[i].fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)) {
+            return fail("socket");
+        }
+    }
+    if ((client = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP)) < 0) {
+        return fail("client socket");
+    }
+
+    /* nothing queued yet */
+    uint16_t payload;
+    if ((recv(fds[0].fd, &payload, sizeof(payload), MSG_DONTWAIT) >= 0) ||
+        (errno != EAGAIN)) {
+        return fail("MSG_DONTWAIT");
+    }
+    if (poll(fds, SERVERS, 0) != 0) {
+        return fail("poll without timeout");
+    }
+
+    if (serve_poll() || serve_select()) {
+        return 1;
+    }
+
+    for (unsigned i = 0; i < SERVERS; i++) {
+        close(fds[i].fd);
+    }
+    close(client);
+
+    printf("Served %u datagrams on %u sockets.\n", SERVERS * ROUNDS + 1,
+           SERVERS);
+    puts("Test successful.");
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the speed of thread creation and thread-specific data
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "pthread.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define PER_ITERATION (16)
+
+/* larger than the stacks in the pool, so the thread comes from the heap */
+#define HEAP_STACKSIZE (THREAD_STACKSIZE_DEFAULT + 64)
+
+static pthread_key_t key;
+static int value;
+
+static void *nop(void *arg)
+{
+    return arg;
+}
+
+static void create_join(const pthread_attr_t *attr)
+{
+    pthread_t th;
+
+    for (unsigned j = 0; j < PER_ITERATION; ++j) {
+        if (pthread_create(&th, attr, nop, NULL) != 0) {
+            puts("pthread_create() failed");
+            return;
+        }
+        pthread_join(th, NULL);
+    }
+}
+
+static void create_join_pool(void)
+{
+    create_join(NULL);
+}
+
+static void create_join_heap(void)
+{
+    pthread_attr_t attr;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, HEAP_STACKSIZE);
+    create_join(&attr);
+    pthread_attr_destroy(&attr);
+}
+
+static void getspecific(void)
+{
+    for (unsigned j = 0; j < PER_ITERATION; ++j) {
+        if (pthread_getspecific(key) != &value) {
+            puts("pthread_getspecific() failed");
+        }
+    }
+}
+
+static void setspecific(void)
+{
+    for (unsigned j = 0; j < PER_ITERATION; ++j) {
+        pthread_setspecific(key, &value);
+    }
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, void (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    printf("+ %s: %lu per second\n", name, PER_ITERATION * count / TIMEOUT_S);
+}
+
+#define run_test(test) run_test(#test, test)
+
+static void *tls_tests(void *arg)
+{
+    (void) arg;
+
+    pthread_key_create(&key, NULL);
+    pthread_setspecific(key, &value);
+
+    run_test(getspecific);
+    run_test(setspecific);
+
+    pthread_key_delete(key);
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t th;
+
+    puts("Start.");
+
+    run_test(create_join_pool);
+    run_test(create_join_heap);
+
+    /* thread-specific data only exists in pthreads */
+    pthread_create(&th, NULL, tls_tests, NULL);
+    pthread_join(th, NULL);
+
+    puts("Done.");
+    return 0;
+}
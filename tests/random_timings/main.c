@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure throughput and latency of the random number generator
+ *
+ * The generator is chosen at compile time, e.g. `make PRNG=xoshiro`.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "random.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define BUF_LEN (1024U)
+#define SMALL_LEN (7U)
+#define LATENCY_CALLS (100000UL)
+
+static uint8_t buf[BUF_LEN];
+static volatile uint32_t sink;
+
+static unsigned uint32_loop(void)
+{
+    uint32_t x = 0;
+
+    for (unsigned i = 0; i < BUF_LEN / sizeof(uint32_t); i++) {
+        x ^= random_uint32();
+    }
+    sink = x;
+    return BUF_LEN;
+}
+
+static unsigned bytes(void)
+{
+    random_bytes(buf, BUF_LEN);
+    return BUF_LEN;
+}
+
+static unsigned bytes_small(void)
+{
+    random_bytes(buf, SMALL_LEN);
+    return SMALL_LEN;
+}
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void run_test(const char *name, unsigned (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long total = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        total += test();
+    } while (done == 0);
+
+    /* bytes per second, in units of 10 kB */
+    unsigned long rate = total / (TIMEOUT_S * 10000);
+    printf("+ %s: %lu.%02lu MB/s\n", name, rate / 100, rate % 100);
+}
+
+#define run_test(test) run_test(#test, test)
+
+static void run_latency(void)
+{
+    uint32_t x = 0, max = 0;
+
+    /* The resolution of xtimer is far coarser than a call, so only calls that
+     * take much longer than the others, e.g. to regenerate a batch of state,
+     * stand out. The largest of them is the worst case. */
+    for (unsigned long i = 0; i < LATENCY_CALLS; i++) {
+        uint32_t start = xtimer_now();
+        x ^= random_uint32();
+        uint32_t t = xtimer_now() - start;
+        if (t > max) {
+            max = t;
+        }
+    }
+    sink = x;
+    printf("+ worst case latency: %lu us\n", (unsigned long)max);
+}
+
+int main(void)
+{
+    random_init(1);
+
+    puts("Start.");
+
+    run_test(uint32_loop);
+    run_test(bytes);
+    run_test(bytes_small);
+    run_latency();
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Sample simulated SAUL devices and report rate and jitter
+ *
+ * Registers a number of simulated sensors with periods between 10 and 50 ms,
+ * each read taking a few microseconds of busy time, runs them through the
+ * SAUL sampler for a while and checks that every reading arrives in order.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "saul_sampler.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+#define SENSOR_NUMOF (24U)
+#define READ_US (20U)
+#define LOOKUPS (10000U)
+
+typedef struct {
+    int16_t count;
+    char name[8];
+} sensor_t;
+
+static sensor_t sensors[SENSOR_NUMOF];
+static saul_reg_t regs[SENSOR_NUMOF];
+static saul_sampler_entry_t plan[SENSOR_NUMOF];
+static int16_t expected[SENSOR_NUMOF];
+static saul_sample_t ring[64];
+static saul_sample_t samples[16];
+static saul_sampler_t sampler;
+static char stack[THREAD_STACKSIZE_DEFAULT];
+
+static int read_sensor(void *dev, phydat_t *res)
+{
+    sensor_t *sensor = dev;
+
+    xtimer_spin(READ_US);
+    res->val[0] = sensor->count++;
+    res->unit = UNIT_TEMP_C;
+    res->scale = 0;
+    return 1;
+}
+
+static const saul_driver_t driver = {
+    .read = read_sensor,
+    .write = saul_notsup,
+    .type = SAUL_SENSE_TEMP,
+};
+
+static void setup(void)
+{
+    for (unsigned i = 0; i < SENSOR_NUMOF; i++) {
+        snprintf(sensors[i].name, sizeof(sensors[i].name), "sim%u", i);
+        regs[i].dev = &sensors[i];
+        regs[i].name = sensors[i].name;
+        regs[i].driver = &driver;
+        saul_reg_add(&regs[i]);
+    }
+    for (unsigned i = 0; i < SENSOR_NUMOF; i++) {
+        plan[i].dev = saul_reg_find_name(sensors[i].name);
+        plan[i].period = (10 + 10 * (i % 5)) * MS_IN_USEC;
+    }
+}
+
+static void bench_lookup(void)
+{
+    const char *name = sensors[SENSOR_NUMOF - 1].name;
+    uint32_t start = xtimer_now();
+
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        if (saul_reg_find_name(name) != &regs[SENSOR_NUMOF - 1]) {
+            puts("error: lookup failed");
+            return;
+        }
+    }
+    uint32_t diff = xtimer_now() - start;
+    printf("+ saul_reg_find_name(): %" PRIu32 " ns per lookup of the last "
+           "of %u devices\n", (uint32_t)((uint64_t)diff * 1000 / LOOKUPS),
+           SENSOR_NUMOF);
+}
+
+int main(void)
+{
+    printf("\nStart.\n");
+
+    setup();
+    bench_lookup();
+
+    if (saul_sampler_init(&sampler, plan, SENSOR_NUMOF, ring,
+                          sizeof(ring)) != 0) {
+        puts("error: saul_sampler_init() failed");
+        return 1;
+    }
+    unsigned rate = 0;
+    for (unsigned i = 0; i < SENSOR_NUMOF; i++) {
+        rate += SEC_IN_USEC / plan[i].period;
+    }
+    printf("%u devices, %u readings per second planned\n", SENSOR_NUMOF, rate);
+
+    uint32_t start = xtimer_now();
+    saul_sampler_start(&sampler, stack, sizeof(stack),
+                       THREAD_PRIORITY_MAIN - 1);
+
+    unsigned received = 0;
+    int errors = 0;
+    while ((xtimer_now() - start) < TIMEOUT) {
+        saul_sampler_wait(&sampler);
+        unsigned n;
+        while ((n = saul_sampler_get(&sampler, samples, 16))) {
+            for (unsigned i = 0; i < n; i++) {
+                saul_sample_t *s = &samples[i];
+                /* dropped readings leave gaps, but never go back */
+                if ((s->dim != 1) ||
+                    ((int16_t)(s->data.val[0] - expected[s->entry]) < 0)) {
+                    errors++;
+                }
+                expected[s->entry] = s->data.val[0] + 1;
+            }
+            received += n;
+        }
+    }
+
+    saul_sampler_stats_t stats;
+    saul_sampler_get_stats(&sampler, &stats);
+    printf("+ sampler: %u readings per second, jitter avg %" PRIu32
+           " us, max %" PRIu32 " us\n", received / (unsigned)TIMEOUT_S,
+           stats.samples ? (uint32_t)(stats.jitter_sum / stats.samples) : 0,
+           stats.jitter_max);
+    printf("+ sampler: %" PRIu32 " late, %" PRIu32 " dropped, %" PRIu32
+           " errors\n", stats.late, stats.dropped, stats.errors);
+
+    if (errors) {
+        printf("error: %d readings out of order\n", errors);
+    }
+    printf("\nDone.\n");
+    return 0;
+}
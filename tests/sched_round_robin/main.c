@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for round robin scheduling of threads
+ *              with the same priority
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "thread.h"
+#include "xtimer.h"
+#include "ps.h"
+
+#define THREAD_NUMOF            (3U)
+#define RUNTIME                 (1U)        /* seconds */
+
+static char stacks[THREAD_NUMOF][THREAD_STACKSIZE_DEFAULT];
+
+static volatile uint32_t counters[THREAD_NUMOF];
+static volatile int done = 0;
+
+static void *busy(void *arg)
+{
+    volatile uint32_t *counter = arg;
+
+    /* never yields voluntarily */
+    while (!done) {
+        (*counter)++;
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    int res = 1;
+
+    puts("Round robin scheduling test");
+
+    for (unsigned i = 0; i < THREAD_NUMOF; i++) {
+        thread_create(stacks[i], sizeof(stacks[i]), THREAD_PRIORITY_MAIN + 1,
+                      THREAD_CREATE_WOUT_YIELD, busy, (void *)&counters[i],
+                      "busy");
+    }
+
+    xtimer_sleep(RUNTIME);
+    done = 1;
+
+    for (unsigned i = 0; i < THREAD_NUMOF; i++) {
+        printf("thread %u: %" PRIu32 " iterations\n", i, counters[i]);
+        if (counters[i] == 0) {
+            res = 0;
+        }
+    }
+    ps();
+
+    puts(res ? "[SUCCESS]" : "[FAILED]");
+
+    return 0;
+}
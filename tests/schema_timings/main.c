@@ -0,0 +1,428 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Compare schema driven serialization of a 20 field telemetry
+ *            record with hand written CBOR and UBJSON code
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "schema.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+
+#define FIELDS          (20)
+
+typedef struct {
+    bool valid;
+    int8_t rssi;
+    int16_t temperature;
+    int16_t dew_point;
+    uint8_t humidity;
+    uint16_t pressure;
+    uint16_t battery;
+    uint32_t uptime;
+    uint32_t sequence;
+    int32_t latitude;
+    int32_t longitude;
+    int32_t altitude;
+    uint16_t speed;
+    uint16_t heading;
+    uint8_t satellites;
+    uint32_t rx_packets;
+    uint32_t tx_packets;
+    uint16_t errors;
+    char name[16];
+    char firmware[8];
+} telemetry_t;
+
+static SCHEMA_DEFINE(telemetry_schema,
+    SCHEMA_FIELD(telemetry_t, valid, SCHEMA_BOOL),
+    SCHEMA_FIELD(telemetry_t, rssi, SCHEMA_INT8),
+    SCHEMA_FIELD(telemetry_t, temperature, SCHEMA_INT16),
+    SCHEMA_FIELD(telemetry_t, dew_point, SCHEMA_INT16),
+    SCHEMA_FIELD(telemetry_t, humidity, SCHEMA_UINT8),
+    SCHEMA_FIELD(telemetry_t, pressure, SCHEMA_UINT16),
+    SCHEMA_FIELD(telemetry_t, battery, SCHEMA_UINT16),
+    SCHEMA_FIELD(telemetry_t, uptime, SCHEMA_UINT32),
+    SCHEMA_FIELD(telemetry_t, sequence, SCHEMA_UINT32),
+    SCHEMA_FIELD(telemetry_t, latitude, SCHEMA_INT32),
+    SCHEMA_FIELD(telemetry_t, longitude, SCHEMA_INT32),
+    SCHEMA_FIELD(telemetry_t, altitude, SCHEMA_INT32),
+    SCHEMA_FIELD(telemetry_t, speed, SCHEMA_UINT16),
+    SCHEMA_FIELD(telemetry_t, heading, SCHEMA_UINT16),
+    SCHEMA_FIELD(telemetry_t, satellites, SCHEMA_UINT8),
+    SCHEMA_FIELD(telemetry_t, rx_packets, SCHEMA_UINT32),
+    SCHEMA_FIELD(telemetry_t, tx_packets, SCHEMA_UINT32),
+    SCHEMA_FIELD(telemetry_t, errors, SCHEMA_UINT16),
+    SCHEMA_FIELD(telemetry_t, name, SCHEMA_STRING),
+    SCHEMA_FIELD(telemetry_t, firmware, SCHEMA_STRING),
+);
+
+/* keys in the order of the hand written code */
+static const char *keys[FIELDS] = {
+    "valid", "rssi", "temperature", "dew_point", "humidity", "pressure",
+    "battery", "uptime", "sequence", "latitude", "longitude", "altitude",
+    "speed", "heading", "satellites", "rx_packets", "tx_packets", "errors",
+    "name", "firmware"
+};
+
+static const telemetry_t record = {
+    true, -67, 2150, 1230, 48, 10132, 3012, 86400, 4711,
+    52516711, 13377186, 34, 0, 270, 9, 120345, 98765, 3,
+    "node-17", "2016.07"
+};
+
+static telemetry_t decoded;
+
+static uint8_t buf[384];
+static cbor_stream_t stream;
+
+typedef struct {
+    ubjson_cookie_t cookie;
+    size_t pos;
+} mem_cookie_t;
+
+static mem_cookie_t mem;
+static size_t ubjson_len;
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static ssize_t mem_write(ubjson_cookie_t *__restrict cookie, const void *data,
+                         size_t len)
+{
+    mem_cookie_t *m = container_of(cookie, mem_cookie_t, cookie);
+    memcpy(&buf[m->pos], data, len);
+    m->pos += len;
+    return len;
+}
+
+static ssize_t mem_read(ubjson_cookie_t *__restrict cookie, void *data,
+                        size_t max_len)
+{
+    mem_cookie_t *m = container_of(cookie, mem_cookie_t, cookie);
+    size_t len = ubjson_len - m->pos;
+
+    if (len > max_len) {
+        len = max_len;
+    }
+    memcpy(data, &buf[m->pos], len);
+    m->pos += len;
+    return len;
+}
+
+static int find_key(const char *key, size_t len)
+{
+    for (int i = 0; i < FIELDS; i++) {
+        if (strlen(keys[i]) == len && !memcmp(keys[i], key, len)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void cbor_encode_hand(void)
+{
+    cbor_writer_t w;
+    const telemetry_t *r = &record;
+
+    cbor_clear(&stream);
+    cbor_writer_init_stream(&w, &stream);
+    cbor_put_map(&w, FIELDS);
+    cbor_put_text(&w, "valid", 5);
+    cbor_put_bool(&w, r->valid);
+    cbor_put_text(&w, "rssi", 4);
+    cbor_put_int(&w, r->rssi);
+    cbor_put_text(&w, "temperature", 11);
+    cbor_put_int(&w, r->temperature);
+    cbor_put_text(&w, "dew_point", 9);
+    cbor_put_int(&w, r->dew_point);
+    cbor_put_text(&w, "humidity", 8);
+    cbor_put_uint(&w, r->humidity);
+    cbor_put_text(&w, "pressure", 8);
+    cbor_put_uint(&w, r->pressure);
+    cbor_put_text(&w, "battery", 7);
+    cbor_put_uint(&w, r->battery);
+    cbor_put_text(&w, "uptime", 6);
+    cbor_put_uint(&w, r->uptime);
+    cbor_put_text(&w, "sequence", 8);
+    cbor_put_uint(&w, r->sequence);
+    cbor_put_text(&w, "latitude", 8);
+    cbor_put_int(&w, r->latitude);
+    cbor_put_text(&w, "longitude", 9);
+    cbor_put_int(&w, r->longitude);
+    cbor_put_text(&w, "altitude", 8);
+    cbor_put_int(&w, r->altitude);
+    cbor_put_text(&w, "speed", 5);
+    cbor_put_uint(&w, r->speed);
+    cbor_put_text(&w, "heading", 7);
+    cbor_put_uint(&w, r->heading);
+    cbor_put_text(&w, "satellites", 10);
+    cbor_put_uint(&w, r->satellites);
+    cbor_put_text(&w, "rx_packets", 10);
+    cbor_put_uint(&w, r->rx_packets);
+    cbor_put_text(&w, "tx_packets", 10);
+    cbor_put_uint(&w, r->tx_packets);
+    cbor_put_text(&w, "errors", 6);
+    cbor_put_uint(&w, r->errors);
+    cbor_put_text(&w, "name", 4);
+    cbor_put_text(&w, r->name, strlen(r->name));
+    cbor_put_text(&w, "firmware", 8);
+    cbor_put_text(&w, r->firmware, strlen(r->firmware));
+    cbor_writer_finish(&w);
+}
+
+static void cbor_encode_schema(void)
+{
+    cbor_writer_t w;
+
+    cbor_clear(&stream);
+    cbor_writer_init_stream(&w, &stream);
+    schema_cbor_encode(&telemetry_schema, &record, &w);
+    cbor_writer_finish(&w);
+}
+
+static void cbor_decode_hand(void)
+{
+    cbor_cursor_t doc, map;
+    telemetry_t *r = &decoded;
+    const char *str;
+    size_t len;
+    int64_t val;
+    bool b;
+
+    cbor_cursor_init_stream(&doc, &stream, 0);
+    cbor_cursor_enter(&doc, &map);
+
+    while (cbor_get_text(&map, &str, &len) == 0) {
+        int i = find_key(str, len);
+        if (i == 0) {
+            cbor_get_bool(&map, &b);
+            r->valid = b;
+            continue;
+        }
+        if (i >= 18) {
+            cbor_get_text(&map, &str, &len);
+            char *dst = (i == 18) ? r->name : r->firmware;
+            size_t size = (i == 18) ? sizeof(r->name) : sizeof(r->firmware);
+            if (len < size) {
+                memcpy(dst, str, len);
+                dst[len] = '\0';
+            }
+            continue;
+        }
+        if (i < 0 || cbor_get_int64(&map, &val) != 0) {
+            cbor_cursor_skip(&map);
+            continue;
+        }
+        switch (i) {
+            case 1: r->rssi = val; break;
+            case 2: r->temperature = val; break;
+            case 3: r->dew_point = val; break;
+            case 4: r->humidity = val; break;
+            case 5: r->pressure = val; break;
+            case 6: r->battery = val; break;
+            case 7: r->uptime = val; break;
+            case 8: r->sequence = val; break;
+            case 9: r->latitude = val; break;
+            case 10: r->longitude = val; break;
+            case 11: r->altitude = val; break;
+            case 12: r->speed = val; break;
+            case 13: r->heading = val; break;
+            case 14: r->satellites = val; break;
+            case 15: r->rx_packets = val; break;
+            case 16: r->tx_packets = val; break;
+            case 17: r->errors = val; break;
+        }
+    }
+}
+
+static void cbor_decode_schema(void)
+{
+    cbor_cursor_t doc;
+
+    cbor_cursor_init_stream(&doc, &stream, 0);
+    schema_cbor_decode(&telemetry_schema, &decoded, &doc);
+}
+
+static void ubjson_encode_schema(void)
+{
+    mem.pos = 0;
+    ubjson_write_init(&mem.cookie, mem_write);
+    schema_ubjson_encode(&telemetry_schema, &record, &mem.cookie);
+}
+
+static ubjson_read_callback_result_t ubjson_value(ubjson_cookie_t *__restrict cookie,
+                                                  int i, ubjson_type_t type,
+                                                  ssize_t content)
+{
+    telemetry_t *r = &decoded;
+    int32_t v32;
+    int64_t val;
+
+    switch (type) {
+        case UBJSON_TYPE_BOOL:
+            if (i == 0) {
+                r->valid = content;
+            }
+            return UBJSON_OKAY;
+        case UBJSON_TYPE_STRING:
+            if (i == 18 && (size_t)content < sizeof(r->name)) {
+                ubjson_get_string(cookie, content, r->name);
+                r->name[content] = '\0';
+            }
+            else if (i == 19 && (size_t)content < sizeof(r->firmware)) {
+                ubjson_get_string(cookie, content, r->firmware);
+                r->firmware[content] = '\0';
+            }
+            else {
+                return UBJSON_ABORTED;
+            }
+            return UBJSON_OKAY;
+        case UBJSON_TYPE_INT32:
+            ubjson_get_i32(cookie, content, &v32);
+            val = v32;
+            break;
+        case UBJSON_TYPE_INT64:
+            ubjson_get_i64(cookie, content, &val);
+            break;
+        default:
+            return UBJSON_ABORTED;
+    }
+
+    switch (i) {
+        case 1: r->rssi = val; break;
+        case 2: r->temperature = val; break;
+        case 3: r->dew_point = val; break;
+        case 4: r->humidity = val; break;
+        case 5: r->pressure = val; break;
+        case 6: r->battery = val; break;
+        case 7: r->uptime = val; break;
+        case 8: r->sequence = val; break;
+        case 9: r->latitude = val; break;
+        case 10: r->longitude = val; break;
+        case 11: r->altitude = val; break;
+        case 12: r->speed = val; break;
+        case 13: r->heading = val; break;
+        case 14: r->satellites = val; break;
+        case 15: r->rx_packets = val; break;
+        case 16: r->tx_packets = val; break;
+        case 17: r->errors = val; break;
+    }
+    return UBJSON_OKAY;
+}
+
+static ubjson_read_callback_result_t ubjson_callback(ubjson_cookie_t *__restrict cookie,
+                                                     ubjson_type_t type1, ssize_t content1,
+                                                     ubjson_type_t type2, ssize_t content2)
+{
+    char key[SCHEMA_UBJSON_KEY_MAX];
+
+    switch (type1) {
+        case UBJSON_ENTER_OBJECT:
+            return ubjson_read_object(cookie);
+        case UBJSON_KEY:
+            if ((size_t)content1 > sizeof(key)) {
+                return UBJSON_ABORTED;
+            }
+            ubjson_get_string(cookie, content1, key);
+            ubjson_peek_value(cookie, &type2, &content2);
+            return ubjson_value(cookie, find_key(key, content1), type2, content2);
+        default:
+            return UBJSON_ABORTED;
+    }
+}
+
+static void ubjson_decode_callback(void)
+{
+    mem.pos = 0;
+    ubjson_read(&mem.cookie, mem_read, ubjson_callback);
+}
+
+static void ubjson_decode_schema(void)
+{
+    mem.pos = 0;
+    schema_ubjson_decode(&telemetry_schema, &decoded, &mem.cookie, mem_read);
+}
+
+static void run_test(const char *name, void (*test)(void))
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    printf("+ %s: %lu per second\n", name, count / TIMEOUT_S);
+}
+
+#define run_test(test) run_test(#test, test)
+
+static void check(const char *name)
+{
+    if (memcmp(&decoded, &record, sizeof(record))) {
+        printf("%s: decoded record differs\n", name);
+    }
+    memset(&decoded, 0, sizeof(decoded));
+}
+
+int main(void)
+{
+    cbor_init(&stream, buf, sizeof(buf));
+
+    /* make sure every decoder yields the original record */
+    cbor_encode_hand();
+    cbor_decode_hand();
+    check("cbor_decode_hand");
+    cbor_decode_schema();
+    check("cbor_decode_schema");
+    ubjson_encode_schema();
+    ubjson_len = mem.pos;
+    ubjson_decode_callback();
+    check("ubjson_decode_callback");
+    ubjson_decode_schema();
+    check("ubjson_decode_schema");
+
+    printf("Start (%u fields, %u bytes CBOR, %u bytes UBJSON).\n",
+           FIELDS, (unsigned)stream.pos, (unsigned)ubjson_len);
+
+    run_test(cbor_encode_hand);
+    run_test(cbor_encode_schema);
+    run_test(cbor_decode_hand);
+    run_test(cbor_decode_schema);
+
+    run_test(ubjson_encode_schema);
+    run_test(ubjson_decode_callback);
+    run_test(ubjson_decode_schema);
+
+    puts("Done.");
+    return 0;
+}
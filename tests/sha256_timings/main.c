@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup   tests
+ * @{
+ *
+ * @file
+ * @brief     Measure the number of SHA-256 hashes per second
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "xtimer.h"
+
+#define TIMEOUT_S (2ul)
+#define TIMEOUT (TIMEOUT_S * SEC_IN_USEC)
+
+#define CHAIN_LENGTH    (256)
+#define MULTI_COUNT     (8)
+
+static unsigned char data[1024];
+static unsigned char digest[SHA256_DIGEST_LENGTH];
+static unsigned char tail[SHA256_DIGEST_LENGTH];
+static sha256_chain_idx_elm_t chain[CHAIN_LENGTH];
+
+static void callback(void *done_)
+{
+    volatile int *done = done_;
+    *done = 1;
+}
+
+static void hash_32(void)
+{
+    sha256(data, 32, digest);
+}
+
+static void hash_64(void)
+{
+    sha256(data, 64, digest);
+}
+
+static void hash_1k(void)
+{
+    sha256(data, sizeof(data), digest);
+}
+
+static void hmac_64(void)
+{
+    hmac_sha256(data, 32, (const unsigned *)data, 64, digest);
+}
+
+static void multi_64(void)
+{
+    static const void *msgs[MULTI_COUNT];
+    static size_t lens[MULTI_COUNT];
+    static unsigned char digests[MULTI_COUNT][SHA256_DIGEST_LENGTH];
+
+    for (unsigned i = 0; i < MULTI_COUNT; i++) {
+        msgs[i] = data + 64 * i;
+        lens[i] = 64;
+    }
+    sha256_multi(msgs, lens, MULTI_COUNT, digests);
+}
+
+static void chain_verify(void)
+{
+    /* verify every element in disclosure order, starting from the tail */
+    for (unsigned i = CHAIN_LENGTH - 1; i > 0; i--) {
+        sha256_chain_verify_element(chain[i].element, i, tail, CHAIN_LENGTH);
+    }
+}
+
+static void chain_verifier(void)
+{
+    sha256_chain_idx_elm_t cache[4];
+    sha256_chain_verifier_t verifier;
+
+    sha256_chain_verifier_init(&verifier, cache, 4, tail, CHAIN_LENGTH);
+    for (unsigned i = CHAIN_LENGTH - 1; i > 0; i--) {
+        sha256_chain_verifier_check(&verifier, chain[i].element, i);
+    }
+}
+
+static void run_test(const char *name, void (*test)(void), unsigned per_call)
+{
+    volatile int done = 0;
+    unsigned long count = 0;
+
+    xtimer_t xtimer;
+    xtimer.callback = callback;
+    xtimer.arg = (void *) &done;
+
+    xtimer_set(&xtimer, TIMEOUT);
+
+    do {
+        test();
+        ++count;
+    } while (done == 0);
+
+    printf("+ %s: %lu per second\n", name, per_call * count / TIMEOUT_S);
+}
+
+#define run_test(test, per_call) run_test(#test, test, per_call)
+
+int main(void)
+{
+    size_t length = CHAIN_LENGTH;
+
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i] = (unsigned char)i;
+    }
+    sha256_chain_with_waypoints(data, 32, CHAIN_LENGTH, tail, chain, &length);
+
+    puts("Start.");
+
+    run_test(hash_32, 1);
+    run_test(hash_64, 1);
+    run_test(hash_1k, 1);
+    run_test(hmac_64, 1);
+    run_test(multi_64, MULTI_COUNT);
+    /* chain verifications count verified elements per second */
+    run_test(chain_verify, CHAIN_LENGTH - 1);
+    run_test(chain_verifier, CHAIN_LENGTH - 1);
+
+    puts("Done.");
+    return 0;
+}
@@ -35,8 +35,8 @@ int main(void)
     puts("SLIP test");
 
     /* initialize and register pktdump */
-    dump.pid = gnrc_pktdump_pid;
-    dump.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
+    gnrc_netreg_entry_init_pid(&dump, GNRC_NETREG_DEMUX_CTX_ALL,
+                               gnrc_pktdump_pid);
 
     if (dump.pid <= KERNEL_PID_UNDEF) {
         puts("Error starting pktdump thread");
@@ -11,6 +11,7 @@
 #if (TEST_BASE64_SHOW_OUTPUT == 1)
 #include <stdio.h>
 #endif
+#include <stdint.h>
 #include <string.h>
 #include "embUnit.h"
 #include "tests-base64.h"
@@ -301,6 +302,153 @@ static void test_base64_07_stream_decode(void)
 #endif
 }
 
+static void test_base64_08_rfc4648_vectors(void)
+{
+    /* test vectors of RFC 4648, section 10 */
+    static const char *plain[] = {
+        "f", "fo", "foo", "foob", "fooba", "foobar"
+    };
+    static const char *encoded[] = {
+        "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"
+    };
+    unsigned char out[12];
+
+    for (unsigned i = 0; i < sizeof(plain) / sizeof(plain[0]); i++) {
+        size_t len = sizeof(out);
+        int ret = base64_encode((unsigned char *)plain[i], strlen(plain[i]),
+                                out, &len);
+        TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_INT(strlen(encoded[i]), len);
+        TEST_ASSERT(memcmp(out, encoded[i], len) == 0);
+
+        len = sizeof(out);
+        ret = base64_decode((unsigned char *)encoded[i], strlen(encoded[i]),
+                            out, &len);
+        TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_INT(strlen(plain[i]), len);
+        TEST_ASSERT(memcmp(out, plain[i], len) == 0);
+    }
+}
+
+#define RANDOM_MAX_LEN  (300U)
+
+static uint32_t _rand_state = 1;
+
+static uint32_t _rand(void)
+{
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+/* bit by bit encoder to compare with */
+static size_t _reference_encode(const unsigned char *in, size_t len,
+                                unsigned char *out)
+{
+    static const char symbols[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                  "abcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t pos = 0;
+
+    for (size_t bit = 0; bit < len * 8; bit += 6) {
+        unsigned code = 0;
+        for (unsigned i = 0; i < 6; i++) {
+            size_t b = bit + i;
+            code <<= 1;
+            if (b < len * 8) {
+                code |= (in[b / 8] >> (7 - (b % 8))) & 1;
+            }
+        }
+        out[pos++] = symbols[code];
+    }
+    while (pos % 4) {
+        out[pos++] = '=';
+    }
+    return pos;
+}
+
+static void test_base64_09_random_roundtrip(void)
+{
+    static unsigned char data[RANDOM_MAX_LEN];
+    static unsigned char expect[BASE64_ENCODE_SIZE(RANDOM_MAX_LEN)];
+    static unsigned char encoded[BASE64_ENCODE_SIZE(RANDOM_MAX_LEN)];
+    static unsigned char decoded[RANDOM_MAX_LEN + 4];
+
+    for (unsigned round = 0; round < 200; round++) {
+        size_t len = 1 + _rand() % RANDOM_MAX_LEN;
+        for (size_t i = 0; i < len; i++) {
+            data[i] = _rand();
+        }
+        size_t expect_len = _reference_encode(data, len, expect);
+
+        size_t encoded_len = sizeof(encoded);
+        int ret = base64_encode(data, len, encoded, &encoded_len);
+        TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_INT(expect_len, encoded_len);
+        TEST_ASSERT(memcmp(expect, encoded, encoded_len) == 0);
+
+        size_t decoded_len = sizeof(decoded);
+        ret = base64_decode(encoded, encoded_len, decoded, &decoded_len);
+        TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_INT(len, decoded_len);
+        TEST_ASSERT(memcmp(data, decoded, len) == 0);
+    }
+}
+
+static void test_base64_10_random_chunks(void)
+{
+    static unsigned char data[RANDOM_MAX_LEN];
+    static unsigned char expect[BASE64_ENCODE_SIZE(RANDOM_MAX_LEN)];
+    /* room for a line break after every character */
+    static unsigned char encoded[BASE64_ENCODE_SIZE(RANDOM_MAX_LEN) * 2];
+    static unsigned char decoded[RANDOM_MAX_LEN + 4];
+
+    for (unsigned round = 0; round < 200; round++) {
+        size_t len = 1 + _rand() % RANDOM_MAX_LEN;
+        for (size_t i = 0; i < len; i++) {
+            data[i] = _rand();
+        }
+        size_t expect_len = _reference_encode(data, len, expect);
+
+        /* encode in chunks of random size */
+        base64_encode_ctx_t enc;
+        size_t pos = 0, out = 0;
+        base64_encode_init(&enc);
+        while (pos < len) {
+            size_t chunk = 1 + _rand() % (len - pos);
+            out += base64_encode_update(&enc, data + pos, chunk, encoded + out);
+            pos += chunk;
+        }
+        out += base64_encode_finish(&enc, encoded + out);
+        TEST_ASSERT_EQUAL_INT(expect_len, out);
+        TEST_ASSERT(memcmp(expect, encoded, out) == 0);
+
+        /* break lines at a random width, as in PEM files */
+        size_t width = 1 + _rand() % 80;
+        size_t wrapped = 0;
+        for (size_t i = 0; i < expect_len; i++) {
+            encoded[wrapped++] = expect[i];
+            if ((i % width) == width - 1) {
+                encoded[wrapped++] = '\n';
+            }
+        }
+
+        /* decode in chunks of random size */
+        base64_decode_ctx_t dec;
+        pos = 0;
+        out = 0;
+        base64_decode_init(&dec);
+        while (pos < wrapped) {
+            size_t chunk = 1 + _rand() % (wrapped - pos);
+            out += base64_decode_update(&dec, encoded + pos, chunk, decoded + out);
+            pos += chunk;
+        }
+        out += base64_decode_finish(&dec, decoded + out);
+        TEST_ASSERT_EQUAL_INT(len, out);
+        TEST_ASSERT(memcmp(data, decoded, len) == 0);
+    }
+}
+
 Test *tests_base64_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -311,6 +459,9 @@ Test *tests_base64_tests(void)
         new_TestFixture(test_base64_05_decode_larger),
         new_TestFixture(test_base64_06_stream_encode),
         new_TestFixture(test_base64_07_stream_decode),
+        new_TestFixture(test_base64_08_rfc4648_vectors),
+        new_TestFixture(test_base64_09_random_roundtrip),
+        new_TestFixture(test_base64_10_random_chunks),
     };
 
     EMB_UNIT_TESTCALLER(base64_tests, NULL, NULL, fixtures);
@@ -116,6 +116,21 @@ static void test_bf_get_unset_lastbyte(void)
     TEST_ASSERT_EQUAL_INT(39, res);
 }
 
+static void test_bf_get_unset_partial(void)
+{
+    int res = 0;
+    uint8_t field[2] = { 0xff, 0x07 };
+
+    /* the unset bits 11 to 15 are beyond the field */
+    res = bf_get_unset(field, 11);
+    TEST_ASSERT_EQUAL_INT(-1, res);
+    TEST_ASSERT_EQUAL_INT(0x07, field[1]);
+
+    res = bf_get_unset(field, 12);
+    TEST_ASSERT_EQUAL_INT(11, res);
+    TEST_ASSERT_EQUAL_INT(0x0f, field[1]);
+}
+
 Test *tests_bitfield_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -123,6 +138,7 @@ Test *tests_bitfield_tests(void)
         new_TestFixture(test_bf_get_unset_firstbyte),
         new_TestFixture(test_bf_get_unset_middle),
         new_TestFixture(test_bf_get_unset_lastbyte),
+        new_TestFixture(test_bf_get_unset_partial),
     };
 
     EMB_UNIT_TESTCALLER(bitfield_tests, NULL, NULL, fixtures);
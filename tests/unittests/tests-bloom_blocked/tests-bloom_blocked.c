@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "bloom_blocked.h"
+#include "tests-bloom_blocked.h"
+
+#define TESTS_BLOOM_SIZE    (16 * BLOOM_BLOCKED_BLOCK_SIZE)
+#define TESTS_BLOOM_K       (6)
+#define TESTS_BLOOM_KEYS    (256)
+#define TESTS_BLOOM_PROBES  (4096)
+
+static uint8_t buf[TESTS_BLOOM_SIZE];
+static bloom_blocked_t bloom;
+static bloom_counting_t counting;
+
+static uint64_t key_hash(uint32_t set, uint32_t i)
+{
+    uint32_t key[3] = { set, i, 0x12345678 };
+    return bloom_blocked_hash(key, sizeof(key));
+}
+
+static void test_bloom_blocked_hash(void)
+{
+    const char *a = "osteopathic";
+    const char *b = "osteopathia";
+
+    TEST_ASSERT(bloom_blocked_hash(a, strlen(a)) ==
+                bloom_blocked_hash(a, strlen(a)));
+    TEST_ASSERT(bloom_blocked_hash(a, strlen(a)) !=
+                bloom_blocked_hash(b, strlen(b)));
+    /* the length is part of the hash, also for the unaligned tail */
+    TEST_ASSERT(bloom_blocked_hash(a, 5) != bloom_blocked_hash(a, 6));
+    TEST_ASSERT(bloom_blocked_hash(a, 0) != bloom_blocked_hash(a, 1));
+}
+
+static void test_bloom_blocked_no_false_negatives(void)
+{
+    unsigned in = 0;
+
+    bloom_blocked_init(&bloom, buf, sizeof(buf), TESTS_BLOOM_K);
+    for (uint32_t i = 0; i < TESTS_BLOOM_KEYS; i++) {
+        bloom_blocked_add_hash(&bloom, key_hash(1, i));
+    }
+    for (uint32_t i = 0; i < TESTS_BLOOM_KEYS; i++) {
+        TEST_ASSERT(bloom_blocked_check_hash(&bloom, key_hash(1, i)));
+    }
+
+    /* 16 bits per key, about 0.2 % expected */
+    for (uint32_t i = 0; i < TESTS_BLOOM_PROBES; i++) {
+        in += bloom_blocked_check_hash(&bloom, key_hash(2, i));
+    }
+    TEST_ASSERT(in < TESTS_BLOOM_PROBES / 100);
+
+    bloom_blocked_clear(&bloom);
+    for (uint32_t i = 0; i < TESTS_BLOOM_KEYS; i++) {
+        TEST_ASSERT(!bloom_blocked_check_hash(&bloom, key_hash(1, i)));
+    }
+}
+
+static void test_bloom_blocked_bytes(void)
+{
+    const char *key = "trustworthiness";
+
+    bloom_blocked_init(&bloom, buf, BLOOM_BLOCKED_BLOCK_SIZE, 1);
+    TEST_ASSERT(!bloom_blocked_check(&bloom, key, strlen(key)));
+    bloom_blocked_add(&bloom, key, strlen(key));
+    TEST_ASSERT(bloom_blocked_check(&bloom, key, strlen(key)));
+}
+
+static void test_bloom_counting_remove(void)
+{
+    unsigned in = 0;
+
+    bloom_counting_init(&counting, buf, sizeof(buf), TESTS_BLOOM_K);
+    for (uint32_t i = 0; i < TESTS_BLOOM_KEYS; i++) {
+        bloom_counting_add_hash(&counting, key_hash(1, i));
+    }
+    for (uint32_t i = 0; i < TESTS_BLOOM_KEYS; i += 2) {
+        bloom_counting_remove_hash(&counting, key_hash(1, i));
+    }
+
+    for (uint32_t i = 1; i < TESTS_BLOOM_KEYS; i += 2) {
+        TEST_ASSERT(bloom_counting_check_hash(&counting, key_hash(1, i)));
+    }
+    for (uint32_t i = 0; i < TESTS_BLOOM_KEYS; i += 2) {
+        in += bloom_counting_check_hash(&counting, key_hash(1, i));
+    }
+    TEST_ASSERT(in < TESTS_BLOOM_KEYS / 20);
+
+    for (uint32_t i = 1; i < TESTS_BLOOM_KEYS; i += 2) {
+        bloom_counting_remove_hash(&counting, key_hash(1, i));
+    }
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        TEST_ASSERT_EQUAL_INT(0, buf[i]);
+    }
+}
+
+static void test_bloom_counting_saturation(void)
+{
+    const char *key = "osteopathic";
+
+    bloom_counting_init(&counting, buf, BLOOM_BLOCKED_BLOCK_SIZE, 4);
+    for (unsigned i = 0; i < 3; i++) {
+        bloom_counting_add(&counting, key, strlen(key));
+    }
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT(bloom_counting_check(&counting, key, strlen(key)));
+        bloom_counting_remove(&counting, key, strlen(key));
+    }
+    TEST_ASSERT(!bloom_counting_check(&counting, key, strlen(key)));
+
+    /* saturated counters stay, as they do not know their keys anymore */
+    for (unsigned i = 0; i < 20; i++) {
+        bloom_counting_add(&counting, key, strlen(key));
+    }
+    for (unsigned i = 0; i < 20; i++) {
+        bloom_counting_remove(&counting, key, strlen(key));
+    }
+    TEST_ASSERT(bloom_counting_check(&counting, key, strlen(key)));
+
+    bloom_counting_clear(&counting);
+    TEST_ASSERT(!bloom_counting_check(&counting, key, strlen(key)));
+}
+
+Test *tests_bloom_blocked_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_bloom_blocked_hash),
+        new_TestFixture(test_bloom_blocked_no_false_negatives),
+        new_TestFixture(test_bloom_blocked_bytes),
+        new_TestFixture(test_bloom_counting_remove),
+        new_TestFixture(test_bloom_counting_saturation),
+    };
+
+    EMB_UNIT_TESTCALLER(bloom_blocked_tests, NULL, NULL, fixtures);
+
+    return (Test *)&bloom_blocked_tests;
+}
+
+void tests_bloom_blocked(void)
+{
+    TESTS_RUN(tests_bloom_blocked_tests());
+}
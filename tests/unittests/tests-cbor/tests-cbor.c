@@ -18,6 +18,7 @@
 #include "bitarithm.h"
 #include "cbor.h"
 
+#include <errno.h>
 #include <float.h>
 #include <math.h>
 #include <stdio.h>
@@ -687,6 +688,261 @@ static void test_double_invalid(void)
 }
 #endif /* CBOR_NO_FLOAT */
 
+static void test_cursor(void)
+{
+    /* {0: "abc", 1: h'0102', 2: [1, -2, true], 3: [_ null, 4], 4: 1(5)} */
+    TEST_ASSERT(cbor_serialize_map(&stream, 5));
+    TEST_ASSERT(cbor_serialize_int(&stream, 0));
+    TEST_ASSERT(cbor_serialize_unicode_string(&stream, "abc"));
+    TEST_ASSERT(cbor_serialize_int(&stream, 1));
+    TEST_ASSERT(cbor_serialize_byte_stringl(&stream, "\x01\x02", 2));
+    TEST_ASSERT(cbor_serialize_int(&stream, 2));
+    TEST_ASSERT(cbor_serialize_array(&stream, 3));
+    TEST_ASSERT(cbor_serialize_int(&stream, 1));
+    TEST_ASSERT(cbor_serialize_int(&stream, -2));
+    TEST_ASSERT(cbor_serialize_bool(&stream, true));
+    TEST_ASSERT(cbor_serialize_int(&stream, 3));
+    TEST_ASSERT(cbor_serialize_array_indefinite(&stream));
+    stream.data[stream.pos++] = 0xf6; /* null */
+    TEST_ASSERT(cbor_serialize_int(&stream, 4));
+    TEST_ASSERT(cbor_write_break(&stream));
+    TEST_ASSERT(cbor_serialize_int(&stream, 4));
+    stream.data[stream.pos++] = 0xc1; /* tag 1 */
+    TEST_ASSERT(cbor_serialize_int(&stream, 5));
+
+    cbor_cursor_t doc, map, inner;
+    cbor_cursor_init_stream(&doc, &stream, 0);
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_MAP, cbor_cursor_peek(&doc));
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_enter(&doc, &map));
+
+    int key;
+    const char *str;
+    const uint8_t *bytes;
+    size_t len;
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_int(&map, &key));
+    TEST_ASSERT_EQUAL_INT(0, key);
+    /* wrong type does not advance the cursor */
+    TEST_ASSERT_EQUAL_INT(-EINVAL, cbor_get_bytes(&map, &bytes, &len));
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_text(&map, &str, &len));
+    TEST_ASSERT_EQUAL_INT(3, len);
+    TEST_ASSERT(memcmp(str, "abc", 3) == 0);
+    /* zero-copy: the view points into the stream */
+    TEST_ASSERT(str > (char *)stream.data && str < (char *)stream.data + stream.pos);
+
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_int(&map, &key));
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_bytes(&map, &bytes, &len));
+    TEST_ASSERT_EQUAL_INT(2, len);
+    TEST_ASSERT_EQUAL_INT(2, bytes[1]);
+
+    /* enter the array, only read its first element */
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_int(&map, &key));
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_enter(&map, &inner));
+    uint64_t u;
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_uint(&inner, &u));
+    TEST_ASSERT_EQUAL_INT(1, u);
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_NEGINT, cbor_cursor_peek(&inner));
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_leave(&map, &inner));
+
+    /* walk the indefinite array completely */
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_int(&map, &key));
+    TEST_ASSERT_EQUAL_INT(3, key);
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_enter(&map, &inner));
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_null(&inner));
+    int64_t i64;
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_int64(&inner, &i64));
+    TEST_ASSERT_EQUAL_INT(4, i64);
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_END, cbor_cursor_peek(&inner));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, cbor_cursor_skip(&inner));
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_leave(&map, &inner));
+
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_int(&map, &key));
+    TEST_ASSERT_EQUAL_INT(4, key);
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_tag(&map, &u));
+    TEST_ASSERT_EQUAL_INT(1, u);
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_int(&map, &key));
+    TEST_ASSERT_EQUAL_INT(5, key);
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_END, cbor_cursor_peek(&map));
+
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_leave(&doc, &map));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_END, cbor_cursor_peek(&doc));
+    TEST_ASSERT(doc.pos == stream.data + stream.pos);
+}
+
+static void test_cursor_skip(void)
+{
+    /* [[1, [2, h'00']], {_ 1: [_ 2], 3: "x"}, 1(2)], 7 */
+    static const uint8_t data[] = {
+        0x83, 0x82, 0x01, 0x82, 0x02, 0x41, 0x00,
+        0xbf, 0x01, 0x9f, 0x02, 0xff, 0x03, 0x61, 0x78, 0xff,
+        0xc1, 0x02,
+        0x07
+    };
+
+    cbor_cursor_t doc;
+    cbor_cursor_init(&doc, data, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_skip(&doc));
+    TEST_ASSERT_EQUAL_INT(sizeof(data) - 1, doc.pos - data);
+    uint64_t u;
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_uint(&doc, &u));
+    TEST_ASSERT_EQUAL_INT(7, u);
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_END, cbor_cursor_peek(&doc));
+
+    /* leaving a container without touching it skips it */
+    cbor_cursor_t outer;
+    cbor_cursor_init(&doc, data, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_enter(&doc, &outer));
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_leave(&doc, &outer));
+    TEST_ASSERT_EQUAL_INT(sizeof(data) - 1, doc.pos - data);
+}
+
+static void test_cursor_invalid(void)
+{
+    cbor_cursor_t doc, inner;
+    uint64_t u;
+    int64_t i64;
+    const uint8_t *bytes;
+    size_t len;
+
+    /* truncated string */
+    static const uint8_t trunc_str[] = { 0x43, 0x01, 0x02 };
+    cbor_cursor_init(&doc, trunc_str, sizeof(trunc_str));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_get_bytes(&doc, &bytes, &len));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_cursor_skip(&doc));
+
+    /* truncated integer */
+    static const uint8_t trunc_int[] = { 0x19, 0x01 };
+    cbor_cursor_init(&doc, trunc_int, sizeof(trunc_int));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_get_uint(&doc, &u));
+
+    /* array claiming more items than there are bytes */
+    static const uint8_t huge_array[] = { 0x9b, 0xff, 0xff, 0xff, 0xff,
+                                          0xff, 0xff, 0xff, 0xff, 0x01 };
+    cbor_cursor_init(&doc, huge_array, sizeof(huge_array));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_cursor_enter(&doc, &inner));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_cursor_skip(&doc));
+
+    /* break outside of an indefinite length item */
+    static const uint8_t stray_break[] = { 0x82, 0x01, 0xff };
+    cbor_cursor_init(&doc, stray_break, sizeof(stray_break));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_cursor_skip(&doc));
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_enter(&doc, &inner));
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_uint(&inner, &u));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_INVALID, cbor_cursor_peek(&inner));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_cursor_leave(&doc, &inner));
+
+    /* indefinite arrays nested deeper than CBOR_CURSOR_MAX_NESTING */
+    uint8_t deep[2 * CBOR_CURSOR_MAX_NESTING + 4];
+    memset(deep, 0x9f, sizeof(deep) / 2);
+    memset(deep + sizeof(deep) / 2, 0xff, sizeof(deep) / 2);
+    cbor_cursor_init(&doc, deep, sizeof(deep));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_cursor_skip(&doc));
+
+    /* value out of range */
+    static const uint8_t big_negint[] = { 0x3b, 0x80, 0x00, 0x00, 0x00,
+                                          0x00, 0x00, 0x00, 0x00 };
+    cbor_cursor_init(&doc, big_negint, sizeof(big_negint));
+    TEST_ASSERT_EQUAL_INT(-ERANGE, cbor_get_int64(&doc, &i64));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, cbor_get_uint(&doc, &u));
+}
+
+static int _chunk_cb(void *arg, const uint8_t *data, size_t len)
+{
+    cbor_stream_t *s = arg;
+
+    /* record the chunk boundaries in the length of the largest chunk */
+    if (len > s->size) {
+        s->size = len;
+    }
+
+    memcpy(&s->data[s->pos], data, len);
+    s->pos += len;
+    return 0;
+}
+
+static void test_writer(void)
+{
+    cbor_writer_t writer;
+
+    /* same encoding as the offset based serializer */
+    cbor_writer_init_stream(&writer, &stream);
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_map(&writer, 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_int(&writer, -500));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_text(&writer, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_uint(&writer, 0x100000000ull));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_array_indefinite(&writer));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_bool(&writer, false));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_tag(&writer, 1));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_bytes(&writer, "\x00\x01", 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_break(&writer));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_finish(&writer));
+
+    unsigned char data[] = {
+        0xa2, 0x39, 0x01, 0xf3, 0x63, 0x61, 0x62, 0x63,
+        0x1b, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        0x9f, 0xf4, 0xc1, 0x42, 0x00, 0x01, 0xff
+    };
+    TEST_ASSERT_EQUAL_INT(sizeof(data), writer.len);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), stream.pos);
+    CBOR_CHECK_SERIALIZED(stream, data, sizeof(data));
+
+    /* round trip through the cursor */
+    cbor_cursor_t doc, map;
+    int64_t i64;
+    cbor_cursor_init_stream(&doc, &stream, 0);
+    TEST_ASSERT_EQUAL_INT(0, cbor_cursor_enter(&doc, &map));
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_int64(&map, &i64));
+    TEST_ASSERT_EQUAL_INT(-500, i64);
+
+    /* strings larger than the staging buffer are passed on directly */
+    static unsigned char big[3 * CBOR_WRITER_BUFSIZE];
+    static char payload[2 * CBOR_WRITER_BUFSIZE];
+    memset(payload, 'x', sizeof(payload));
+    cbor_stream_t chunks = { big, 0, 0 };
+    cbor_writer_init(&writer, _chunk_cb, &chunks);
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_uint(&writer, 1));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_text(&writer, payload, sizeof(payload)));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_uint(&writer, 2));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_finish(&writer));
+    TEST_ASSERT_EQUAL_INT(sizeof(payload), chunks.size);
+    TEST_ASSERT_EQUAL_INT(1 + 2 + sizeof(payload) + 1, chunks.pos);
+    TEST_ASSERT_EQUAL_INT(writer.len, chunks.pos);
+
+    /* errors are sticky */
+    unsigned char small[4];
+    cbor_stream_t small_stream;
+    cbor_init(&small_stream, small, sizeof(small));
+    cbor_writer_init_stream(&writer, &small_stream);
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_text(&writer, "abcdef", 6));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_flush(&writer));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_put_null(&writer));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_finish(&writer));
+}
+
+#ifndef CBOR_NO_FLOAT
+static void test_cursor_float(void)
+{
+    cbor_writer_t writer;
+    cbor_writer_init_stream(&writer, &stream);
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_float(&writer, 1.5f));
+    TEST_ASSERT_EQUAL_INT(0, cbor_put_double(&writer, -2.25));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_finish(&writer));
+    TEST_ASSERT(cbor_serialize_float_half(&stream, 0.5f));
+
+    cbor_cursor_t doc;
+    float f;
+    double d;
+    cbor_cursor_init_stream(&doc, &stream, 0);
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_FLOAT, cbor_cursor_peek(&doc));
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_float(&doc, &f));
+    TEST_ASSERT(EQUAL_FLOAT(1.5f, f));
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_double(&doc, &d));
+    TEST_ASSERT(d == -2.25);
+    TEST_ASSERT_EQUAL_INT(0, cbor_get_double(&doc, &d));
+    TEST_ASSERT(d == 0.5);
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_END, cbor_cursor_peek(&doc));
+}
+#endif /* CBOR_NO_FLOAT */
+
 #ifndef CBOR_NO_PRINT
 /**
  * Manual test for testing the cbor_stream_decode function
@@ -786,7 +1042,12 @@ TestRef tests_cbor_all(void)
                         new_TestFixture(test_float_invalid),
                         new_TestFixture(test_double),
                         new_TestFixture(test_double_invalid),
+                        new_TestFixture(test_cursor_float),
 #endif /* CBOR_NO_FLOAT */
+                        new_TestFixture(test_cursor),
+                        new_TestFixture(test_cursor_skip),
+                        new_TestFixture(test_cursor_invalid),
+                        new_TestFixture(test_writer),
     };
 
     EMB_UNIT_TESTCALLER(CborTest, setUp, tearDown, fixtures);
@@ -7,6 +7,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "embUnit/embUnit.h"
 
@@ -88,6 +89,21 @@ static void test_checksum_crc16_ccitt_sequence_4bytes(void)
                 sizeof(buf) / 2, expect));
 }
 
+static void test_checksum_crc16_ccitt_sequence_unaligned(void)
+{
+    /* "123456789" at every alignment, split at every position */
+    unsigned char buf[20];
+    uint16_t expect = 0xE5CC;
+
+    for (unsigned shift = 0; shift < 8; shift++) {
+        memcpy(buf + shift, "123456789", 9);
+        for (unsigned split = 0; split <= 9; split++) {
+            TEST_ASSERT(calc_and_compare_crc_with_update(buf + shift, 9, split,
+                                                         expect));
+        }
+    }
+}
+
 Test *tests_checksum_crc16_ccitt_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -98,6 +114,7 @@ Test *tests_checksum_crc16_ccitt_tests(void)
         new_TestFixture(test_checksum_crc16_ccitt_sequence_256a),
         new_TestFixture(test_checksum_crc16_ccitt_sequence_1to9),
         new_TestFixture(test_checksum_crc16_ccitt_sequence_4bytes),
+        new_TestFixture(test_checksum_crc16_ccitt_sequence_unaligned),
     };
 
     EMB_UNIT_TESTCALLER(checksum_crc16_ccitt_tests, NULL, NULL, fixtures);
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "checksum/crc32.h"
+
+#include "tests-checksum.h"
+
+typedef uint32_t (*crc32_update_t)(uint32_t crc, const unsigned char *buf,
+                                   size_t len);
+
+/* checks the whole buffer at once, at every split point and at every
+ * alignment, to exercise the sliced and the byte wise loops */
+static int calc_and_compare_crc(crc32_update_t update,
+                                const unsigned char *buf, size_t len,
+                                uint32_t expected)
+{
+    static unsigned char shifted[300];
+
+    if (update(0, buf, len) != expected) {
+        return 0;
+    }
+    for (size_t split = 0; split <= len; split++) {
+        if (update(update(0, buf, split), buf + split, len - split) != expected) {
+            return 0;
+        }
+    }
+    for (size_t shift = 1; shift < 8; shift++) {
+        memcpy(shifted + shift, buf, len);
+        if (update(0, shifted + shift, len) != expected) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void test_checksum_crc32_ieee_empty(void)
+{
+    unsigned char buf[] = "";
+
+    TEST_ASSERT(calc_and_compare_crc(crc32_ieee_update, buf, 0, 0));
+}
+
+static void test_checksum_crc32_ieee_1to9(void)
+{
+    unsigned char buf[] = "123456789";
+
+    TEST_ASSERT(calc_and_compare_crc(crc32_ieee_update, buf, sizeof(buf) - 1,
+                                     0xCBF43926));
+}
+
+static void test_checksum_crc32_ieee_fox(void)
+{
+    unsigned char buf[] = "The quick brown fox jumps over the lazy dog";
+
+    TEST_ASSERT(calc_and_compare_crc(crc32_ieee_update, buf, sizeof(buf) - 1,
+                                     0x414FA339));
+}
+
+static void test_checksum_crc32_ieee_256a(void)
+{
+    unsigned char buf[256];
+
+    memset(buf, 'A', sizeof(buf));
+    TEST_ASSERT(calc_and_compare_crc(crc32_ieee_update, buf, sizeof(buf),
+                                     0x49975B13));
+}
+
+static void test_checksum_crc32c_empty(void)
+{
+    unsigned char buf[] = "";
+
+    TEST_ASSERT(calc_and_compare_crc(crc32c_update, buf, 0, 0));
+}
+
+static void test_checksum_crc32c_1to9(void)
+{
+    unsigned char buf[] = "123456789";
+
+    TEST_ASSERT(calc_and_compare_crc(crc32c_update, buf, sizeof(buf) - 1,
+                                     0xE3069283));
+}
+
+static void test_checksum_crc32c_iscsi(void)
+{
+    unsigned char buf[32];
+
+    memset(buf, 0, sizeof(buf));
+    TEST_ASSERT(calc_and_compare_crc(crc32c_update, buf, sizeof(buf),
+                                     0x8A9136AA));
+    memset(buf, 0xff, sizeof(buf));
+    TEST_ASSERT(calc_and_compare_crc(crc32c_update, buf, sizeof(buf),
+                                     0x62A8AB43));
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = i;
+    }
+    TEST_ASSERT(calc_and_compare_crc(crc32c_update, buf, sizeof(buf),
+                                     0x46DD794E));
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = 31 - i;
+    }
+    TEST_ASSERT(calc_and_compare_crc(crc32c_update, buf, sizeof(buf),
+                                     0x113FDB5C));
+}
+
+Test *tests_checksum_crc32_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        /* Check values according to the catalogue of parametrised CRC
+         * algorithms, http://reveng.sourceforge.net/crc-catalogue/ and
+         * test vectors of RFC 3720, B.4 */
+        new_TestFixture(test_checksum_crc32_ieee_empty),
+        new_TestFixture(test_checksum_crc32_ieee_1to9),
+        new_TestFixture(test_checksum_crc32_ieee_fox),
+        new_TestFixture(test_checksum_crc32_ieee_256a),
+        new_TestFixture(test_checksum_crc32c_empty),
+        new_TestFixture(test_checksum_crc32c_1to9),
+        new_TestFixture(test_checksum_crc32c_iscsi),
+    };
+
+    EMB_UNIT_TESTCALLER(checksum_crc32_tests, NULL, NULL, fixtures);
+
+    return (Test *)&checksum_crc32_tests;
+}
@@ -59,12 +59,25 @@ static void test_checksum_fletcher16_atoe(void)
     TEST_ASSERT(calc_and_compare_checksum(buf, sizeof(buf) - 1, expect));
 }
 
+static void test_checksum_fletcher16_long(void)
+{
+    /* longer than the blocks summed up between two reductions */
+    static unsigned char buf[6000];
+    uint16_t expect = 0x777f;
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = i * 7 + 3;
+    }
+    TEST_ASSERT(calc_and_compare_checksum(buf, sizeof(buf), expect));
+}
+
 Test *tests_checksum_fletcher16_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_checksum_fletcher16_empty),
         new_TestFixture(test_checksum_fletcher16_0to1_undetected),
         new_TestFixture(test_checksum_fletcher16_atoe),
+        new_TestFixture(test_checksum_fletcher16_long),
     };
 
     EMB_UNIT_TESTCALLER(checksum_fletcher16_tests, NULL, NULL, fixtures);
@@ -211,6 +211,31 @@ static void test_bitarithm_bits_set_random(void)
                                                         dice roll ;-) */
 }
 
+static void test_bitarithm_soft(void)
+{
+    /* every single bit and pair of bits, plus a pseudo random walk */
+    unsigned bits = sizeof(unsigned) * 8;
+    unsigned v = 1;
+
+    for (unsigned i = 0; i < bits; i++) {
+        for (unsigned j = 0; j <= i; j++) {
+            unsigned x = (1u << i) | (1u << j);
+            TEST_ASSERT_EQUAL_INT(i, bitarithm_msb_soft(x));
+            TEST_ASSERT_EQUAL_INT(j, bitarithm_lsb_soft(x));
+            TEST_ASSERT_EQUAL_INT((i == j) ? 1 : 2, bitarithm_bits_set_soft(x));
+        }
+    }
+    for (unsigned i = 0; i < 10000; i++) {
+        v = v * 1103515245u + 12345u;
+        if (v == 0) {
+            continue;
+        }
+        TEST_ASSERT_EQUAL_INT(bitarithm_msb(v), bitarithm_msb_soft(v));
+        TEST_ASSERT_EQUAL_INT(bitarithm_lsb(v), bitarithm_lsb_soft(v));
+        TEST_ASSERT_EQUAL_INT(__builtin_popcount(v), bitarithm_bits_set_soft(v));
+    }
+}
+
 Test *tests_core_bitarithm_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -244,6 +269,8 @@ Test *tests_core_bitarithm_tests(void)
         new_TestFixture(test_bitarithm_bits_set_one),
         new_TestFixture(test_bitarithm_bits_set_limit),
         new_TestFixture(test_bitarithm_bits_set_random),
+
+        new_TestFixture(test_bitarithm_soft),
     };
 
     EMB_UNIT_TESTCALLER(core_bitarithm_tests, NULL, NULL, fixtures);
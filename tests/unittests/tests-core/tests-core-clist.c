@@ -76,6 +76,33 @@ static void test_clist_remove_two(void)
     TEST_ASSERT_NULL(list->next);
 }
 
+static void test_clist_remove(void)
+{
+    list_node_t *list = &test_clist;
+    list->next = NULL;
+
+    for (int i = 0; i < 3; i++) {
+        clist_insert(list, &tests_clist_buf[i]);
+    }
+
+    /* remove tail */
+    TEST_ASSERT(clist_remove(list, &tests_clist_buf[2]) == &tests_clist_buf[2]);
+    TEST_ASSERT(list->next == &tests_clist_buf[1]);
+    TEST_ASSERT(list->next->next == &tests_clist_buf[0]);
+
+    /* node not in list */
+    TEST_ASSERT_NULL(clist_remove(list, &tests_clist_buf[2]));
+
+    /* remove head */
+    TEST_ASSERT(clist_remove(list, &tests_clist_buf[0]) == &tests_clist_buf[0]);
+    TEST_ASSERT(list->next == &tests_clist_buf[1]);
+    TEST_ASSERT(list->next->next == &tests_clist_buf[1]);
+
+    /* remove last element */
+    TEST_ASSERT(clist_remove(list, &tests_clist_buf[1]) == &tests_clist_buf[1]);
+    TEST_ASSERT_NULL(list->next);
+}
+
 static void test_clist_advance(void)
 {
     list_node_t *list = &test_clist;
@@ -99,6 +126,7 @@ Test *tests_core_clist_tests(void)
         new_TestFixture(test_clist_add_two),
         new_TestFixture(test_clist_remove_head),
         new_TestFixture(test_clist_remove_two),
+        new_TestFixture(test_clist_remove),
         new_TestFixture(test_clist_advance),
     };
 
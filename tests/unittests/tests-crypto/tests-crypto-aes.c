@@ -83,11 +83,44 @@ static void test_crypto_aes_decrypt(void)
     TEST_ASSERT_MESSAGE(1 == compare(TEST_1_INP, data, AES_BLOCK_SIZE), "wrong plaintext");
 }
 
+static void test_crypto_aes_blocks(void)
+{
+    cipher_context_t ctx;
+    int err;
+    uint8_t plain[37 * AES_BLOCK_SIZE], data[sizeof(plain)];
+
+    for (unsigned i = 0; i < sizeof(plain); i++) {
+        plain[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    err = aes_init(&ctx, TEST_1_KEY, AES_KEY_SIZE);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    /* multi-block encryption must match block by block encryption */
+    err = aes_encrypt_blocks(&ctx, plain, data, sizeof(plain) / AES_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    for (unsigned i = 0; i < sizeof(plain); i += AES_BLOCK_SIZE) {
+        uint8_t block[AES_BLOCK_SIZE];
+
+        err = aes_encrypt(&ctx, plain + i, block);
+        TEST_ASSERT_EQUAL_INT(1, err);
+        TEST_ASSERT_MESSAGE(1 == compare(block, data + i, AES_BLOCK_SIZE), "wrong ciphertext");
+    }
+
+    /* in-place decryption */
+    err = aes_decrypt_blocks(&ctx, data, data, sizeof(data) / AES_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL_INT(1, err);
+    for (unsigned i = 0; i < sizeof(plain); i += AES_BLOCK_SIZE) {
+        TEST_ASSERT_MESSAGE(1 == compare(plain + i, data + i, AES_BLOCK_SIZE), "wrong plaintext");
+    }
+}
+
 Test* tests_crypto_aes_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_aes_encrypt),
                         new_TestFixture(test_crypto_aes_decrypt),
+                        new_TestFixture(test_crypto_aes_blocks),
     };
 
     EMB_UNIT_TESTCALLER(crypto_aes_tests, NULL, NULL, fixtures);
@@ -130,12 +130,58 @@ static void test_crypto_chacha20_tc8(void)
                         TC8_CHACHA20_BLOCK0, TC8_CHACHA20_BLOCK1);
 }
 
+static void test_crypto_chacha_blocks(void)
+{
+    static uint8_t bulk[9 * 64], single[9 * 64];
+    chacha_ctx ctx, ref;
+
+    for (unsigned n = 1; n <= 9; n++) {
+        chacha_init(&ctx, 20, TC8_KEY, 16, TC8_IV);
+        /* the block counter overflows into the upper word within the batch */
+        ctx.state[12] = 0xfffffffe;
+        ref = ctx;
+
+        chacha_keystream_blocks(&ctx, bulk, n);
+        for (unsigned i = 0; i < n; i++) {
+            chacha_keystream_bytes(&ref, single + 64 * i);
+        }
+        TEST_ASSERT_EQUAL_INT(0, memcmp(bulk, single, 64 * n));
+        TEST_ASSERT_EQUAL_INT(0, memcmp(ctx.state, ref.state, 64));
+    }
+}
+
+static void test_crypto_chacha_encrypt_bytes_n(void)
+{
+    static uint8_t data[300], enc[300];
+    chacha_ctx ctx;
+
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)i;
+    }
+
+    chacha_init(&ctx, 8, TC8_KEY, 16, TC8_IV);
+    chacha_encrypt_bytes_n(&ctx, data, enc, sizeof(data));
+    for (unsigned i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL_INT(data[i] ^ TC8_CHACHA8_BLOCK0[i], enc[i]);
+        TEST_ASSERT_EQUAL_INT(data[64 + i] ^ TC8_CHACHA8_BLOCK1[i], enc[64 + i]);
+    }
+    /* five blocks were used for 300 bytes */
+    TEST_ASSERT_EQUAL_INT(5, ctx.state[12]);
+
+    /* decrypting in place restores the input */
+    chacha_init(&ctx, 8, TC8_KEY, 16, TC8_IV);
+    chacha_encrypt_bytes_n(&ctx, enc, enc, sizeof(enc));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, enc, sizeof(data)));
+}
+
 Test *tests_crypto_chacha_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_chacha8_tc8),
         new_TestFixture(test_crypto_chacha12_tc8),
         new_TestFixture(test_crypto_chacha20_tc8),
+        new_TestFixture(test_crypto_chacha_blocks),
+        new_TestFixture(test_crypto_chacha_encrypt_bytes_n),
     };
     EMB_UNIT_TESTCALLER(crypto_chacha_tests, NULL, NULL, fixtures);
     return (Test *) &crypto_chacha_tests;
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "xtimer.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/cbc.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/ecb.h"
+#include "tests-crypto.h"
+
+/* size of a single message and number of messages per measurement */
+#define BENCH_LEN       (512U)
+#define BENCH_RUNS      (8U)
+/* CCM is limited to short messages, use a typical link layer frame size */
+#define BENCH_CCM_LEN   (112U)
+#define BENCH_CCM_RUNS  (BENCH_RUNS * BENCH_LEN / BENCH_CCM_LEN)
+#define BENCH_MAC_LEN   (8U)
+
+static uint8_t KEY[] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+static uint8_t NONCE[] = {
+    0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0,
+    0xa1, 0xa2, 0xa3, 0xa4, 0xa5
+};
+
+static uint8_t plain[BENCH_LEN];
+static uint8_t encrypted[BENCH_LEN + BENCH_MAC_LEN];
+static uint8_t decrypted[BENCH_LEN];
+static cipher_t cipher;
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < BENCH_LEN; i++) {
+        plain[i] = (uint8_t)i;
+    }
+    memset(encrypted, 0, sizeof(encrypted));
+    memset(decrypted, 0, sizeof(decrypted));
+    cipher_init(&cipher, CIPHER_AES_128, KEY, sizeof(KEY));
+}
+
+static void print_rate(const char *mode, const char *op, size_t bytes,
+                       uint32_t usec)
+{
+    /* bytes per microsecond equals MB/s, print with three decimals */
+    unsigned long kbps = (usec) ? (unsigned long)(((uint64_t)bytes * 1000) / usec) : 0;
+
+    printf("\n%-4s %s: %lu.%03lu MB/s", mode, op, kbps / 1000, kbps % 1000);
+}
+
+static void test_crypto_throughput_ecb(void)
+{
+    uint32_t start, enc, dec;
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        cipher_encrypt_ecb(&cipher, plain, BENCH_LEN, encrypted);
+    }
+    enc = xtimer_now() - start;
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        cipher_decrypt_ecb(&cipher, encrypted, BENCH_LEN, decrypted);
+    }
+    dec = xtimer_now() - start;
+
+    print_rate("ECB", "encrypt", BENCH_LEN * BENCH_RUNS, enc);
+    print_rate("ECB", "decrypt", BENCH_LEN * BENCH_RUNS, dec);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(plain, decrypted, BENCH_LEN));
+}
+
+static void test_crypto_throughput_cbc(void)
+{
+    uint32_t start, enc, dec;
+    uint8_t iv[16] = { 0 };
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        cipher_encrypt_cbc(&cipher, iv, plain, BENCH_LEN, encrypted);
+    }
+    enc = xtimer_now() - start;
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        cipher_decrypt_cbc(&cipher, iv, encrypted, BENCH_LEN, decrypted);
+    }
+    dec = xtimer_now() - start;
+
+    print_rate("CBC", "encrypt", BENCH_LEN * BENCH_RUNS, enc);
+    print_rate("CBC", "decrypt", BENCH_LEN * BENCH_RUNS, dec);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(plain, decrypted, BENCH_LEN));
+}
+
+static void test_crypto_throughput_ctr(void)
+{
+    uint32_t start, enc, dec;
+    uint8_t ctr[16];
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        memset(ctr, 0, sizeof(ctr));
+        cipher_encrypt_ctr(&cipher, ctr, 0, plain, BENCH_LEN, encrypted);
+    }
+    enc = xtimer_now() - start;
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        memset(ctr, 0, sizeof(ctr));
+        cipher_decrypt_ctr(&cipher, ctr, 0, encrypted, BENCH_LEN, decrypted);
+    }
+    dec = xtimer_now() - start;
+
+    print_rate("CTR", "encrypt", BENCH_LEN * BENCH_RUNS, enc);
+    print_rate("CTR", "decrypt", BENCH_LEN * BENCH_RUNS, dec);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(plain, decrypted, BENCH_LEN));
+}
+
+static void test_crypto_throughput_ccm(void)
+{
+    uint32_t start, enc, dec;
+    int len = 0;
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < BENCH_CCM_RUNS; i++) {
+        len = cipher_encrypt_ccm(&cipher, NULL, 0, BENCH_MAC_LEN, 2,
+                                 NONCE, sizeof(NONCE), plain, BENCH_CCM_LEN,
+                                 encrypted);
+    }
+    enc = xtimer_now() - start;
+    TEST_ASSERT_EQUAL_INT(BENCH_CCM_LEN + BENCH_MAC_LEN, len);
+
+    start = xtimer_now();
+    for (unsigned i = 0; i < BENCH_CCM_RUNS; i++) {
+        len = cipher_decrypt_ccm(&cipher, NULL, 0, BENCH_MAC_LEN, 2,
+                                 NONCE, sizeof(NONCE), encrypted,
+                                 BENCH_CCM_LEN + BENCH_MAC_LEN, decrypted);
+    }
+    dec = xtimer_now() - start;
+
+    print_rate("CCM", "encrypt", BENCH_CCM_LEN * BENCH_CCM_RUNS, enc);
+    print_rate("CCM", "decrypt", BENCH_CCM_LEN * BENCH_CCM_RUNS, dec);
+    TEST_ASSERT_EQUAL_INT(BENCH_CCM_LEN, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(plain, decrypted, BENCH_CCM_LEN));
+}
+
+Test* tests_crypto_throughput_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_throughput_ecb),
+        new_TestFixture(test_crypto_throughput_cbc),
+        new_TestFixture(test_crypto_throughput_ctr),
+        new_TestFixture(test_crypto_throughput_ccm),
+    };
+
+    EMB_UNIT_TESTCALLER(crypto_throughput_tests, set_up, NULL, fixtures);
+
+    return (Test*)&crypto_throughput_tests;
+}
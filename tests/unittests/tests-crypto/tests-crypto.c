@@ -20,4 +20,5 @@ void tests_crypto(void)
     TESTS_RUN(tests_crypto_modes_ecb_tests());
     TESTS_RUN(tests_crypto_modes_cbc_tests());
     TESTS_RUN(tests_crypto_modes_ctr_tests());
+    TESTS_RUN(tests_crypto_throughput_tests());
 }
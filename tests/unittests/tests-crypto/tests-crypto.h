@@ -60,6 +60,13 @@ Test* tests_crypto_modes_ecb_tests(void);
 Test* tests_crypto_modes_cbc_tests(void);
 Test* tests_crypto_modes_ctr_tests(void);
 
+/**
+ * @brief   Measures the throughput of the AES block cipher modes
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test* tests_crypto_throughput_tests(void);
+
 #ifdef __cplusplus
 }
 #endif
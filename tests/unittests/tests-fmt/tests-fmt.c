@@ -12,7 +12,9 @@
  * @file
  */
 #include <errno.h>
+#include <math.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "embUnit/embUnit.h"
 
@@ -90,6 +92,55 @@ static void test_fmt_u32_dec(void)
     TEST_ASSERT_EQUAL_STRING("12345678", (char *) out);
 }
 
+static void test_fmt_u32_dec_lengths(void)
+{
+    char out[11];
+    uint32_t val = 0;
+    const char *expect = "4294967295";
+
+    TEST_ASSERT_EQUAL_INT(1, fmt_u32_dec(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(10, fmt_u32_dec(NULL, UINT32_MAX));
+
+    /* 9, 99, 999, ... and 1, 10, 100, ... */
+    for (unsigned i = 1; i <= 9; i++) {
+        val = val * 10 + 9;
+        TEST_ASSERT_EQUAL_INT(i, fmt_u32_dec(out, val));
+        TEST_ASSERT_EQUAL_INT(i + 1, fmt_u32_dec(out, val + 1));
+        out[i + 1] = '\0';
+        TEST_ASSERT_EQUAL_INT('1', out[0]);
+        TEST_ASSERT_EQUAL_INT(i, strspn(out + 1, "0"));
+    }
+
+    out[fmt_u32_dec(out, UINT32_MAX)] = '\0';
+    TEST_ASSERT_EQUAL_STRING(expect, (char *)out);
+}
+
+static void test_fmt_u64_dec(void)
+{
+    char out[21];
+    size_t len;
+
+    len = fmt_u64_dec(out, 4294967295ULL);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(10, len);
+    TEST_ASSERT_EQUAL_STRING("4294967295", (char *)out);
+
+    len = fmt_u64_dec(out, 4294967296ULL);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(10, len);
+    TEST_ASSERT_EQUAL_STRING("4294967296", (char *)out);
+
+    len = fmt_u64_dec(out, 1000000000000000007ULL);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(19, len);
+    TEST_ASSERT_EQUAL_STRING("1000000000000000007", (char *)out);
+
+    len = fmt_u64_dec(out, UINT64_MAX);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(20, fmt_u64_dec(NULL, UINT64_MAX));
+    TEST_ASSERT_EQUAL_STRING("18446744073709551615", (char *)out);
+}
+
 static void test_fmt_u16_dec(void)
 {
     char out[5] = "----";
@@ -120,6 +171,17 @@ static void test_fmt_s32_dec(void)
     TEST_ASSERT_EQUAL_STRING("-9876", (char *) out);
 }
 
+static void test_fmt_s32_dec_min(void)
+{
+    char out[12];
+    size_t len;
+
+    len = fmt_s32_dec(out, INT32_MIN);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(11, len);
+    TEST_ASSERT_EQUAL_STRING("-2147483648", (char *)out);
+}
+
 static void test_rmt_s16_dec(void)
 {
     char out[7] = "-------";
@@ -209,6 +271,88 @@ static void test_rmt_s16_dfp(void)
     TEST_ASSERT_EQUAL_STRING("", (char *)out);
 }
 
+static void test_fmt_s16_dfp_len(void)
+{
+    char out[8];
+
+    /* the length must include the sign, also without an output buffer */
+    TEST_ASSERT_EQUAL_INT(fmt_s16_dfp(out, -23, 4), fmt_s16_dfp(NULL, -23, 4));
+    TEST_ASSERT_EQUAL_INT(7, fmt_s16_dfp(out, -32768, 2));
+    out[7] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-327.68", (char *)out);
+}
+
+static void test_fmt_s32_dfp(void)
+{
+    char out[13];
+    size_t len;
+
+    len = fmt_s32_dfp(out, 2147483647, 9);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(11, len);
+    TEST_ASSERT_EQUAL_STRING("2.147483647", (char *)out);
+
+    len = fmt_s32_dfp(out, -1, 9);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(12, len);
+    TEST_ASSERT_EQUAL_INT(12, fmt_s32_dfp(NULL, -1, 9));
+    TEST_ASSERT_EQUAL_STRING("-0.000000001", (char *)out);
+
+    len = fmt_s32_dfp(out, -123456789, 3);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(11, len);
+    TEST_ASSERT_EQUAL_STRING("-123456.789", (char *)out);
+
+    len = fmt_s32_dfp(out, INT32_MIN, 0);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-2147483648", (char *)out);
+
+    TEST_ASSERT_EQUAL_INT(0, fmt_s32_dfp(out, 1, 10));
+}
+
+static void test_fmt_float(void)
+{
+    char out[32];
+    size_t len;
+
+    len = fmt_float(out, 0.0f, 2);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("0.00", (char *)out);
+
+    len = fmt_float(out, -12.345f, 2);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(6, len);
+    TEST_ASSERT_EQUAL_STRING("-12.35", (char *)out);
+
+    len = fmt_float(out, 1.5f, 0);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("2", (char *)out);
+
+    /* rounding carries into the integer part */
+    len = fmt_float(out, 9.9999f, 3);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("10.000", (char *)out);
+
+    len = fmt_float(out, 0.0625f, 9);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("0.0625000", (char *)out);
+
+    len = fmt_float(out, 1e10f, 1);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("10000000000.0", (char *)out);
+
+    len = fmt_float(out, -1e30f, 1);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-inf", (char *)out);
+
+    len = fmt_float(out, NAN, 1);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("nan", (char *)out);
+
+    TEST_ASSERT_EQUAL_INT(fmt_float(out, -273.15f, 3),
+                          fmt_float(NULL, -273.15f, 3));
+}
+
 static void test_fmt_strlen(void)
 {
     const char *empty_str = "";
@@ -239,6 +383,91 @@ static void test_scn_u32_dec(void)
     TEST_ASSERT_EQUAL_INT(val2, scn_u32_dec(string1, 5));
 }
 
+static void test_scn_s32_dec(void)
+{
+    TEST_ASSERT_EQUAL_INT(-123, scn_s32_dec("-123", 4));
+    TEST_ASSERT_EQUAL_INT(123, scn_s32_dec("+123,", 5));
+    TEST_ASSERT_EQUAL_INT(-12, scn_s32_dec("-123", 3));
+    TEST_ASSERT_EQUAL_INT(INT32_MIN, scn_s32_dec("-2147483648", 11));
+    TEST_ASSERT_EQUAL_INT(0, scn_s32_dec("-", 1));
+}
+
+static void test_scn_u32_hex(void)
+{
+    TEST_ASSERT_EQUAL_INT(0xDEADBEEF, scn_u32_hex("DEADBEEF", 8));
+    TEST_ASSERT_EQUAL_INT(0xcafe, scn_u32_hex("cafeX", 5));
+    TEST_ASSERT_EQUAL_INT(0xca, scn_u32_hex("cafe", 2));
+    TEST_ASSERT_EQUAL_INT(0, scn_u32_hex("g", 1));
+}
+
+static void test_scn_s32_dfp(void)
+{
+    TEST_ASSERT_EQUAL_INT(-3548, scn_s32_dfp("-35.48", 6, 2));
+    TEST_ASSERT_EQUAL_INT(1210, scn_s32_dfp("12.1", 4, 2));
+    TEST_ASSERT_EQUAL_INT(700, scn_s32_dfp("7", 1, 2));
+    TEST_ASSERT_EQUAL_INT(1234, scn_s32_dfp("12.3456", 7, 2));
+    TEST_ASSERT_EQUAL_INT(12, scn_s32_dfp("12.34", 5, 0));
+    TEST_ASSERT_EQUAL_INT(50, scn_s32_dfp("0.5.1", 5, 2));
+    TEST_ASSERT_EQUAL_INT(-23, scn_s32_dfp("-0.0023", 7, 4));
+}
+
+static char _sink[128];
+static size_t _sink_len;
+static unsigned _sink_calls;
+
+static void _sink_write(const char *s, size_t n)
+{
+    memcpy(&_sink[_sink_len], s, n);
+    _sink_len += n;
+    _sink_calls++;
+}
+
+static void _writer_line(fmt_writer_t *w)
+{
+    fmt_writer_u32_dec(w, 123456);
+    fmt_writer_char(w, ',');
+    fmt_writer_s32_dfp(w, -2215, 2);
+    fmt_writer_char(w, ',');
+    fmt_writer_float(w, 45.5f, 1);
+    fmt_writer_char(w, ',');
+    fmt_writer_u32_hex(w, 0xBEEF);
+    fmt_writer_str(w, ",ok\n");
+}
+
+static void test_fmt_writer(void)
+{
+    const char *expect = "123456,-22.15,45.5,0000BEEF,ok\n";
+    char buf[64];
+    fmt_writer_t w;
+
+    /* all output goes out in one piece */
+    memset(_sink, 0, sizeof(_sink));
+    _sink_len = 0;
+    _sink_calls = 0;
+    fmt_writer_init(&w, buf, sizeof(buf), _sink_write);
+    _writer_line(&w);
+    TEST_ASSERT_EQUAL_INT(0, _sink_calls);
+    fmt_writer_flush(&w);
+    fmt_writer_flush(&w);
+    TEST_ASSERT_EQUAL_INT(1, _sink_calls);
+    TEST_ASSERT_EQUAL_STRING(expect, (char *)_sink);
+
+    /* buffers too small to format in place */
+    memset(_sink, 0, sizeof(_sink));
+    _sink_len = 0;
+    fmt_writer_init(&w, buf, 5, _sink_write);
+    _writer_line(&w);
+    fmt_writer_flush(&w);
+    TEST_ASSERT_EQUAL_STRING(expect, (char *)_sink);
+
+    memset(_sink, 0, sizeof(_sink));
+    _sink_len = 0;
+    fmt_writer_init(&w, NULL, 0, _sink_write);
+    _writer_line(&w);
+    fmt_writer_flush(&w);
+    TEST_ASSERT_EQUAL_STRING(expect, (char *)_sink);
+}
+
 Test *tests_fmt_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -247,13 +476,23 @@ Test *tests_fmt_tests(void)
         new_TestFixture(test_fmt_u32_hex),
         new_TestFixture(test_fmt_u64_hex),
         new_TestFixture(test_fmt_u32_dec),
+        new_TestFixture(test_fmt_u32_dec_lengths),
+        new_TestFixture(test_fmt_u64_dec),
         new_TestFixture(test_fmt_u16_dec),
         new_TestFixture(test_fmt_s32_dec),
+        new_TestFixture(test_fmt_s32_dec_min),
         new_TestFixture(test_rmt_s16_dec),
         new_TestFixture(test_rmt_s16_dfp),
+        new_TestFixture(test_fmt_s16_dfp_len),
+        new_TestFixture(test_fmt_s32_dfp),
+        new_TestFixture(test_fmt_float),
         new_TestFixture(test_fmt_strlen),
         new_TestFixture(test_fmt_str),
         new_TestFixture(test_scn_u32_dec),
+        new_TestFixture(test_scn_s32_dec),
+        new_TestFixture(test_scn_u32_hex),
+        new_TestFixture(test_scn_s32_dfp),
+        new_TestFixture(test_fmt_writer),
     };
 
     EMB_UNIT_TESTCALLER(fmt_tests, NULL, NULL, fixtures);
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "framing.h"
+
+#include "tests-framing.h"
+
+#define PAYLOAD_LEN     (100)
+
+static uint8_t payload[PAYLOAD_LEN];
+static uint8_t encoded[2 * PAYLOAD_LEN];
+static uint8_t decoded[2 * PAYLOAD_LEN];
+static size_t written;
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < PAYLOAD_LEN; i++) {
+        payload[i] = i;
+    }
+    written = 0;
+}
+
+static void _collect(void *arg, const uint8_t *data, size_t len)
+{
+    (void)arg;
+    memcpy(&encoded[written], data, len);
+    written += len;
+}
+
+static void test_framing_plain_len(void)
+{
+    static const uint8_t data[] = "0123456789abcdef0123456789abcdef";
+
+    /* all offsets and alignments, with a special byte at every position */
+    for (unsigned start = 0; start < 8; start++) {
+        for (unsigned special = start; special < sizeof(data); special++) {
+            uint8_t buf[sizeof(data)];
+
+            memcpy(buf, data, sizeof(buf));
+            buf[special] = framing_slip.esc;
+            TEST_ASSERT_EQUAL_INT(special - start,
+                                  framing_plain_len(&framing_slip, buf + start,
+                                                    sizeof(buf) - start));
+            buf[special] = framing_slip.end;
+            TEST_ASSERT_EQUAL_INT(special - start,
+                                  framing_plain_len(&framing_slip, buf + start,
+                                                    sizeof(buf) - start));
+        }
+        TEST_ASSERT_EQUAL_INT(sizeof(data) - start,
+                              framing_plain_len(&framing_slip, data + start,
+                                                sizeof(data) - start));
+    }
+}
+
+static void test_framing_encode_slip(void)
+{
+    static const uint8_t in[] = { 0x01, 0xc0, 0x02, 0xdb, 0xdb, 0xc0 };
+    static const uint8_t exp[] = { 0x01, 0xdb, 0xdc, 0x02, 0xdb, 0xdd,
+                                   0xdb, 0xdd, 0xdb, 0xdc };
+
+    TEST_ASSERT_EQUAL_INT(sizeof(exp),
+                          framing_encode_buf(&framing_slip, encoded, in,
+                                             sizeof(in)));
+    TEST_ASSERT(memcmp(exp, encoded, sizeof(exp)) == 0);
+
+    memset(encoded, 0, sizeof(encoded));
+    framing_encode(&framing_slip, in, sizeof(in), _collect, NULL);
+    TEST_ASSERT_EQUAL_INT(sizeof(exp), written);
+    TEST_ASSERT(memcmp(exp, encoded, sizeof(exp)) == 0);
+}
+
+static void test_framing_encode_hdlc(void)
+{
+    static const uint8_t in[] = { 0x7e, 0x7d, 0x20 };
+    static const uint8_t exp[] = { 0x7d, 0x5e, 0x7d, 0x5d, 0x20 };
+
+    TEST_ASSERT_EQUAL_INT(sizeof(exp),
+                          framing_encode_buf(&framing_hdlc, encoded, in,
+                                             sizeof(in)));
+    TEST_ASSERT(memcmp(exp, encoded, sizeof(exp)) == 0);
+}
+
+static void test_framing_roundtrip(void)
+{
+    const framing_t *framings[] = { &framing_slip, &framing_hdlc };
+
+    for (unsigned i = 0; i < sizeof(framings) / sizeof(framings[0]); i++) {
+        const framing_t *f = framings[i];
+        payload[10] = f->end;
+        payload[11] = f->esc;
+        payload[50] = f->esc;
+
+        size_t len = framing_encode_buf(f, encoded, payload, PAYLOAD_LEN);
+        TEST_ASSERT_EQUAL_INT(PAYLOAD_LEN + 3, len);
+        TEST_ASSERT_NULL(memchr(encoded, f->end, len));
+
+        /* split at every position, including inside escape sequences */
+        for (size_t split = 0; split <= len; split++) {
+            uint8_t esc = 0;
+            size_t n = framing_decode(f, decoded, encoded, split, &esc);
+            n += framing_decode(f, decoded + n, encoded + split, len - split,
+                                &esc);
+            TEST_ASSERT_EQUAL_INT(PAYLOAD_LEN, n);
+            TEST_ASSERT_EQUAL_INT(0, esc);
+            TEST_ASSERT(memcmp(payload, decoded, PAYLOAD_LEN) == 0);
+        }
+
+        /* in place */
+        uint8_t esc = 0;
+        TEST_ASSERT_EQUAL_INT(PAYLOAD_LEN,
+                              framing_decode(f, encoded, encoded, len, &esc));
+        TEST_ASSERT(memcmp(payload, encoded, PAYLOAD_LEN) == 0);
+    }
+}
+
+static void test_framing_decode_unknown_escape(void)
+{
+    static const uint8_t in[] = { 0x01, 0xdb, 0x42, 0x02 };
+    static const uint8_t exp[] = { 0x01, 0x02 };
+    uint8_t esc = 0;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(exp),
+                          framing_decode(&framing_slip, decoded, in, sizeof(in),
+                                         &esc));
+    TEST_ASSERT(memcmp(exp, decoded, sizeof(exp)) == 0);
+}
+
+Test *tests_framing_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_framing_plain_len),
+        new_TestFixture(test_framing_encode_slip),
+        new_TestFixture(test_framing_encode_hdlc),
+        new_TestFixture(test_framing_roundtrip),
+        new_TestFixture(test_framing_decode_unknown_escape),
+    };
+
+    EMB_UNIT_TESTCALLER(framing_tests, set_up, NULL, fixtures);
+
+    return (Test *)&framing_tests;
+}
+
+void tests_framing(void)
+{
+    TESTS_RUN(tests_framing_tests());
+}
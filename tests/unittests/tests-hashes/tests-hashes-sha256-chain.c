@@ -143,12 +143,55 @@ static void test_sha256_hash_chain_store_whole(void)
     }
 }
 
+static void test_sha256_hash_chain_verifier(void)
+{
+    const char strSeed[] = "My cool secret seed, you'll never guess it ;) 12345";
+    static unsigned char tail_hash_chain_element[SHA256_DIGEST_LENGTH];
+    size_t elements = 65;
+
+    /* keep the whole chain to disclose its elements */
+    size_t whole_chain_length = elements;
+    sha256_chain_idx_elm_t chain[whole_chain_length];
+
+    sha256_chain_with_waypoints((unsigned char*)strSeed, strlen(strSeed),
+                                elements, tail_hash_chain_element,
+                                chain, &whole_chain_length);
+
+    sha256_chain_idx_elm_t cache[4];
+    sha256_chain_verifier_t verifier;
+    sha256_chain_verifier_init(&verifier, cache, 4, tail_hash_chain_element,
+                               elements);
+
+    /* elements are disclosed in descending order, skipping some */
+    for (size_t i = elements - 1; i > 0; i -= 3) {
+        TEST_ASSERT(sha256_chain_verifier_check(&verifier, chain[i].element, i) == 0);
+        /* a wrong index must not verify */
+        TEST_ASSERT(sha256_chain_verifier_check(&verifier, chain[i].element, i - 1) == 1);
+        if (i < 3) {
+            break;
+        }
+    }
+
+    /* out of order elements can still be verified with a full cache */
+    TEST_ASSERT(sha256_chain_verifier_check(&verifier, chain[40].element, 40) == 0);
+    TEST_ASSERT(sha256_chain_verifier_check(&verifier, chain[0].element, 0) == 0);
+    TEST_ASSERT(sha256_chain_verifier_check(&verifier, chain[63].element, 63) == 0);
+    TEST_ASSERT(sha256_chain_verifier_check(&verifier, chain[5].element, 6) == 1);
+    TEST_ASSERT(sha256_chain_verifier_check(&verifier, chain[5].element, 70) == 1);
+
+    /* the tail is never evicted */
+    TEST_ASSERT(verifier.waypoints[verifier.used - 1].index == (elements - 1));
+    TEST_ASSERT(memcmp(verifier.waypoints[verifier.used - 1].element,
+                       tail_hash_chain_element, SHA256_DIGEST_LENGTH) == 0);
+}
+
 Test *tests_hashes_sha256_chain_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_sha256_hash_chain),
         new_TestFixture(test_sha256_hash_chain_with_waypoints),
         new_TestFixture(test_sha256_hash_chain_store_whole),
+        new_TestFixture(test_sha256_hash_chain_verifier),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
@@ -59,6 +59,24 @@ static void test_hashes_hmac_sha256_hash_sequence(void)
                  "f7bc83f430538424b13298e6aa6fb143ef4d59a14946175997479dbc2d1a3cd8", hmac));
 }
 
+static void test_hashes_hmac_sha256_streaming(void)
+{
+    const char key[] = "key";
+    const char str[] = "The quick brown fox jumps over the lazy dog";
+    static unsigned char hmac[SHA256_DIGEST_LENGTH];
+    hmac_context_t ctx;
+
+    /* feed the message in uneven pieces */
+    hmac_sha256_init(&ctx, key, strlen(key));
+    hmac_sha256_update(&ctx, str, 3);
+    hmac_sha256_update(&ctx, str + 3, 17);
+    hmac_sha256_update(&ctx, str + 20, strlen(str) - 20);
+    hmac_sha256_final(&ctx, hmac);
+
+    TEST_ASSERT(compare_str_vs_digest(
+                 "f7bc83f430538424b13298e6aa6fb143ef4d59a14946175997479dbc2d1a3cd8", hmac));
+}
+
 /*
         The followig testcases are taken from:
         https://tools.ietf.org/html/rfc4868#section-2.7.1
@@ -157,6 +175,7 @@ Test *tests_hashes_sha256_hmac_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_hashes_hmac_sha256_hash_sequence),
+        new_TestFixture(test_hashes_hmac_sha256_streaming),
         new_TestFixture(test_hashes_hmac_sha256_hash_PRF1),
         new_TestFixture(test_hashes_hmac_sha256_hash_PRF2),
         new_TestFixture(test_hashes_hmac_sha256_hash_PRF3),
@@ -212,6 +212,32 @@ static void test_hashes_sha256_hash_long_sequence(void)
                     hlong_sequence));
 }
 
+static void test_hashes_sha256_multi(void)
+{
+    /* lengths around the padding boundaries and more messages than lanes */
+    static const size_t lens[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 200, 1000 };
+    const size_t n = sizeof(lens) / sizeof(lens[0]);
+    static unsigned char data[1000];
+    const void *msgs[sizeof(lens) / sizeof(lens[0])];
+    unsigned char digests[sizeof(lens) / sizeof(lens[0])][SHA256_DIGEST_LENGTH];
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (unsigned char)(i * 13);
+    }
+    for (size_t i = 0; i < n; i++) {
+        /* use different offsets so every message has different content */
+        msgs[i] = data + (sizeof(data) - lens[i]) / 2;
+    }
+
+    sha256_multi(msgs, lens, n, digests);
+
+    for (size_t i = 0; i < n; i++) {
+        unsigned char expected[SHA256_DIGEST_LENGTH];
+        sha256(msgs[i], lens[i], expected);
+        TEST_ASSERT(memcmp(expected, digests[i], SHA256_DIGEST_LENGTH) == 0);
+    }
+}
+
 Test *tests_hashes_sha256_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -227,6 +253,7 @@ Test *tests_hashes_sha256_tests(void)
         new_TestFixture(test_hashes_sha256_hash_sequence_failing_compare),
 
         new_TestFixture(test_hashes_sha256_hash_long_sequence),
+        new_TestFixture(test_hashes_sha256_multi),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
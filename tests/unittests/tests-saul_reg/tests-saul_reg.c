@@ -63,6 +63,19 @@ static saul_reg_t *last(void)
     return cur;
 }
 
+static void check_nth(void)
+{
+    saul_reg_t *cur = saul_reg;
+    int i = 0;
+
+    while (cur) {
+        TEST_ASSERT(saul_reg_find_nth(i) == cur);
+        ++i;
+        cur = cur->next;
+    }
+    TEST_ASSERT_NULL(saul_reg_find_nth(i));
+}
+
 static void test_reg_initial_size(void)
 {
     TEST_ASSERT_NULL(saul_reg);
@@ -173,6 +186,57 @@ static void test_reg_rm(void)
     TEST_ASSERT_EQUAL_INT(2, count());
 }
 
+static void test_reg_index_overflow(void)
+{
+    static saul_reg_t many[SAUL_REG_INDEX_NUMOF + 4];
+    static char names[SAUL_REG_INDEX_NUMOF + 4][4];
+    unsigned numof = SAUL_REG_INDEX_NUMOF + 4;
+
+    /* S0 and S2 are left over from the previous tests */
+    for (unsigned i = 0; i < numof; i++) {
+        names[i][0] = 'M';
+        names[i][1] = '0' + (i / 10);
+        names[i][2] = '0' + (i % 10);
+        many[i].name = names[i];
+        many[i].driver = &s1_dri;
+        TEST_ASSERT_EQUAL_INT(0, saul_reg_add(&many[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(numof + 2, count());
+    for (unsigned i = 0; i < numof; i++) {
+        TEST_ASSERT(saul_reg_find_nth(i + 2) == &many[i]);
+        TEST_ASSERT(saul_reg_find_name(names[i]) == &many[i]);
+    }
+    TEST_ASSERT_NULL(saul_reg_find_nth(numof + 2));
+    TEST_ASSERT_NULL(saul_reg_find_nth(-1));
+
+    /* removing from the table pulls the first unindexed entry in */
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_rm(&many[1]));
+    TEST_ASSERT(saul_reg_find_nth(5) == &many[4]);
+    TEST_ASSERT_NULL(saul_reg_find_name(names[1]));
+    check_nth();
+
+    /* removing the head and the tail */
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_rm(&s0));
+    TEST_ASSERT(saul_reg == &s2);
+    TEST_ASSERT(saul_reg_find_nth(0) == &s2);
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_rm(&many[numof - 1]));
+    TEST_ASSERT(last() == &many[numof - 2]);
+    TEST_ASSERT_EQUAL_INT(0, saul_reg_add(&s0));
+    TEST_ASSERT(last() == &s0);
+    TEST_ASSERT(saul_reg_find_nth(numof - 1) == &s0);
+    check_nth();
+
+    for (unsigned i = 0; i < numof - 1; i++) {
+        if (i != 1) {
+            TEST_ASSERT_EQUAL_INT(0, saul_reg_rm(&many[i]));
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(2, count());
+    TEST_ASSERT(saul_reg_find_nth(0) == &s2);
+    TEST_ASSERT(saul_reg_find_nth(1) == &s0);
+    TEST_ASSERT_NULL(saul_reg_find_nth(2));
+}
+
 Test *tests_saul_reg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -181,7 +245,8 @@ Test *tests_saul_reg_tests(void)
         new_TestFixture(test_reg_find_nth),
         new_TestFixture(test_reg_find_type),
         new_TestFixture(test_reg_find_name),
-        new_TestFixture(test_reg_rm)
+        new_TestFixture(test_reg_rm),
+        new_TestFixture(test_reg_index_overflow)
     };
 
     EMB_UNIT_TESTCALLER(pkt_tests, NULL, NULL, fixtures);
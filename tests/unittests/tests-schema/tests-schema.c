@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "schema.h"
+
+#include "tests-schema.h"
+
+typedef struct {
+    int32_t lat;
+    int32_t lon;
+} position_t;
+
+typedef struct {
+    bool valid;
+    int8_t i8;
+    int16_t i16;
+    int64_t i64;
+    uint8_t u8;
+    uint32_t u32;
+    uint64_t u64;
+    float f;
+    double d;
+    char name[8];
+    position_t pos;
+} record_t;
+
+static SCHEMA_DEFINE(position_schema,
+    SCHEMA_FIELD(position_t, lat, SCHEMA_INT32),
+    SCHEMA_FIELD(position_t, lon, SCHEMA_INT32),
+);
+
+static SCHEMA_DEFINE(record_schema,
+    SCHEMA_FIELD(record_t, valid, SCHEMA_BOOL),
+    SCHEMA_FIELD(record_t, i8, SCHEMA_INT8),
+    SCHEMA_FIELD(record_t, i16, SCHEMA_INT16),
+    SCHEMA_FIELD(record_t, i64, SCHEMA_INT64),
+    SCHEMA_FIELD(record_t, u8, SCHEMA_UINT8),
+    SCHEMA_FIELD(record_t, u32, SCHEMA_UINT32),
+    SCHEMA_FIELD(record_t, u64, SCHEMA_UINT64),
+    SCHEMA_FIELD(record_t, f, SCHEMA_FLOAT),
+    SCHEMA_FIELD(record_t, d, SCHEMA_DOUBLE),
+    SCHEMA_FIELD(record_t, name, SCHEMA_STRING),
+    SCHEMA_FIELD_STRUCT(record_t, pos, position_schema),
+);
+
+static const record_t reference = {
+    .valid = true, .i8 = -100, .i16 = -1000, .i64 = -0x123456789ll,
+    .u8 = 200, .u32 = 4000000000u, .u64 = 0x7fffffffffffull,
+    .f = 1.5f, .d = -0.25, .name = "riot",
+    .pos = { .lat = 52516, .lon = -13377 },
+};
+
+static uint8_t buf[256];
+static cbor_stream_t stream;
+
+/* UBJSON cookie reading from and writing to buf */
+typedef struct {
+    ubjson_cookie_t cookie;
+    size_t pos;
+    size_t len;
+} mem_cookie_t;
+
+static ssize_t _mem_write(ubjson_cookie_t *__restrict cookie, const void *data, size_t len)
+{
+    mem_cookie_t *mem = container_of(cookie, mem_cookie_t, cookie);
+
+    if (mem->len + len > sizeof(buf)) {
+        return -ENOBUFS;
+    }
+
+    memcpy(&buf[mem->len], data, len);
+    mem->len += len;
+    return len;
+}
+
+static ssize_t _mem_read(ubjson_cookie_t *__restrict cookie, void *data, size_t len)
+{
+    mem_cookie_t *mem = container_of(cookie, mem_cookie_t, cookie);
+
+    if (mem->pos >= mem->len) {
+        return -1;
+    }
+
+    if (len > mem->len - mem->pos) {
+        len = mem->len - mem->pos;
+    }
+
+    memcpy(data, &buf[mem->pos], len);
+    mem->pos += len;
+    return len;
+}
+
+static void set_up(void)
+{
+    memset(buf, 0, sizeof(buf));
+    cbor_init(&stream, buf, sizeof(buf));
+}
+
+static void assert_equal_record(const record_t *a, const record_t *b)
+{
+    TEST_ASSERT_EQUAL_INT(a->valid, b->valid);
+    TEST_ASSERT_EQUAL_INT(a->i8, b->i8);
+    TEST_ASSERT_EQUAL_INT(a->i16, b->i16);
+    TEST_ASSERT(a->i64 == b->i64);
+    TEST_ASSERT_EQUAL_INT(a->u8, b->u8);
+    TEST_ASSERT(a->u32 == b->u32);
+    TEST_ASSERT(a->u64 == b->u64);
+    TEST_ASSERT(a->f == b->f);
+    TEST_ASSERT(a->d == b->d);
+    TEST_ASSERT_EQUAL_STRING(&a->name[0], &b->name[0]);
+    TEST_ASSERT_EQUAL_INT(a->pos.lat, b->pos.lat);
+    TEST_ASSERT_EQUAL_INT(a->pos.lon, b->pos.lon);
+}
+
+static void test_schema_find(void)
+{
+    TEST_ASSERT(schema_find(&record_schema, "u32", 3) == &record_schema_fields[5]);
+    TEST_ASSERT(schema_find(&record_schema, "pos", 3) == &record_schema_fields[10]);
+    TEST_ASSERT_NULL(schema_find(&record_schema, "u3", 2));
+    TEST_ASSERT_NULL(schema_find(&record_schema, "u322", 4));
+    TEST_ASSERT_NULL(schema_find(&record_schema, "", 0));
+}
+
+static void test_schema_store(void)
+{
+    record_t r;
+    const schema_field_t *i8 = schema_find(&record_schema, "i8", 2);
+    const schema_field_t *u8 = schema_find(&record_schema, "u8", 2);
+    const schema_field_t *f = schema_find(&record_schema, "f", 1);
+    const schema_field_t *name = schema_find(&record_schema, "name", 4);
+
+    TEST_ASSERT_EQUAL_INT(0, schema_store_int(i8, &r, -128));
+    TEST_ASSERT_EQUAL_INT(-128, r.i8);
+    TEST_ASSERT_EQUAL_INT(-ERANGE, schema_store_int(i8, &r, -129));
+    TEST_ASSERT_EQUAL_INT(-ERANGE, schema_store_uint(i8, &r, 128));
+    TEST_ASSERT_EQUAL_INT(-ERANGE, schema_store_int(u8, &r, -1));
+    TEST_ASSERT_EQUAL_INT(-ERANGE, schema_store_uint(u8, &r, 256));
+    TEST_ASSERT_EQUAL_INT(0, schema_store_int(f, &r, 3));
+    TEST_ASSERT(r.f == 3.0f);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, schema_store_double(i8, &r, 1.0));
+    TEST_ASSERT_EQUAL_INT(0, schema_store_string(name, &r, "1234567", 7));
+    TEST_ASSERT_EQUAL_STRING("1234567", &r.name[0]);
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, schema_store_string(name, &r, "12345678", 8));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, schema_store_string(i8, &r, "1", 1));
+}
+
+static void test_schema_cbor(void)
+{
+    cbor_writer_t writer;
+    cbor_cursor_t cursor;
+    record_t r;
+
+    cbor_writer_init_stream(&writer, &stream);
+    TEST_ASSERT_EQUAL_INT(0, schema_cbor_encode(&record_schema, &reference, &writer));
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_finish(&writer));
+
+    memset(&r, 0, sizeof(r));
+    cbor_cursor_init_stream(&cursor, &stream, 0);
+    TEST_ASSERT_EQUAL_INT(11, schema_cbor_decode(&record_schema, &r, &cursor));
+    assert_equal_record(&reference, &r);
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_END, cbor_cursor_peek(&cursor));
+}
+
+static void test_schema_cbor_unknown(void)
+{
+    cbor_writer_t writer;
+    cbor_cursor_t cursor;
+    record_t r;
+
+    /* {"x": [1, {"y": 2}], 7: "z", "i16": 5, "name": null} */
+    cbor_writer_init_stream(&writer, &stream);
+    cbor_put_map(&writer, 4);
+    cbor_put_text(&writer, "x", 1);
+    cbor_put_array(&writer, 2);
+    cbor_put_uint(&writer, 1);
+    cbor_put_map(&writer, 1);
+    cbor_put_text(&writer, "y", 1);
+    cbor_put_uint(&writer, 2);
+    cbor_put_uint(&writer, 7);
+    cbor_put_text(&writer, "z", 1);
+    cbor_put_text(&writer, "i16", 3);
+    cbor_put_int(&writer, 5);
+    cbor_put_text(&writer, "name", 4);
+    cbor_put_null(&writer);
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_finish(&writer));
+
+    r = reference;
+    cbor_cursor_init_stream(&cursor, &stream, 0);
+    TEST_ASSERT_EQUAL_INT(2, schema_cbor_decode(&record_schema, &r, &cursor));
+    TEST_ASSERT_EQUAL_INT(5, r.i16);
+    TEST_ASSERT_EQUAL_STRING(&reference.name[0], &r.name[0]);
+
+    /* type mismatch and out of range values */
+    cbor_clear(&stream);
+    cbor_writer_init_stream(&writer, &stream);
+    cbor_put_map(&writer, 1);
+    cbor_put_text(&writer, "valid", 5);
+    cbor_put_uint(&writer, 1);
+    cbor_writer_finish(&writer);
+    cbor_cursor_init_stream(&cursor, &stream, 0);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, schema_cbor_decode(&record_schema, &r, &cursor));
+
+    cbor_clear(&stream);
+    cbor_writer_init_stream(&writer, &stream);
+    cbor_put_map(&writer, 1);
+    cbor_put_text(&writer, "u8", 2);
+    cbor_put_uint(&writer, 256);
+    cbor_writer_finish(&writer);
+    cbor_cursor_init_stream(&cursor, &stream, 0);
+    TEST_ASSERT_EQUAL_INT(-ERANGE, schema_cbor_decode(&record_schema, &r, &cursor));
+}
+
+static void test_schema_ubjson(void)
+{
+    mem_cookie_t mem = { .pos = 0, .len = 0 };
+    record_t r;
+
+    ubjson_write_init(&mem.cookie, _mem_write);
+    ssize_t len = schema_ubjson_encode(&record_schema, &reference, &mem.cookie);
+    TEST_ASSERT_EQUAL_INT(mem.len, len);
+
+    memset(&r, 0, sizeof(r));
+    TEST_ASSERT_EQUAL_INT(11, schema_ubjson_decode(&record_schema, &r, &mem.cookie,
+                                                   _mem_read));
+    assert_equal_record(&reference, &r);
+    TEST_ASSERT_EQUAL_INT(mem.len, mem.pos);
+}
+
+static void test_schema_ubjson_unknown(void)
+{
+    mem_cookie_t mem = { .pos = 0, .len = 0 };
+    record_t r = reference;
+
+    /* {"x": [$i#2 1 2], "o": {"y": "abc"}, N "i16": 5, "name": Z} */
+    static const char doc[] = "{" "i\x01x" "[$i#i\x02\x01\x02"
+                              "i\x01o" "{i\x01yS" "i\x03" "abc}"
+                              "N" "i\x03i16" "i\x05"
+                              "i\x04nameZ" "}";
+    memcpy(buf, doc, sizeof(doc) - 1);
+    mem.len = sizeof(doc) - 1;
+
+    TEST_ASSERT_EQUAL_INT(2, schema_ubjson_decode(&record_schema, &r, &mem.cookie,
+                                                  _mem_read));
+    TEST_ASSERT_EQUAL_INT(5, r.i16);
+    TEST_ASSERT_EQUAL_STRING(&reference.name[0], &r.name[0]);
+    TEST_ASSERT_EQUAL_INT(mem.len, mem.pos);
+
+    /* string too long for the field */
+    static const char too_long[] = "{i\x04nameSi\x08" "12345678}";
+    memcpy(buf, too_long, sizeof(too_long) - 1);
+    mem.len = sizeof(too_long) - 1;
+    mem.pos = 0;
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, schema_ubjson_decode(&record_schema, &r, &mem.cookie,
+                                                           _mem_read));
+
+    /* truncated */
+    mem.len = 5;
+    mem.pos = 0;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, schema_ubjson_decode(&record_schema, &r, &mem.cookie,
+                                                         _mem_read));
+}
+
+Test *tests_schema_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_schema_find),
+        new_TestFixture(test_schema_store),
+        new_TestFixture(test_schema_cbor),
+        new_TestFixture(test_schema_cbor_unknown),
+        new_TestFixture(test_schema_ubjson),
+        new_TestFixture(test_schema_ubjson_unknown),
+    };
+
+    EMB_UNIT_TESTCALLER(schema_tests, set_up, NULL, fixtures);
+
+    return (Test *)&schema_tests;
+}
+
+void tests_schema(void)
+{
+    TESTS_RUN(tests_schema_tests());
+}
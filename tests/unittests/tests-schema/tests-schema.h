@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``schema`` module
+ */
+#ifndef TESTS_SCHEMA_H_
+#define TESTS_SCHEMA_H_
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_schema(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_SCHEMA_H_ */
+/** @} */
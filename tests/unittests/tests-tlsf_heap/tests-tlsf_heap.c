@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "tlsf_heap.h"
+
+#include "tests-tlsf_heap.h"
+
+#define MEM_SIZE    (4096)
+#define NUMOF       (32)
+
+static uint8_t mem[MEM_SIZE + 3];
+static tlsf_heap_t heap;
+
+static void set_up(void)
+{
+    /* deliberately misaligned */
+    tlsf_heap_init(&heap, "test", mem + 3, MEM_SIZE);
+}
+
+static void test_tlsf_heap_alloc_free(void)
+{
+    tlsf_heap_stats_t before, after;
+    void *ptrs[NUMOF];
+
+    tlsf_heap_get_stats(&heap, &before);
+    TEST_ASSERT_EQUAL_INT(1, before.free_blocks);
+    TEST_ASSERT_EQUAL_INT(0, before.used);
+
+    for (unsigned i = 0; i < NUMOF; i++) {
+        ptrs[i] = tlsf_heap_alloc(&heap, i * 3 + 1);
+        TEST_ASSERT_NOT_NULL(ptrs[i]);
+        TEST_ASSERT_EQUAL_INT(0, (uintptr_t)ptrs[i] % TLSF_HEAP_ALIGN);
+        memset(ptrs[i], i, i * 3 + 1);
+    }
+    for (unsigned i = 0; i < NUMOF; i++) {
+        uint8_t *p = ptrs[i];
+        TEST_ASSERT_EQUAL_INT(i, p[i * 3]);
+    }
+
+    /* free every other block first, then the rest */
+    for (unsigned i = 0; i < NUMOF; i += 2) {
+        tlsf_heap_free(&heap, ptrs[i]);
+    }
+    for (unsigned i = 1; i < NUMOF; i += 2) {
+        tlsf_heap_free(&heap, ptrs[i]);
+    }
+
+    /* everything merged back into a single block */
+    tlsf_heap_get_stats(&heap, &after);
+    TEST_ASSERT_EQUAL_INT(0, after.used);
+    TEST_ASSERT_EQUAL_INT(1, after.free_blocks);
+    TEST_ASSERT_EQUAL_INT(before.largest_free, after.largest_free);
+    TEST_ASSERT(after.high_water > 0);
+}
+
+static void test_tlsf_heap_exhaust(void)
+{
+    tlsf_heap_stats_t stats;
+    unsigned n = 0;
+
+    TEST_ASSERT_NULL(tlsf_heap_alloc(&heap, MEM_SIZE));
+    while (tlsf_heap_alloc(&heap, 100)) {
+        n++;
+    }
+    TEST_ASSERT(n > 10);
+
+    tlsf_heap_get_stats(&heap, &stats);
+    TEST_ASSERT_EQUAL_INT(2, stats.failed);
+    TEST_ASSERT_EQUAL_INT(n, stats.used_blocks);
+}
+
+static void test_tlsf_heap_memalign(void)
+{
+    void *a = tlsf_heap_alloc(&heap, 10);
+    void *b = tlsf_heap_memalign(&heap, 256, 100);
+    void *c = tlsf_heap_alloc(&heap, 10);
+    tlsf_heap_stats_t stats;
+
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_INT(0, (uintptr_t)b % 256);
+    memset(b, 0xff, 100);
+
+    tlsf_heap_free(&heap, b);
+    tlsf_heap_free(&heap, a);
+    tlsf_heap_free(&heap, c);
+    tlsf_heap_get_stats(&heap, &stats);
+    TEST_ASSERT_EQUAL_INT(0, stats.used);
+    TEST_ASSERT_EQUAL_INT(1, stats.free_blocks);
+}
+
+static void test_tlsf_heap_realloc(void)
+{
+    uint8_t *p = tlsf_heap_alloc(&heap, 16);
+    memset(p, 0xab, 16);
+
+    /* grows in place, nothing follows */
+    uint8_t *q = tlsf_heap_realloc(&heap, p, 200);
+    TEST_ASSERT(p == q);
+
+    /* has to move */
+    void *block = tlsf_heap_alloc(&heap, 16);
+    uint8_t *r = tlsf_heap_realloc(&heap, q, 1000);
+    TEST_ASSERT_NOT_NULL(r);
+    TEST_ASSERT(q != r);
+    TEST_ASSERT_EQUAL_INT(0xab, r[15]);
+
+    /* shrinks in place */
+    TEST_ASSERT(r == tlsf_heap_realloc(&heap, r, 8));
+    TEST_ASSERT_EQUAL_INT(0xab, r[7]);
+
+    TEST_ASSERT_NULL(tlsf_heap_realloc(&heap, r, 0));
+    tlsf_heap_free(&heap, block);
+
+    uint8_t *z = tlsf_heap_calloc(&heap, 10, 10);
+    TEST_ASSERT_NOT_NULL(z);
+    TEST_ASSERT_EQUAL_INT(0, z[99]);
+    TEST_ASSERT_NULL(tlsf_heap_calloc(&heap, SIZE_MAX / 2, 4));
+}
+
+static void test_tlsf_heap_usable_size(void)
+{
+    tlsf_heap_stats_t stats;
+
+    TEST_ASSERT_EQUAL_INT(0, tlsf_heap_usable_size(NULL));
+    for (size_t size = 1; size < 100; size += 7) {
+        void *ptr = tlsf_heap_alloc(&heap, size);
+        TEST_ASSERT_NOT_NULL(ptr);
+        TEST_ASSERT(tlsf_heap_usable_size(ptr) >= size);
+        /* the accounted size is the usable size */
+        tlsf_heap_get_stats(&heap, &stats);
+        TEST_ASSERT_EQUAL_INT(stats.used, tlsf_heap_usable_size(ptr));
+        tlsf_heap_free(&heap, ptr);
+    }
+}
+
+Test *tests_tlsf_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tlsf_heap_alloc_free),
+        new_TestFixture(test_tlsf_heap_exhaust),
+        new_TestFixture(test_tlsf_heap_memalign),
+        new_TestFixture(test_tlsf_heap_realloc),
+        new_TestFixture(test_tlsf_heap_usable_size),
+    };
+
+    EMB_UNIT_TESTCALLER(tlsf_heap_tests, set_up, NULL, fixtures);
+
+    return (Test *)&tlsf_heap_tests;
+}
+
+void tests_tlsf_heap(void)
+{
+    TESTS_RUN(tests_tlsf_heap_tests());
+}
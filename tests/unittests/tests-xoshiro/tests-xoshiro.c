@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "xoshiro.h"
+#include "tests-xoshiro.h"
+
+static void test_xoshiro_reference(void)
+{
+    /* output of the reference implementation for this state */
+    static const uint32_t expected[] = {
+        11520, 0, 5927040, 70819200, 2031721883, 1637235492, 1287239034,
+        3734860849
+    };
+    xoshiro_t x = { .s = { 1, 2, 3, 4 } };
+
+    for (unsigned i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        TEST_ASSERT_EQUAL_INT(expected[i], xoshiro_next(&x));
+    }
+}
+
+static void test_xoshiro_init(void)
+{
+    xoshiro_t x, y;
+
+    xoshiro_init(&x, 42);
+    TEST_ASSERT_EQUAL_INT(0x2feb6e95, x.s[0]);
+    TEST_ASSERT_EQUAL_INT(0xbdd73226, x.s[1]);
+    TEST_ASSERT_EQUAL_INT(0xb266f103, x.s[2]);
+    TEST_ASSERT_EQUAL_INT(0x28efe333, x.s[3]);
+
+    xoshiro_init(&y, 43);
+    TEST_ASSERT(xoshiro_next(&x) != xoshiro_next(&y));
+}
+
+static void test_xoshiro_bytes(void)
+{
+    uint8_t buf[39];
+    xoshiro_t x, y;
+
+    xoshiro_init(&x, 1);
+    y = x;
+    memset(buf, 0xee, sizeof(buf));
+    xoshiro_bytes(&x, buf, sizeof(buf) - 2);
+
+    for (unsigned i = 0; i + sizeof(uint32_t) <= sizeof(buf) - 2;
+         i += sizeof(uint32_t)) {
+        uint32_t r = xoshiro_next(&y);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(&buf[i], &r, sizeof(r)));
+    }
+    /* the last word is cut to one byte */
+    uint32_t r = xoshiro_next(&y);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&buf[36], &r, 1));
+    TEST_ASSERT_EQUAL_INT(0xee, buf[37]);
+    TEST_ASSERT_EQUAL_INT(0xee, buf[38]);
+
+    /* and both are at the same place */
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&x, &y, sizeof(x)));
+}
+
+static void test_xoshiro_jump(void)
+{
+    /* state after 2^64 steps from { 1, 2, 3, 4 }, computed by squaring the
+     * transition matrix of the generator over GF(2) */
+    static const uint32_t expected[] = {
+        0xa9765206, 0x797aa168, 0x5b62e331, 0x02abd971
+    };
+    xoshiro_t x = { .s = { 1, 2, 3, 4 } };
+    xoshiro_t y = x;
+
+    xoshiro_jump(&x);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(x.s, expected, sizeof(expected)));
+
+    /* jumping commutes with stepping */
+    xoshiro_next(&x);
+    xoshiro_next(&y);
+    xoshiro_jump(&y);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&x, &y, sizeof(x)));
+}
+
+Test *tests_xoshiro_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_xoshiro_reference),
+        new_TestFixture(test_xoshiro_init),
+        new_TestFixture(test_xoshiro_bytes),
+        new_TestFixture(test_xoshiro_jump),
+    };
+
+    EMB_UNIT_TESTCALLER(xoshiro_tests, NULL, NULL, fixtures);
+
+    return (Test *)&xoshiro_tests;
+}
+
+void tests_xoshiro(void)
+{
+    TESTS_RUN(tests_xoshiro_tests());
+}
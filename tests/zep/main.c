@@ -35,14 +35,14 @@ int main(void)
     puts("ZEP module test");
 
     /* initialize and register pktdump */
-    dump.pid = gnrc_pktdump_pid;
+    gnrc_netreg_entry_init_pid(&dump, GNRC_NETREG_DEMUX_CTX_ALL,
+                               gnrc_pktdump_pid);
 
     if (dump.pid <= KERNEL_PID_UNDEF) {
         puts("Error starting pktdump thread");
         return -1;
     }
 
-    dump.demux_ctx = GNRC_NETREG_DEMUX_CTX_ALL;
     gnrc_netreg_register(GNRC_NETTYPE_NETIF, &dump);
 
     /* start the shell */